@@ -0,0 +1,36 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <BWAPI.h>
+
+namespace BWAPI
+{
+    // The bench doesn't connect to a game: the state of each frame is set on the Game directly
+    // (see Game::setFrame()), so this client has nothing to do.
+    class ProtoClient : public Client
+    {
+    public:
+        bool isConnected() const override { return true; }
+        bool connect() override { return true; }
+        void disconnect() override {}
+        void update(Game&) override {}
+    };
+}
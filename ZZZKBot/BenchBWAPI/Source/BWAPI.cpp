@@ -0,0 +1,1355 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <BWAPI.h>
+#include <algorithm>
+#include <climits>
+
+namespace BWAPI
+{
+    namespace
+    {
+        // The game whose match was started last, for the filters (which BWAPI bases on its global
+        // Broodwar pointer too).
+        const Game* currentGame = nullptr;
+
+        bool isEggType(const UnitType type)
+        {
+            return type == UnitTypes::Zerg_Egg || type == UnitTypes::Zerg_Lurker_Egg || type == UnitTypes::Zerg_Cocoon;
+        }
+
+        bool isMorphSourceType(const UnitType type)
+        {
+            return type == UnitTypes::Zerg_Larva || type == UnitTypes::Zerg_Hydralisk || type == UnitTypes::Zerg_Mutalisk || isEggType(type);
+        }
+
+        int getApproxDistance(const int xDist, const int yDist)
+        {
+            return Positions::Origin.getApproxDistance(Position(xDist, yDist));
+        }
+
+        // Whether a requirement of type is met by a unit of haveType (higher tech buildings meet the
+        // requirements of the ones they were morphed from).
+        bool meetsRequirement(const UnitType haveType, const UnitType type)
+        {
+            return haveType == type ||
+                (type == UnitTypes::Zerg_Hatchery && (haveType == UnitTypes::Zerg_Lair || haveType == UnitTypes::Zerg_Hive)) ||
+                (type == UnitTypes::Zerg_Lair && haveType == UnitTypes::Zerg_Hive) ||
+                (type == UnitTypes::Zerg_Spire && haveType == UnitTypes::Zerg_Greater_Spire);
+        }
+
+        // The radius (in tiles) of the creep around a building that produces creep.
+        int getCreepRadius(const UnitType type)
+        {
+            return type.isResourceDepot() ? 10 : 6;
+        }
+    }
+
+    namespace Filter
+    {
+        const PtrUnitFilter IsEnemy([](Unit& u) { return u->getPlayer() != nullptr && u->getPlayer()->isEnemy(currentGame->self()); });
+        const PtrUnitFilter IsAlly([](Unit& u) { return u->getPlayer() != nullptr && u->getPlayer()->isAlly(currentGame->self()); });
+        const PtrUnitFilter IsOwned([](Unit& u) { return u->getPlayer() == currentGame->self(); });
+        const PtrUnitFilter IsVisible([](Unit& u) { return u->isVisible(); });
+        const PtrUnitFilter Exists([](Unit& u) { return u->exists(); });
+        const PtrUnitFilter IsCompleted([](Unit& u) { return u->isCompleted(); });
+        const PtrUnitFilter IsLifted([](Unit& u) { return u->isLifted(); });
+        const PtrUnitFilter IsResourceDepot([](Unit& u) { return u->getType().isResourceDepot(); });
+        const PtrUnitFilter IsMineralField([](Unit& u) { return u->getType().isMineralField(); });
+        const PtrUnitFilter IsRefinery([](Unit& u) { return u->getType().isRefinery(); });
+        const PtrUnitFilter IsBuilding([](Unit& u) { return u->getType().isBuilding(); });
+        const PtrUnitFilter IsWorker([](Unit& u) { return u->getType().isWorker(); });
+        const PtrUnitFilter IsCarryingGas([](Unit& u) { return u->isCarryingGas(); });
+        const PtrUnitFilter IsCarryingSomething([](Unit& u) { return u->isCarryingGas() || u->isCarryingMinerals(); });
+        const PtrUnitFilter IsDetected([](Unit& u) { return u->isDetected(); });
+        const PtrUnitFilter IsFlying([](Unit& u) { return u->isFlying(); });
+        const PtrUnitFilter IsGatheringGas([](Unit& u) { return u->isGatheringGas(); });
+        const PtrUnitFilter IsGatheringMinerals([](Unit& u) { return u->isGatheringMinerals(); });
+        const PtrUnitFilter IsIdle([](Unit& u) { return u->isIdle(); });
+        const PtrUnitFilter IsInvincible([](Unit& u) { return u->isInvincible(); });
+        const PtrUnitFilter IsLockedDown([](Unit& u) { return u->isLockedDown(); });
+        const PtrUnitFilter IsMaelstrommed([](Unit& u) { return u->isMaelstrommed(); });
+        const PtrUnitFilter IsStasised([](Unit& u) { return u->isStasised(); });
+        const PtrUnitFilter IsPowered([](Unit& u) { return u->isPowered(); });
+        const PtrUnitFilter IsMoving([](Unit& u) { return u->isMoving(); });
+        const PtrUnitFilter CanAttack([](Unit& u) { return u->getType().canAttack(); });
+        const CompareFilter<Unit, UnitType> GetType([](Unit& u) { return u->getType(); });
+        const CompareFilter<Unit, Player> GetPlayer([](Unit& u) { return u->getPlayer(); });
+        const CompareFilter<Unit, Order> CurrentOrder([](Unit& u) { return u->getOrder(); });
+        const CompareFilter<Unit, int> HP([](Unit& u) { return u->getHitPoints(); });
+        const CompareFilter<Unit, int> Shields([](Unit& u) { return u->getShields(); });
+        const CompareFilter<Unit, int> Resources([](Unit& u) { return u->getResources(); });
+        const CompareFilter<Unit, int> ID([](Unit& u) { return u->getID(); });
+    }
+
+    UnitCommand UnitCommand::attack(Unit unit, Position target, bool shiftQueueCommand)
+    {
+        return UnitCommand(unit, UnitCommandTypes::Attack_Move, nullptr, target.x, target.y, shiftQueueCommand ? 1 : 0);
+    }
+
+    UnitCommand UnitCommand::attack(Unit unit, Unit target, bool shiftQueueCommand)
+    {
+        return UnitCommand(unit, UnitCommandTypes::Attack_Unit, target, Positions::None.x, Positions::None.y, shiftQueueCommand ? 1 : 0);
+    }
+
+    UnitCommand UnitCommand::move(Unit unit, Position target, bool shiftQueueCommand)
+    {
+        return UnitCommand(unit, UnitCommandTypes::Move, nullptr, target.x, target.y, shiftQueueCommand ? 1 : 0);
+    }
+
+    UnitCommand UnitCommand::rightClick(Unit unit, Position target, bool shiftQueueCommand)
+    {
+        return UnitCommand(unit, UnitCommandTypes::Right_Click_Position, nullptr, target.x, target.y, shiftQueueCommand ? 1 : 0);
+    }
+
+    UnitCommand UnitCommand::rightClick(Unit unit, Unit target, bool shiftQueueCommand)
+    {
+        return UnitCommand(unit, UnitCommandTypes::Right_Click_Unit, target, Positions::None.x, Positions::None.y, shiftQueueCommand ? 1 : 0);
+    }
+
+    UnitCommand UnitCommand::stop(Unit unit, bool shiftQueueCommand)
+    {
+        return UnitCommand(unit, UnitCommandTypes::Stop, nullptr, Positions::None.x, Positions::None.y, shiftQueueCommand ? 1 : 0);
+    }
+
+    UnitCommand UnitCommand::holdPosition(Unit unit, bool shiftQueueCommand)
+    {
+        return UnitCommand(unit, UnitCommandTypes::Hold_Position, nullptr, Positions::None.x, Positions::None.y, shiftQueueCommand ? 1 : 0);
+    }
+
+    bool UnitCommand::operator==(const UnitCommand& other) const
+    {
+        return unit == other.unit && type == other.type && target == other.target && x == other.x && y == other.y && extra == other.extra;
+    }
+
+    Position UnitCommand::getTargetPosition() const
+    {
+        if (type == UnitCommandTypes::Build)
+        {
+            return Position(TilePosition(x, y));
+        }
+
+        return Position(x, y);
+    }
+
+    TilePosition UnitCommand::getTargetTilePosition() const
+    {
+        if (type == UnitCommandTypes::Build)
+        {
+            return TilePosition(x, y);
+        }
+
+        return TilePosition(Position(x, y));
+    }
+
+    UnitType UnitCommand::getUnitType() const
+    {
+        if (type == UnitCommandTypes::Build || type == UnitCommandTypes::Train || type == UnitCommandTypes::Morph)
+        {
+            return UnitType(extra);
+        }
+
+        return UnitTypes::None;
+    }
+
+    UpgradeType UnitCommand::getUpgradeType() const
+    {
+        return type == UnitCommandTypes::Upgrade ? UpgradeType(extra) : UpgradeTypes::None;
+    }
+
+    TechType UnitCommand::getTechType() const
+    {
+        return TechTypes::None;
+    }
+
+    Position Unitset::getPosition() const
+    {
+        if (empty())
+        {
+            return Positions::Invalid;
+        }
+
+        Position sum(0, 0);
+        for (const Unit u : *this)
+        {
+            sum += u->getPosition();
+        }
+
+        return sum / (int) size();
+    }
+
+    Unitset Unitset::getUnitsInRadius(int radius, const UnitFilter& pred) const
+    {
+        Unitset result;
+        for (const Unit u : *this)
+        {
+            const Unitset unitsInRadius = u->getUnitsInRadius(radius, pred);
+            result.insert(unitsInRadius.begin(), unitsInRadius.end());
+        }
+
+        return result;
+    }
+
+    Unit Unitset::getClosestUnit(const UnitFilter& pred, int radius) const
+    {
+        return currentGame->getClosestUnit(getPosition(), pred, radius);
+    }
+
+    Player UnitInterface::getPlayer() const
+    {
+        return game->getPlayer(state.playerID);
+    }
+
+    TilePosition UnitInterface::getTilePosition() const
+    {
+        return TilePosition(Position(state.x - getType().tileWidth() * 16, state.y - getType().tileHeight() * 16));
+    }
+
+    TilePosition UnitInterface::getInitialTilePosition() const
+    {
+        return TilePosition(Position(initialPosition.x - initialType.tileWidth() * 16, initialPosition.y - initialType.tileHeight() * 16));
+    }
+
+    int UnitInterface::getDistance(Position target) const
+    {
+        int xDist = getLeft() - (target.x + 1);
+        if (xDist < 0)
+        {
+            xDist = (target.x - 1) - getRight();
+            if (xDist < 0)
+            {
+                xDist = 0;
+            }
+        }
+
+        int yDist = getTop() - (target.y + 1);
+        if (yDist < 0)
+        {
+            yDist = (target.y - 1) - getBottom();
+            if (yDist < 0)
+            {
+                yDist = 0;
+            }
+        }
+
+        return getApproxDistance(xDist, yDist);
+    }
+
+    int UnitInterface::getDistance(Unit target) const
+    {
+        if (target == this)
+        {
+            return 0;
+        }
+
+        int xDist = getLeft() - (target->getRight() + 1);
+        if (xDist < 0)
+        {
+            xDist = target->getLeft() - (getRight() + 1);
+            if (xDist < 0)
+            {
+                xDist = 0;
+            }
+        }
+
+        int yDist = getTop() - (target->getBottom() + 1);
+        if (yDist < 0)
+        {
+            yDist = target->getTop() - (getBottom() + 1);
+            if (yDist < 0)
+            {
+                yDist = 0;
+            }
+        }
+
+        return getApproxDistance(xDist, yDist);
+    }
+
+    UnitType UnitInterface::getBuildType() const
+    {
+        return isEggType(getType()) ? buildType : UnitTypes::None;
+    }
+
+    Unit UnitInterface::getTarget() const
+    {
+        const Unit target = game->getUnit(state.targetID);
+        return target != nullptr && target->exists() ? target : nullptr;
+    }
+
+    Position UnitInterface::getTargetPosition() const
+    {
+        const Unit target = getTarget();
+        return target != nullptr ? target->getPosition() : Positions::None;
+    }
+
+    Unit UnitInterface::getOrderTarget() const
+    {
+        const Unit orderTarget = game->getUnit(state.orderTargetID);
+        return orderTarget != nullptr && orderTarget->exists() ? orderTarget : nullptr;
+    }
+
+    Position UnitInterface::getOrderTargetPosition() const
+    {
+        const Unit orderTarget = getOrderTarget();
+        return orderTarget != nullptr ? orderTarget->getPosition() : Positions::None;
+    }
+
+    Unitset UnitInterface::getLarva() const
+    {
+        if (!getType().producesLarva())
+        {
+            return Unitset();
+        }
+
+        const Player player = getPlayer();
+        return getUnitsInRadius(64, [player](Unit& u) { return u->getType() == UnitTypes::Zerg_Larva && u->getPlayer() == player; });
+    }
+
+    bool UnitInterface::isVisible(Player player) const
+    {
+        if (player == nullptr || player == game->self())
+        {
+            return isAccessible && (hasFlag(GameRecord::visibleFlag) || getPlayer() == game->self());
+        }
+
+        return isAccessible && getPlayer() == player;
+    }
+
+    bool UnitInterface::isInWeaponRange(Unit target) const
+    {
+        if (!exists() || target == nullptr || !target->exists() || target == this)
+        {
+            return false;
+        }
+
+        const WeaponType weapon = target->isFlying() ? getType().airWeapon() : getType().groundWeapon();
+        if (weapon == WeaponTypes::None || weapon == WeaponTypes::Unknown)
+        {
+            return false;
+        }
+
+        const int minRange = weapon.minRange();
+        const int maxRange = getPlayer()->weaponMaxRange(weapon);
+        const int distance = getDistance(target);
+        return (minRange == 0 || minRange < distance) && distance <= maxRange;
+    }
+
+    Unitset UnitInterface::getUnitsInRadius(int radius, const UnitFilter& pred) const
+    {
+        Unitset result;
+        game->forEachUnitInRectangle(getLeft() - radius, getTop() - radius, getRight() + radius, getBottom() + radius, [this, radius, &pred, &result](const Unit u)
+        {
+            if (u != this && getDistance(u) <= radius && (!pred.isValid() || pred(u)))
+            {
+                result.insert(u);
+            }
+        });
+
+        return result;
+    }
+
+    Unitset UnitInterface::getUnitsInWeaponRange(WeaponType weapon, const UnitFilter& pred) const
+    {
+        const int maxRange = getPlayer()->weaponMaxRange(weapon);
+        const int minRange = weapon.minRange();
+        Unitset result;
+        game->forEachUnitInRectangle(getLeft() - maxRange, getTop() - maxRange, getRight() + maxRange, getBottom() + maxRange, [this, weapon, maxRange, minRange, &pred, &result](const Unit u)
+        {
+            if (u == this || (u->isFlying() ? !weapon.targetsAir() : !weapon.targetsGround()))
+            {
+                return;
+            }
+
+            const int distance = getDistance(u);
+            if ((minRange == 0 || minRange < distance) && distance <= maxRange && (!pred.isValid() || pred(u)))
+            {
+                result.insert(u);
+            }
+        });
+
+        return result;
+    }
+
+    Unit UnitInterface::getClosestUnit(const UnitFilter& pred, int radius) const
+    {
+        Unit closestUnit = nullptr;
+        int closestDistance = INT_MAX;
+        game->forEachUnitInRectangle(getLeft() - radius, getTop() - radius, getRight() + radius, getBottom() + radius, [this, radius, &pred, &closestUnit, &closestDistance](const Unit u)
+        {
+            if (u == this || getDistance(u) > radius || (pred.isValid() && !pred(u)))
+            {
+                return;
+            }
+
+            // Like BWAPI, the radius is from this unit's edges but the closest unit is the one
+            // closest to its position.
+            const int distance = u->getDistance(getPosition());
+            if (distance < closestDistance)
+            {
+                closestUnit = u;
+                closestDistance = distance;
+            }
+        });
+
+        return closestUnit;
+    }
+
+    bool UnitInterface::issueCommand(UnitCommand command)
+    {
+        if (!canCommand())
+        {
+            return false;
+        }
+
+        lastCommand = command;
+        lastCommandFrame = game->getFrameCount();
+
+        GameRecord::CommandInfo commandInfo;
+        commandInfo.unitID = id;
+        commandInfo.typeID = command.type;
+        commandInfo.targetID = command.target != nullptr ? command.target->getID() : -1;
+        commandInfo.x = command.x;
+        commandInfo.y = command.y;
+        commandInfo.extra = command.extra;
+        game->issuedCommands.push_back(commandInfo);
+        return true;
+    }
+
+    bool UnitInterface::attack(Position target, bool shiftQueueCommand)
+    {
+        return issueCommand(UnitCommand::attack(this, target, shiftQueueCommand));
+    }
+
+    bool UnitInterface::attack(Unit target, bool shiftQueueCommand)
+    {
+        return canAttack(target) && issueCommand(UnitCommand::attack(this, target, shiftQueueCommand));
+    }
+
+    bool UnitInterface::build(UnitType type, TilePosition target)
+    {
+        return canBuild(type, target) && issueCommand(UnitCommand(this, UnitCommandTypes::Build, nullptr, target.x, target.y, type));
+    }
+
+    bool UnitInterface::train(UnitType type)
+    {
+        return canTrain(type) && issueCommand(UnitCommand(this, UnitCommandTypes::Train, nullptr, Positions::None.x, Positions::None.y, type));
+    }
+
+    bool UnitInterface::morph(UnitType type)
+    {
+        return canMorph(type) && issueCommand(UnitCommand(this, UnitCommandTypes::Morph, nullptr, Positions::None.x, Positions::None.y, type));
+    }
+
+    bool UnitInterface::upgrade(UpgradeType upgrade)
+    {
+        return canUpgrade(upgrade) && issueCommand(UnitCommand(this, UnitCommandTypes::Upgrade, nullptr, Positions::None.x, Positions::None.y, upgrade));
+    }
+
+    bool UnitInterface::move(Position target, bool shiftQueueCommand)
+    {
+        return canMove() && issueCommand(UnitCommand::move(this, target, shiftQueueCommand));
+    }
+
+    bool UnitInterface::stop(bool shiftQueueCommand)
+    {
+        return canStop() && issueCommand(UnitCommand::stop(this, shiftQueueCommand));
+    }
+
+    bool UnitInterface::gather(Unit target, bool shiftQueueCommand)
+    {
+        return canGather(target) && issueCommand(UnitCommand(this, UnitCommandTypes::Gather, target, Positions::None.x, Positions::None.y, shiftQueueCommand ? 1 : 0));
+    }
+
+    bool UnitInterface::returnCargo(bool shiftQueueCommand)
+    {
+        return canReturnCargo() && issueCommand(UnitCommand(this, UnitCommandTypes::Return_Cargo, nullptr, Positions::None.x, Positions::None.y, shiftQueueCommand ? 1 : 0));
+    }
+
+    bool UnitInterface::rightClick(Position target, bool shiftQueueCommand)
+    {
+        return canRightClick(target) && issueCommand(UnitCommand::rightClick(this, target, shiftQueueCommand));
+    }
+
+    bool UnitInterface::rightClick(Unit target, bool shiftQueueCommand)
+    {
+        return canRightClick(target) && issueCommand(UnitCommand::rightClick(this, target, shiftQueueCommand));
+    }
+
+    bool UnitInterface::cancelMorph()
+    {
+        return canCancelMorph() && issueCommand(UnitCommand(this, UnitCommandTypes::Cancel_Morph, nullptr, Positions::None.x, Positions::None.y, 0));
+    }
+
+    bool UnitInterface::holdPosition(bool shiftQueueCommand)
+    {
+        return canMove() && issueCommand(UnitCommand::holdPosition(this, shiftQueueCommand));
+    }
+
+    bool UnitInterface::canCommand() const
+    {
+        return isAccessible &&
+            getPlayer() == game->self() &&
+            (isCompleted() || isMorphing() || getType().isBuilding() || isEggType(getType()));
+    }
+
+    bool UnitInterface::canAttack(bool checkCommandibility) const
+    {
+        if (checkCommandibility && !canCommand())
+        {
+            return false;
+        }
+
+        const UnitType type = getType();
+        if ((type.isBuilding() && !isCompleted()) || isEggType(type))
+        {
+            return false;
+        }
+
+        return type.groundWeapon() != WeaponTypes::None ||
+            type.airWeapon() != WeaponTypes::None ||
+            type == UnitTypes::Protoss_Carrier ||
+            type == UnitTypes::Protoss_Reaver;
+    }
+
+    bool UnitInterface::canAttack(Unit target, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibility) const
+    {
+        if (checkCommandibility && !canCommand())
+        {
+            return false;
+        }
+
+        if (target == nullptr || !target->exists() || target == this || (checkCanIssueCommandType && !canAttack(false)))
+        {
+            return false;
+        }
+
+        const UnitType targetType = target->getType();
+        if (checkCanTargetUnit &&
+            ((!target->isCompleted() &&
+              !targetType.isBuilding() &&
+              !target->isMorphing() &&
+              targetType != UnitTypes::Protoss_Archon &&
+              targetType != UnitTypes::Protoss_Dark_Archon) ||
+             targetType == UnitTypes::Spell_Scanner_Sweep ||
+             targetType == UnitTypes::Spell_Dark_Swarm ||
+             targetType == UnitTypes::Spell_Disruption_Web ||
+             targetType == UnitTypes::Special_Map_Revealer))
+        {
+            return false;
+        }
+
+        if (target->isInvincible())
+        {
+            return false;
+        }
+
+        const UnitType type = getType();
+        const WeaponType weapon = target->isFlying() ? type.airWeapon() : type.groundWeapon();
+        if (weapon == WeaponTypes::None)
+        {
+            if (type == UnitTypes::Protoss_Reaver || type == UnitTypes::Hero_Warbringer)
+            {
+                if (target->isFlying())
+                {
+                    return false;
+                }
+            }
+            else if (type != UnitTypes::Protoss_Carrier && type != UnitTypes::Hero_Gantrithor)
+            {
+                return false;
+            }
+        }
+
+        return (type.canMove() && type != UnitTypes::Zerg_Lurker) || isInWeaponRange(target);
+    }
+
+    bool UnitInterface::canAttack(Position /*target*/, bool /*checkCanTargetUnit*/, bool /*checkCanIssueCommandType*/, bool checkCommandibility) const
+    {
+        return canAttack(checkCommandibility) && getType().canMove();
+    }
+
+    bool UnitInterface::canBuild(bool checkCommandibility) const
+    {
+        return (!checkCommandibility || canCommand()) && getType().isWorker() && isCompleted();
+    }
+
+    bool UnitInterface::canBuild(UnitType uType, bool /*checkCanIssueCommandType*/, bool checkCommandibility) const
+    {
+        return canBuild(checkCommandibility) &&
+            uType.isBuilding() &&
+            uType.whatBuilds().first == getType() &&
+            game->canMake(uType, const_cast<UnitInterface*>(this));
+    }
+
+    bool UnitInterface::canBuild(UnitType uType, TilePosition tilePos, bool /*checkTargetUnitType*/, bool checkCanIssueCommandType, bool checkCommandibility) const
+    {
+        return canBuild(uType, checkCanIssueCommandType, checkCommandibility) &&
+            game->canBuildHere(tilePos, uType, const_cast<UnitInterface*>(this));
+    }
+
+    bool UnitInterface::canTrain(bool checkCommandibility) const
+    {
+        return (!checkCommandibility || canCommand()) &&
+            isCompleted() &&
+            (getType().canProduce() || getType() == UnitTypes::Zerg_Larva);
+    }
+
+    bool UnitInterface::canTrain(UnitType uType, bool /*checkCanIssueCommandType*/, bool checkCommandibility) const
+    {
+        if (!canTrain(checkCommandibility))
+        {
+            return false;
+        }
+
+        // Training at a hatchery takes one of its larvae.
+        const UnitType builderType = uType.whatBuilds().first;
+        if (builderType == UnitTypes::Zerg_Larva && getType().producesLarva())
+        {
+            return !getLarva().empty() && game->canMake(uType);
+        }
+
+        return builderType == getType() && game->canMake(uType, const_cast<UnitInterface*>(this));
+    }
+
+    bool UnitInterface::canMorph(bool checkCommandibility) const
+    {
+        return (!checkCommandibility || canCommand()) && isCompleted() && !isMorphing();
+    }
+
+    bool UnitInterface::canMorph(UnitType uType, bool /*checkCanIssueCommandType*/, bool checkCommandibility) const
+    {
+        return canMorph(checkCommandibility) &&
+            uType.whatBuilds().first == getType() &&
+            game->canMake(uType, const_cast<UnitInterface*>(this));
+    }
+
+    bool UnitInterface::canUpgrade(bool checkCommandibility) const
+    {
+        return (!checkCommandibility || canCommand()) && getType().isBuilding() && isCompleted() && !isUpgrading();
+    }
+
+    bool UnitInterface::canUpgrade(UpgradeType type, bool /*checkCanIssueCommandType*/) const
+    {
+        const Player self = game->self();
+        return canUpgrade() &&
+            type.whatUpgrades() == getType() &&
+            self->getUpgradeLevel(type) < self->getMaxUpgradeLevel(type) &&
+            self->minerals() >= type.mineralPrice(self->getUpgradeLevel(type) + 1) &&
+            self->gas() >= type.gasPrice(self->getUpgradeLevel(type) + 1);
+    }
+
+    bool UnitInterface::canMove(bool checkCommandibility) const
+    {
+        return (!checkCommandibility || canCommand()) && isCompleted() && getType().canMove() && !isBurrowed();
+    }
+
+    bool UnitInterface::canStop(bool checkCommandibility) const
+    {
+        return (!checkCommandibility || canCommand()) && isCompleted();
+    }
+
+    bool UnitInterface::canGather(bool checkCommandibility) const
+    {
+        return (!checkCommandibility || canCommand()) && isCompleted() && getType().isWorker();
+    }
+
+    bool UnitInterface::canGather(Unit target, bool /*checkCanTargetUnit*/, bool /*checkCanIssueCommandType*/, bool checkCommandibility) const
+    {
+        if (!canGather(checkCommandibility) || target == nullptr || !target->exists())
+        {
+            return false;
+        }
+
+        const UnitType targetType = target->getType();
+        if (targetType.isMineralField())
+        {
+            return true;
+        }
+
+        return targetType.isRefinery() && target->isCompleted() && target->getPlayer() == game->self();
+    }
+
+    bool UnitInterface::canReturnCargo(bool checkCommandibility) const
+    {
+        return canGather(checkCommandibility) && (isCarryingMinerals() || isCarryingGas());
+    }
+
+    bool UnitInterface::canRightClick(bool checkCommandibility) const
+    {
+        return (!checkCommandibility || canCommand()) && isCompleted();
+    }
+
+    bool UnitInterface::canRightClick(Position /*target*/, bool /*checkCanTargetUnit*/, bool /*checkCanIssueCommandType*/, bool checkCommandibility) const
+    {
+        return canRightClick(checkCommandibility) && (getType().canMove() || getType().canProduce());
+    }
+
+    bool UnitInterface::canRightClick(Unit target, bool /*checkCanTargetUnit*/, bool /*checkCanIssueCommandType*/, bool checkCommandibility) const
+    {
+        return canRightClick(checkCommandibility) && target != nullptr && target->exists() && target != this;
+    }
+
+    bool UnitInterface::canCancelMorph(bool checkCommandibility) const
+    {
+        return (!checkCommandibility || canCommand()) && (isMorphing() || (!isCompleted() && isEggType(getType())));
+    }
+
+    bool PlayerInterface::isEnemy(Player player) const
+    {
+        if (player == nullptr || player == this || info.isNeutral || player->info.isNeutral)
+        {
+            return false;
+        }
+
+        if (player == game->self())
+        {
+            return info.isEnemy;
+        }
+
+        if (this == game->self())
+        {
+            return player->info.isEnemy;
+        }
+
+        return true;
+    }
+
+    bool PlayerInterface::isAlly(Player player) const
+    {
+        if (player == nullptr)
+        {
+            return false;
+        }
+
+        if (player == this)
+        {
+            return true;
+        }
+
+        if (player == game->self())
+        {
+            return info.isAlly;
+        }
+
+        if (this == game->self())
+        {
+            return player->info.isAlly;
+        }
+
+        return false;
+    }
+
+    int PlayerInterface::allUnitCount(UnitType unit) const
+    {
+        return unit == UnitTypes::AllUnits ? (int) units.size() : allCounts[unit];
+    }
+
+    int PlayerInterface::visibleUnitCount(UnitType unit) const
+    {
+        return allUnitCount(unit);
+    }
+
+    int PlayerInterface::completedUnitCount(UnitType unit) const
+    {
+        if (unit == UnitTypes::AllUnits)
+        {
+            int count = 0;
+            for (const int completedCount : completedCounts)
+            {
+                count += completedCount;
+            }
+
+            return count;
+        }
+
+        return completedCounts[unit];
+    }
+
+    int PlayerInterface::incompleteUnitCount(UnitType unit) const
+    {
+        return allUnitCount(unit) - completedUnitCount(unit);
+    }
+
+    int PlayerInterface::deadUnitCount(UnitType unit) const
+    {
+        if (unit == UnitTypes::AllUnits)
+        {
+            int count = 0;
+            for (const int deadCount : deadCounts)
+            {
+                count += deadCount;
+            }
+
+            return count;
+        }
+
+        return deadCounts[unit];
+    }
+
+    void Game::startMatch(const GameRecord::MatchInfo& newMatchInfo)
+    {
+        currentGame = this;
+        matchInfo = newMatchInfo;
+        isMatchStarted = true;
+        frameCount = 0;
+        remainingLatencyFrames = 0;
+        enabledFlags.clear();
+
+        unitsByID.clear();
+        playersByID.clear();
+        selfPlayer = nullptr;
+        neutralPlayer = nullptr;
+        playerset.clear();
+        alliedPlayers.clear();
+        enemyPlayers.clear();
+        observerPlayers.clear();
+        for (const GameRecord::PlayerInfo& playerInfo : matchInfo.players)
+        {
+            if (playerInfo.id < 0)
+            {
+                continue;
+            }
+
+            if (playerInfo.id >= (int) playersByID.size())
+            {
+                playersByID.resize(playerInfo.id + 1);
+            }
+
+            PlayerInterface& player = playersByID[playerInfo.id];
+            player.game = this;
+            player.info = playerInfo;
+            player.allCounts.assign(UnitTypes::Enum::MAX, 0);
+            player.completedCounts.assign(UnitTypes::Enum::MAX, 0);
+            player.deadCounts.assign(UnitTypes::Enum::MAX, 0);
+        }
+
+        for (PlayerInterface& player : playersByID)
+        {
+            if (player.game == nullptr)
+            {
+                continue;
+            }
+
+            playerset.insert(&player);
+            if (player.info.isSelf || player.info.id == matchInfo.selfID)
+            {
+                selfPlayer = &player;
+            }
+            else if (player.info.isNeutral)
+            {
+                neutralPlayer = &player;
+            }
+            else if (player.info.isEnemy)
+            {
+                enemyPlayers.insert(&player);
+            }
+            else if (player.info.isAlly)
+            {
+                alliedPlayers.insert(&player);
+            }
+        }
+
+        allUnits.clear();
+        minerals.clear();
+        geysers.clear();
+        neutralUnits.clear();
+        staticMinerals.clear();
+        staticGeysers.clear();
+        staticNeutralUnits.clear();
+        unitsByLeft.clear();
+        events.clear();
+        startLocations.clear();
+        for (const std::pair<int, int>& startLocation : matchInfo.startLocations)
+        {
+            startLocations.push_back(TilePosition(startLocation.first, startLocation.second));
+        }
+
+        // Enough for the commands of any frame, so that issuing them doesn't allocate.
+        issuedCommands.clear();
+        issuedCommands.reserve(4096);
+
+        const size_t numTiles = (size_t) std::max(0, matchInfo.mapWidth * matchInfo.mapHeight);
+        visibleTiles.assign(numTiles, 0);
+        exploredTiles.assign(numTiles, 0);
+        creepTiles.assign(numTiles, 0);
+    }
+
+    void Game::setFrame(const GameRecord::Frame& frame)
+    {
+        const bool isFirstFrame = allUnits.empty();
+        frameCount = frame.frameCount;
+        remainingLatencyFrames = frame.remainingLatencyFrames;
+        issuedCommands.clear();
+
+        // The units that are destroyed are counted with their state from the frame before.
+        for (const GameRecord::EventInfo& eventInfo : frame.events)
+        {
+            if (eventInfo.typeID != EventType::UnitDestroy || eventInfo.unitID < 0 || eventInfo.unitID >= (int) unitsByID.size())
+            {
+                continue;
+            }
+
+            const UnitInterface& unit = unitsByID[eventInfo.unitID];
+            const Player player = getPlayer(unit.state.playerID);
+            if (player != nullptr && unit.getType() < UnitTypes::Enum::MAX)
+            {
+                ++player->deadCounts[unit.getType()];
+            }
+        }
+
+        for (const GameRecord::CommandInfo& commandInfo : frame.commands)
+        {
+            if ((commandInfo.typeID == UnitCommandTypes::Morph || commandInfo.typeID == UnitCommandTypes::Train) &&
+                commandInfo.unitID >= 0 && commandInfo.unitID < (int) unitsByID.size())
+            {
+                unitsByID[commandInfo.unitID].buildType = UnitType(commandInfo.extra);
+            }
+        }
+
+        for (const Unit u : allUnits)
+        {
+            u->isAccessible = false;
+        }
+
+        allUnits.clear();
+        minerals.clear();
+        geysers.clear();
+        neutralUnits.clear();
+        unitsByLeft.clear();
+        for (PlayerInterface& player : playersByID)
+        {
+            player.units.clear();
+        }
+
+        for (const GameRecord::UnitState& unitState : frame.units)
+        {
+            UnitInterface& unit = getOrCreateUnit(unitState.id);
+            if (unit.initialType == UnitTypes::None)
+            {
+                unit.initialType = UnitType(unitState.typeID);
+                unit.initialPosition = Position(unitState.x, unitState.y);
+                unit.initialHitPoints = unitState.hitPoints;
+                unit.initialResources = unitState.resources;
+            }
+
+            unit.state = unitState;
+            unit.isAccessible = true;
+            if (!isMorphSourceType(unit.getType()))
+            {
+                unit.buildType = UnitTypes::None;
+            }
+
+            allUnits.insert(&unit);
+            unitsByLeft.push_back(&unit);
+            const Player player = getPlayer(unitState.playerID);
+            if (player != nullptr)
+            {
+                player->units.insert(&unit);
+            }
+
+            if (player == neutralPlayer || player == nullptr)
+            {
+                neutralUnits.insert(&unit);
+                if (unit.getType().isMineralField())
+                {
+                    minerals.insert(&unit);
+                }
+                else if (unit.getType() == UnitTypes::Resource_Vespene_Geyser)
+                {
+                    geysers.insert(&unit);
+                }
+
+                if (isFirstFrame)
+                {
+                    staticNeutralUnits.insert(&unit);
+                    if (unit.getType().isMineralField())
+                    {
+                        staticMinerals.insert(&unit);
+                    }
+                    else if (unit.getType() == UnitTypes::Resource_Vespene_Geyser)
+                    {
+                        staticGeysers.insert(&unit);
+                    }
+                }
+            }
+        }
+
+        std::sort(unitsByLeft.begin(), unitsByLeft.end(), [](const Unit a, const Unit b)
+        {
+            return a->getLeft() < b->getLeft() || (a->getLeft() == b->getLeft() && a->getID() < b->getID());
+        });
+
+        if (selfPlayer != nullptr)
+        {
+            selfPlayer->mineralCount = frame.minerals;
+            selfPlayer->gasCount = frame.gas;
+            selfPlayer->supplyUsedCount = frame.supplyUsed;
+            selfPlayer->supplyTotalCount = frame.supplyTotal;
+        }
+
+        updateCounts();
+        updateTiles();
+        addEvents(frame);
+    }
+
+    Unit Game::getUnit(int unitID) const
+    {
+        if (unitID < 0 || unitID >= (int) unitsByID.size() || unitsByID[unitID].game == nullptr)
+        {
+            return nullptr;
+        }
+
+        return const_cast<UnitInterface*>(&unitsByID[unitID]);
+    }
+
+    Player Game::getPlayer(int playerID) const
+    {
+        if (playerID < 0 || playerID >= (int) playersByID.size() || playersByID[playerID].game == nullptr)
+        {
+            return nullptr;
+        }
+
+        return const_cast<PlayerInterface*>(&playersByID[playerID]);
+    }
+
+    bool Game::isFlagEnabled(int flag) const
+    {
+        return enabledFlags.count(flag) != 0;
+    }
+
+    void Game::enableFlag(int flag)
+    {
+        enabledFlags.insert(flag);
+    }
+
+    Unitset Game::getUnitsOnTile(TilePosition tile, const UnitFilter& pred) const
+    {
+        return getUnitsOnTile(tile.x, tile.y, pred);
+    }
+
+    Unitset Game::getUnitsOnTile(int tileX, int tileY, const UnitFilter& pred) const
+    {
+        return getUnitsInRectangle(Position(tileX * 32, tileY * 32), Position(tileX * 32 + 31, tileY * 32 + 31), pred);
+    }
+
+    Unitset Game::getUnitsInRectangle(Position topLeft, Position bottomRight, const UnitFilter& pred) const
+    {
+        Unitset result;
+        forEachUnitInRectangle(topLeft.x, topLeft.y, bottomRight.x, bottomRight.y, [&pred, &result](const Unit u)
+        {
+            if (!pred.isValid() || pred(u))
+            {
+                result.insert(u);
+            }
+        });
+
+        return result;
+    }
+
+    Unitset Game::getUnitsInRadius(Position center, int radius, const UnitFilter& pred) const
+    {
+        Unitset result;
+        forEachUnitInRectangle(center.x - radius, center.y - radius, center.x + radius, center.y + radius, [center, radius, &pred, &result](const Unit u)
+        {
+            if (u->getDistance(center) <= radius && (!pred.isValid() || pred(u)))
+            {
+                result.insert(u);
+            }
+        });
+
+        return result;
+    }
+
+    Unit Game::getClosestUnit(Position center, const UnitFilter& pred, int radius) const
+    {
+        Unit closestUnit = nullptr;
+        int closestDistance = INT_MAX;
+        forEachUnitInRectangle(center.x - radius, center.y - radius, center.x + radius, center.y + radius, [center, &pred, &closestUnit, &closestDistance](const Unit u)
+        {
+            if (pred.isValid() && !pred(u))
+            {
+                return;
+            }
+
+            const int distance = u->getDistance(center);
+            if (distance < closestDistance)
+            {
+                closestUnit = u;
+                closestDistance = distance;
+            }
+        });
+
+        return closestUnit;
+    }
+
+    Unit Game::getBestUnit(const BestUnitFilter& best, const UnitFilter& pred, Position center, int radius) const
+    {
+        Unit bestUnit = nullptr;
+        forEachUnitInRectangle(center.x - radius, center.y - radius, center.x + radius, center.y + radius, [&best, &pred, &bestUnit](const Unit u)
+        {
+            if (pred.isValid() && !pred(u))
+            {
+                return;
+            }
+
+            bestUnit = bestUnit != nullptr ? best(bestUnit, u) : u;
+        });
+
+        return bestUnit;
+    }
+
+    bool Game::isBuildable(int tileX, int tileY, bool includeBuildings) const
+    {
+        if (!isValid(TilePosition(tileX, tileY)))
+        {
+            return false;
+        }
+
+        if (!includeBuildings)
+        {
+            return true;
+        }
+
+        bool isOccupied = false;
+        forEachUnitInRectangle(tileX * 32, tileY * 32, tileX * 32 + 31, tileY * 32 + 31, [&isOccupied](const Unit u)
+        {
+            isOccupied = isOccupied || (u->getType().isBuilding() && !u->isFlying());
+        });
+
+        return !isOccupied;
+    }
+
+    bool Game::canBuildHere(TilePosition position, UnitType type, Unit builder, bool checkExplored)
+    {
+        const TilePosition bottomRight = position + type.tileSize();
+        if (!isValid(position) || !isValid(bottomRight - TilePosition(1, 1)))
+        {
+            return false;
+        }
+
+        if (type.isRefinery())
+        {
+            bool isOnGeyser = false;
+            for (const Unit geyser : geysers)
+            {
+                isOnGeyser = isOnGeyser || geyser->getTilePosition() == position;
+            }
+
+            return isOnGeyser;
+        }
+
+        for (int tileY = position.y; tileY < bottomRight.y; ++tileY)
+        {
+            for (int tileX = position.x; tileX < bottomRight.x; ++tileX)
+            {
+                if ((type.requiresCreep() && !hasCreep(tileX, tileY)) ||
+                    (checkExplored && !isExplored(tileX, tileY)))
+                {
+                    return false;
+                }
+            }
+        }
+
+        bool isBlocked = false;
+        forEachUnitInRectangle(position.x * 32, position.y * 32, bottomRight.x * 32 - 1, bottomRight.y * 32 - 1, [builder, &isBlocked](const Unit u)
+        {
+            isBlocked = isBlocked || (u != builder && !u->isFlying() && !u->isLifted() && u->getType() != UnitTypes::Zerg_Larva);
+        });
+        if (isBlocked)
+        {
+            return false;
+        }
+
+        // Resource depots can't be built within 3 tiles of resources.
+        if (type.isResourceDepot())
+        {
+            const int left = position.x * 32 - 3 * 32;
+            const int top = position.y * 32 - 3 * 32;
+            const int right = bottomRight.x * 32 + 3 * 32 - 1;
+            const int bottom = bottomRight.y * 32 + 3 * 32 - 1;
+            forEachUnitInRectangle(left, top, right, bottom, [&isBlocked](const Unit u)
+            {
+                isBlocked = isBlocked || u->getType().isMineralField() || u->getType() == UnitTypes::Resource_Vespene_Geyser;
+            });
+        }
+
+        return !isBlocked;
+    }
+
+    bool Game::canMake(UnitType type, Unit builder) const
+    {
+        const Player self = selfPlayer;
+        if (self == nullptr || self->minerals() < type.mineralPrice() || self->gas() < type.gasPrice())
+        {
+            return false;
+        }
+
+        if (type.supplyRequired() > 0 && self->supplyTotal() - self->supplyUsed() < type.supplyRequired())
+        {
+            return false;
+        }
+
+        if (type.requiredTech() != TechTypes::None && !self->hasResearched(type.requiredTech()))
+        {
+            return false;
+        }
+
+        for (const std::pair<const UnitType, int>& requiredUnit : type.requiredUnits())
+        {
+            bool isRequirementMet = false;
+            for (const Unit u : self->getUnits())
+            {
+                isRequirementMet = isRequirementMet ||
+                    (meetsRequirement(u->getType(), requiredUnit.first) && (u->isCompleted() || requiredUnit.first == UnitTypes::Zerg_Larva));
+            }
+
+            if (!isRequirementMet)
+            {
+                return false;
+            }
+        }
+
+        if (builder != nullptr)
+        {
+            return builder->getPlayer() == self;
+        }
+
+        return true;
+    }
+
+    UnitInterface& Game::getOrCreateUnit(int unitID)
+    {
+        if (unitID >= (int) unitsByID.size())
+        {
+            unitsByID.resize(unitID + 1);
+        }
+
+        UnitInterface& unit = unitsByID[unitID];
+        if (unit.game == nullptr)
+        {
+            unit.game = this;
+            unit.id = unitID;
+        }
+
+        return unit;
+    }
+
+    bool Game::getTile(const std::vector<unsigned char>& tiles, int tileX, int tileY) const
+    {
+        return isValid(TilePosition(tileX, tileY)) && tiles[tileY * mapWidth() + tileX] != 0;
+    }
+
+    void Game::updateCounts()
+    {
+        for (PlayerInterface& player : playersByID)
+        {
+            std::fill(player.allCounts.begin(), player.allCounts.end(), 0);
+            std::fill(player.completedCounts.begin(), player.completedCounts.end(), 0);
+            for (const Unit u : player.units)
+            {
+                const UnitType type = u->getType();
+                if (type >= UnitTypes::Enum::MAX)
+                {
+                    continue;
+                }
+
+                ++player.allCounts[type];
+                if (u->isCompleted())
+                {
+                    ++player.completedCounts[type];
+                }
+
+                const UnitType buildType = u->getBuildType();
+                if (buildType != UnitTypes::None && buildType < UnitTypes::Enum::MAX)
+                {
+                    player.allCounts[buildType] += buildType.isTwoUnitsInOneEgg() ? 2 : 1;
+                }
+            }
+        }
+
+        // My start location is the one that my first resource depot is at.
+        if (selfPlayer != nullptr && selfPlayer->startLocation == TilePositions::Unknown)
+        {
+            for (const Unit u : selfPlayer->units)
+            {
+                if (u->getType().isResourceDepot() &&
+                    std::find(startLocations.begin(), startLocations.end(), u->getTilePosition()) != startLocations.end())
+                {
+                    selfPlayer->startLocation = u->getTilePosition();
+                }
+            }
+        }
+    }
+
+    void Game::updateTiles()
+    {
+        std::fill(visibleTiles.begin(), visibleTiles.end(), 0);
+        std::fill(creepTiles.begin(), creepTiles.end(), 0);
+        for (const Unit u : allUnits)
+        {
+            const bool isMine = u->getPlayer() == selfPlayer && selfPlayer != nullptr;
+            const bool isCreepProducer = u->getType().producesCreep() && !u->isBeingConstructed();
+            if (!isMine && !isCreepProducer)
+            {
+                continue;
+            }
+
+            const int sightRange = isMine ? selfPlayer->sightRange(u->getType()) : 0;
+            const int creepRange = isCreepProducer ? getCreepRadius(u->getType()) * 32 : 0;
+            const int range = std::max(sightRange, creepRange);
+            const TilePosition tile(u->getPosition());
+            for (int tileY = std::max(0, tile.y - range / 32); tileY <= std::min(mapHeight() - 1, tile.y + range / 32); ++tileY)
+            {
+                for (int tileX = std::max(0, tile.x - range / 32); tileX <= std::min(mapWidth() - 1, tile.x + range / 32); ++tileX)
+                {
+                    const int dx = (tileX - tile.x) * 32;
+                    const int dy = (tileY - tile.y) * 32;
+                    const int distanceSquared = dx * dx + dy * dy;
+                    if (isMine && distanceSquared <= sightRange * sightRange)
+                    {
+                        visibleTiles[tileY * mapWidth() + tileX] = 1;
+                        exploredTiles[tileY * mapWidth() + tileX] = 1;
+                    }
+
+                    if (distanceSquared <= creepRange * creepRange)
+                    {
+                        creepTiles[tileY * mapWidth() + tileX] = 1;
+                    }
+                }
+            }
+        }
+    }
+
+    void Game::addEvents(const GameRecord::Frame& frame)
+    {
+        events.clear();
+        for (const GameRecord::EventInfo& eventInfo : frame.events)
+        {
+            Event e;
+            e.type = (EventType::Enum) eventInfo.typeID;
+            e.position = Position(eventInfo.x, eventInfo.y);
+            e.text = eventInfo.text;
+            e.unit = eventInfo.unitID >= 0 ? &getOrCreateUnit(eventInfo.unitID) : nullptr;
+            e.player = getPlayer(eventInfo.playerID);
+            e.winner = eventInfo.isWinner;
+            events.push_back(e);
+        }
+    }
+}
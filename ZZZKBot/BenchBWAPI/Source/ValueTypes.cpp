@@ -0,0 +1,1305 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+#include <BWAPI.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
+#include <vector>
+
+namespace BWAPI
+{
+    namespace
+    {
+        namespace R = Races::Enum;
+        namespace U = UnitTypes::Enum;
+        namespace W = WeaponTypes::Enum;
+
+        enum UnitTypeFlag
+        {
+            CanProduce = 1 << 0,
+            CanAttack = 1 << 1,
+            CanMove = 1 << 2,
+            Flyer = 1 << 3,
+            Organic = 1 << 4,
+            Mechanical = 1 << 5,
+            Building = 1 << 6,
+            Addon = 1 << 7,
+            Worker = 1 << 8,
+            Detector = 1 << 9,
+            ResourceContainer = 1 << 10,
+            ResourceDepot = 1 << 11,
+            Refinery = 1 << 12,
+            MineralField = 1 << 13,
+            RequiresPsi = 1 << 14,
+            RequiresCreep = 1 << 15,
+            ProducesCreep = 1 << 16,
+            ProducesLarva = 1 << 17,
+            TwoUnitsInOneEgg = 1 << 18,
+            Burrowable = 1 << 19,
+            PermanentCloak = 1 << 20,
+            Invincible = 1 << 21,
+            Neutral = 1 << 22,
+            Hero = 1 << 23,
+            Spell = 1 << 24
+        };
+
+        struct UnitTypeInfo
+        {
+            int id;
+            const char* name;
+            int race;
+            int tileWidth, tileHeight;
+            int dimensionLeft, dimensionUp, dimensionRight, dimensionDown;
+            int maxHitPoints, maxShields, armor;
+            int mineralPrice, gasPrice, buildTime;
+            int supplyRequired, supplyProvided;
+            int sightRange;
+            int groundWeapon, airWeapon;
+            double topSpeed;
+            int flags;
+            int builder;
+
+            // The unit type other than the builder that is needed to make this type, if any.
+            int requiredUnit;
+        };
+
+        // The unit types that the bench can meet, with their properties from BWAPI. Hit points are
+        // whole hit points, speeds are in pixels per frame and times are in frames.
+        const UnitTypeInfo unitTypeInfos[] =
+        {
+            { U::Terran_Marine, "Terran_Marine", R::Terran, 1, 1, 8, 9, 8, 10, 40, 0, 0, 50, 0, 360, 2, 0, 224,
+                W::Gauss_Rifle, W::Gauss_Rifle, 4.0, CanAttack | CanMove | Organic, U::Terran_Barracks, U::None },
+            { U::Terran_Ghost, "Terran_Ghost", R::Terran, 1, 1, 7, 10, 7, 11, 45, 0, 0, 25, 75, 750, 2, 0, 288,
+                W::C_10_Canister_Rifle, W::C_10_Canister_Rifle, 4.0, CanAttack | CanMove | Organic, U::Terran_Barracks, U::None },
+            { U::Terran_Vulture, "Terran_Vulture", R::Terran, 1, 1, 16, 16, 15, 15, 80, 0, 0, 75, 0, 450, 4, 0, 256,
+                W::Fragmentation_Grenade, W::None, 6.4, CanAttack | CanMove | Mechanical, U::Terran_Factory, U::None },
+            { U::Terran_Goliath, "Terran_Goliath", R::Terran, 1, 1, 16, 16, 15, 15, 125, 0, 1, 100, 50, 600, 4, 0, 256,
+                W::Twin_Autocannons, W::Hellfire_Missile_Pack, 4.57, CanAttack | CanMove | Mechanical, U::Terran_Factory, U::None },
+            { U::Terran_Siege_Tank_Tank_Mode, "Terran_Siege_Tank_Tank_Mode", R::Terran, 1, 1, 16, 16, 15, 15, 150, 0, 1, 150, 100, 750, 4, 0, 320,
+                W::Arclite_Cannon, W::None, 4.0, CanAttack | CanMove | Mechanical, U::Terran_Factory, U::None },
+            { U::Terran_SCV, "Terran_SCV", R::Terran, 1, 1, 11, 11, 11, 11, 60, 0, 0, 50, 0, 300, 2, 0, 224,
+                W::Fusion_Cutter, W::None, 4.92, CanAttack | CanMove | Organic | Mechanical | Worker, U::Terran_Command_Center, U::None },
+            { U::Terran_Wraith, "Terran_Wraith", R::Terran, 1, 1, 19, 15, 18, 14, 120, 0, 0, 150, 100, 900, 4, 0, 224,
+                W::Burst_Lasers, W::Gemini_Missiles, 6.67, CanAttack | CanMove | Flyer | Mechanical, U::Terran_Starport, U::None },
+            { U::Terran_Science_Vessel, "Terran_Science_Vessel", R::Terran, 2, 2, 32, 33, 32, 16, 200, 0, 1, 100, 225, 1200, 4, 0, 320,
+                W::None, W::None, 5.0, CanMove | Flyer | Mechanical | Detector, U::Terran_Starport, U::None },
+            { U::Terran_Dropship, "Terran_Dropship", R::Terran, 2, 2, 24, 16, 23, 15, 150, 0, 1, 100, 100, 750, 4, 0, 256,
+                W::None, W::None, 5.47, CanMove | Flyer | Mechanical, U::Terran_Starport, U::None },
+            { U::Terran_Battlecruiser, "Terran_Battlecruiser", R::Terran, 2, 2, 37, 29, 37, 29, 500, 0, 3, 400, 300, 2000, 12, 0, 352,
+                W::ATS_Laser_Battery, W::ATA_Laser_Battery, 2.5, CanAttack | CanMove | Flyer | Mechanical, U::Terran_Starport, U::None },
+            { U::Terran_Vulture_Spider_Mine, "Terran_Vulture_Spider_Mine", R::Terran, 1, 1, 7, 7, 7, 7, 20, 0, 0, 1, 0, 1, 0, 0, 96,
+                W::Spider_Mines, W::None, 16.0, CanAttack | CanMove | Mechanical, U::None, U::None },
+            { U::Terran_Siege_Tank_Siege_Mode, "Terran_Siege_Tank_Siege_Mode", R::Terran, 1, 1, 16, 16, 15, 15, 150, 0, 1, 150, 100, 750, 4, 0, 320,
+                W::Arclite_Shock_Cannon, W::None, 0.0, CanAttack | Mechanical, U::None, U::None },
+            { U::Terran_Firebat, "Terran_Firebat", R::Terran, 1, 1, 11, 7, 11, 14, 50, 0, 1, 50, 25, 360, 2, 0, 224,
+                W::Flame_Thrower, W::None, 4.0, CanAttack | CanMove | Organic, U::Terran_Barracks, U::None },
+            { U::Spell_Scanner_Sweep, "Spell_Scanner_Sweep", R::None, 1, 1, 13, 13, 13, 13, 0, 0, 0, 0, 0, 0, 0, 0, 320,
+                W::None, W::None, 0.0, Flyer | Invincible | Spell, U::None, U::None },
+            { U::Terran_Medic, "Terran_Medic", R::Terran, 1, 1, 8, 9, 8, 10, 60, 0, 1, 50, 25, 450, 2, 0, 288,
+                W::None, W::None, 4.0, CanMove | Organic, U::Terran_Barracks, U::None },
+            { U::Zerg_Larva, "Zerg_Larva", R::Zerg, 1, 1, 8, 8, 7, 7, 25, 0, 10, 1, 1, 1, 0, 0, 128,
+                W::None, W::None, 0.0, Organic, U::Zerg_Hatchery, U::None },
+            { U::Zerg_Egg, "Zerg_Egg", R::Zerg, 1, 1, 16, 16, 15, 15, 200, 0, 10, 1, 1, 1, 0, 0, 128,
+                W::None, W::None, 0.0, Organic, U::Zerg_Larva, U::None },
+            { U::Zerg_Zergling, "Zerg_Zergling", R::Zerg, 1, 1, 8, 4, 7, 11, 35, 0, 0, 50, 0, 420, 1, 0, 160,
+                W::Claws, W::None, 5.49, CanAttack | CanMove | Organic | TwoUnitsInOneEgg | Burrowable, U::Zerg_Larva, U::Zerg_Spawning_Pool },
+            { U::Zerg_Hydralisk, "Zerg_Hydralisk", R::Zerg, 1, 1, 10, 10, 10, 12, 80, 0, 0, 75, 25, 420, 2, 0, 192,
+                W::Needle_Spines, W::Needle_Spines, 3.66, CanAttack | CanMove | Organic | Burrowable, U::Zerg_Larva, U::Zerg_Hydralisk_Den },
+            { U::Zerg_Ultralisk, "Zerg_Ultralisk", R::Zerg, 2, 2, 19, 16, 18, 15, 400, 0, 1, 200, 200, 900, 8, 0, 224,
+                W::Kaiser_Blades, W::None, 5.12, CanAttack | CanMove | Organic, U::Zerg_Larva, U::Zerg_Ultralisk_Cavern },
+            { U::Zerg_Broodling, "Zerg_Broodling", R::Zerg, 1, 1, 9, 9, 9, 9, 30, 0, 0, 1, 1, 1, 0, 0, 160,
+                W::Toxic_Spores, W::None, 6.0, CanAttack | CanMove | Organic, U::None, U::None },
+            { U::Zerg_Drone, "Zerg_Drone", R::Zerg, 1, 1, 11, 11, 11, 11, 40, 0, 0, 50, 0, 300, 2, 0, 224,
+                W::Spines, W::None, 4.92, CanAttack | CanMove | Organic | Worker | Burrowable, U::Zerg_Larva, U::None },
+            { U::Zerg_Overlord, "Zerg_Overlord", R::Zerg, 2, 2, 25, 25, 24, 24, 200, 0, 0, 100, 0, 600, 0, 16, 288,
+                W::None, W::None, 0.83, CanMove | Flyer | Organic, U::Zerg_Larva, U::None },
+            { U::Zerg_Mutalisk, "Zerg_Mutalisk", R::Zerg, 2, 2, 22, 22, 21, 21, 120, 0, 0, 100, 100, 600, 4, 0, 224,
+                W::Glave_Wurm, W::Glave_Wurm, 6.67, CanAttack | CanMove | Flyer | Organic, U::Zerg_Larva, U::Zerg_Spire },
+            { U::Zerg_Guardian, "Zerg_Guardian", R::Zerg, 2, 2, 22, 22, 21, 21, 150, 0, 2, 50, 100, 600, 4, 0, 352,
+                W::Acid_Spore, W::None, 2.5, CanAttack | CanMove | Flyer | Organic, U::Zerg_Mutalisk, U::Zerg_Greater_Spire },
+            { U::Zerg_Queen, "Zerg_Queen", R::Zerg, 2, 2, 24, 24, 23, 23, 120, 0, 0, 100, 100, 750, 4, 0, 320,
+                W::None, W::None, 6.67, CanMove | Flyer | Organic, U::Zerg_Larva, U::Zerg_Queens_Nest },
+            { U::Zerg_Defiler, "Zerg_Defiler", R::Zerg, 1, 1, 13, 12, 13, 12, 80, 0, 1, 50, 150, 750, 4, 0, 320,
+                W::None, W::None, 4.0, CanMove | Organic | Burrowable, U::Zerg_Larva, U::Zerg_Defiler_Mound },
+            { U::Zerg_Scourge, "Zerg_Scourge", R::Zerg, 1, 1, 12, 12, 11, 11, 25, 0, 0, 25, 75, 450, 1, 0, 160,
+                W::None, W::Suicide_Scourge, 6.67, CanAttack | CanMove | Flyer | Organic | TwoUnitsInOneEgg, U::Zerg_Larva, U::Zerg_Spire },
+            { U::Zerg_Infested_Terran, "Zerg_Infested_Terran", R::Zerg, 1, 1, 8, 9, 8, 10, 60, 0, 0, 100, 50, 600, 2, 0, 160,
+                W::Suicide_Infested_Terran, W::None, 5.82, CanAttack | CanMove | Organic | Burrowable, U::Zerg_Infested_Command_Center, U::None },
+            { U::Terran_Valkyrie, "Terran_Valkyrie", R::Terran, 2, 2, 24, 24, 23, 23, 200, 0, 2, 250, 125, 750, 6, 0, 256,
+                W::None, W::Halo_Rockets, 6.6, CanAttack | CanMove | Flyer | Mechanical, U::Terran_Starport, U::None },
+            { U::Zerg_Cocoon, "Zerg_Cocoon", R::Zerg, 1, 1, 16, 16, 15, 15, 200, 0, 10, 1, 1, 1, 0, 0, 128,
+                W::None, W::None, 0.0, Flyer | Organic, U::Zerg_Mutalisk, U::None },
+            { U::Protoss_Corsair, "Protoss_Corsair", R::Protoss, 1, 1, 18, 16, 17, 15, 100, 80, 1, 150, 100, 600, 4, 0, 288,
+                W::None, W::Neutron_Flare, 6.67, CanAttack | CanMove | Flyer | Mechanical, U::Protoss_Stargate, U::None },
+            { U::Protoss_Dark_Templar, "Protoss_Dark_Templar", R::Protoss, 1, 1, 12, 6, 11, 19, 80, 40, 1, 125, 100, 750, 4, 0, 224,
+                W::Warp_Blades, W::None, 4.92, CanAttack | CanMove | Organic | PermanentCloak, U::Protoss_Gateway, U::None },
+            { U::Zerg_Devourer, "Zerg_Devourer", R::Zerg, 2, 2, 22, 22, 21, 21, 250, 0, 2, 150, 50, 600, 4, 0, 320,
+                W::None, W::Corrosive_Acid, 5.0, CanAttack | CanMove | Flyer | Organic, U::Zerg_Mutalisk, U::Zerg_Greater_Spire },
+            { U::Protoss_Dark_Archon, "Protoss_Dark_Archon", R::Protoss, 1, 1, 16, 16, 15, 15, 25, 200, 1, 0, 0, 300, 8, 0, 320,
+                W::None, W::None, 4.92, CanMove, U::None, U::None },
+            { U::Protoss_Probe, "Protoss_Probe", R::Protoss, 1, 1, 11, 11, 11, 11, 20, 20, 0, 50, 0, 300, 2, 0, 256,
+                W::Particle_Beam, W::None, 4.92, CanAttack | CanMove | Mechanical | Worker, U::Protoss_Nexus, U::None },
+            { U::Protoss_Zealot, "Protoss_Zealot", R::Protoss, 1, 1, 11, 5, 11, 13, 100, 60, 1, 100, 0, 600, 4, 0, 224,
+                W::Psi_Blades, W::None, 4.0, CanAttack | CanMove | Organic, U::Protoss_Gateway, U::None },
+            { U::Protoss_Dragoon, "Protoss_Dragoon", R::Protoss, 1, 1, 15, 15, 16, 16, 100, 80, 1, 125, 50, 750, 4, 0, 256,
+                W::Phase_Disruptor, W::Phase_Disruptor, 5.0, CanAttack | CanMove | Mechanical, U::Protoss_Gateway, U::None },
+            { U::Protoss_High_Templar, "Protoss_High_Templar", R::Protoss, 1, 1, 12, 10, 11, 13, 40, 40, 0, 50, 150, 750, 4, 0, 224,
+                W::None, W::None, 3.2, CanMove | Organic, U::Protoss_Gateway, U::None },
+            { U::Protoss_Archon, "Protoss_Archon", R::Protoss, 1, 1, 16, 16, 15, 15, 10, 350, 0, 0, 0, 300, 8, 0, 256,
+                W::Psionic_Shockwave, W::Psionic_Shockwave, 4.92, CanAttack | CanMove, U::None, U::None },
+            { U::Protoss_Shuttle, "Protoss_Shuttle", R::Protoss, 2, 1, 20, 16, 19, 15, 80, 60, 1, 200, 0, 900, 4, 0, 256,
+                W::None, W::None, 4.43, CanMove | Flyer | Mechanical, U::Protoss_Robotics_Facility, U::None },
+            { U::Protoss_Scout, "Protoss_Scout", R::Protoss, 1, 1, 18, 16, 17, 15, 150, 100, 0, 275, 125, 1200, 6, 0, 256,
+                W::Dual_Photon_Blasters, W::Anti_Matter_Missiles, 5.0, CanAttack | CanMove | Flyer | Mechanical, U::Protoss_Stargate, U::None },
+            { U::Protoss_Arbiter, "Protoss_Arbiter", R::Protoss, 1, 1, 22, 22, 21, 21, 200, 150, 1, 100, 350, 2400, 8, 0, 288,
+                W::Phase_Disruptor_Cannon, W::Phase_Disruptor_Cannon, 5.0, CanAttack | CanMove | Flyer | Mechanical, U::Protoss_Stargate, U::None },
+            { U::Protoss_Carrier, "Protoss_Carrier", R::Protoss, 2, 2, 32, 32, 31, 31, 300, 150, 4, 350, 250, 2100, 12, 0, 352,
+                W::None, W::None, 3.33, CanMove | Flyer | Mechanical, U::Protoss_Stargate, U::None },
+            { U::Protoss_Interceptor, "Protoss_Interceptor", R::Protoss, 1, 1, 8, 8, 7, 7, 40, 40, 0, 25, 0, 300, 0, 0, 192,
+                W::Pulse_Cannon, W::Pulse_Cannon, 13.33, CanAttack | CanMove | Flyer | Mechanical, U::None, U::None },
+            { U::Hero_Warbringer, "Hero_Warbringer", R::Protoss, 1, 1, 16, 16, 15, 15, 200, 400, 2, 400, 300, 1800, 0, 0, 320,
+                W::None, W::None, 1.78, CanMove | Mechanical | Hero, U::None, U::None },
+            { U::Hero_Gantrithor, "Hero_Gantrithor", R::Protoss, 2, 2, 32, 32, 31, 31, 800, 500, 4, 700, 600, 4800, 0, 0, 352,
+                W::None, W::None, 3.33, CanMove | Flyer | Mechanical | Hero, U::None, U::None },
+            { U::Protoss_Reaver, "Protoss_Reaver", R::Protoss, 1, 1, 16, 16, 15, 15, 100, 80, 0, 200, 100, 1050, 8, 0, 320,
+                W::None, W::None, 1.78, CanMove | Mechanical, U::Protoss_Robotics_Facility, U::None },
+            { U::Protoss_Observer, "Protoss_Observer", R::Protoss, 1, 1, 16, 16, 15, 15, 40, 20, 0, 25, 75, 600, 2, 0, 288,
+                W::None, W::None, 3.33, CanMove | Flyer | Mechanical | Detector | PermanentCloak, U::Protoss_Robotics_Facility, U::None },
+            { U::Protoss_Scarab, "Protoss_Scarab", R::Protoss, 1, 1, 2, 2, 2, 2, 20, 10, 0, 15, 0, 105, 0, 0, 160,
+                W::Scarab, W::None, 16.0, CanAttack | CanMove | Mechanical, U::None, U::None },
+            { U::Zerg_Lurker_Egg, "Zerg_Lurker_Egg", R::Zerg, 1, 1, 16, 16, 15, 15, 200, 0, 10, 1, 1, 1, 0, 0, 128,
+                W::None, W::None, 0.0, Organic, U::Zerg_Hydralisk, U::None },
+            { U::Special_Map_Revealer, "Special_Map_Revealer", R::None, 1, 1, 13, 13, 13, 13, 0, 0, 0, 0, 0, 0, 0, 0, 320,
+                W::None, W::None, 0.0, Invincible | Spell, U::None, U::None },
+            { U::Zerg_Lurker, "Zerg_Lurker", R::Zerg, 1, 1, 15, 15, 16, 16, 125, 0, 1, 50, 100, 600, 4, 0, 256,
+                W::Subterranean_Spines, W::None, 5.82, CanAttack | CanMove | Organic | Burrowable, U::Zerg_Hydralisk, U::None },
+            { U::Spell_Disruption_Web, "Spell_Disruption_Web", R::None, 4, 3, 60, 40, 59, 39, 800, 0, 0, 250, 250, 2400, 0, 0, 256,
+                W::None, W::None, 0.0, Flyer | Invincible | Spell, U::None, U::None },
+            { U::Terran_Command_Center, "Terran_Command_Center", R::Terran, 4, 3, 58, 41, 58, 41, 1500, 0, 1, 400, 0, 1800, 0, 20, 320,
+                W::None, W::None, 0.0, CanProduce | Building | ResourceDepot, U::Terran_SCV, U::None },
+            { U::Terran_Comsat_Station, "Terran_Comsat_Station", R::Terran, 2, 2, 37, 16, 31, 25, 500, 0, 1, 50, 50, 600, 0, 0, 320,
+                W::None, W::None, 0.0, Building | Addon, U::Terran_Command_Center, U::None },
+            { U::Terran_Nuclear_Silo, "Terran_Nuclear_Silo", R::Terran, 2, 2, 37, 16, 31, 25, 600, 0, 1, 100, 100, 600, 0, 0, 256,
+                W::None, W::None, 0.0, Building | Addon, U::Terran_Command_Center, U::None },
+            { U::Terran_Supply_Depot, "Terran_Supply_Depot", R::Terran, 3, 2, 38, 22, 38, 26, 500, 0, 1, 100, 0, 600, 0, 16, 256,
+                W::None, W::None, 0.0, Building, U::Terran_SCV, U::None },
+            { U::Terran_Refinery, "Terran_Refinery", R::Terran, 4, 2, 56, 32, 56, 31, 750, 0, 1, 100, 0, 600, 0, 0, 256,
+                W::None, W::None, 0.0, Building | Refinery, U::Terran_SCV, U::None },
+            { U::Terran_Barracks, "Terran_Barracks", R::Terran, 4, 3, 48, 40, 56, 32, 1000, 0, 1, 150, 0, 1200, 0, 0, 256,
+                W::None, W::None, 0.0, CanProduce | Building, U::Terran_SCV, U::None },
+            { U::Terran_Academy, "Terran_Academy", R::Terran, 3, 2, 40, 32, 44, 24, 600, 0, 1, 150, 0, 1200, 0, 0, 256,
+                W::None, W::None, 0.0, Building, U::Terran_SCV, U::None },
+            { U::Terran_Factory, "Terran_Factory", R::Terran, 4, 3, 56, 40, 56, 40, 1250, 0, 1, 200, 100, 1200, 0, 0, 256,
+                W::None, W::None, 0.0, CanProduce | Building, U::Terran_SCV, U::None },
+            { U::Terran_Starport, "Terran_Starport", R::Terran, 4, 3, 48, 40, 48, 38, 1300, 0, 1, 150, 100, 1050, 0, 0, 256,
+                W::None, W::None, 0.0, CanProduce | Building, U::Terran_SCV, U::None },
+            { U::Terran_Control_Tower, "Terran_Control_Tower", R::Terran, 2, 2, 47, 24, 28, 22, 500, 0, 1, 50, 50, 600, 0, 0, 256,
+                W::None, W::None, 0.0, Building | Addon, U::Terran_Starport, U::None },
+            { U::Terran_Science_Facility, "Terran_Science_Facility", R::Terran, 4, 3, 48, 38, 48, 38, 850, 0, 1, 100, 150, 900, 0, 0, 256,
+                W::None, W::None, 0.0, Building, U::Terran_SCV, U::None },
+            { U::Terran_Covert_Ops, "Terran_Covert_Ops", R::Terran, 2, 2, 47, 24, 28, 22, 750, 0, 1, 50, 50, 600, 0, 0, 256,
+                W::None, W::None, 0.0, Building | Addon, U::Terran_Science_Facility, U::None },
+            { U::Terran_Physics_Lab, "Terran_Physics_Lab", R::Terran, 2, 2, 47, 24, 28, 22, 600, 0, 1, 50, 50, 600, 0, 0, 256,
+                W::None, W::None, 0.0, Building | Addon, U::Terran_Science_Facility, U::None },
+            { U::Terran_Machine_Shop, "Terran_Machine_Shop", R::Terran, 2, 2, 39, 24, 31, 24, 750, 0, 1, 50, 50, 600, 0, 0, 256,
+                W::None, W::None, 0.0, Building | Addon, U::Terran_Factory, U::None },
+            { U::Terran_Engineering_Bay, "Terran_Engineering_Bay", R::Terran, 4, 3, 48, 32, 48, 28, 850, 0, 1, 125, 0, 900, 0, 0, 256,
+                W::None, W::None, 0.0, Building, U::Terran_SCV, U::None },
+            { U::Terran_Armory, "Terran_Armory", R::Terran, 3, 2, 48, 32, 47, 22, 750, 0, 1, 100, 50, 1200, 0, 0, 256,
+                W::None, W::None, 0.0, Building, U::Terran_SCV, U::None },
+            { U::Terran_Missile_Turret, "Terran_Missile_Turret", R::Terran, 2, 2, 16, 32, 16, 16, 200, 0, 0, 75, 0, 450, 0, 0, 352,
+                W::None, W::Halo_Rockets, 0.0, CanAttack | Building | Detector, U::Terran_SCV, U::None },
+            { U::Terran_Bunker, "Terran_Bunker", R::Terran, 3, 2, 32, 24, 32, 16, 350, 0, 1, 100, 0, 450, 0, 0, 320,
+                W::None, W::None, 0.0, Building, U::Terran_SCV, U::None },
+            { U::Zerg_Infested_Command_Center, "Zerg_Infested_Command_Center", R::Zerg, 4, 3, 58, 41, 58, 41, 1500, 0, 1, 1, 1, 1800, 0, 0, 320,
+                W::None, W::None, 0.0, CanProduce | Building, U::None, U::None },
+            { U::Zerg_Hatchery, "Zerg_Hatchery", R::Zerg, 4, 3, 49, 32, 49, 32, 1250, 0, 1, 300, 0, 1800, 0, 2, 256,
+                W::None, W::None, 0.0, CanProduce | Building | ResourceDepot | ProducesCreep | ProducesLarva, U::Zerg_Drone, U::None },
+            { U::Zerg_Lair, "Zerg_Lair", R::Zerg, 4, 3, 49, 32, 49, 32, 1800, 0, 1, 150, 100, 1500, 0, 2, 288,
+                W::None, W::None, 0.0, CanProduce | Building | ResourceDepot | RequiresCreep | ProducesCreep | ProducesLarva, U::Zerg_Hatchery, U::Zerg_Spawning_Pool },
+            { U::Zerg_Hive, "Zerg_Hive", R::Zerg, 4, 3, 49, 32, 49, 32, 2500, 0, 1, 200, 150, 1800, 0, 2, 320,
+                W::None, W::None, 0.0, CanProduce | Building | ResourceDepot | RequiresCreep | ProducesCreep | ProducesLarva, U::Zerg_Lair, U::Zerg_Queens_Nest },
+            { U::Zerg_Nydus_Canal, "Zerg_Nydus_Canal", R::Zerg, 2, 2, 32, 32, 31, 31, 250, 0, 1, 150, 0, 600, 0, 0, 256,
+                W::None, W::None, 0.0, Building | RequiresCreep, U::Zerg_Drone, U::Zerg_Hive },
+            { U::Zerg_Hydralisk_Den, "Zerg_Hydralisk_Den", R::Zerg, 3, 2, 40, 32, 40, 24, 850, 0, 1, 100, 50, 600, 0, 0, 256,
+                W::None, W::None, 0.0, Building | RequiresCreep, U::Zerg_Drone, U::Zerg_Spawning_Pool },
+            { U::Zerg_Defiler_Mound, "Zerg_Defiler_Mound", R::Zerg, 4, 2, 48, 32, 48, 4, 850, 0, 1, 100, 100, 900, 0, 0, 256,
+                W::None, W::None, 0.0, Building | RequiresCreep, U::Zerg_Drone, U::Zerg_Hive },
+            { U::Zerg_Greater_Spire, "Zerg_Greater_Spire", R::Zerg, 2, 2, 28, 32, 27, 24, 1000, 0, 1, 100, 150, 1800, 0, 0, 256,
+                W::None, W::None, 0.0, Building | RequiresCreep, U::Zerg_Spire, U::Zerg_Hive },
+            { U::Zerg_Queens_Nest, "Zerg_Queens_Nest", R::Zerg, 2, 2, 24, 24, 23, 23, 850, 0, 1, 150, 100, 900, 0, 0, 256,
+                W::None, W::None, 0.0, Building | RequiresCreep, U::Zerg_Drone, U::Zerg_Lair },
+            { U::Zerg_Evolution_Chamber, "Zerg_Evolution_Chamber", R::Zerg, 3, 2, 44, 32, 42, 24, 750, 0, 1, 75, 0, 600, 0, 0, 256,
+                W::None, W::None, 0.0, Building | RequiresCreep, U::Zerg_Drone, U::Zerg_Hatchery },
+            { U::Zerg_Ultralisk_Cavern, "Zerg_Ultralisk_Cavern", R::Zerg, 3, 2, 40, 32, 32, 31, 600, 0, 1, 150, 200, 1200, 0, 0, 256,
+                W::None, W::None, 0.0, Building | RequiresCreep, U::Zerg_Drone, U::Zerg_Hive },
+            { U::Zerg_Spire, "Zerg_Spire", R::Zerg, 2, 2, 28, 32, 27, 24, 600, 0, 1, 200, 150, 1800, 0, 0, 256,
+                W::None, W::None, 0.0, Building | RequiresCreep, U::Zerg_Drone, U::Zerg_Lair },
+            { U::Zerg_Spawning_Pool, "Zerg_Spawning_Pool", R::Zerg, 3, 2, 36, 28, 40, 18, 750, 0, 1, 200, 0, 1200, 0, 0, 256,
+                W::None, W::None, 0.0, Building | RequiresCreep, U::Zerg_Drone, U::Zerg_Hatchery },
+            { U::Zerg_Creep_Colony, "Zerg_Creep_Colony", R::Zerg, 2, 2, 24, 24, 23, 23, 400, 0, 0, 75, 0, 300, 0, 0, 320,
+                W::None, W::None, 0.0, Building | RequiresCreep | ProducesCreep, U::Zerg_Drone, U::None },
+            { U::Zerg_Spore_Colony, "Zerg_Spore_Colony", R::Zerg, 2, 2, 24, 24, 23, 23, 400, 0, 0, 50, 0, 300, 0, 0, 320,
+                W::None, W::Seeker_Spores, 0.0, CanAttack | Building | Detector | RequiresCreep | ProducesCreep, U::Zerg_Creep_Colony, U::Zerg_Evolution_Chamber },
+            { U::Zerg_Sunken_Colony, "Zerg_Sunken_Colony", R::Zerg, 2, 2, 24, 24, 23, 23, 300, 0, 2, 50, 0, 300, 0, 0, 320,
+                W::Subterranean_Tentacle, W::None, 0.0, CanAttack | Building | RequiresCreep | ProducesCreep, U::Zerg_Creep_Colony, U::Zerg_Spawning_Pool },
+            { U::Zerg_Extractor, "Zerg_Extractor", R::Zerg, 4, 2, 64, 32, 63, 31, 750, 0, 1, 50, 0, 600, 0, 0, 256,
+                W::None, W::None, 0.0, Building | Refinery, U::Zerg_Drone, U::None },
+            { U::Protoss_Nexus, "Protoss_Nexus", R::Protoss, 4, 3, 56, 39, 56, 39, 750, 750, 1, 400, 0, 1800, 0, 18, 352,
+                W::None, W::None, 0.0, CanProduce | Building | ResourceDepot, U::Protoss_Probe, U::None },
+            { U::Protoss_Robotics_Facility, "Protoss_Robotics_Facility", R::Protoss, 3, 2, 36, 16, 40, 20, 500, 500, 1, 200, 200, 1200, 0, 0, 320,
+                W::None, W::None, 0.0, CanProduce | Building | RequiresPsi, U::Protoss_Probe, U::None },
+            { U::Protoss_Pylon, "Protoss_Pylon", R::Protoss, 2, 2, 16, 12, 15, 19, 300, 300, 0, 100, 0, 450, 0, 16, 256,
+                W::None, W::None, 0.0, Building, U::Protoss_Probe, U::None },
+            { U::Protoss_Assimilator, "Protoss_Assimilator", R::Protoss, 4, 2, 48, 32, 48, 24, 450, 450, 1, 100, 0, 600, 0, 0, 256,
+                W::None, W::None, 0.0, Building | Refinery, U::Protoss_Probe, U::None },
+            { U::Protoss_Observatory, "Protoss_Observatory", R::Protoss, 3, 2, 44, 16, 44, 28, 250, 250, 1, 50, 100, 450, 0, 0, 256,
+                W::None, W::None, 0.0, Building | RequiresPsi, U::Protoss_Probe, U::None },
+            { U::Protoss_Gateway, "Protoss_Gateway", R::Protoss, 4, 3, 48, 32, 48, 40, 500, 500, 1, 150, 0, 900, 0, 0, 256,
+                W::None, W::None, 0.0, CanProduce | Building | RequiresPsi, U::Protoss_Probe, U::None },
+            { U::Protoss_Photon_Cannon, "Protoss_Photon_Cannon", R::Protoss, 2, 2, 20, 16, 20, 16, 100, 100, 0, 150, 0, 750, 0, 0, 352,
+                W::STS_Photon_Cannon, W::STA_Photon_Cannon, 0.0, CanAttack | Building | Detector | RequiresPsi, U::Protoss_Probe, U::None },
+            { U::Protoss_Citadel_of_Adun, "Protoss_Citadel_of_Adun", R::Protoss, 3, 2, 24, 24, 40, 24, 450, 450, 1, 150, 100, 900, 0, 0, 256,
+                W::None, W::None, 0.0, Building | RequiresPsi, U::Protoss_Probe, U::None },
+            { U::Protoss_Cybernetics_Core, "Protoss_Cybernetics_Core", R::Protoss, 3, 2, 40, 24, 40, 24, 500, 500, 1, 200, 0, 900, 0, 0, 256,
+                W::None, W::None, 0.0, Building | RequiresPsi, U::Protoss_Probe, U::None },
+            { U::Protoss_Templar_Archives, "Protoss_Templar_Archives", R::Protoss, 3, 2, 32, 24, 32, 24, 500, 500, 1, 150, 200, 900, 0, 0, 256,
+                W::None, W::None, 0.0, Building | RequiresPsi, U::Protoss_Probe, U::None },
+            { U::Protoss_Forge, "Protoss_Forge", R::Protoss, 3, 2, 36, 24, 36, 20, 550, 550, 1, 150, 0, 600, 0, 0, 256,
+                W::None, W::None, 0.0, Building | RequiresPsi, U::Protoss_Probe, U::None },
+            { U::Protoss_Stargate, "Protoss_Stargate", R::Protoss, 4, 3, 48, 40, 48, 32, 600, 600, 1, 150, 150, 1050, 0, 0, 256,
+                W::None, W::None, 0.0, CanProduce | Building | RequiresPsi, U::Protoss_Probe, U::None },
+            { U::Protoss_Fleet_Beacon, "Protoss_Fleet_Beacon", R::Protoss, 3, 2, 40, 32, 47, 24, 500, 500, 1, 300, 200, 900, 0, 0, 256,
+                W::None, W::None, 0.0, Building | RequiresPsi, U::Protoss_Probe, U::None },
+            { U::Protoss_Arbiter_Tribunal, "Protoss_Arbiter_Tribunal", R::Protoss, 3, 2, 44, 28, 44, 28, 500, 500, 1, 200, 150, 900, 0, 0, 256,
+                W::None, W::None, 0.0, Building | RequiresPsi, U::Protoss_Probe, U::None },
+            { U::Protoss_Shield_Battery, "Protoss_Shield_Battery", R::Protoss, 2, 2, 16, 16, 16, 16, 200, 200, 1, 100, 0, 450, 0, 0, 256,
+                W::None, W::None, 0.0, Building | RequiresPsi, U::Protoss_Probe, U::None },
+            { U::Resource_Mineral_Field, "Resource_Mineral_Field", R::None, 2, 1, 32, 16, 31, 15, 100000, 0, 1, 1, 1, 1, 0, 0, 288,
+                W::None, W::None, 0.0, ResourceContainer | MineralField | Invincible | Neutral, U::None, U::None },
+            { U::Resource_Mineral_Field_Type_2, "Resource_Mineral_Field_Type_2", R::None, 2, 1, 32, 16, 31, 15, 100000, 0, 1, 1, 1, 1, 0, 0, 288,
+                W::None, W::None, 0.0, ResourceContainer | MineralField | Invincible | Neutral, U::None, U::None },
+            { U::Resource_Mineral_Field_Type_3, "Resource_Mineral_Field_Type_3", R::None, 2, 1, 32, 16, 31, 15, 100000, 0, 1, 1, 1, 1, 0, 0, 288,
+                W::None, W::None, 0.0, ResourceContainer | MineralField | Invincible | Neutral, U::None, U::None },
+            { U::Resource_Vespene_Geyser, "Resource_Vespene_Geyser", R::None, 4, 2, 64, 32, 63, 31, 100000, 0, 1, 1, 1, 1, 0, 0, 288,
+                W::None, W::None, 0.0, ResourceContainer | Invincible | Neutral, U::None, U::None },
+            { U::Spell_Dark_Swarm, "Spell_Dark_Swarm", R::None, 6, 4, 80, 80, 79, 79, 800, 0, 0, 1, 1, 1, 0, 0, 32,
+                W::None, W::None, 0.0, Invincible | Spell, U::None, U::None },
+            { U::Special_Start_Location, "Special_Start_Location", R::None, 4, 3, 48, 32, 47, 31, 800, 0, 0, 0, 0, 0, 0, 0, 128,
+                W::None, W::None, 0.0, Invincible, U::None, U::None }
+        };
+
+        struct WeaponTypeInfo
+        {
+            int id;
+            const char* name;
+            int damageAmount, damageCooldown;
+            int minRange, maxRange;
+            bool targetsAir, targetsGround;
+        };
+
+        const WeaponTypeInfo weaponTypeInfos[] =
+        {
+            { W::Gauss_Rifle, "Gauss_Rifle", 6, 15, 0, 128, true, true },
+            { W::C_10_Canister_Rifle, "C_10_Canister_Rifle", 10, 22, 0, 224, true, true },
+            { W::Fragmentation_Grenade, "Fragmentation_Grenade", 20, 30, 0, 160, false, true },
+            { W::Spider_Mines, "Spider_Mines", 125, 22, 0, 10, false, true },
+            { W::Twin_Autocannons, "Twin_Autocannons", 12, 22, 0, 192, false, true },
+            { W::Hellfire_Missile_Pack, "Hellfire_Missile_Pack", 10, 22, 0, 160, true, false },
+            { W::Arclite_Cannon, "Arclite_Cannon", 30, 37, 0, 224, false, true },
+            { W::Fusion_Cutter, "Fusion_Cutter", 5, 15, 0, 10, false, true },
+            { W::Burst_Lasers, "Burst_Lasers", 8, 30, 0, 160, false, true },
+            { W::Gemini_Missiles, "Gemini_Missiles", 20, 22, 0, 160, true, false },
+            { W::ATS_Laser_Battery, "ATS_Laser_Battery", 25, 30, 0, 192, false, true },
+            { W::ATA_Laser_Battery, "ATA_Laser_Battery", 25, 30, 0, 192, true, false },
+            { W::Flame_Thrower, "Flame_Thrower", 16, 22, 0, 32, false, true },
+            { W::Arclite_Shock_Cannon, "Arclite_Shock_Cannon", 70, 75, 64, 384, false, true },
+            { W::Halo_Rockets, "Halo_Rockets", 6, 64, 0, 192, true, false },
+            { W::Claws, "Claws", 5, 8, 0, 15, false, true },
+            { W::Needle_Spines, "Needle_Spines", 10, 15, 0, 128, true, true },
+            { W::Kaiser_Blades, "Kaiser_Blades", 20, 15, 0, 25, false, true },
+            { W::Toxic_Spores, "Toxic_Spores", 4, 15, 0, 2, false, true },
+            { W::Spines, "Spines", 5, 22, 0, 32, false, true },
+            { W::Acid_Spore, "Acid_Spore", 20, 30, 0, 256, false, true },
+            { W::Glave_Wurm, "Glave_Wurm", 9, 30, 0, 96, true, true },
+            { W::Seeker_Spores, "Seeker_Spores", 15, 15, 0, 224, true, false },
+            { W::Subterranean_Tentacle, "Subterranean_Tentacle", 40, 32, 0, 224, false, true },
+            { W::Suicide_Infested_Terran, "Suicide_Infested_Terran", 500, 1, 0, 3, false, true },
+            { W::Suicide_Scourge, "Suicide_Scourge", 110, 1, 0, 3, true, false },
+            { W::Particle_Beam, "Particle_Beam", 5, 22, 0, 32, false, true },
+            { W::Psi_Blades, "Psi_Blades", 8, 22, 0, 15, false, true },
+            { W::Phase_Disruptor, "Phase_Disruptor", 20, 30, 0, 128, true, true },
+            { W::STS_Photon_Cannon, "STS_Photon_Cannon", 20, 22, 0, 224, false, true },
+            { W::STA_Photon_Cannon, "STA_Photon_Cannon", 20, 22, 0, 224, true, false },
+            { W::Dual_Photon_Blasters, "Dual_Photon_Blasters", 8, 30, 0, 128, false, true },
+            { W::Anti_Matter_Missiles, "Anti_Matter_Missiles", 14, 22, 0, 128, true, false },
+            { W::Phase_Disruptor_Cannon, "Phase_Disruptor_Cannon", 10, 45, 0, 160, true, true },
+            { W::Psionic_Shockwave, "Psionic_Shockwave", 30, 20, 0, 64, true, true },
+            { W::Neutron_Flare, "Neutron_Flare", 5, 8, 0, 160, true, false },
+            { W::Pulse_Cannon, "Pulse_Cannon", 6, 1, 0, 128, true, true },
+            { W::Scarab, "Scarab", 100, 1, 0, 128, false, true },
+            { W::Corrosive_Acid, "Corrosive_Acid", 25, 100, 0, 192, true, false },
+            { W::Subterranean_Spines, "Subterranean_Spines", 20, 37, 0, 192, false, true },
+            { W::Warp_Blades, "Warp_Blades", 40, 30, 0, 15, false, true }
+        };
+
+        struct UpgradeTypeInfo
+        {
+            int id;
+            const char* name;
+            int mineralPrice, gasPrice;
+            int maxRepeats;
+            int whatUpgrades;
+        };
+
+        const UpgradeTypeInfo upgradeTypeInfos[] =
+        {
+            { 3, "Zerg_Carapace", 150, 150, 3, U::Zerg_Evolution_Chamber },
+            { 4, "Zerg_Flyer_Carapace", 150, 225, 3, U::Zerg_Spire },
+            { 10, "Zerg_Melee_Attacks", 100, 100, 3, U::Zerg_Evolution_Chamber },
+            { 11, "Zerg_Missile_Attacks", 100, 100, 3, U::Zerg_Evolution_Chamber },
+            { 12, "Zerg_Flyer_Attacks", 100, 100, 3, U::Zerg_Spire },
+            { 25, "Antennae", 150, 150, 1, U::Zerg_Lair },
+            { 26, "Pneumatized_Carapace", 150, 150, 1, U::Zerg_Lair },
+            { 27, "Metabolic_Boost", 100, 100, 1, U::Zerg_Spawning_Pool },
+            { 28, "Adrenal_Glands", 200, 200, 1, U::Zerg_Spawning_Pool },
+            { 29, "Muscular_Augments", 150, 150, 1, U::Zerg_Hydralisk_Den },
+            { 30, "Grooved_Spines", 150, 150, 1, U::Zerg_Hydralisk_Den },
+            { 52, "Anabolic_Synthesis", 200, 200, 1, U::Zerg_Ultralisk_Cavern },
+            { 53, "Chitinous_Plating", 150, 150, 1, U::Zerg_Ultralisk_Cavern },
+            { 61, "None", 0, 0, 0, U::None },
+            { 63, "Unknown", 0, 0, 0, U::None }
+        };
+
+        const char* const raceNames[] = { "Zerg", "Terran", "Protoss", "Other", "Unused", "Select", "Random", "None", "Unknown" };
+
+        // Indexed by id, and nullptr for the ids that aren't in the table.
+        template<typename Info, size_t N> std::vector<const Info*> makeIndex(const Info (&infos)[N], const int size)
+        {
+            std::vector<const Info*> index(size, nullptr);
+            for (const Info& info : infos)
+            {
+                index[info.id] = &info;
+            }
+
+            return index;
+        }
+
+        // The indexes and names are function local statics rather than globals so that they can be
+        // used during the static initialization of other files, and they are made in one go
+        // because the bot's worker threads may ask for them.
+        const std::vector<const UnitTypeInfo*>& getUnitTypeIndex()
+        {
+            static const std::vector<const UnitTypeInfo*> index = makeIndex(unitTypeInfos, U::MAX);
+            return index;
+        }
+
+        const std::vector<const WeaponTypeInfo*>& getWeaponTypeIndex()
+        {
+            static const std::vector<const WeaponTypeInfo*> index = makeIndex(weaponTypeInfos, W::MAX);
+            return index;
+        }
+
+        const UnitTypeInfo* getInfo(const UnitType type)
+        {
+            const std::vector<const UnitTypeInfo*>& index = getUnitTypeIndex();
+            return type >= 0 && type < (int) index.size() ? index[type] : nullptr;
+        }
+
+        const WeaponTypeInfo* getInfo(const WeaponType type)
+        {
+            const std::vector<const WeaponTypeInfo*>& index = getWeaponTypeIndex();
+            return type >= 0 && type < (int) index.size() ? index[type] : nullptr;
+        }
+
+        const UpgradeTypeInfo* getInfo(const UpgradeType type)
+        {
+            for (const UpgradeTypeInfo& info : upgradeTypeInfos)
+            {
+                if (info.id == type)
+                {
+                    return &info;
+                }
+            }
+
+            return nullptr;
+        }
+
+        bool hasFlag(const UnitType type, const int flag)
+        {
+            const UnitTypeInfo* info = getInfo(type);
+            return info != nullptr && (info->flags & flag) != 0;
+        }
+
+        template<typename Name> std::vector<std::string> makeNames(const int size, const Name& name)
+        {
+            std::vector<std::string> names;
+            names.reserve(size);
+            for (int id = 0; id < size; ++id)
+            {
+                names.push_back(name(id));
+            }
+
+            return names;
+        }
+    }
+
+    namespace Positions { const Position Invalid(32000, 32032), None(32000, 32000), Unknown(32000, 32064), Origin(0, 0); }
+    namespace WalkPositions { const WalkPosition Invalid(4000, 4004), None(4000, 4000), Unknown(4000, 4008), Origin(0, 0); }
+    namespace TilePositions { const TilePosition Invalid(1000, 1001), None(1000, 1000), Unknown(1000, 1002), Origin(0, 0); }
+
+    template<typename T, int Scale> bool Point<T, Scale>::isValid() const
+    {
+        return x >= 0 && y >= 0 && x < 256 * 32 / Scale && y < 256 * 32 / Scale;
+    }
+
+    template<typename T, int Scale> Point<T, Scale>& Point<T, Scale>::makeValid()
+    {
+        x = std::max<T>(0, std::min<T>(x, 256 * 32 / Scale - 1));
+        y = std::max<T>(0, std::min<T>(y, 256 * 32 / Scale - 1));
+        return *this;
+    }
+
+    template<typename T, int Scale> double Point<T, Scale>::getDistance(const Point& p) const
+    {
+        const double dx = x - p.x;
+        const double dy = y - p.y;
+        return std::sqrt(dx * dx + dy * dy);
+    }
+
+    template<typename T, int Scale> double Point<T, Scale>::getLength() const
+    {
+        return std::sqrt((double) x * x + (double) y * y);
+    }
+
+    // The same approximation as BWAPI (and the game) uses.
+    template<typename T, int Scale> int Point<T, Scale>::getApproxDistance(const Point& p) const
+    {
+        unsigned int min = std::abs((int) (x - p.x));
+        unsigned int max = std::abs((int) (y - p.y));
+        if (max < min)
+        {
+            std::swap(min, max);
+        }
+
+        if (min < (max >> 2))
+        {
+            return max;
+        }
+
+        const unsigned int minCalc = (3 * min) >> 3;
+        return (minCalc >> 5) + minCalc + max - (max >> 4) - (max >> 6);
+    }
+
+    template class Point<int, 1>;
+    template class Point<int, 8>;
+    template class Point<int, 32>;
+
+    namespace Races { const Race Zerg(R::Zerg), Terran(R::Terran), Protoss(R::Protoss), Random(R::Random), None(R::None), Unknown(R::Unknown); }
+
+    template<> const std::string& Type<Race, 7>::getName() const
+    {
+        static const std::vector<std::string> names(std::begin(raceNames), std::end(raceNames));
+        return getID() >= 0 && getID() < R::MAX ? names[getID()] : names[R::Unknown];
+    }
+
+    UnitType Race::getWorker() const
+    {
+        return getID() == R::Zerg ? U::Zerg_Drone : getID() == R::Terran ? U::Terran_SCV : getID() == R::Protoss ? U::Protoss_Probe : U::None;
+    }
+
+    UnitType Race::getResourceDepot() const
+    {
+        return getID() == R::Zerg ? U::Zerg_Hatchery : getID() == R::Terran ? U::Terran_Command_Center : getID() == R::Protoss ? U::Protoss_Nexus : U::None;
+    }
+
+    UnitType Race::getCenter() const
+    {
+        return getResourceDepot();
+    }
+
+    UnitType Race::getRefinery() const
+    {
+        return getID() == R::Zerg ? U::Zerg_Extractor : getID() == R::Terran ? U::Terran_Refinery : getID() == R::Protoss ? U::Protoss_Assimilator : U::None;
+    }
+
+    UnitType Race::getTransport() const
+    {
+        return getID() == R::Zerg ? U::Zerg_Overlord : getID() == R::Terran ? U::Terran_Dropship : getID() == R::Protoss ? U::Protoss_Shuttle : U::None;
+    }
+
+    UnitType Race::getSupplyProvider() const
+    {
+        return getID() == R::Zerg ? U::Zerg_Overlord : getID() == R::Terran ? U::Terran_Supply_Depot : getID() == R::Protoss ? U::Protoss_Pylon : U::None;
+    }
+
+    namespace UnitTypes
+    {
+        const UnitType Hero_Gantrithor(Enum::Hero_Gantrithor), Hero_Warbringer(Enum::Hero_Warbringer),
+            Protoss_Arbiter(Enum::Protoss_Arbiter), Protoss_Arbiter_Tribunal(Enum::Protoss_Arbiter_Tribunal),
+            Protoss_Archon(Enum::Protoss_Archon), Protoss_Assimilator(Enum::Protoss_Assimilator),
+            Protoss_Carrier(Enum::Protoss_Carrier), Protoss_Citadel_of_Adun(Enum::Protoss_Citadel_of_Adun),
+            Protoss_Corsair(Enum::Protoss_Corsair), Protoss_Cybernetics_Core(Enum::Protoss_Cybernetics_Core),
+            Protoss_Dark_Archon(Enum::Protoss_Dark_Archon), Protoss_Dark_Templar(Enum::Protoss_Dark_Templar),
+            Protoss_Dragoon(Enum::Protoss_Dragoon), Protoss_Fleet_Beacon(Enum::Protoss_Fleet_Beacon),
+            Protoss_Forge(Enum::Protoss_Forge), Protoss_Gateway(Enum::Protoss_Gateway),
+            Protoss_High_Templar(Enum::Protoss_High_Templar), Protoss_Interceptor(Enum::Protoss_Interceptor),
+            Protoss_Nexus(Enum::Protoss_Nexus), Protoss_Observatory(Enum::Protoss_Observatory),
+            Protoss_Observer(Enum::Protoss_Observer), Protoss_Photon_Cannon(Enum::Protoss_Photon_Cannon),
+            Protoss_Probe(Enum::Protoss_Probe), Protoss_Pylon(Enum::Protoss_Pylon),
+            Protoss_Reaver(Enum::Protoss_Reaver), Protoss_Robotics_Facility(Enum::Protoss_Robotics_Facility),
+            Protoss_Scarab(Enum::Protoss_Scarab), Protoss_Scout(Enum::Protoss_Scout),
+            Protoss_Shield_Battery(Enum::Protoss_Shield_Battery), Protoss_Shuttle(Enum::Protoss_Shuttle),
+            Protoss_Stargate(Enum::Protoss_Stargate), Protoss_Templar_Archives(Enum::Protoss_Templar_Archives),
+            Protoss_Zealot(Enum::Protoss_Zealot), Resource_Mineral_Field(Enum::Resource_Mineral_Field),
+            Resource_Mineral_Field_Type_2(Enum::Resource_Mineral_Field_Type_2),
+            Resource_Mineral_Field_Type_3(Enum::Resource_Mineral_Field_Type_3),
+            Resource_Vespene_Geyser(Enum::Resource_Vespene_Geyser),
+            Special_Map_Revealer(Enum::Special_Map_Revealer),
+            Special_Start_Location(Enum::Special_Start_Location), Spell_Dark_Swarm(Enum::Spell_Dark_Swarm),
+            Spell_Disruption_Web(Enum::Spell_Disruption_Web), Spell_Scanner_Sweep(Enum::Spell_Scanner_Sweep),
+            Terran_Academy(Enum::Terran_Academy), Terran_Armory(Enum::Terran_Armory),
+            Terran_Barracks(Enum::Terran_Barracks), Terran_Battlecruiser(Enum::Terran_Battlecruiser),
+            Terran_Bunker(Enum::Terran_Bunker), Terran_Command_Center(Enum::Terran_Command_Center),
+            Terran_Comsat_Station(Enum::Terran_Comsat_Station),
+            Terran_Control_Tower(Enum::Terran_Control_Tower), Terran_Covert_Ops(Enum::Terran_Covert_Ops),
+            Terran_Dropship(Enum::Terran_Dropship), Terran_Engineering_Bay(Enum::Terran_Engineering_Bay),
+            Terran_Factory(Enum::Terran_Factory), Terran_Firebat(Enum::Terran_Firebat),
+            Terran_Ghost(Enum::Terran_Ghost), Terran_Goliath(Enum::Terran_Goliath),
+            Terran_Machine_Shop(Enum::Terran_Machine_Shop), Terran_Marine(Enum::Terran_Marine),
+            Terran_Medic(Enum::Terran_Medic), Terran_Missile_Turret(Enum::Terran_Missile_Turret),
+            Terran_Nuclear_Silo(Enum::Terran_Nuclear_Silo), Terran_Physics_Lab(Enum::Terran_Physics_Lab),
+            Terran_Refinery(Enum::Terran_Refinery), Terran_SCV(Enum::Terran_SCV),
+            Terran_Science_Facility(Enum::Terran_Science_Facility),
+            Terran_Science_Vessel(Enum::Terran_Science_Vessel),
+            Terran_Siege_Tank_Siege_Mode(Enum::Terran_Siege_Tank_Siege_Mode),
+            Terran_Siege_Tank_Tank_Mode(Enum::Terran_Siege_Tank_Tank_Mode),
+            Terran_Starport(Enum::Terran_Starport), Terran_Supply_Depot(Enum::Terran_Supply_Depot),
+            Terran_Valkyrie(Enum::Terran_Valkyrie), Terran_Vulture(Enum::Terran_Vulture),
+            Terran_Vulture_Spider_Mine(Enum::Terran_Vulture_Spider_Mine), Terran_Wraith(Enum::Terran_Wraith),
+            Zerg_Broodling(Enum::Zerg_Broodling), Zerg_Cocoon(Enum::Zerg_Cocoon),
+            Zerg_Creep_Colony(Enum::Zerg_Creep_Colony), Zerg_Defiler(Enum::Zerg_Defiler),
+            Zerg_Defiler_Mound(Enum::Zerg_Defiler_Mound), Zerg_Devourer(Enum::Zerg_Devourer),
+            Zerg_Drone(Enum::Zerg_Drone), Zerg_Egg(Enum::Zerg_Egg),
+            Zerg_Evolution_Chamber(Enum::Zerg_Evolution_Chamber), Zerg_Extractor(Enum::Zerg_Extractor),
+            Zerg_Greater_Spire(Enum::Zerg_Greater_Spire), Zerg_Guardian(Enum::Zerg_Guardian),
+            Zerg_Hatchery(Enum::Zerg_Hatchery), Zerg_Hive(Enum::Zerg_Hive),
+            Zerg_Hydralisk(Enum::Zerg_Hydralisk), Zerg_Hydralisk_Den(Enum::Zerg_Hydralisk_Den),
+            Zerg_Infested_Command_Center(Enum::Zerg_Infested_Command_Center),
+            Zerg_Infested_Terran(Enum::Zerg_Infested_Terran), Zerg_Lair(Enum::Zerg_Lair),
+            Zerg_Larva(Enum::Zerg_Larva), Zerg_Lurker(Enum::Zerg_Lurker),
+            Zerg_Lurker_Egg(Enum::Zerg_Lurker_Egg), Zerg_Mutalisk(Enum::Zerg_Mutalisk),
+            Zerg_Nydus_Canal(Enum::Zerg_Nydus_Canal), Zerg_Overlord(Enum::Zerg_Overlord),
+            Zerg_Queen(Enum::Zerg_Queen), Zerg_Queens_Nest(Enum::Zerg_Queens_Nest),
+            Zerg_Scourge(Enum::Zerg_Scourge), Zerg_Spawning_Pool(Enum::Zerg_Spawning_Pool),
+            Zerg_Spire(Enum::Zerg_Spire), Zerg_Spore_Colony(Enum::Zerg_Spore_Colony),
+            Zerg_Sunken_Colony(Enum::Zerg_Sunken_Colony), Zerg_Ultralisk(Enum::Zerg_Ultralisk),
+            Zerg_Ultralisk_Cavern(Enum::Zerg_Ultralisk_Cavern), Zerg_Zergling(Enum::Zerg_Zergling),
+            None(Enum::None), AllUnits(Enum::AllUnits), Unknown(Enum::Unknown);
+
+        const std::set<UnitType>& allUnitTypes()
+        {
+            static const std::set<UnitType> types = []()
+                {
+                    std::set<UnitType> s;
+                    for (const UnitTypeInfo& info : unitTypeInfos)
+                    {
+                        s.insert(UnitType(info.id));
+                    }
+
+                    return s;
+                }();
+            return types;
+        }
+    }
+
+    template<> bool Type<UnitType, 233>::isValid() const
+    {
+        return getID() >= 0 && getID() <= U::Unknown;
+    }
+
+    template<> const std::string& Type<UnitType, 233>::getName() const
+    {
+        static const std::vector<std::string> names = makeNames(U::MAX, [](const int id)
+            {
+                const UnitTypeInfo* info = getInfo(UnitType(id));
+                return std::string(info != nullptr ? info->name : id == U::None ? "None" : "Unknown");
+            });
+        return getID() >= 0 && getID() < U::MAX ? names[getID()] : names[U::Unknown];
+    }
+
+    Race UnitType::getRace() const
+    {
+        const UnitTypeInfo* info = getInfo(*this);
+        return info != nullptr ? Race(info->race) : Races::None;
+    }
+
+    const std::pair<UnitType, int> UnitType::whatBuilds() const
+    {
+        const UnitTypeInfo* info = getInfo(*this);
+        const UnitType builder = info != nullptr ? info->builder : U::None;
+        return std::make_pair(builder, builder != U::None ? 1 : 0);
+    }
+
+    const std::map<UnitType, int>& UnitType::requiredUnits() const
+    {
+        static const std::vector<std::map<UnitType, int>> requiredUnits = []()
+            {
+                std::vector<std::map<UnitType, int>> r(U::MAX);
+                for (const UnitTypeInfo& info : unitTypeInfos)
+                {
+                    for (const int requiredUnit : { info.builder, info.requiredUnit })
+                    {
+                        if (requiredUnit != U::None)
+                        {
+                            r[info.id][UnitType(requiredUnit)] = 1;
+                        }
+                    }
+                }
+
+                return r;
+            }();
+        return requiredUnits[getInfo(*this) != nullptr ? getID() : U::None];
+    }
+
+    TechType UnitType::requiredTech() const
+    {
+        return getID() == U::Zerg_Lurker ? TechTypes::Lurker_Aspect : TechTypes::None;
+    }
+
+    UpgradeType UnitType::armorUpgrade() const
+    {
+        return UpgradeTypes::None;
+    }
+
+    int UnitType::maxHitPoints() const
+    {
+        const UnitTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->maxHitPoints : 0;
+    }
+
+    int UnitType::maxShields() const
+    {
+        const UnitTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->maxShields : 0;
+    }
+
+    int UnitType::armor() const
+    {
+        const UnitTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->armor : 0;
+    }
+
+    int UnitType::mineralPrice() const
+    {
+        const UnitTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->mineralPrice : 0;
+    }
+
+    int UnitType::gasPrice() const
+    {
+        const UnitTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->gasPrice : 0;
+    }
+
+    int UnitType::buildTime() const
+    {
+        const UnitTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->buildTime : 0;
+    }
+
+    int UnitType::supplyRequired() const
+    {
+        const UnitTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->supplyRequired : 0;
+    }
+
+    int UnitType::supplyProvided() const
+    {
+        const UnitTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->supplyProvided : 0;
+    }
+
+    int UnitType::tileWidth() const
+    {
+        const UnitTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->tileWidth : 1;
+    }
+
+    int UnitType::tileHeight() const
+    {
+        const UnitTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->tileHeight : 1;
+    }
+
+    int UnitType::dimensionLeft() const
+    {
+        const UnitTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->dimensionLeft : 0;
+    }
+
+    int UnitType::dimensionUp() const
+    {
+        const UnitTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->dimensionUp : 0;
+    }
+
+    int UnitType::dimensionRight() const
+    {
+        const UnitTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->dimensionRight : 0;
+    }
+
+    int UnitType::dimensionDown() const
+    {
+        const UnitTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->dimensionDown : 0;
+    }
+
+    int UnitType::sightRange() const
+    {
+        const UnitTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->sightRange : 0;
+    }
+
+    int UnitType::maxEnergy() const
+    {
+        switch (getID())
+        {
+            case U::Terran_Ghost:
+            case U::Terran_Science_Vessel:
+            case U::Terran_Medic:
+            case U::Zerg_Queen:
+            case U::Zerg_Defiler:
+            case U::Protoss_High_Templar:
+                return 200;
+            default:
+                return 0;
+        }
+    }
+
+    int UnitType::spaceRequired() const
+    {
+        return isBuilding() ? 255 : 1;
+    }
+
+    int UnitType::spaceProvided() const
+    {
+        return getID() == U::Terran_Dropship || getID() == U::Protoss_Shuttle ? 8 : 0;
+    }
+
+    int UnitType::buildScore() const
+    {
+        return mineralPrice();
+    }
+
+    int UnitType::destroyScore() const
+    {
+        return mineralPrice() * 2;
+    }
+
+    // Buildings are large and everything else is small.
+    UnitSizeType UnitType::size() const
+    {
+        return UnitSizeType(isBuilding() ? 3 : 1);
+    }
+
+    TilePosition UnitType::tileSize() const
+    {
+        return TilePosition(tileWidth(), tileHeight());
+    }
+
+    int UnitType::width() const
+    {
+        return dimensionLeft() + dimensionRight() + 1;
+    }
+
+    int UnitType::height() const
+    {
+        return dimensionUp() + dimensionDown() + 1;
+    }
+
+    int UnitType::seekRange() const
+    {
+        return 0;
+    }
+
+    WeaponType UnitType::groundWeapon() const
+    {
+        const UnitTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->groundWeapon : W::None;
+    }
+
+    int UnitType::maxGroundHits() const
+    {
+        return groundWeapon() != WeaponTypes::None ? 1 : 0;
+    }
+
+    WeaponType UnitType::airWeapon() const
+    {
+        const UnitTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->airWeapon : W::None;
+    }
+
+    int UnitType::maxAirHits() const
+    {
+        return airWeapon() != WeaponTypes::None ? 1 : 0;
+    }
+
+    double UnitType::topSpeed() const
+    {
+        const UnitTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->topSpeed : 0.0;
+    }
+
+    int UnitType::acceleration() const
+    {
+        return 1;
+    }
+
+    int UnitType::haltDistance() const
+    {
+        return 1;
+    }
+
+    int UnitType::turnRadius() const
+    {
+        return 40;
+    }
+
+    bool UnitType::canProduce() const
+    {
+        return hasFlag(*this, CanProduce);
+    }
+
+    bool UnitType::canAttack() const
+    {
+        return hasFlag(*this, CanAttack);
+    }
+
+    bool UnitType::canMove() const
+    {
+        return hasFlag(*this, CanMove);
+    }
+
+    bool UnitType::isFlyer() const
+    {
+        return hasFlag(*this, Flyer);
+    }
+
+    bool UnitType::hasPermanentCloak() const
+    {
+        return hasFlag(*this, PermanentCloak);
+    }
+
+    bool UnitType::isInvincible() const
+    {
+        return hasFlag(*this, Invincible);
+    }
+
+    bool UnitType::isOrganic() const
+    {
+        return hasFlag(*this, Organic);
+    }
+
+    bool UnitType::isMechanical() const
+    {
+        return hasFlag(*this, Mechanical);
+    }
+
+    bool UnitType::isDetector() const
+    {
+        return hasFlag(*this, Detector);
+    }
+
+    bool UnitType::isResourceContainer() const
+    {
+        return hasFlag(*this, ResourceContainer);
+    }
+
+    bool UnitType::isResourceDepot() const
+    {
+        return hasFlag(*this, ResourceDepot);
+    }
+
+    bool UnitType::isRefinery() const
+    {
+        return hasFlag(*this, Refinery);
+    }
+
+    bool UnitType::isWorker() const
+    {
+        return hasFlag(*this, Worker);
+    }
+
+    bool UnitType::requiresPsi() const
+    {
+        return hasFlag(*this, RequiresPsi);
+    }
+
+    bool UnitType::requiresCreep() const
+    {
+        return hasFlag(*this, RequiresCreep);
+    }
+
+    bool UnitType::isTwoUnitsInOneEgg() const
+    {
+        return hasFlag(*this, TwoUnitsInOneEgg);
+    }
+
+    bool UnitType::isBurrowable() const
+    {
+        return hasFlag(*this, Burrowable);
+    }
+
+    bool UnitType::isBuilding() const
+    {
+        return hasFlag(*this, Building);
+    }
+
+    bool UnitType::isAddon() const
+    {
+        return hasFlag(*this, Addon);
+    }
+
+    bool UnitType::isNeutral() const
+    {
+        return hasFlag(*this, Neutral);
+    }
+
+    bool UnitType::isHero() const
+    {
+        return hasFlag(*this, Hero);
+    }
+
+    bool UnitType::isSpell() const
+    {
+        return hasFlag(*this, Spell);
+    }
+
+    bool UnitType::producesCreep() const
+    {
+        return hasFlag(*this, ProducesCreep);
+    }
+
+    bool UnitType::producesLarva() const
+    {
+        return hasFlag(*this, ProducesLarva);
+    }
+
+    bool UnitType::isMineralField() const
+    {
+        return hasFlag(*this, MineralField);
+    }
+
+    // These are always false in the bench.
+    bool UnitType::regeneratesHP() const
+    {
+        return false;
+    }
+
+    bool UnitType::isSpellcaster() const
+    {
+        return false;
+    }
+
+    bool UnitType::isRobotic() const
+    {
+        return false;
+    }
+
+    bool UnitType::isCloakable() const
+    {
+        return false;
+    }
+
+    bool UnitType::isFlyingBuilding() const
+    {
+        return false;
+    }
+
+    bool UnitType::isPowerup() const
+    {
+        return false;
+    }
+
+    bool UnitType::isBeacon() const
+    {
+        return false;
+    }
+
+    bool UnitType::isFlagBeacon() const
+    {
+        return false;
+    }
+
+    bool UnitType::isSpecialBuilding() const
+    {
+        return false;
+    }
+
+    bool UnitType::isCritter() const
+    {
+        return false;
+    }
+
+    bool UnitType::canBuildAddon() const
+    {
+        return false;
+    }
+
+    bool UnitType::isSuccessorOf(const UnitType type) const
+    {
+        return *this == type ||
+            (type == UnitTypes::Zerg_Hatchery && (getID() == U::Zerg_Lair || getID() == U::Zerg_Hive)) ||
+            (type == UnitTypes::Zerg_Lair && getID() == U::Zerg_Hive) ||
+            (type == UnitTypes::Zerg_Spire && getID() == U::Zerg_Greater_Spire);
+    }
+
+    namespace WeaponTypes { const WeaponType None(Enum::None), Unknown(Enum::Unknown); }
+
+    template<> const std::string& Type<WeaponType, 130>::getName() const
+    {
+        static const std::vector<std::string> names = makeNames(W::MAX, [](const int id)
+            {
+                const WeaponTypeInfo* info = getInfo(WeaponType(id));
+                return std::string(info != nullptr ? info->name : "None");
+            });
+        return getID() >= 0 && getID() < W::MAX ? names[getID()] : names[W::None];
+    }
+
+    int WeaponType::damageAmount() const
+    {
+        const WeaponTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->damageAmount : 0;
+    }
+
+    int WeaponType::damageBonus() const
+    {
+        return 1;
+    }
+
+    int WeaponType::damageCooldown() const
+    {
+        const WeaponTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->damageCooldown : 0;
+    }
+
+    int WeaponType::damageFactor() const
+    {
+        return 1;
+    }
+
+    // Every weapon does normal damage, and none of them splash.
+    DamageType WeaponType::damageType() const
+    {
+        return DamageType(3);
+    }
+
+    int WeaponType::maxRange() const
+    {
+        const WeaponTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->maxRange : 0;
+    }
+
+    int WeaponType::minRange() const
+    {
+        const WeaponTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->minRange : 0;
+    }
+
+    int WeaponType::innerSplashRadius() const
+    {
+        return 0;
+    }
+
+    int WeaponType::medianSplashRadius() const
+    {
+        return 0;
+    }
+
+    int WeaponType::outerSplashRadius() const
+    {
+        return 0;
+    }
+
+    bool WeaponType::targetsAir() const
+    {
+        const WeaponTypeInfo* info = getInfo(*this);
+        return info != nullptr && info->targetsAir;
+    }
+
+    bool WeaponType::targetsGround() const
+    {
+        const WeaponTypeInfo* info = getInfo(*this);
+        return info != nullptr && info->targetsGround;
+    }
+
+    // The first unit type (by id) that has the weapon.
+    UnitType WeaponType::whatUses() const
+    {
+        for (const UnitTypeInfo* info : getUnitTypeIndex())
+        {
+            if (info != nullptr && (info->groundWeapon == getID() || info->airWeapon == getID()))
+            {
+                return UnitType(info->id);
+            }
+        }
+
+        return UnitTypes::None;
+    }
+
+    namespace UpgradeTypes
+    {
+        const UpgradeType Zerg_Carapace(3), Zerg_Flyer_Carapace(4), Zerg_Melee_Attacks(10),
+            Zerg_Missile_Attacks(11), Zerg_Flyer_Attacks(12), Antennae(25), Pneumatized_Carapace(26),
+            Metabolic_Boost(27), Adrenal_Glands(28), Muscular_Augments(29), Grooved_Spines(30),
+            Anabolic_Synthesis(52), Chitinous_Plating(53), None(61), Unknown(63);
+    }
+
+    template<> const std::string& Type<UpgradeType, 63>::getName() const
+    {
+        static const std::vector<std::string> names = makeNames(64, [](const int id)
+            {
+                const UpgradeTypeInfo* info = getInfo(UpgradeType(id));
+                return std::string(info != nullptr ? info->name : "Unknown");
+            });
+        return getID() >= 0 && getID() < (int) names.size() ? names[getID()] : names[UpgradeTypes::Unknown];
+    }
+
+    int UpgradeType::mineralPrice(const int level) const
+    {
+        const UpgradeTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->mineralPrice * level : 0;
+    }
+
+    int UpgradeType::gasPrice(const int level) const
+    {
+        const UpgradeTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->gasPrice * level : 0;
+    }
+
+    int UpgradeType::maxRepeats() const
+    {
+        const UpgradeTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->maxRepeats : 0;
+    }
+
+    UnitType UpgradeType::whatUpgrades() const
+    {
+        const UpgradeTypeInfo* info = getInfo(*this);
+        return info != nullptr ? info->whatUpgrades : U::None;
+    }
+
+    // Levels 2 and 3 of the Zerg upgrades need a Lair.
+    UnitType UpgradeType::whatsRequired(const int level) const
+    {
+        return level > 1 ? UnitTypes::Zerg_Lair : UnitTypes::None;
+    }
+
+    namespace TechTypes { const TechType Burrowing(11), Lurker_Aspect(32), None(44), Unknown(46); }
+
+    namespace Orders
+    {
+        const Order Die(0), Stop(1), Guard(2), PlayerGuard(3), Move(6), AttackUnit(10), Nothing(23),
+            IncompleteBuilding(25), Build(30), Train(38), ZergBuildingMorph(42), Harvest1(79), Harvest2(80),
+            MoveToGas(81), WaitForGas(82), HarvestGas(83), ReturnGas(84), MoveToMinerals(85),
+            WaitForMinerals(86), MiningMinerals(87), Harvest3(88), Harvest4(89), ReturnMinerals(90),
+            ResetCollision(150), None(189), Unknown(190);
+    }
+
+    template<> const std::string& Type<Order, 191>::getName() const
+    {
+        static const std::vector<std::string> names = makeNames(192, [](const int id)
+            {
+                return "Order" + std::to_string(id);
+            });
+        return getID() >= 0 && getID() < (int) names.size() ? names[getID()] : names[Orders::Unknown];
+    }
+
+    namespace UnitCommandTypes
+    {
+        const UnitCommandType Attack_Move(0), Attack_Unit(1), Build(2), Train(9), Morph(12), Upgrade(14),
+            Move(16), Stop(18), Hold_Position(19), Gather(23), Return_Cargo(24), Right_Click_Position(25),
+            Right_Click_Unit(26), Cancel_Morph(35), None(44), Unknown(45);
+    }
+
+    namespace PlayerTypes { const PlayerType None(0), Computer(1), Player(2), Neutral(11), Unknown(13); }
+
+    template<> const std::string& Type<PlayerType, 13>::getName() const
+    {
+        static const std::vector<std::string> names = { "None", "Computer", "Player", "RescuePassive", "RescueActive",
+            "EitherPreferComputer", "EitherPreferHuman", "Neutral", "Closed", "Observer", "PlayerLeft", "ComputerLeft",
+            "Unknown", "Unknown" };
+        return names[std::max(0, std::min(getID(), (int) PlayerTypes::Unknown))];
+    }
+
+    // The bench only plays melee games.
+    namespace GameTypes { const GameType Melee(2); }
+
+    template<> const std::string& Type<GameType, 35>::getName() const
+    {
+        static const std::string name = "Melee";
+        return name;
+    }
+
+    namespace Errors { const Error None(27); }
+
+    std::ostream& operator<<(std::ostream& os, const Race& t)
+    {
+        return os << t.getName();
+    }
+
+    std::ostream& operator<<(std::ostream& os, const UnitType& t)
+    {
+        return os << t.getName();
+    }
+
+    std::ostream& operator<<(std::ostream& os, const WeaponType& t)
+    {
+        return os << t.getName();
+    }
+
+    std::ostream& operator<<(std::ostream& os, const UpgradeType& t)
+    {
+        return os << t.getName();
+    }
+
+    std::ostream& operator<<(std::ostream& os, const Order& t)
+    {
+        return os << t.getName();
+    }
+
+    std::ostream& operator<<(std::ostream& os, const UnitCommandType& t)
+    {
+        return os << t.getID();
+    }
+
+    std::ostream& operator<<(std::ostream& os, const PlayerType& t)
+    {
+        return os << t.getName();
+    }
+
+    std::ostream& operator<<(std::ostream& os, const GameType& t)
+    {
+        return os << t.getName();
+    }
+}
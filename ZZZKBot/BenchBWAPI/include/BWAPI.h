@@ -0,0 +1,688 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <list>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "BWAPI/ValueTypes.h"
+#include "../../Source/GameRecord.h"
+
+#ifndef _MSC_VER
+// The bot uses these MSVC CRT functions, so provide them for the bench's other compilers.
+typedef int errno_t;
+
+inline errno_t localtime_s(std::tm* buf, const std::time_t* timer)
+{
+    return localtime_r(timer, buf) != nullptr ? 0 : 1;
+}
+
+inline errno_t _dupenv_s(char** pValue, size_t* len, const char* name)
+{
+    const char* value = std::getenv(name);
+    *pValue = value != nullptr ? strdup(value) : nullptr;
+    *len = value != nullptr ? std::strlen(value) + 1 : 0;
+    return 0;
+}
+#endif
+
+// A stand-in for the client side of BWAPI that the bench builds the real ZZZKBotAIModule against
+// (this directory is on the bench's include path instead of $(BWAPI_DIR)/include, so the bench
+// doesn't need BWAPI). The value types (UnitType, WeaponType, Order etc) are in ValueTypes.h. Game,
+// Unit and Player are backed by GameRecord frames instead of a running game: the bench sets the
+// state of each frame (see startMatch() and setFrame()) and then calls the bot's callbacks, so the
+// bot's own code runs on recorded or MockGame states. Only the part of the API that the bot uses is
+// here. Deliberate simplifications: every tile is walkable and buildable, creep is only around Zerg
+// buildings, a tile is visible if it is in sight range of one of my units, and commands are only
+// recorded (the next frame's state comes from the record, not from the bot's commands).
+namespace BWAPI
+{
+    typedef int PlayerID;
+    typedef int UnitID;
+    class PlayerInterface;
+    typedef PlayerInterface* Player;
+    class UnitInterface;
+    typedef UnitInterface* Unit;
+    class Unitset;
+    class Game;
+
+    class Playerset : public std::set<Player>
+    {
+    };
+
+    template<typename T> class UnaryFilter
+    {
+    public:
+        UnaryFilter() {}
+        UnaryFilter(std::nullptr_t) {}
+        template<typename F> UnaryFilter(const F& _f) : f(_f) {}
+        bool operator()(T t) const { return f(t); }
+        bool isValid() const { return (bool) f; }
+        UnaryFilter operator!() const
+        {
+            const std::function<bool(T&)> g = f;
+            return UnaryFilter([g](T& t) { return !g(t); });
+        }
+
+    private:
+        std::function<bool(T&)> f;
+    };
+
+    template<typename T> UnaryFilter<T> operator&&(const UnaryFilter<T>& a, const UnaryFilter<T>& b)
+    {
+        return UnaryFilter<T>([a, b](T& t) { return a(t) && b(t); });
+    }
+
+    template<typename T> UnaryFilter<T> operator||(const UnaryFilter<T>& a, const UnaryFilter<T>& b)
+    {
+        return UnaryFilter<T>([a, b](T& t) { return a(t) || b(t); });
+    }
+
+    template<typename T, typename F> UnaryFilter<T> operator&&(const UnaryFilter<T>& a, const F& b)
+    {
+        return a && UnaryFilter<T>(b);
+    }
+
+    template<typename T, typename F> UnaryFilter<T> operator||(const UnaryFilter<T>& a, const F& b)
+    {
+        return a || UnaryFilter<T>(b);
+    }
+
+    // A function of a unit that can be compared to a value to make a UnaryFilter, e.g. GetType == x.
+    template<typename T, typename R> class CompareFilter
+    {
+    public:
+        template<typename F> CompareFilter(const F& _f) : f(_f) {}
+        R operator()(T t) const { return f(t); }
+        UnaryFilter<T> operator==(const R& r) const { return compare(r, [](const R& a, const R& b) { return a == b; }); }
+        UnaryFilter<T> operator!=(const R& r) const { return compare(r, [](const R& a, const R& b) { return a != b; }); }
+        UnaryFilter<T> operator<(const R& r) const { return compare(r, [](const R& a, const R& b) { return a < b; }); }
+        UnaryFilter<T> operator>(const R& r) const { return compare(r, [](const R& a, const R& b) { return a > b; }); }
+        UnaryFilter<T> operator<=(const R& r) const { return compare(r, [](const R& a, const R& b) { return a <= b; }); }
+        UnaryFilter<T> operator>=(const R& r) const { return compare(r, [](const R& a, const R& b) { return a >= b; }); }
+
+    private:
+        template<typename C> UnaryFilter<T> compare(const R& r, const C& c) const
+        {
+            const std::function<R(T&)> g = f;
+            return UnaryFilter<T>([g, r, c](T& t) { return c(g(t), r); });
+        }
+
+        std::function<R(T&)> f;
+    };
+
+    template<typename T> class BestFilter
+    {
+    public:
+        template<typename F> BestFilter(const F& _f) : f(_f) {}
+        T operator()(T a, T b) const { return f(a, b); }
+
+    private:
+        std::function<T(T&, T&)> f;
+    };
+
+    typedef UnaryFilter<Unit> UnitFilter;
+    typedef UnaryFilter<Unit> PtrUnitFilter;
+    typedef BestFilter<Unit> BestUnitFilter;
+
+    namespace Filter
+    {
+        extern const PtrUnitFilter IsEnemy, IsAlly, IsOwned, IsVisible, Exists, IsCompleted, IsLifted, IsResourceDepot,
+            IsMineralField, IsRefinery, IsBuilding, IsWorker, IsCarryingGas, IsCarryingSomething, IsDetected, IsFlying,
+            IsGatheringGas, IsGatheringMinerals, IsIdle, IsInvincible, IsLockedDown, IsMaelstrommed, IsStasised,
+            IsPowered, IsMoving, CanAttack;
+        extern const CompareFilter<Unit, UnitType> GetType;
+        extern const CompareFilter<Unit, Player> GetPlayer;
+        extern const CompareFilter<Unit, Order> CurrentOrder;
+        extern const CompareFilter<Unit, int> HP, Shields, Resources, ID;
+    }
+
+    class UnitCommand
+    {
+    public:
+        UnitCommand() {}
+        UnitCommand(Unit _unit, UnitCommandType _type, Unit _target, int _x, int _y, int _extra)
+            : unit(_unit), type(_type), target(_target), x(_x), y(_y), extra(_extra) {}
+
+        static UnitCommand attack(Unit unit, Position target, bool shiftQueueCommand = false);
+        static UnitCommand attack(Unit unit, Unit target, bool shiftQueueCommand = false);
+        static UnitCommand move(Unit unit, Position target, bool shiftQueueCommand = false);
+        static UnitCommand rightClick(Unit unit, Position target, bool shiftQueueCommand = false);
+        static UnitCommand rightClick(Unit unit, Unit target, bool shiftQueueCommand = false);
+        static UnitCommand stop(Unit unit, bool shiftQueueCommand = false);
+        static UnitCommand holdPosition(Unit unit, bool shiftQueueCommand = false);
+
+        bool operator==(const UnitCommand& other) const;
+        bool operator!=(const UnitCommand& other) const { return !(*this == other); }
+
+        UnitCommandType getType() const { return type; }
+        Unit getUnit() const { return unit; }
+        Unit getTarget() const { return target; }
+        Position getTargetPosition() const;
+        TilePosition getTargetTilePosition() const;
+        UnitType getUnitType() const;
+        UpgradeType getUpgradeType() const;
+        TechType getTechType() const;
+
+        Unit unit = nullptr;
+        UnitCommandType type = UnitCommandTypes::None;
+        Unit target = nullptr;
+        int x = Positions::None.x;
+        int y = Positions::None.y;
+        int extra = 0;
+    };
+
+    class Unitset : public std::unordered_set<Unit>
+    {
+    public:
+        Position getPosition() const;
+        Unitset getUnitsInRadius(int radius, const UnitFilter& pred = nullptr) const;
+        Unit getClosestUnit(const UnitFilter& pred = nullptr, int radius = 999999) const;
+        bool contains(Unit u) const { return count(u) != 0; }
+    };
+
+    class UnitInterface
+    {
+    public:
+        int getID() const { return id; }
+        bool exists() const { return isAccessible; }
+        int getReplayID() const { return id; }
+        Player getPlayer() const;
+        UnitType getType() const { return UnitType(state.typeID); }
+        Position getPosition() const { return Position(state.x, state.y); }
+        TilePosition getTilePosition() const;
+        double getAngle() const { return 0; }
+        double getVelocityX() const { return 0; }
+        double getVelocityY() const { return 0; }
+        int getLeft() const { return state.x - getType().dimensionLeft(); }
+        int getTop() const { return state.y - getType().dimensionUp(); }
+        int getRight() const { return state.x + getType().dimensionRight(); }
+        int getBottom() const { return state.y + getType().dimensionDown(); }
+        int getHitPoints() const { return state.hitPoints; }
+        int getShields() const { return state.shields; }
+        int getEnergy() const { return state.energy; }
+        int getResources() const { return state.resources; }
+        int getResourceGroup() const { return 0; }
+        int getInitialResources() const { return initialResources; }
+        Position getInitialPosition() const { return initialPosition; }
+        TilePosition getInitialTilePosition() const;
+        UnitType getInitialType() const { return initialType; }
+        int getInitialHitPoints() const { return initialHitPoints; }
+
+        int getDistance(Position target) const;
+        int getDistance(Unit target) const;
+        bool hasPath(Position /*target*/) const { return true; }
+        bool hasPath(Unit /*target*/) const { return true; }
+        int getLastCommandFrame() const { return lastCommandFrame; }
+        UnitCommand getLastCommand() const { return lastCommand; }
+        Player getLastAttackingPlayer() const { return nullptr; }
+
+        UnitType getBuildType() const;
+        std::list<UnitType> getTrainingQueue() const { return std::list<UnitType>(); }
+        TechType getTech() const { return TechTypes::None; }
+        UpgradeType getUpgrade() const { return UpgradeTypes::None; }
+        int getRemainingBuildTime() const { return 0; }
+        int getRemainingTrainTime() const { return 0; }
+        int getRemainingResearchTime() const { return 0; }
+        int getRemainingUpgradeTime() const { return 0; }
+        Unit getBuildUnit() const { return nullptr; }
+        Unit getTarget() const;
+        Position getTargetPosition() const;
+        Order getOrder() const { return Order(state.orderID); }
+        Order getSecondaryOrder() const { return Orders::Nothing; }
+        Unit getOrderTarget() const;
+        Position getOrderTargetPosition() const;
+        Position getRallyPosition() const { return Positions::None; }
+        Unit getRallyUnit() const { return nullptr; }
+        Unit getAddon() const { return nullptr; }
+        Unit getNydusExit() const { return nullptr; }
+        Unit getPowerUp() const { return nullptr; }
+        Unit getTransport() const { return nullptr; }
+        Unitset getLoadedUnits() const { return Unitset(); }
+        int getSpaceRemaining() const { return getType().spaceProvided(); }
+        Unit getCarrier() const { return nullptr; }
+        Unitset getInterceptors() const { return Unitset(); }
+        Unit getHatchery() const { return nullptr; }
+        Unitset getLarva() const;
+
+        int getGroundWeaponCooldown() const { return state.groundWeaponCooldown; }
+        int getAirWeaponCooldown() const { return state.airWeaponCooldown; }
+        int getSpellCooldown() const { return 0; }
+        int getDefenseMatrixPoints() const { return 0; }
+        int getDefenseMatrixTimer() const { return 0; }
+        int getEnsnareTimer() const { return 0; }
+        int getIrradiateTimer() const { return 0; }
+        int getLockdownTimer() const { return 0; }
+        int getMaelstromTimer() const { return 0; }
+        int getOrderTimer() const { return 0; }
+        int getPlagueTimer() const { return 0; }
+        int getRemoveTimer() const { return 0; }
+        int getStasisTimer() const { return 0; }
+        int getStimTimer() const { return 0; }
+        int getKillCount() const { return 0; }
+        int getAcidSporeCount() const { return 0; }
+        int getInterceptorCount() const { return 0; }
+        int getScarabCount() const { return 0; }
+        int getSpiderMineCount() const { return 0; }
+
+        bool isAccelerating() const { return false; }
+        bool isAttacking() const { return hasFlag(GameRecord::attackingFlag); }
+        bool isAttackFrame() const { return false; }
+        bool isBeingConstructed() const { return hasFlag(GameRecord::beingConstructedFlag); }
+        bool isBeingGathered() const { return false; }
+        bool isBeingHealed() const { return false; }
+        bool isBlind() const { return false; }
+        bool isBraking() const { return false; }
+        bool isBurrowed() const { return hasFlag(GameRecord::burrowedFlag); }
+        bool isCarryingGas() const { return hasFlag(GameRecord::carryingGasFlag); }
+        bool isCarryingMinerals() const { return hasFlag(GameRecord::carryingMineralsFlag); }
+        bool isCloaked() const { return hasFlag(GameRecord::cloakedFlag); }
+        bool isCompleted() const { return hasFlag(GameRecord::completedFlag); }
+        bool isConstructing() const { return hasFlag(GameRecord::constructingFlag); }
+        bool isDefenseMatrixed() const { return false; }
+        bool isDetected() const { return hasFlag(GameRecord::detectedFlag); }
+        bool isEnsnared() const { return false; }
+        bool isFlying() const { return hasFlag(GameRecord::flyingFlag); }
+        bool isFollowing() const { return false; }
+        bool isGatheringGas() const { return hasFlag(GameRecord::gatheringGasFlag); }
+        bool isGatheringMinerals() const { return hasFlag(GameRecord::gatheringMineralsFlag); }
+        bool isHallucination() const { return false; }
+        bool isHoldingPosition() const { return false; }
+        bool isIdle() const { return hasFlag(GameRecord::idleFlag); }
+        bool isInterruptible() const { return true; }
+        bool isInvincible() const { return getType().isInvincible(); }
+        bool isIrradiated() const { return false; }
+        bool isLifted() const { return hasFlag(GameRecord::liftedFlag); }
+        bool isLoaded() const { return false; }
+        bool isLockedDown() const { return false; }
+        bool isMaelstrommed() const { return false; }
+        bool isMorphing() const { return hasFlag(GameRecord::morphingFlag); }
+        bool isMoving() const { return hasFlag(GameRecord::movingFlag); }
+        bool isParasited() const { return false; }
+        bool isPatrolling() const { return false; }
+        bool isPlagued() const { return false; }
+        bool isRepairing() const { return false; }
+        bool isResearching() const { return false; }
+        bool isSelected() const { return false; }
+        bool isSieged() const { return getType() == UnitTypes::Terran_Siege_Tank_Siege_Mode; }
+        bool isStartingAttack() const { return false; }
+        bool isStasised() const { return false; }
+        bool isStimmed() const { return false; }
+        bool isStuck() const { return hasFlag(GameRecord::stuckFlag); }
+        bool isTraining() const { return false; }
+        bool isUnderAttack() const { return hasFlag(GameRecord::underAttackFlag); }
+        bool isUnderDarkSwarm() const { return false; }
+        bool isUnderDisruptionWeb() const { return false; }
+        bool isUnderStorm() const { return false; }
+        bool isPowered() const { return true; }
+        bool isUpgrading() const { return false; }
+        bool isVisible(Player player = nullptr) const;
+        bool isTargetable() const { return isAccessible; }
+
+        bool isInWeaponRange(Unit target) const;
+        Unitset getUnitsInRadius(int radius, const UnitFilter& pred = nullptr) const;
+        Unitset getUnitsInWeaponRange(WeaponType weapon, const UnitFilter& pred = nullptr) const;
+        Unit getClosestUnit(const UnitFilter& pred = nullptr, int radius = 999999) const;
+
+        bool issueCommand(UnitCommand command);
+        bool attack(Position target, bool shiftQueueCommand = false);
+        bool attack(Unit target, bool shiftQueueCommand = false);
+        bool build(UnitType type, TilePosition target = TilePositions::None);
+        bool train(UnitType type = UnitTypes::None);
+        bool morph(UnitType type);
+        bool upgrade(UpgradeType upgrade);
+        bool move(Position target, bool shiftQueueCommand = false);
+        bool stop(bool shiftQueueCommand = false);
+        bool gather(Unit target, bool shiftQueueCommand = false);
+        bool returnCargo(bool shiftQueueCommand = false);
+        bool rightClick(Position target, bool shiftQueueCommand = false);
+        bool rightClick(Unit target, bool shiftQueueCommand = false);
+        bool cancelMorph();
+        bool holdPosition(bool shiftQueueCommand = false);
+
+        bool canCommand() const;
+        bool canAttack(bool checkCommandibility = true) const;
+        bool canAttack(Unit target, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const;
+        bool canAttack(Position target, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const;
+        bool canBuild(bool checkCommandibility = true) const;
+        bool canBuild(UnitType uType, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const;
+        bool canBuild(UnitType uType, TilePosition tilePos, bool checkTargetUnitType = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const;
+        bool canTrain(bool checkCommandibility = true) const;
+        bool canTrain(UnitType uType, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const;
+        bool canMorph(bool checkCommandibility = true) const;
+        bool canMorph(UnitType uType, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const;
+        bool canUpgrade(bool checkCommandibility = true) const;
+        bool canUpgrade(UpgradeType type, bool checkCanIssueCommandType = true) const;
+        bool canMove(bool checkCommandibility = true) const;
+        bool canStop(bool checkCommandibility = true) const;
+        bool canGather(bool checkCommandibility = true) const;
+        bool canGather(Unit target, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const;
+        bool canReturnCargo(bool checkCommandibility = true) const;
+        bool canRightClick(bool checkCommandibility = true) const;
+        bool canRightClick(Position target, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const;
+        bool canRightClick(Unit target, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const;
+        bool canCancelMorph(bool checkCommandibility = true) const;
+
+    private:
+        friend class Game;
+
+        bool hasFlag(const unsigned int flag) const { return (state.flags & flag) != 0; }
+
+        Game* game = nullptr;
+        int id = -1;
+        bool isAccessible = false;
+        GameRecord::UnitState state;
+        UnitType initialType = UnitTypes::None;
+        Position initialPosition = Positions::None;
+        int initialHitPoints = 0;
+        int initialResources = 0;
+        int lastCommandFrame = -1;
+        UnitCommand lastCommand;
+
+        // What an egg, lurker egg or cocoon is morphing into, from the recorded morph commands.
+        UnitType buildType = UnitTypes::None;
+    };
+
+    class PlayerInterface
+    {
+    public:
+        int getID() const { return info.id; }
+        std::string getName() const { return info.name; }
+        const Unitset& getUnits() const { return units; }
+        Race getRace() const { return Race(info.raceID); }
+        PlayerType getType() const { return PlayerType(info.typeID); }
+        bool isEnemy(Player player) const;
+        bool isAlly(Player player) const;
+        bool isNeutral() const { return info.isNeutral; }
+        bool isObserver() const { return false; }
+        bool isVictorious() const { return false; }
+        bool isDefeated() const { return false; }
+        bool leftGame() const { return false; }
+        TilePosition getStartLocation() const { return startLocation; }
+
+        int minerals() const { return mineralCount; }
+        int gas() const { return gasCount; }
+        int gatheredMinerals() const { return 0; }
+        int gatheredGas() const { return 0; }
+        int supplyTotal(Race /*race*/ = Races::None) const { return supplyTotalCount; }
+        int supplyUsed(Race /*race*/ = Races::None) const { return supplyUsedCount; }
+
+        int allUnitCount(UnitType unit = UnitTypes::AllUnits) const;
+        int visibleUnitCount(UnitType unit = UnitTypes::AllUnits) const;
+        int completedUnitCount(UnitType unit = UnitTypes::AllUnits) const;
+        int incompleteUnitCount(UnitType unit = UnitTypes::AllUnits) const;
+        int deadUnitCount(UnitType unit = UnitTypes::AllUnits) const;
+        int killedUnitCount(UnitType /*unit*/ = UnitTypes::AllUnits) const { return 0; }
+
+        int getUpgradeLevel(UpgradeType /*upgrade*/) const { return 0; }
+        int getMaxUpgradeLevel(UpgradeType upgrade) const { return upgrade.maxRepeats(); }
+        bool isUpgrading(UpgradeType /*upgrade*/) const { return false; }
+        bool hasResearched(TechType /*tech*/) const { return false; }
+        bool isResearching(TechType /*tech*/) const { return false; }
+        bool isUnitAvailable(UnitType /*unit*/) const { return true; }
+
+        // No upgrades are ever researched, so these are the plain values of the types.
+        int weaponMaxRange(WeaponType weapon) const { return weapon.maxRange(); }
+        int weaponDamageCooldown(UnitType unit) const { return unit.groundWeapon().damageCooldown(); }
+        double topSpeed(UnitType unit) const { return unit.topSpeed(); }
+        int sightRange(UnitType unit) const { return unit.sightRange(); }
+        int armor(UnitType unit) const { return unit.armor(); }
+
+    private:
+        friend class Game;
+
+        Game* game = nullptr;
+        GameRecord::PlayerInfo info;
+        Unitset units;
+        TilePosition startLocation = TilePositions::Unknown;
+        int mineralCount = 0;
+        int gasCount = 0;
+        int supplyUsedCount = 0;
+        int supplyTotalCount = 0;
+
+        // Indexed by unit type ID.
+        std::vector<int> allCounts;
+        std::vector<int> completedCounts;
+        std::vector<int> deadCounts;
+    };
+
+    class Event
+    {
+    public:
+        EventType::Enum getType() const { return type; }
+        Position getPosition() const { return position; }
+        const std::string& getText() const { return text; }
+        Unit getUnit() const { return unit; }
+        Player getPlayer() const { return player; }
+        bool isWinner() const { return winner; }
+
+    private:
+        friend class Game;
+
+        EventType::Enum type = EventType::None;
+        Position position = Positions::None;
+        std::string text;
+        Unit unit = nullptr;
+        Player player = nullptr;
+        bool winner = false;
+    };
+
+    class Client
+    {
+    public:
+        virtual ~Client() {}
+        virtual bool isConnected() const = 0;
+        virtual bool connect() = 0;
+        virtual void disconnect() = 0;
+        virtual void update(Game& game) = 0;
+    };
+
+    class Game
+    {
+    public:
+        Game(Client& /*client*/) {}
+        Game* operator->() { return this; }
+        const Game* operator->() const { return this; }
+
+        // Stand-in only. Sets up a new match; the units and events come with each setFrame().
+        void startMatch(const GameRecord::MatchInfo& matchInfo);
+
+        // Stand-in only. Makes the frame the current game state: its units are the accessible
+        // units, its events are the events, and its resources and supply are mine.
+        void setFrame(const GameRecord::Frame& frame);
+
+        // Stand-in only. The commands that the bot issued since the last setFrame().
+        const std::vector<GameRecord::CommandInfo>& getIssuedCommands() const { return issuedCommands; }
+
+        const Playerset& getPlayers() const { return playerset; }
+        const Unitset& getAllUnits() const { return allUnits; }
+        const Unitset& getMinerals() const { return minerals; }
+        const Unitset& getGeysers() const { return geysers; }
+        const Unitset& getNeutralUnits() const { return neutralUnits; }
+        const Unitset& getStaticMinerals() const { return staticMinerals; }
+        const Unitset& getStaticGeysers() const { return staticGeysers; }
+        const Unitset& getStaticNeutralUnits() const { return staticNeutralUnits; }
+        const std::list<Event>& getEvents() const { return events; }
+        Unit getUnit(int unitID) const;
+        Player getPlayer(int playerID) const;
+
+        GameType getGameType() const { return GameTypes::Melee; }
+        int getLatency() const { return matchInfo.latencyFrames == 2 ? 1 : 2; }
+        int getFrameCount() const { return frameCount; }
+        int getReplayFrameCount() const { return 0; }
+        int getFPS() const { return 0; }
+        double getAverageFPS() const { return 0; }
+        Position getMousePosition() const { return Positions::Origin; }
+        Position getScreenPosition() const { return Positions::Origin; }
+        bool isFlagEnabled(int flag) const;
+        void enableFlag(int flag);
+
+        Unitset getUnitsOnTile(TilePosition tile, const UnitFilter& pred = nullptr) const;
+        Unitset getUnitsOnTile(int tileX, int tileY, const UnitFilter& pred = nullptr) const;
+        Unitset getUnitsInRectangle(Position topLeft, Position bottomRight, const UnitFilter& pred = nullptr) const;
+        Unitset getUnitsInRadius(Position center, int radius, const UnitFilter& pred = nullptr) const;
+        Unit getClosestUnit(Position center, const UnitFilter& pred = nullptr, int radius = 999999) const;
+        Unit getBestUnit(const BestUnitFilter& best, const UnitFilter& pred, Position center = Positions::Origin, int radius = 999999) const;
+        Error getLastError() const { return Errors::None; }
+
+        int mapWidth() const { return matchInfo.mapWidth; }
+        int mapHeight() const { return matchInfo.mapHeight; }
+        std::string mapFileName() const { return matchInfo.mapFileName; }
+        std::string mapPathName() const { return "maps\\" + matchInfo.mapFileName; }
+        std::string mapName() const { return matchInfo.mapName; }
+        std::string mapHash() const { return matchInfo.mapHash; }
+        bool isWalkable(int walkX, int walkY) const { return isValid(WalkPosition(walkX, walkY)); }
+        bool isWalkable(WalkPosition position) const { return isValid(position); }
+        int getGroundHeight(int /*tileX*/, int /*tileY*/) const { return 0; }
+        int getGroundHeight(TilePosition /*position*/) const { return 0; }
+        bool isBuildable(int tileX, int tileY, bool includeBuildings = false) const;
+        bool isBuildable(TilePosition position, bool includeBuildings = false) const { return isBuildable(position.x, position.y, includeBuildings); }
+        bool isVisible(int tileX, int tileY) const { return getTile(visibleTiles, tileX, tileY); }
+        bool isVisible(TilePosition position) const { return isVisible(position.x, position.y); }
+        bool isExplored(int tileX, int tileY) const { return getTile(exploredTiles, tileX, tileY); }
+        bool isExplored(TilePosition position) const { return isExplored(position.x, position.y); }
+        bool hasCreep(int tileX, int tileY) const { return getTile(creepTiles, tileX, tileY); }
+        bool hasCreep(TilePosition position) const { return hasCreep(position.x, position.y); }
+        bool hasPowerPrecise(int /*x*/, int /*y*/, UnitType /*unitType*/ = UnitTypes::None) const { return true; }
+        bool canBuildHere(TilePosition position, UnitType type, Unit builder = nullptr, bool checkExplored = false);
+        bool canMake(UnitType type, Unit builder = nullptr) const;
+        bool hasPath(Position /*source*/, Position /*destination*/) const { return true; }
+        bool isValid(TilePosition p) const { return p.x >= 0 && p.y >= 0 && p.x < mapWidth() && p.y < mapHeight(); }
+        bool isValid(WalkPosition p) const { return p.x >= 0 && p.y >= 0 && p.x < mapWidth() * 4 && p.y < mapHeight() * 4; }
+        bool isValid(Position p) const { return p.x >= 0 && p.y >= 0 && p.x < mapWidth() * 32 && p.y < mapHeight() * 32; }
+
+        bool isInGame() const { return isMatchStarted; }
+        bool isMultiplayer() const { return true; }
+        bool isBattleNet() const { return false; }
+        bool isPaused() const { return false; }
+        bool isReplay() const { return false; }
+        void setLocalSpeed(int /*speed*/) {}
+        void setFrameSkip(int /*frameSkip*/) {}
+        void setGUI(bool /*enabled*/) {}
+        bool isGUIEnabled() const { return false; }
+        void sendText(const char* /*format*/, ...) {}
+        void printf(const char* /*format*/, ...) {}
+        void leaveGame() {}
+        void drawTextScreen(int /*x*/, int /*y*/, const char* /*format*/, ...) {}
+        void drawTextMap(int /*x*/, int /*y*/, const char* /*format*/, ...) {}
+
+        Player self() const { return selfPlayer; }
+        Player enemy() const { return enemyPlayers.empty() ? nullptr : *enemyPlayers.begin(); }
+        Player neutral() const { return neutralPlayer; }
+        Playerset& allies() { return alliedPlayers; }
+        Playerset& enemies() { return enemyPlayers; }
+        Playerset& observers() { return observerPlayers; }
+
+        int getLatencyFrames() const { return matchInfo.latencyFrames; }
+        int getLatencyTime() const { return matchInfo.latencyFrames * 42; }
+        int getRemainingLatencyFrames() const { return remainingLatencyFrames; }
+        int getRemainingLatencyTime() const { return remainingLatencyFrames * 42; }
+        int getRevision() const { return 0; }
+        int getClientVersion() const { return 0; }
+        bool isDebug() const { return false; }
+        bool isLatComEnabled() const { return true; }
+        void setLatCom(bool /*isEnabled*/) {}
+        int getInstanceNumber() const { return 0; }
+        int getAPM(bool /*includeSelects*/ = false) const { return 0; }
+        bool setMap(const std::string& /*mapFileName*/) { return false; }
+        const std::list<Position>& getNukeDots() const { return nukeDots; }
+        bool setCommandOptimizationLevel(int /*level*/) { return true; }
+        int countdownTimer() const { return 0; }
+        int elapsedTime() const { return frameCount * 42 / 1000; }
+        unsigned getRandomSeed() const { return 0; }
+        const std::deque<TilePosition>& getStartLocations() const { return startLocations; }
+
+        // Text that would be shown in the game is dropped.
+        template<typename T> Game& operator<<(const T& value) { return *this; }
+        Game& operator<<(std::ostream& (*/*fn*/)(std::ostream&)) { return *this; }
+
+    private:
+        friend class UnitInterface;
+
+        UnitInterface& getOrCreateUnit(int unitID);
+        bool getTile(const std::vector<unsigned char>& tiles, int tileX, int tileY) const;
+        void updateTiles();
+        void updateCounts();
+        void addEvents(const GameRecord::Frame& frame);
+
+        // Calls fn(u) for the accessible units whose bounding boxes overlap the rectangle, in order
+        // of left edge (like the unit finder of BWAPI).
+        template<typename F> void forEachUnitInRectangle(int left, int top, int right, int bottom, const F& fn) const
+        {
+            for (const Unit u : unitsByLeft)
+            {
+                if (u->getLeft() > right)
+                {
+                    break;
+                }
+
+                if (u->getRight() >= left && u->getTop() <= bottom && u->getBottom() >= top)
+                {
+                    fn(u);
+                }
+            }
+        }
+
+        GameRecord::MatchInfo matchInfo;
+        bool isMatchStarted = false;
+        int frameCount = 0;
+        int remainingLatencyFrames = 0;
+        std::set<int> enabledFlags;
+
+        // Indexed by unit ID and player ID, so pointers to them stay valid for the whole match.
+        std::deque<UnitInterface> unitsByID;
+        std::deque<PlayerInterface> playersByID;
+
+        Player selfPlayer = nullptr;
+        Player neutralPlayer = nullptr;
+        Playerset playerset;
+        Playerset alliedPlayers;
+        Playerset enemyPlayers;
+        Playerset observerPlayers;
+
+        Unitset allUnits;
+        Unitset minerals;
+        Unitset geysers;
+        Unitset neutralUnits;
+        Unitset staticMinerals;
+        Unitset staticGeysers;
+        Unitset staticNeutralUnits;
+        std::vector<Unit> unitsByLeft;
+        std::list<Event> events;
+        std::list<Position> nukeDots;
+        std::deque<TilePosition> startLocations;
+        std::vector<GameRecord::CommandInfo> issuedCommands;
+
+        // One byte per tile, indexed by tileY * mapWidth() + tileX.
+        std::vector<unsigned char> visibleTiles;
+        std::vector<unsigned char> exploredTiles;
+        std::vector<unsigned char> creepTiles;
+    };
+}
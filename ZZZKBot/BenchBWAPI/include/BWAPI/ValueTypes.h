@@ -0,0 +1,417 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <utility>
+
+// The value types of BWAPI (positions, races, unit types, weapon types, orders etc) for the bench's
+// stand-in, so that the bench doesn't need the real BWAPI headers or library. The ids are BWAPI's,
+// so that they match the ids in game records, but only the types and the properties that the bot
+// uses are here, and some of the properties are simplified (see ValueTypes.cpp).
+namespace BWAPI
+{
+    template<typename T, int Scale> class Point
+    {
+    public:
+        constexpr Point() {}
+        constexpr Point(T _x, T _y) : x(_x), y(_y) {}
+        template<typename FromT, int FromScale> explicit Point(const Point<FromT, FromScale>& p)
+            : x(p.x * FromScale / Scale), y(p.y * FromScale / Scale) {}
+
+        bool operator==(const Point& p) const { return x == p.x && y == p.y; }
+        bool operator!=(const Point& p) const { return !(*this == p); }
+        bool operator<(const Point& p) const { return x < p.x || (x == p.x && y < p.y); }
+        Point operator+(const Point& p) const { return Point(x + p.x, y + p.y); }
+        Point operator-(const Point& p) const { return Point(x - p.x, y - p.y); }
+        Point operator*(const T v) const { return Point(x * v, y * v); }
+        Point operator/(const T v) const { return Point(x / v, y / v); }
+        Point& operator+=(const Point& p) { x += p.x; y += p.y; return *this; }
+        Point& operator-=(const Point& p) { x -= p.x; y -= p.y; return *this; }
+        Point& operator*=(const T v) { x *= v; y *= v; return *this; }
+        Point& operator/=(const T v) { x /= v; y /= v; return *this; }
+
+        // Whether the point is on a map of the largest size (256x256 tiles).
+        bool isValid() const;
+        Point& makeValid();
+        double getDistance(const Point& p) const;
+        int getApproxDistance(const Point& p) const;
+        double getLength() const;
+
+        T x = 0;
+        T y = 0;
+    };
+
+    template<typename T, int Scale> std::ostream& operator<<(std::ostream& os, const Point<T, Scale>& p)
+    {
+        return os << '(' << p.x << ',' << p.y << ')';
+    }
+
+    typedef Point<int, 1> Position;
+    typedef Point<int, 8> WalkPosition;
+    typedef Point<int, 32> TilePosition;
+    const int TILEPOSITION_SCALE = 32;
+
+    namespace Positions { extern const Position Invalid, None, Unknown, Origin; }
+    namespace WalkPositions { extern const WalkPosition Invalid, None, Unknown, Origin; }
+    namespace TilePositions { extern const TilePosition Invalid, None, Unknown, Origin; }
+
+    // The base of the value types: a type is just its id.
+    template<typename T, int DefaultId> class Type
+    {
+    public:
+        constexpr Type(const int _id = DefaultId) : id(_id) {}
+        operator int() const { return id; }
+        int getID() const { return id; }
+        bool isValid() const;
+        const std::string& getName() const;
+        const char* c_str() const { return getName().c_str(); }
+
+    private:
+        int id;
+    };
+
+    class UnitType;
+    class WeaponType;
+    class UpgradeType;
+    class TechType;
+
+    class Race : public Type<Race, 7>
+    {
+    public:
+        using Type::Type;
+        UnitType getWorker() const;
+        UnitType getResourceDepot() const;
+        UnitType getCenter() const;
+        UnitType getRefinery() const;
+        UnitType getTransport() const;
+        UnitType getSupplyProvider() const;
+    };
+
+    namespace Races
+    {
+        namespace Enum { enum Enum { Zerg, Terran, Protoss, Other, Unused, Select, Random, None, Unknown, MAX }; }
+        extern const Race Zerg, Terran, Protoss, Random, None, Unknown;
+    }
+
+    class UnitSizeType : public Type<UnitSizeType, 6>
+    {
+    public:
+        using Type::Type;
+    };
+
+    class DamageType : public Type<DamageType, 6>
+    {
+    public:
+        using Type::Type;
+    };
+
+    class UnitType : public Type<UnitType, 233>
+    {
+    public:
+        using Type::Type;
+        Race getRace() const;
+        const std::pair<UnitType, int> whatBuilds() const;
+        const std::map<UnitType, int>& requiredUnits() const;
+        TechType requiredTech() const;
+        UpgradeType armorUpgrade() const;
+        int maxHitPoints() const;
+        int maxShields() const;
+        int maxEnergy() const;
+        int armor() const;
+        int mineralPrice() const;
+        int gasPrice() const;
+        int buildTime() const;
+        int supplyRequired() const;
+        int supplyProvided() const;
+        int spaceRequired() const;
+        int spaceProvided() const;
+        int buildScore() const;
+        int destroyScore() const;
+        UnitSizeType size() const;
+        int tileWidth() const;
+        int tileHeight() const;
+        TilePosition tileSize() const;
+        int dimensionLeft() const;
+        int dimensionUp() const;
+        int dimensionRight() const;
+        int dimensionDown() const;
+        int width() const;
+        int height() const;
+        int seekRange() const;
+        int sightRange() const;
+        WeaponType groundWeapon() const;
+        int maxGroundHits() const;
+        WeaponType airWeapon() const;
+        int maxAirHits() const;
+        double topSpeed() const;
+        int acceleration() const;
+        int haltDistance() const;
+        int turnRadius() const;
+        bool canProduce() const;
+        bool canAttack() const;
+        bool canMove() const;
+        bool isFlyer() const;
+        bool regeneratesHP() const;
+        bool isSpellcaster() const;
+        bool hasPermanentCloak() const;
+        bool isInvincible() const;
+        bool isOrganic() const;
+        bool isMechanical() const;
+        bool isRobotic() const;
+        bool isDetector() const;
+        bool isResourceContainer() const;
+        bool isResourceDepot() const;
+        bool isRefinery() const;
+        bool isWorker() const;
+        bool requiresPsi() const;
+        bool requiresCreep() const;
+        bool isTwoUnitsInOneEgg() const;
+        bool isBurrowable() const;
+        bool isCloakable() const;
+        bool isBuilding() const;
+        bool isAddon() const;
+        bool isFlyingBuilding() const;
+        bool isNeutral() const;
+        bool isHero() const;
+        bool isPowerup() const;
+        bool isBeacon() const;
+        bool isFlagBeacon() const;
+        bool isSpecialBuilding() const;
+        bool isSpell() const;
+        bool producesCreep() const;
+        bool producesLarva() const;
+        bool isMineralField() const;
+        bool isCritter() const;
+        bool canBuildAddon() const;
+        bool isSuccessorOf(const UnitType type) const;
+    };
+
+    namespace UnitTypes
+    {
+        namespace Enum
+        {
+            enum Enum
+            {
+                Terran_Marine = 0, Terran_Ghost, Terran_Vulture, Terran_Goliath,
+                Terran_Siege_Tank_Tank_Mode = 5, Terran_SCV = 7, Terran_Wraith, Terran_Science_Vessel,
+                Terran_Dropship = 11, Terran_Battlecruiser, Terran_Vulture_Spider_Mine,
+                Terran_Siege_Tank_Siege_Mode = 30, Terran_Firebat = 32, Spell_Scanner_Sweep, Terran_Medic,
+                Zerg_Larva, Zerg_Egg, Zerg_Zergling, Zerg_Hydralisk, Zerg_Ultralisk, Zerg_Broodling,
+                Zerg_Drone, Zerg_Overlord, Zerg_Mutalisk, Zerg_Guardian, Zerg_Queen, Zerg_Defiler,
+                Zerg_Scourge, Zerg_Infested_Terran = 50, Terran_Valkyrie = 58, Zerg_Cocoon, Protoss_Corsair,
+                Protoss_Dark_Templar, Zerg_Devourer, Protoss_Dark_Archon, Protoss_Probe, Protoss_Zealot,
+                Protoss_Dragoon, Protoss_High_Templar, Protoss_Archon, Protoss_Shuttle, Protoss_Scout,
+                Protoss_Arbiter, Protoss_Carrier, Protoss_Interceptor, Hero_Warbringer = 81,
+                Hero_Gantrithor, Protoss_Reaver, Protoss_Observer, Protoss_Scarab, Zerg_Lurker_Egg = 97,
+                Special_Map_Revealer = 101, Zerg_Lurker = 103, Spell_Disruption_Web = 105,
+                Terran_Command_Center, Terran_Comsat_Station, Terran_Nuclear_Silo, Terran_Supply_Depot,
+                Terran_Refinery, Terran_Barracks, Terran_Academy, Terran_Factory, Terran_Starport,
+                Terran_Control_Tower, Terran_Science_Facility, Terran_Covert_Ops, Terran_Physics_Lab,
+                Terran_Machine_Shop = 120, Terran_Engineering_Bay = 122, Terran_Armory,
+                Terran_Missile_Turret, Terran_Bunker, Zerg_Infested_Command_Center = 130, Zerg_Hatchery,
+                Zerg_Lair, Zerg_Hive, Zerg_Nydus_Canal, Zerg_Hydralisk_Den, Zerg_Defiler_Mound,
+                Zerg_Greater_Spire, Zerg_Queens_Nest, Zerg_Evolution_Chamber, Zerg_Ultralisk_Cavern,
+                Zerg_Spire, Zerg_Spawning_Pool, Zerg_Creep_Colony, Zerg_Spore_Colony,
+                Zerg_Sunken_Colony = 146, Zerg_Extractor = 149, Protoss_Nexus = 154,
+                Protoss_Robotics_Facility, Protoss_Pylon, Protoss_Assimilator, Protoss_Observatory = 159,
+                Protoss_Gateway, Protoss_Photon_Cannon = 162, Protoss_Citadel_of_Adun,
+                Protoss_Cybernetics_Core, Protoss_Templar_Archives, Protoss_Forge, Protoss_Stargate,
+                Protoss_Fleet_Beacon = 169, Protoss_Arbiter_Tribunal, Protoss_Shield_Battery = 172,
+                Resource_Mineral_Field = 176, Resource_Mineral_Field_Type_2, Resource_Mineral_Field_Type_3,
+                Resource_Vespene_Geyser = 188, Spell_Dark_Swarm = 202, Special_Start_Location = 214,
+                None = 228, AllUnits, Men, Buildings, Factories, Unknown, MAX
+            };
+        }
+
+        extern const UnitType Hero_Gantrithor, Hero_Warbringer, Protoss_Arbiter, Protoss_Arbiter_Tribunal,
+            Protoss_Archon, Protoss_Assimilator, Protoss_Carrier, Protoss_Citadel_of_Adun, Protoss_Corsair,
+            Protoss_Cybernetics_Core, Protoss_Dark_Archon, Protoss_Dark_Templar, Protoss_Dragoon,
+            Protoss_Fleet_Beacon, Protoss_Forge, Protoss_Gateway, Protoss_High_Templar, Protoss_Interceptor,
+            Protoss_Nexus, Protoss_Observatory, Protoss_Observer, Protoss_Photon_Cannon, Protoss_Probe,
+            Protoss_Pylon, Protoss_Reaver, Protoss_Robotics_Facility, Protoss_Scarab, Protoss_Scout,
+            Protoss_Shield_Battery, Protoss_Shuttle, Protoss_Stargate, Protoss_Templar_Archives,
+            Protoss_Zealot, Resource_Mineral_Field, Resource_Mineral_Field_Type_2,
+            Resource_Mineral_Field_Type_3, Resource_Vespene_Geyser, Special_Map_Revealer,
+            Special_Start_Location, Spell_Dark_Swarm, Spell_Disruption_Web, Spell_Scanner_Sweep,
+            Terran_Academy, Terran_Armory, Terran_Barracks, Terran_Battlecruiser, Terran_Bunker,
+            Terran_Command_Center, Terran_Comsat_Station, Terran_Control_Tower, Terran_Covert_Ops,
+            Terran_Dropship, Terran_Engineering_Bay, Terran_Factory, Terran_Firebat, Terran_Ghost,
+            Terran_Goliath, Terran_Machine_Shop, Terran_Marine, Terran_Medic, Terran_Missile_Turret,
+            Terran_Nuclear_Silo, Terran_Physics_Lab, Terran_Refinery, Terran_SCV, Terran_Science_Facility,
+            Terran_Science_Vessel, Terran_Siege_Tank_Siege_Mode, Terran_Siege_Tank_Tank_Mode,
+            Terran_Starport, Terran_Supply_Depot, Terran_Valkyrie, Terran_Vulture,
+            Terran_Vulture_Spider_Mine, Terran_Wraith, Zerg_Broodling, Zerg_Cocoon, Zerg_Creep_Colony,
+            Zerg_Defiler, Zerg_Defiler_Mound, Zerg_Devourer, Zerg_Drone, Zerg_Egg, Zerg_Evolution_Chamber,
+            Zerg_Extractor, Zerg_Greater_Spire, Zerg_Guardian, Zerg_Hatchery, Zerg_Hive, Zerg_Hydralisk,
+            Zerg_Hydralisk_Den, Zerg_Infested_Command_Center, Zerg_Infested_Terran, Zerg_Lair, Zerg_Larva,
+            Zerg_Lurker, Zerg_Lurker_Egg, Zerg_Mutalisk, Zerg_Nydus_Canal, Zerg_Overlord, Zerg_Queen,
+            Zerg_Queens_Nest, Zerg_Scourge, Zerg_Spawning_Pool, Zerg_Spire, Zerg_Spore_Colony,
+            Zerg_Sunken_Colony, Zerg_Ultralisk, Zerg_Ultralisk_Cavern, Zerg_Zergling, None, AllUnits,
+            Unknown;
+
+        // The unit types that are in the table in ValueTypes.cpp.
+        const std::set<UnitType>& allUnitTypes();
+    }
+
+    class WeaponType : public Type<WeaponType, 130>
+    {
+    public:
+        using Type::Type;
+        int damageAmount() const;
+        int damageBonus() const;
+        int damageCooldown() const;
+        int damageFactor() const;
+        DamageType damageType() const;
+        int maxRange() const;
+        int minRange() const;
+        int innerSplashRadius() const;
+        int medianSplashRadius() const;
+        int outerSplashRadius() const;
+        bool targetsAir() const;
+        bool targetsGround() const;
+        UnitType whatUses() const;
+    };
+
+    namespace WeaponTypes
+    {
+        namespace Enum
+        {
+            enum Enum
+            {
+                Gauss_Rifle = 0, C_10_Canister_Rifle = 2, Fragmentation_Grenade = 4, Spider_Mines = 6,
+                Twin_Autocannons, Hellfire_Missile_Pack, Arclite_Cannon = 11, Fusion_Cutter = 13,
+                Burst_Lasers = 16, Gemini_Missiles, ATS_Laser_Battery = 19, ATA_Laser_Battery,
+                Flame_Thrower = 25, Arclite_Shock_Cannon = 27, Halo_Rockets = 29, Claws = 35,
+                Needle_Spines = 38, Kaiser_Blades = 40, Toxic_Spores = 42, Spines, Acid_Spore = 46,
+                Glave_Wurm = 48, Seeker_Spores = 50, Subterranean_Tentacle = 52, Suicide_Infested_Terran,
+                Suicide_Scourge, Particle_Beam = 64, Psi_Blades, Phase_Disruptor, STS_Photon_Cannon = 74,
+                STA_Photon_Cannon, Dual_Photon_Blasters = 77, Anti_Matter_Missiles, Phase_Disruptor_Cannon,
+                Psionic_Shockwave = 81, Neutron_Flare = 83, Pulse_Cannon, Scarab, Corrosive_Acid,
+                Subterranean_Spines = 103, Warp_Blades, None = 130, Unknown, MAX
+            };
+        }
+
+        extern const WeaponType None, Unknown;
+    }
+
+    class UpgradeType : public Type<UpgradeType, 63>
+    {
+    public:
+        using Type::Type;
+        int mineralPrice(const int level = 1) const;
+        int gasPrice(const int level = 1) const;
+        int maxRepeats() const;
+        UnitType whatUpgrades() const;
+        UnitType whatsRequired(const int level = 1) const;
+    };
+
+    namespace UpgradeTypes
+    {
+        extern const UpgradeType Zerg_Carapace, Zerg_Flyer_Carapace, Zerg_Melee_Attacks,
+            Zerg_Missile_Attacks, Zerg_Flyer_Attacks, Antennae, Pneumatized_Carapace, Metabolic_Boost,
+            Adrenal_Glands, Muscular_Augments, Grooved_Spines, Anabolic_Synthesis, Chitinous_Plating, None,
+            Unknown;
+    }
+
+    class TechType : public Type<TechType, 47>
+    {
+    public:
+        using Type::Type;
+    };
+
+    namespace TechTypes { extern const TechType Burrowing, Lurker_Aspect, None, Unknown; }
+
+    class Order : public Type<Order, 191>
+    {
+    public:
+        using Type::Type;
+    };
+
+    namespace Orders
+    {
+        extern const Order Die, Stop, Guard, PlayerGuard, Move, AttackUnit, Nothing, IncompleteBuilding,
+            Build, Train, ZergBuildingMorph, Harvest1, Harvest2, MoveToGas, WaitForGas, HarvestGas,
+            ReturnGas, MoveToMinerals, WaitForMinerals, MiningMinerals, Harvest3, Harvest4, ReturnMinerals,
+            ResetCollision, None, Unknown;
+    }
+
+    class UnitCommandType : public Type<UnitCommandType, 45>
+    {
+    public:
+        using Type::Type;
+    };
+
+    namespace UnitCommandTypes
+    {
+        extern const UnitCommandType Attack_Move, Attack_Unit, Build, Train, Morph, Upgrade, Move, Stop,
+            Hold_Position, Gather, Return_Cargo, Right_Click_Position, Right_Click_Unit, Cancel_Morph, None,
+            Unknown;
+    }
+
+    class PlayerType : public Type<PlayerType, 13>
+    {
+    public:
+        using Type::Type;
+    };
+
+    namespace PlayerTypes { extern const PlayerType None, Computer, Player, Neutral, Unknown; }
+
+    class GameType : public Type<GameType, 35>
+    {
+    public:
+        using Type::Type;
+    };
+
+    namespace GameTypes { extern const GameType Melee; }
+
+    class Error : public Type<Error, 28>
+    {
+    public:
+        using Type::Type;
+    };
+
+    namespace Errors { extern const Error None; }
+
+    std::ostream& operator<<(std::ostream& os, const Race& t);
+    std::ostream& operator<<(std::ostream& os, const UnitType& t);
+    std::ostream& operator<<(std::ostream& os, const WeaponType& t);
+    std::ostream& operator<<(std::ostream& os, const UpgradeType& t);
+    std::ostream& operator<<(std::ostream& os, const Order& t);
+    std::ostream& operator<<(std::ostream& os, const UnitCommandType& t);
+    std::ostream& operator<<(std::ostream& os, const PlayerType& t);
+    std::ostream& operator<<(std::ostream& os, const GameType& t);
+
+    namespace EventType
+    {
+        enum Enum
+        {
+            MatchStart, MatchEnd, MatchFrame, MenuFrame, SendText, ReceiveText, PlayerLeft, NukeDetect,
+            UnitDiscover, UnitEvade, UnitShow, UnitHide, UnitCreate, UnitDestroy, UnitMorph, UnitRenegade,
+            SaveGame, UnitComplete, None
+        };
+    }
+
+    namespace Flag { enum Enum { CompleteMapInformation = 0, UserInput = 1, Max }; }
+    namespace Text { enum Enum { Default = 1 }; }
+    namespace CoordinateType { enum Enum { None, Screen, Map, Mouse }; }
+}
@@ -0,0 +1,185 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "AllocationCounter.h"
+
+// Only the bench defines this (see AllocationCounter.h), so that the replaced operator new/delete
+// aren't in the tournament bot.
+#ifdef ZZZKBOT_COUNT_ALLOCATIONS
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+static std::atomic<std::uint64_t> numAllocations(0);
+static std::atomic<std::uint64_t> numBytesAllocated(0);
+static std::atomic<std::int64_t> numBytesInUse(0);
+static std::atomic<std::int64_t> peakNumBytesInUse(0);
+
+std::uint64_t AllocationCounter::getNumAllocations()
+{
+    return numAllocations.load(std::memory_order_relaxed);
+}
+
+std::uint64_t AllocationCounter::getNumBytesAllocated()
+{
+    return numBytesAllocated.load(std::memory_order_relaxed);
+}
+
+std::int64_t AllocationCounter::getNumBytesInUse()
+{
+    return numBytesInUse.load(std::memory_order_relaxed);
+}
+
+std::int64_t AllocationCounter::getPeakNumBytesInUse()
+{
+    return peakNumBytesInUse.load(std::memory_order_relaxed);
+}
+
+void AllocationCounter::resetPeakNumBytesInUse()
+{
+    peakNumBytesInUse.store(numBytesInUse.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+// The usable size of a block from malloc()/the aligned allocation function.
+static std::size_t getUsableSize(void* p)
+{
+#ifdef _MSC_VER
+    return _msize(p);
+#else
+    return malloc_usable_size(p);
+#endif
+}
+
+static std::size_t getUsableSize(void* p, const std::align_val_t alignment)
+{
+#ifdef _MSC_VER
+    return _aligned_msize(p, static_cast<std::size_t>(alignment), 0);
+#else
+    (void) alignment;
+    return malloc_usable_size(p);
+#endif
+}
+
+static void countAllocation(const std::size_t size, const std::size_t usableSize)
+{
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+    numBytesAllocated.fetch_add(size, std::memory_order_relaxed);
+
+    const std::int64_t newNumBytesInUse = numBytesInUse.fetch_add((std::int64_t) usableSize, std::memory_order_relaxed) + (std::int64_t) usableSize;
+    std::int64_t peak = peakNumBytesInUse.load(std::memory_order_relaxed);
+    while (newNumBytesInUse > peak && !peakNumBytesInUse.compare_exchange_weak(peak, newNumBytesInUse, std::memory_order_relaxed))
+    {
+    }
+}
+
+static void countDeallocation(const std::size_t usableSize)
+{
+    numBytesInUse.fetch_sub((std::int64_t) usableSize, std::memory_order_relaxed);
+}
+
+// Calls the new handler until the allocation succeeds, like the default operator new.
+template <typename Allocate>
+static void* allocateOrThrow(Allocate allocate)
+{
+    for (;;)
+    {
+        void* p = allocate();
+        if (p)
+        {
+            return p;
+        }
+
+        std::new_handler handler = std::get_new_handler();
+        if (!handler)
+        {
+            throw std::bad_alloc();
+        }
+
+        handler();
+    }
+}
+
+// The array and nothrow forms of operator new and the sized forms of operator delete call these
+// by default, so they don't need to be replaced as well.
+void* operator new(std::size_t size)
+{
+    // malloc(0) may return nullptr, but operator new must return a unique pointer.
+    void* p = allocateOrThrow([size]() { return std::malloc(size > 0 ? size : 1); });
+    countAllocation(size, getUsableSize(p));
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    if (p)
+    {
+        countDeallocation(getUsableSize(p));
+        std::free(p);
+    }
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    operator delete(p);
+}
+
+// The over-aligned forms (e.g. std::pmr::new_delete_resource() may use them for the arenas'
+// overflow blocks). The memory must be freed with the matching function, which differs on MSVC.
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    void* p = allocateOrThrow(
+        [size, alignment]()
+        {
+            const std::size_t align = static_cast<std::size_t>(alignment);
+            const std::size_t roundedSize = ((size > 0 ? size : 1) + align - 1) / align * align;
+#ifdef _MSC_VER
+            return _aligned_malloc(roundedSize, align);
+#else
+            return std::aligned_alloc(align, roundedSize);
+#endif
+        });
+    countAllocation(size, getUsableSize(p, alignment));
+    return p;
+}
+
+void operator delete(void* p, std::align_val_t alignment) noexcept
+{
+    if (!p)
+    {
+        return;
+    }
+
+    countDeallocation(getUsableSize(p, alignment));
+#ifdef _MSC_VER
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t alignment) noexcept
+{
+    operator delete(p, alignment);
+}
+
+#endif
@@ -0,0 +1,46 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+#include <cstdint>
+
+// Counts the heap allocations made through the global operator new on all threads (this includes
+// the containers of the standard library and of the BWAPI client, but not the memory that the
+// arenas hand out from their buffers). AllocationCounter.cpp replaces the global operator
+// new/delete (including the over-aligned forms) to do the counting, which costs a couple of
+// relaxed atomic increments per allocation (and per deallocation, for the bytes in use).
+// AllocationCounter.cpp is empty unless ZZZKBOT_COUNT_ALLOCATIONS is defined, which only the bench
+// project does, so the tournament bot keeps the default allocator (define it there as well to count
+// the allocations of live games).
+//
+// E.g. to check that a frame doesn't allocate, compare getNumAllocations() before and after it.
+class AllocationCounter
+{
+public:
+    static std::uint64_t getNumAllocations();
+    static std::uint64_t getNumBytesAllocated();
+
+    // The bytes that are currently allocated, and the most there were since the last reset (by the
+    // usable sizes of the blocks, which may be a little more than what was asked for).
+    static std::int64_t getNumBytesInUse();
+    static std::int64_t getPeakNumBytesInUse();
+    static void resetPeakNumBytesInUse();
+};
@@ -0,0 +1,77 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "Arena.h"
+
+Arena::Arena(const std::size_t initialSize)
+    : buffer(initialSize > 0 ? new unsigned char[initialSize] : nullptr),
+      bufferSize(initialSize)
+{
+    initResource();
+}
+
+void Arena::reset()
+{
+    // Release whatever was allocated from the heap before (possibly) replacing the buffer.
+    resource.reset();
+
+    if (numBytesUsed > peakNumBytesUsed)
+    {
+        peakNumBytesUsed = numBytesUsed;
+    }
+
+    // Leave some room for the padding for alignment, which isn't counted.
+    if (numBytesUsed > bufferSize)
+    {
+        bufferSize = numBytesUsed + numBytesUsed / 4;
+        buffer.reset(new unsigned char[bufferSize]);
+    }
+
+    numBytesUsed = 0;
+    initResource();
+}
+
+void* Arena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    numBytesUsed += bytes;
+    return resource->allocate(bytes, alignment);
+}
+
+void Arena::do_deallocate(void*, std::size_t, std::size_t)
+{
+}
+
+bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+void Arena::initResource()
+{
+    if (bufferSize > 0)
+    {
+        resource.emplace(buffer.get(), bufferSize, std::pmr::new_delete_resource());
+    }
+    else
+    {
+        resource.emplace(std::pmr::new_delete_resource());
+    }
+}
@@ -0,0 +1,74 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+// A memory resource that hands out memory from a buffer in order and frees all of it at once in
+// reset(), e.g. everything that was allocated during a game or during a frame. Deallocating does
+// nothing, so containers that use it can be thrown away without visiting their nodes, but they
+// must be destroyed before the reset.
+//
+// When more memory is needed than the buffer holds it is allocated from the global heap, and the
+// next reset() enlarges the buffer to the most that was used since the previous reset, so once it
+// has warmed up a game/frame doesn't allocate from the heap at all.
+//
+// It isn't thread-safe (only use it from the thread that owns it).
+class Arena : public std::pmr::memory_resource
+{
+public:
+    explicit Arena(const std::size_t initialSize = 0);
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Frees everything that was allocated since the last reset.
+    void reset();
+
+    // The number of bytes allocated since the last reset, and the most that were allocated between
+    // two resets (since construction or the last call to clearPeakNumBytesUsed()).
+    std::size_t getNumBytesUsed() const { return numBytesUsed; }
+    std::size_t getPeakNumBytesUsed() const { return numBytesUsed > peakNumBytesUsed ? numBytesUsed : peakNumBytesUsed; }
+    void clearPeakNumBytesUsed() { peakNumBytesUsed = 0; }
+
+    // The size of the buffer (not counting what is allocated from the heap when it runs out).
+    std::size_t getBufferSize() const { return bufferSize; }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    void initResource();
+
+    std::unique_ptr<unsigned char[]> buffer;
+    std::size_t bufferSize = 0;
+
+    // Recreated on each reset (a monotonic_buffer_resource can only go back to the start of the
+    // buffer that it was constructed with).
+    std::optional<std::pmr::monotonic_buffer_resource> resource;
+
+    std::size_t numBytesUsed = 0;
+    std::size_t peakNumBytesUsed = 0;
+};
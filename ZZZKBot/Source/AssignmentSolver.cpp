@@ -0,0 +1,278 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "AssignmentSolver.h"
+#include <algorithm>
+#include <limits>
+
+const long long AssignmentSolver::unassignedCost;
+
+void AssignmentSolver::clear()
+{
+    *this = AssignmentSolver();
+}
+
+int AssignmentSolver::addRow()
+{
+    int row = (int) (std::find(isRealRow.begin(), isRealRow.end(), false) - isRealRow.begin());
+    if (row == n)
+    {
+        grow();
+    }
+
+    // A dummy row costs 0 for everything, whereas a real row costs unassignedCost until the
+    // caller sets its costs.
+    isRealRow[row] = true;
+    for (int col = 0; col < n; ++col)
+    {
+        setCostInternal(row, col, unassignedCost);
+    }
+
+    return row;
+}
+
+int AssignmentSolver::addColumn()
+{
+    int col = (int) (std::find(isRealCol.begin(), isRealCol.end(), false) - isRealCol.begin());
+    if (col == n)
+    {
+        grow();
+    }
+
+    // Real rows already cost unassignedCost for a dummy column and dummy rows cost 0, so none of
+    // the costs change.
+    isRealCol[col] = true;
+    return col;
+}
+
+void AssignmentSolver::removeRow(const int row)
+{
+    isRealRow[row] = false;
+    for (int col = 0; col < n; ++col)
+    {
+        setCostInternal(row, col, 0);
+    }
+}
+
+void AssignmentSolver::removeColumn(const int col)
+{
+    isRealCol[col] = false;
+    for (int row = 0; row < n; ++row)
+    {
+        if (isRealRow[row])
+        {
+            setCostInternal(row, col, unassignedCost);
+        }
+    }
+}
+
+void AssignmentSolver::setCost(const int row, const int col, const long long cost)
+{
+    if (isRealRow[row] && isRealCol[col])
+    {
+        setCostInternal(row, col, std::min(cost, unassignedCost));
+    }
+}
+
+void AssignmentSolver::solve()
+{
+    // Make the potentials of the invalidated rows feasible again (the lowest reduced cost in the
+    // row becomes 0) and unmatch them.
+    for (int row = 0; row < n; ++row)
+    {
+        if (!isRowDirty[row])
+        {
+            continue;
+        }
+
+        isRowDirty[row] = false;
+        if (rowToCol[row] != -1)
+        {
+            colToRow[rowToCol[row]] = -1;
+            rowToCol[row] = -1;
+        }
+
+        long long minReducedCost = std::numeric_limits<long long>::max();
+        for (int col = 0; col < n; ++col)
+        {
+            minReducedCost = std::min(minReducedCost, cost(row, col) - v[col]);
+        }
+
+        u[row] = minReducedCost;
+    }
+
+    for (int row = 0; row < n; ++row)
+    {
+        if (rowToCol[row] == -1)
+        {
+            augment(row);
+        }
+    }
+}
+
+int AssignmentSolver::getAssignedColumn(const int row) const
+{
+    const int col = rowToCol[row];
+    if (col == -1 || !isRealRow[row] || !isRealCol[col] || cost(row, col) >= unassignedCost)
+    {
+        return -1;
+    }
+
+    return col;
+}
+
+void AssignmentSolver::grow()
+{
+    const int oldN = n;
+    ++n;
+
+    std::vector<long long> newCosts((size_t) n * n, 0);
+    for (int row = 0; row < oldN; ++row)
+    {
+        std::copy(costs.begin() + (size_t) row * oldN, costs.begin() + (size_t) (row + 1) * oldN, newCosts.begin() + (size_t) row * n);
+
+        // The new column is a dummy.
+        newCosts[(size_t) row * n + oldN] = isRealRow[row] ? unassignedCost : 0;
+    }
+
+    // The new row is a dummy so its costs are all 0.
+    costs.swap(newCosts);
+    isRealRow.push_back(false);
+    isRealCol.push_back(false);
+    rowToCol.push_back(-1);
+    colToRow.push_back(-1);
+    isRowDirty.push_back(false);
+
+    // Feasible potentials for the new column and row.
+    long long newV = 0;
+    if (oldN > 0)
+    {
+        newV = std::numeric_limits<long long>::max();
+        for (int row = 0; row < oldN; ++row)
+        {
+            newV = std::min(newV, cost(row, oldN) - u[row]);
+        }
+    }
+
+    v.push_back(newV);
+
+    long long newU = std::numeric_limits<long long>::max();
+    for (int col = 0; col < n; ++col)
+    {
+        newU = std::min(newU, cost(oldN, col) - v[col]);
+    }
+
+    u.push_back(newU);
+}
+
+void AssignmentSolver::setCostInternal(const int row, const int col, const long long newCost)
+{
+    long long& c = cost(row, col);
+    if (c == newCost)
+    {
+        return;
+    }
+
+    c = newCost;
+
+    // The solution is still optimal unless a matched pair is no longer tight or the reduced cost
+    // of the pair is now negative.
+    if (rowToCol[row] == col || u[row] + v[col] > newCost)
+    {
+        isRowDirty[row] = true;
+    }
+}
+
+void AssignmentSolver::augment(const int row)
+{
+    // Shortest augmenting path from the row using the reduced costs (Dijkstra-like), updating the
+    // potentials as it goes. Index n is a virtual column that the row is matched to at the start,
+    // and p[col] is the row matched to col.
+    const long long inf = std::numeric_limits<long long>::max();
+    std::vector<long long> minv(n + 1, inf);
+    std::vector<bool> used(n + 1, false);
+    std::vector<int> way(n + 1, n);
+    std::vector<int> p(colToRow);
+    p.push_back(row);
+
+    int j0 = n;
+    do
+    {
+        used[j0] = true;
+        const int i0 = p[j0];
+        long long delta = inf;
+        int j1 = -1;
+        for (int col = 0; col < n; ++col)
+        {
+            if (!used[col])
+            {
+                const long long cur = cost(i0, col) - u[i0] - v[col];
+                if (cur < minv[col])
+                {
+                    minv[col] = cur;
+                    way[col] = j0;
+                }
+
+                if (minv[col] < delta)
+                {
+                    delta = minv[col];
+                    j1 = col;
+                }
+            }
+        }
+
+        for (int col = 0; col <= n; ++col)
+        {
+            if (used[col])
+            {
+                u[p[col]] += delta;
+                if (col < n)
+                {
+                    v[col] -= delta;
+                }
+            }
+            else
+            {
+                minv[col] -= delta;
+            }
+        }
+
+        j0 = j1;
+    }
+    while (p[j0] != -1);
+
+    // Flip the matching along the path.
+    do
+    {
+        const int j1 = way[j0];
+        p[j0] = p[j1];
+        j0 = j1;
+    }
+    while (j0 != n);
+
+    for (int col = 0; col < n; ++col)
+    {
+        colToRow[col] = p[col];
+        if (p[col] != -1)
+        {
+            rowToCol[p[col]] = col;
+        }
+    }
+}
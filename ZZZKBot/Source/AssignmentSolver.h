@@ -0,0 +1,90 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Minimum cost assignment of rows (e.g. gatherers) to columns (e.g. mineral patches), at most one
+// row per column and one column per row, using the Hungarian algorithm on a dense cost matrix.
+// It doesn't depend on BWAPI.
+//
+// The matrix is kept square by padding it with dummy rows/columns: a dummy row costs 0 for every
+// column, and a real row costs unassignedCost for a dummy column (or for any pair that the caller
+// sets to unassignedCost, i.e. isn't allowed). Removed rows/columns become dummies and their
+// slots are reused by later additions.
+//
+// The dual potentials and the matching are kept between calls to solve(), so it is incremental:
+// changing a cost only invalidates the row it's in if the current solution depends on it (i.e.
+// if the pair is matched, or if the cost decreased below what the potentials allow), and each
+// invalidated row only needs one O(n^2) shortest augmenting path search rather than solving the
+// whole O(n^3) problem again.
+class AssignmentSolver
+{
+public:
+    // Anything at least this big means the pair can't be assigned.
+    static const long long unassignedCost = 1000000000LL;
+
+    void clear();
+
+    // Returns the index of the new row/column, whose costs are initially unassignedCost.
+    int addRow();
+    int addColumn();
+
+    void removeRow(const int row);
+    void removeColumn(const int col);
+
+    // Sets the cost of a real row and a real column (values >= unassignedCost mean not allowed).
+    void setCost(const int row, const int col, const long long cost);
+
+    // Updates the solution after the changes since the last call.
+    void solve();
+
+    // Returns the column assigned to the row (after solve()) or -1 if it isn't assigned a real
+    // column.
+    int getAssignedColumn(const int row) const;
+
+    // The number of rows/columns including the dummies.
+    int getSize() const { return n; }
+
+private:
+    long long& cost(const int row, const int col) { return costs[(std::size_t) row * n + col]; }
+    long long cost(const int row, const int col) const { return costs[(std::size_t) row * n + col]; }
+    void grow();
+    void setCostInternal(const int row, const int col, const long long newCost);
+    void augment(const int row);
+
+    int n = 0;
+
+    // Row-major n * n.
+    std::vector<long long> costs;
+    std::vector<bool> isRealRow;
+    std::vector<bool> isRealCol;
+
+    // Potentials.
+    std::vector<long long> u;
+    std::vector<long long> v;
+
+    // The column matched to each row and the row matched to each column (or -1).
+    std::vector<int> rowToCol;
+    std::vector<int> colToRow;
+
+    std::vector<bool> isRowDirty;
+};
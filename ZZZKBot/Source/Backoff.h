@@ -0,0 +1,67 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+// Exponential backoff for polling/retrying: each wait is twice as long as the previous one (up to
+// a maximum) and, if jitter is enabled, a random amount shorter (up to half), so that clients that
+// all lost their connection at the same time don't all retry at the same time.
+class Backoff
+{
+public:
+    Backoff(const std::chrono::milliseconds newMinDelay, const std::chrono::milliseconds newMaxDelay, const bool newIsJittered)
+      : minDelay(newMinDelay),
+        maxDelay(newMaxDelay),
+        isJittered(newIsJittered),
+        nextDelay(newMinDelay),
+        rng(std::random_device()())
+    {
+    }
+
+    // Call this when whatever was being waited for happened.
+    void reset()
+    {
+        nextDelay = minDelay;
+    }
+
+    // Returns how long to wait this time.
+    std::chrono::milliseconds next()
+    {
+        std::chrono::milliseconds delay = nextDelay;
+        nextDelay = std::min(maxDelay, nextDelay * 2);
+        if (isJittered && delay.count() > 1)
+        {
+            std::uniform_int_distribution<long long> dist(0, delay.count() / 2);
+            delay -= std::chrono::milliseconds(dist(rng));
+        }
+
+        return delay;
+    }
+
+private:
+    std::chrono::milliseconds minDelay;
+    std::chrono::milliseconds maxDelay;
+    bool isJittered;
+    std::chrono::milliseconds nextDelay;
+    std::mt19937 rng;
+};
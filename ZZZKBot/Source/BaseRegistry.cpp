@@ -0,0 +1,444 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "BaseRegistry.h"
+#include <algorithm>
+#include <limits>
+#include <map>
+
+// Same calculation as BWAPI's Unit::getDistance(Unit) (i.e. the approximate distance between the
+// edges of the two units), but for unit types at particular positions, so that it can be used
+// before the units exist or while they aren't visible.
+static int getEdgeDistance(
+    const BWAPI::UnitType type1,
+    const BWAPI::Position pos1,
+    const BWAPI::UnitType type2,
+    const BWAPI::Position pos2)
+{
+    const int left = pos1.x - type1.dimensionLeft();
+    const int top = pos1.y - type1.dimensionUp();
+    const int right = pos1.x + type1.dimensionRight();
+    const int bottom = pos1.y + type1.dimensionDown();
+    const int targetLeft = pos2.x - type2.dimensionLeft();
+    const int targetTop = pos2.y - type2.dimensionUp();
+    const int targetRight = pos2.x + type2.dimensionRight();
+    const int targetBottom = pos2.y + type2.dimensionDown();
+
+    int xDist = left - (targetRight + 1);
+    if (xDist < 0)
+    {
+        xDist = targetLeft - (right + 1);
+        if (xDist < 0)
+        {
+            xDist = 0;
+        }
+    }
+
+    int yDist = top - (targetBottom + 1);
+    if (yDist < 0)
+    {
+        yDist = targetTop - (bottom + 1);
+        if (yDist < 0)
+        {
+            yDist = 0;
+        }
+    }
+
+    return BWAPI::Positions::Origin.getApproxDistance(BWAPI::Position(xDist, yDist));
+}
+
+static BWAPI::Position getDepotPos(const BWAPI::TilePosition depotLoc)
+{
+    const BWAPI::UnitType depotType = BWAPI::UnitTypes::Zerg_Hatchery;
+    return BWAPI::Position(depotLoc) + BWAPI::Position((depotType.tileWidth() * BWAPI::TILEPOSITION_SCALE) / 2, (depotType.tileHeight() * BWAPI::TILEPOSITION_SCALE) / 2);
+}
+
+// Finds the tile where a resource depot would mine the resources most efficiently, i.e. the
+// buildable location (that isn't too close to the resources for a resource depot to be
+// allowed) with the smallest total distance to the resources. Only used for bases that aren't
+// start locations, and only once per game.
+static BWAPI::TilePosition findDepotLoc(BWAPI::Game& Broodwar, const std::vector<BWAPI::Unit>& resources, const BWAPI::Position centroid)
+{
+    const BWAPI::UnitType depotType = BWAPI::UnitTypes::Zerg_Hatchery;
+    // Resource depots can't be built within this many tiles of a mineral patch or geyser.
+    const int minResourceGapTiles = 3;
+    const int searchRadiusTiles = 12;
+    const BWAPI::TilePosition centroidLoc(centroid);
+
+    BWAPI::TilePosition bestLoc = BWAPI::TilePositions::None;
+    int bestTotDist = std::numeric_limits<int>::max();
+
+    for (int dy = -searchRadiusTiles; dy <= searchRadiusTiles; ++dy)
+    {
+        for (int dx = -searchRadiusTiles; dx <= searchRadiusTiles; ++dx)
+        {
+            const BWAPI::TilePosition loc(centroidLoc.x + dx - depotType.tileWidth() / 2, centroidLoc.y + dy - depotType.tileHeight() / 2);
+
+            bool isValid = true;
+            for (int y = loc.y; isValid && y < loc.y + depotType.tileHeight(); ++y)
+            {
+                for (int x = loc.x; isValid && x < loc.x + depotType.tileWidth(); ++x)
+                {
+                    isValid = x >= 0 && y >= 0 && x < Broodwar->mapWidth() && y < Broodwar->mapHeight() && Broodwar->isBuildable(x, y);
+                }
+            }
+
+            if (!isValid)
+            {
+                continue;
+            }
+
+            int totDist = 0;
+            for (const BWAPI::Unit resource : resources)
+            {
+                const BWAPI::TilePosition resourceLoc = resource->getInitialTilePosition();
+                const BWAPI::UnitType resourceType = resource->getInitialType();
+                if (resourceLoc.x + resourceType.tileWidth() > loc.x - minResourceGapTiles &&
+                    resourceLoc.x < loc.x + depotType.tileWidth() + minResourceGapTiles &&
+                    resourceLoc.y + resourceType.tileHeight() > loc.y - minResourceGapTiles &&
+                    resourceLoc.y < loc.y + depotType.tileHeight() + minResourceGapTiles)
+                {
+                    isValid = false;
+                    break;
+                }
+
+                totDist += getEdgeDistance(depotType, getDepotPos(loc), resourceType, resource->getInitialPosition());
+            }
+
+            if (isValid && totDist < bestTotDist)
+            {
+                bestLoc = loc;
+                bestTotDist = totDist;
+            }
+        }
+    }
+
+    return bestLoc;
+}
+
+void BaseRegistry::onStart(BWAPI::Game& Broodwar)
+{
+    *this = BaseRegistry();
+    self = Broodwar->self();
+
+    // The key is BWAPI's resource group, i.e. resources with the same key are considered to be
+    // part of one base.
+    std::map<int, std::vector<BWAPI::Unit>> resourceGroups;
+    for (const BWAPI::Unit mineral : Broodwar->getStaticMinerals())
+    {
+        // Ignore the tiny mineral patches that some maps use to block paths.
+        if (mineral->getInitialResources() > 16)
+        {
+            resourceGroups[mineral->getResourceGroup()].push_back(mineral);
+        }
+    }
+
+    for (const BWAPI::Unit geyser : Broodwar->getStaticGeysers())
+    {
+        resourceGroups[geyser->getResourceGroup()].push_back(geyser);
+    }
+
+    const BWAPI::UnitType depotType = BWAPI::UnitTypes::Zerg_Hatchery;
+    for (const auto& resourceGroup : resourceGroups)
+    {
+        const std::vector<BWAPI::Unit>& resources = resourceGroup.second;
+
+        BWAPI::Position centroid(0, 0);
+        for (const BWAPI::Unit resource : resources)
+        {
+            centroid += resource->getInitialPosition();
+        }
+        centroid /= (int) resources.size();
+
+        Base base;
+
+        // Use the start location if the resources are next to one.
+        int bestStartLocDist = 320;
+        for (const BWAPI::TilePosition startLoc : Broodwar->getStartLocations())
+        {
+            const int startLocDist = (int) centroid.getDistance(getDepotPos(startLoc));
+            if (startLocDist < bestStartLocDist)
+            {
+                base.depotLoc = startLoc;
+                base.isStartLocation = true;
+                bestStartLocDist = startLocDist;
+            }
+        }
+
+        if (!base.isStartLocation)
+        {
+            base.depotLoc = findDepotLoc(Broodwar, resources, centroid);
+            if (base.depotLoc == BWAPI::TilePositions::None)
+            {
+                continue;
+            }
+        }
+
+        base.depotPos = getDepotPos(base.depotLoc);
+
+        // Keep the resources sorted by distance to the depot, so the first free one is the closest.
+        std::vector<std::pair<int, BWAPI::Unit>> resourceDists;
+        for (const BWAPI::Unit resource : resources)
+        {
+            resourceDists.emplace_back(getEdgeDistance(depotType, base.depotPos, resource->getInitialType(), resource->getInitialPosition()), resource);
+        }
+        std::stable_sort(
+            resourceDists.begin(),
+            resourceDists.end(),
+            [](const std::pair<int, BWAPI::Unit>& a, const std::pair<int, BWAPI::Unit>& b)
+            {
+                return a.first < b.first;
+            });
+
+        const int baseIndex = (int) bases.size();
+        for (const auto& resourceDist : resourceDists)
+        {
+            const BWAPI::Unit resource = resourceDist.second;
+            if (resource->getInitialType().isMineralField())
+            {
+                mineralToSlot.emplace(resource, std::make_pair(baseIndex, (int) base.minerals.size()));
+                base.minerals.push_back(resource);
+                base.mineralToDepotDists.push_back(resourceDist.first);
+            }
+            else
+            {
+                geyserToBaseIndex.emplace(resource, baseIndex);
+                base.geysers.push_back(resource);
+            }
+        }
+
+        bases.push_back(base);
+    }
+
+    if (self != nullptr)
+    {
+        const BWAPI::TilePosition myStartLoc = self->getStartLocation();
+        mainDepotSearchPos =
+            (myStartLoc != BWAPI::TilePositions::None && myStartLoc != BWAPI::TilePositions::Unknown) ?
+            getDepotPos(myStartLoc) :
+            BWAPI::Position((Broodwar->mapWidth() * BWAPI::TILEPOSITION_SCALE) / 2, (Broodwar->mapHeight() * BWAPI::TILEPOSITION_SCALE) / 2);
+
+        // The starting resource depot(s) might not get a create event.
+        for (const BWAPI::Unit u : self->getUnits())
+        {
+            onUnitChanged(Broodwar, u);
+        }
+    }
+}
+
+void BaseRegistry::onUnitChanged(BWAPI::Game& Broodwar, BWAPI::Unit unit)
+{
+    if (unit == nullptr)
+    {
+        return;
+    }
+
+    const BWAPI::UnitType unitType = unit->getType();
+
+    if (unitType == BWAPI::UnitTypes::Resource_Vespene_Geyser)
+    {
+        // E.g. a geyser that reappeared after the refinery on it was destroyed.
+        if (geyserToBaseIndex.find(unit) == geyserToBaseIndex.end())
+        {
+            const int baseIndex = getClosestBaseIndex(unit->getPosition(), 320);
+            if (baseIndex >= 0)
+            {
+                geyserToBaseIndex.emplace(unit, baseIndex);
+                bases[baseIndex].geysers.push_back(unit);
+            }
+        }
+
+        return;
+    }
+
+    const bool isMyDepot = self != nullptr && unit->getPlayer() == self && unitType.isResourceDepot();
+    std::unordered_map<BWAPI::Unit, int>::iterator myDepotIter = myDepotToBaseIndex.find(unit);
+    if (isMyDepot)
+    {
+        if (myDepotIter == myDepotToBaseIndex.end())
+        {
+            // A resource depot belongs to a base if it is (roughly) where the base's depot should be.
+            const int baseIndex = getClosestBaseIndex(unit->getPosition(), 128);
+            myDepotToBaseIndex.emplace(unit, baseIndex);
+            if (baseIndex >= 0)
+            {
+                bases[baseIndex].myDepot = unit;
+            }
+        }
+
+        // E.g. it completed or it morphed into a lair, so the main depot may have changed.
+        isMainDepotDirty = true;
+    }
+    else if (myDepotIter != myDepotToBaseIndex.end())
+    {
+        // E.g. the hatchery morph was cancelled or it was mind controlled.
+        onUnitDestroy(Broodwar, unit);
+    }
+}
+
+void BaseRegistry::onUnitDestroy(BWAPI::Game& /*Broodwar*/, BWAPI::Unit unit)
+{
+    std::unordered_map<BWAPI::Unit, std::pair<int, int>>::iterator mineralIter = mineralToSlot.find(unit);
+    if (mineralIter != mineralToSlot.end())
+    {
+        // The mineral patch mined out. Swap it with the last mineral patch of the base so that
+        // removing it is O(1) (the order of the minerals doesn't need to be kept).
+        Base& base = bases[mineralIter->second.first];
+        const int slot = mineralIter->second.second;
+        const int lastSlot = (int) base.minerals.size() - 1;
+        if (slot != lastSlot)
+        {
+            base.minerals[slot] = base.minerals[lastSlot];
+            base.mineralToDepotDists[slot] = base.mineralToDepotDists[lastSlot];
+            mineralToSlot[base.minerals[slot]].second = slot;
+        }
+
+        base.minerals.pop_back();
+        base.mineralToDepotDists.pop_back();
+        mineralToSlot.erase(unit);
+        return;
+    }
+
+    std::unordered_map<BWAPI::Unit, int>::iterator myDepotIter = myDepotToBaseIndex.find(unit);
+    if (myDepotIter != myDepotToBaseIndex.end())
+    {
+        const int baseIndex = myDepotIter->second;
+        if (baseIndex >= 0 && bases[baseIndex].myDepot == unit)
+        {
+            bases[baseIndex].myDepot = nullptr;
+        }
+
+        myDepotToBaseIndex.erase(myDepotIter);
+        isMainDepotDirty = true;
+    }
+}
+
+int BaseRegistry::getBaseIndex(const BWAPI::Unit unit) const
+{
+    std::unordered_map<BWAPI::Unit, std::pair<int, int>>::const_iterator mineralIter = mineralToSlot.find(unit);
+    if (mineralIter != mineralToSlot.end())
+    {
+        return mineralIter->second.first;
+    }
+
+    std::unordered_map<BWAPI::Unit, int>::const_iterator geyserIter = geyserToBaseIndex.find(unit);
+    if (geyserIter != geyserToBaseIndex.end())
+    {
+        return geyserIter->second;
+    }
+
+    std::unordered_map<BWAPI::Unit, int>::const_iterator myDepotIter = myDepotToBaseIndex.find(unit);
+    if (myDepotIter != myDepotToBaseIndex.end())
+    {
+        return myDepotIter->second;
+    }
+
+    return -1;
+}
+
+int BaseRegistry::getMineralToDepotDist(const BWAPI::Unit mineral) const
+{
+    std::unordered_map<BWAPI::Unit, std::pair<int, int>>::const_iterator mineralIter = mineralToSlot.find(mineral);
+    if (mineralIter == mineralToSlot.end())
+    {
+        return std::numeric_limits<int>::max();
+    }
+
+    return bases[mineralIter->second.first].mineralToDepotDists[mineralIter->second.second];
+}
+
+BWAPI::Unit BaseRegistry::getFreeGeyser(const int baseIndex) const
+{
+    if (baseIndex < 0 || baseIndex >= (int) bases.size())
+    {
+        return nullptr;
+    }
+
+    for (const BWAPI::Unit geyser : bases[baseIndex].geysers)
+    {
+        if (geyser->exists() && geyser->getType() == BWAPI::UnitTypes::Resource_Vespene_Geyser)
+        {
+            return geyser;
+        }
+    }
+
+    return nullptr;
+}
+
+BWAPI::Unit BaseRegistry::getMainDepot()
+{
+    if (isMainDepotDirty || (mainDepot != nullptr && !mainDepot->exists()))
+    {
+        updateMainDepot();
+    }
+
+    return mainDepot;
+}
+
+int BaseRegistry::getMainBaseIndex()
+{
+    getMainDepot();
+    return mainBaseIndex;
+}
+
+int BaseRegistry::getClosestBaseIndex(const BWAPI::Position pos, const int maxDist) const
+{
+    int closestBaseIndex = -1;
+    int closestDist = maxDist;
+    for (int baseIndex = 0; baseIndex < (int) bases.size(); ++baseIndex)
+    {
+        const int dist = (int) pos.getDistance(bases[baseIndex].depotPos);
+        if (dist <= closestDist)
+        {
+            closestBaseIndex = baseIndex;
+            closestDist = dist;
+        }
+    }
+
+    return closestBaseIndex;
+}
+
+void BaseRegistry::updateMainDepot()
+{
+    isMainDepotDirty = false;
+    mainDepot = nullptr;
+    mainBaseIndex = -1;
+
+    int closestDist = std::numeric_limits<int>::max();
+    for (const auto& myDepotAndBaseIndex : myDepotToBaseIndex)
+    {
+        const BWAPI::Unit depot = myDepotAndBaseIndex.first;
+        if (depot->exists() && depot->isCompleted() && !depot->isLifted())
+        {
+            const int dist = depot->getDistance(mainDepotSearchPos);
+            if (dist < closestDist)
+            {
+                mainDepot = depot;
+                mainBaseIndex = myDepotAndBaseIndex.second;
+                closestDist = dist;
+            }
+        }
+    }
+
+    if (mainDepot != nullptr && mainBaseIndex < 0)
+    {
+        mainBaseIndex = getClosestBaseIndex(mainDepot->getPosition(), std::numeric_limits<int>::max());
+    }
+}
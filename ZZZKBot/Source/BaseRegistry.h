@@ -0,0 +1,113 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <BWAPI.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Registry of the base locations on the map, i.e. each group of mineral patches and geysers,
+// plus the tile where a resource depot would be placed to mine them. It is built once at the
+// start of the game from the static neutral units, then kept up-to-date from the unit events
+// (mineral patches mining out, resource depots being created/morphed/destroyed), so that
+// onFrame doesn't need to ask BWAPI for units in a radius just to find the resources of a base.
+class BaseRegistry
+{
+public:
+    struct Base
+    {
+        // Top-left tile of where a resource depot would be placed for this base.
+        BWAPI::TilePosition depotLoc = BWAPI::TilePositions::None;
+
+        // Centre of a resource depot placed at depotLoc.
+        BWAPI::Position depotPos = BWAPI::Positions::None;
+
+        bool isStartLocation = false;
+
+        // My resource depot that is on this base (if any).
+        BWAPI::Unit myDepot = nullptr;
+
+        // Mineral patches that have not mined out yet. mineralToDepotDists has the same size and
+        // holds the distance from each mineral patch to a resource depot placed at depotLoc
+        // (it is the same distance that BWAPI's Unit::getDistance() would return).
+        std::vector<BWAPI::Unit> minerals;
+        std::vector<int> mineralToDepotDists;
+
+        // Geysers (note: a refinery may have been built on them, in which case the geyser unit's
+        // type will be a refinery type).
+        std::vector<BWAPI::Unit> geysers;
+    };
+
+    // Rebuilds the registry for a new game.
+    void onStart(BWAPI::Game& Broodwar);
+
+    // Call these from the corresponding AI module callbacks.
+    void onUnitCreate(BWAPI::Game& Broodwar, BWAPI::Unit unit) { onUnitChanged(Broodwar, unit); }
+    void onUnitMorph(BWAPI::Game& Broodwar, BWAPI::Unit unit) { onUnitChanged(Broodwar, unit); }
+    void onUnitComplete(BWAPI::Game& Broodwar, BWAPI::Unit unit) { onUnitChanged(Broodwar, unit); }
+    void onUnitRenegade(BWAPI::Game& Broodwar, BWAPI::Unit unit) { onUnitChanged(Broodwar, unit); }
+    void onUnitDestroy(BWAPI::Game& Broodwar, BWAPI::Unit unit);
+
+    const std::vector<Base>& getBases() const { return bases; }
+
+    // Returns the index (into getBases()) of the base that the mineral patch, geyser or resource
+    // depot belongs to, or -1 if it doesn't belong to any base.
+    int getBaseIndex(const BWAPI::Unit unit) const;
+
+    // Returns the distance from the mineral patch to the resource depot of its base, or
+    // std::numeric_limits<int>::max() if it isn't a mineral patch that is in the registry.
+    int getMineralToDepotDist(const BWAPI::Unit mineral) const;
+
+    // Returns a geyser of the base that doesn't have a refinery on it (or nullptr).
+    BWAPI::Unit getFreeGeyser(const int baseIndex) const;
+
+    // My completed resource depot that is closest to my start location (i.e. what the rest of
+    // the code calls the main base), or nullptr if I don't have one. It is only recalculated
+    // when one of my resource depots changes.
+    BWAPI::Unit getMainDepot();
+
+    // Index of the base that the main depot belongs to (or the closest base to it, if it isn't
+    // on a base), or -1 if there is no main depot.
+    int getMainBaseIndex();
+
+private:
+    void onUnitChanged(BWAPI::Game& Broodwar, BWAPI::Unit unit);
+    int getClosestBaseIndex(const BWAPI::Position pos, const int maxDist) const;
+    void updateMainDepot();
+
+    std::vector<Base> bases;
+
+    // The value is the index of the base and the index of the mineral patch in Base::minerals.
+    std::unordered_map<BWAPI::Unit, std::pair<int, int>> mineralToSlot;
+
+    // The value is the index of the base.
+    std::unordered_map<BWAPI::Unit, int> geyserToBaseIndex;
+
+    // All of my resource depots (including ones that aren't on a base, e.g. macro hatcheries).
+    // The value is the index of the base (or -1).
+    std::unordered_map<BWAPI::Unit, int> myDepotToBaseIndex;
+
+    BWAPI::Player self = nullptr;
+    BWAPI::Position mainDepotSearchPos = BWAPI::Positions::Unknown;
+    BWAPI::Unit mainDepot = nullptr;
+    int mainBaseIndex = -1;
+    bool isMainDepotDirty = true;
+};
@@ -0,0 +1,525 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "DecisionCheck.h"
+#include "FrameTimeStats.h"
+#include "GameRecordReader.h"
+#include "GameRecordWriter.h"
+#include "KernelBenchmarks.h"
+#include "LearningFileGenerator.h"
+#include "LearningStartBenchmark.h"
+#include "MapSweep.h"
+#include "MockGame.h"
+#include "ModuleReplay.h"
+#include "Scenario.h"
+
+// The scenarios that are run if no file is given: battles that are much bigger than what recorded
+// games usually have.
+const char* const defaultScenarios = R"(
+scenario zerglings_vs_marines
+frames 1500
+player 0 self
+player 1 enemy
+units 200 Zerg_Zergling 0 1200 2000 240
+units 150 Terran_Marine 1 2400 2000 200
+order 0 attack
+order 1 hold
+
+scenario drones_vs_worker_rush
+frames 1500
+player 0 self
+player 1 enemy
+units 1 Zerg_Hatchery 0 2000 2000
+units 60 Zerg_Drone 0 2000 2120 120
+units 12 Terran_SCV 1 2700 2000 60
+order 0 hold
+order 1 attack
+
+scenario mutalisks_vs_turrets
+frames 1500
+player 0 self
+player 1 enemy
+units 40 Zerg_Mutalisk 0 800 800 96
+units 12 Terran_Missile_Turret 1 2400 2400 320
+units 1 Terran_Command_Center 1 2400 2400
+order 0 attack
+order 1 hold
+)";
+
+const char* getOption(int argc, const char* argv[], const char* name)
+{
+  for (int i = 1; i + 1 < argc; ++i)
+  {
+    if (std::strcmp(argv[i], name) == 0)
+    {
+      return argv[i + 1];
+    }
+  }
+
+  return nullptr;
+}
+
+void printFrameTimeStats(const char* stageName, const FrameTimeStats& stats)
+{
+  std::cout << "  " << std::left << std::setw(8) << stageName << std::right
+            << " p50 " << std::setw(6) << stats.getPercentile(0.5).count() << " us"
+            << ", p90 " << std::setw(6) << stats.getPercentile(0.9).count() << " us"
+            << ", p99 " << std::setw(6) << stats.getPercentile(0.99).count() << " us"
+            << ", max " << std::setw(6) << stats.getMax().count() << " us" << std::endl;
+}
+
+// Plays the scenario on the mock game, writing each frame to a game record, then reads the
+// record back, then plays the scenario through the bot itself (see ModuleReplay.h), so its combat
+// code picks targets among the scenario's units, once as in a live game and once with the combat
+// intent check enabled (so the BWAPI unit queries of the target selection run too), and reports
+// the frame time percentiles of each stage. The bot's commands aren't fed back into the mock
+// game, so its units keep following the scenario's orders.
+bool runScenario(const Scenario& scenario, const std::string& recordFilePath)
+{
+  MockGame game;
+  std::string error;
+  if (!game.start(scenario, error))
+  {
+    std::cout << scenario.name << ": " << error << std::endl;
+    return false;
+  }
+
+  GameRecordWriter writer;
+  if (!writer.open(recordFilePath, game.getMatchInfo()))
+  {
+    std::cout << scenario.name << ": can't write " << recordFilePath << std::endl;
+    return false;
+  }
+
+  FrameTimeStats gameStats;
+  FrameTimeStats encodeStats;
+  FrameTimeStats decodeStats;
+  std::size_t maxUnits = 0;
+  while (true)
+  {
+    const std::chrono::steady_clock::time_point stepStart = std::chrono::steady_clock::now();
+    if (!game.step())
+    {
+      break;
+    }
+    const std::chrono::steady_clock::time_point encodeStart = std::chrono::steady_clock::now();
+    writer.writeFrame(game.getFrame());
+    const std::chrono::steady_clock::time_point encodeEnd = std::chrono::steady_clock::now();
+    gameStats.add(std::chrono::duration_cast<std::chrono::microseconds>(encodeStart - stepStart));
+    encodeStats.add(std::chrono::duration_cast<std::chrono::microseconds>(encodeEnd - encodeStart));
+    maxUnits = std::max(maxUnits, game.getFrame().units.size());
+  }
+  writer.close();
+
+  GameRecordReader reader;
+  if (!reader.open(recordFilePath))
+  {
+    std::cout << scenario.name << ": can't read " << recordFilePath << std::endl;
+    return false;
+  }
+
+  GameRecord::Frame frame;
+  while (true)
+  {
+    const std::chrono::steady_clock::time_point decodeStart = std::chrono::steady_clock::now();
+    if (!reader.readFrame(frame))
+    {
+      break;
+    }
+    decodeStats.add(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - decodeStart));
+  }
+
+  ModuleReplay moduleReplay;
+  ModuleReplay checkedModuleReplay;
+  checkedModuleReplay.setCombatIntentCheckEnabled(true);
+  if (!moduleReplay.playScenario(scenario, error) || !checkedModuleReplay.playScenario(scenario, error))
+  {
+    std::cout << scenario.name << ": " << error << std::endl;
+    return false;
+  }
+
+  std::cout << scenario.name << ": " << gameStats.getNumFrames() << " frames, max units " << maxUnits
+            << ", record " << writer.getNumBytesWritten() << " bytes, units left:";
+  for (const Scenario::Player& player : scenario.players)
+  {
+    std::cout << " player " << player.id << " " << game.getNumUnits(player.id);
+  }
+  std::cout << std::endl;
+  printFrameTimeStats("game", gameStats);
+  printFrameTimeStats("encode", encodeStats);
+  printFrameTimeStats("decode", decodeStats);
+  std::cout << "  bot commands " << moduleReplay.getResult().numCommands << std::endl;
+  printFrameTimeStats("bot", moduleReplay.getResult().frameTimes);
+  printFrameTimeStats("checked", checkedModuleReplay.getResult().frameTimes);
+  return decodeStats.getNumFrames() == gameStats.getNumFrames() && !reader.isCorrupt();
+}
+
+// Runs the kernel benchmarks (see KernelBenchmarks.h) and prints the results, and writes them as
+// JSON if there is a path for that.
+bool runKernelBenchmarks(const int numSamples, const char* jsonFilePath)
+{
+  const std::vector<KernelBenchmarks::Result> results = KernelBenchmarks::runAll(numSamples);
+  for (const KernelBenchmarks::Result& result : results)
+  {
+    KernelBenchmarks::print(std::cout, result);
+  }
+
+  if (jsonFilePath != nullptr)
+  {
+    std::ofstream ofs(jsonFilePath);
+    KernelBenchmarks::writeJson(ofs, results);
+    if (!ofs)
+    {
+      std::cout << "Can't write " << jsonFilePath << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Checks the mineral assignment solver against a brute-force search (see KernelBenchmarks.h).
+bool runAssignmentCheck(const int numTrials)
+{
+  std::string error;
+  if (!KernelBenchmarks::checkAssignment(numTrials, error))
+  {
+    std::cout << "assignment check failed: " << error << std::endl;
+    return false;
+  }
+
+  std::cout << "assignment check: " << numTrials << " trials matched the brute-force search" << std::endl;
+  return true;
+}
+
+// Checks the decisions of the bot on the frames of the record (see DecisionCheck.h), and prints
+// the first divergence if there is one.
+bool runDecisionCheck(const char* recordFilePath, const char* learningFilePath)
+{
+  std::ifstream learningFile;
+  if (learningFilePath != nullptr)
+  {
+    learningFile.open(learningFilePath);
+    if (!learningFile)
+    {
+      std::cout << "Can't read " << learningFilePath << std::endl;
+      return false;
+    }
+  }
+
+  DecisionCheck decisionCheck;
+  DecisionCheck::Divergence divergence;
+  const bool isOk = decisionCheck.checkRecord(recordFilePath, learningFilePath != nullptr ? &learningFile : nullptr, divergence);
+  if (!isOk && divergence.decision.empty())
+  {
+    std::cout << "Can't read " << recordFilePath << std::endl;
+    return false;
+  }
+
+  std::cout << recordFilePath << ": " << decisionCheck.getNumFramesChecked() << " frames checked";
+  for (const std::pair<const std::string, int>& decisionToNumChecks : decisionCheck.getNumChecks())
+  {
+    std::cout << ", " << decisionToNumChecks.first << " " << decisionToNumChecks.second;
+  }
+  std::cout << std::endl;
+  if (learningFilePath == nullptr)
+  {
+    std::cout << "  strategy_selection not checked (no learning file)" << std::endl;
+  }
+
+  if (!isOk)
+  {
+    std::cout << divergence.decision << " diverged at frame " << divergence.frameCount << ":" << std::endl << divergence.context;
+  }
+
+  return isOk;
+}
+
+// Replays the records and a synthetic game on each other map that the bot knows (see MapSweep.h),
+// prints the results per map, and writes them as TSV if there is a path for that. Returns false if
+// a map is flagged.
+bool runMapSweep(const std::vector<std::string>& recordFilePaths, const char* p99LimitStr, const char* tsvFilePath, const char* baselineFilePath)
+{
+  MapSweep mapSweep;
+  if (p99LimitStr != nullptr)
+  {
+    mapSweep.p99Limit = std::chrono::microseconds(std::atoll(p99LimitStr));
+  }
+
+  std::string error;
+  if (!mapSweep.run(recordFilePaths, error))
+  {
+    std::cout << error << std::endl;
+    return false;
+  }
+
+  if (baselineFilePath != nullptr)
+  {
+    std::ifstream ifs(baselineFilePath);
+    std::vector<MapSweep::MapResult> baselineResults;
+    if (!MapSweep::readTsv(ifs, baselineResults))
+    {
+      std::cout << "Can't read " << baselineFilePath << std::endl;
+      return false;
+    }
+
+    mapSweep.compare(baselineResults);
+  }
+
+  mapSweep.print(std::cout);
+  if (tsvFilePath != nullptr)
+  {
+    std::ofstream ofs(tsvFilePath);
+    MapSweep::writeTsv(ofs, mapSweep.getResults());
+    if (!ofs)
+    {
+      std::cout << "Can't write " << tsvFilePath << std::endl;
+      return false;
+    }
+  }
+
+  return std::none_of(mapSweep.getResults().begin(), mapSweep.getResults().end(), [](const MapSweep::MapResult& result) { return result.isFlagged; });
+}
+
+// Plays each record through the bot itself (see ModuleReplay.h), and reports the frame time
+// percentiles, the number of commands the bot issued and how many frames of the second half of
+// the game allocated. Fails if any of the frames of a full cycle of the bot's periodic work (which
+// runs at most every 24 frames) from the middle of the game allocated, i.e. once the bot's
+// containers and arenas have warmed up a mid-game frame must not touch the heap.
+bool runModuleReplay(const std::vector<std::string>& recordFilePaths)
+{
+  const int zeroAllocationFrames = 24;
+  bool isOk = true;
+  for (const std::string& recordFilePath : recordFilePaths)
+  {
+    ModuleReplay moduleReplay;
+    std::string error;
+    if (!moduleReplay.playRecord(recordFilePath, error))
+    {
+      std::cout << error << std::endl;
+      isOk = false;
+      continue;
+    }
+
+    const ModuleReplay::Result& result = moduleReplay.getResult();
+    std::cout << recordFilePath << ": " << result.numFrames << " frames, commands " << result.numCommands << std::endl;
+    printFrameTimeStats("frame", result.frameTimes);
+
+    const int midFrame = result.numFrames / 2;
+    int numAllocatingFrames = 0;
+    std::uint64_t maxAllocationsPerFrame = 0;
+    for (int frame = midFrame; frame < result.numFrames; ++frame)
+    {
+      if (result.numAllocationsByFrame[frame] > 0)
+      {
+        ++numAllocatingFrames;
+      }
+      maxAllocationsPerFrame = std::max(maxAllocationsPerFrame, result.numAllocationsByFrame[frame]);
+    }
+    std::cout << "  second half " << result.numFrames - midFrame << " frames, of which allocated: " << numAllocatingFrames
+              << ", max allocations in a frame: " << maxAllocationsPerFrame << std::endl;
+
+    for (int frame = midFrame; frame < std::min(midFrame + zeroAllocationFrames, result.numFrames); ++frame)
+    {
+      if (result.numAllocationsByFrame[frame] > 0)
+      {
+        std::cout << "  frame " << frame << " allocated " << result.numAllocationsByFrame[frame] << " times (a warmed-up mid-game frame must not allocate)" << std::endl;
+        isOk = false;
+      }
+    }
+  }
+
+  return isOk;
+}
+
+// The config of the synthetic learning files from the options.
+LearningFileGenerator::Config getLearningFileConfig(int argc, const char* argv[])
+{
+  LearningFileGenerator::Config config;
+  if (const char* numGamesStr = getOption(argc, argv, "--games"))
+  {
+    config.numGames = std::max(0, std::atoi(numGamesStr));
+  }
+  if (const char* numMapsStr = getOption(argc, argv, "--maps"))
+  {
+    config.numMaps = std::max(1, std::atoi(numMapsStr));
+  }
+  if (const char* winRatioStr = getOption(argc, argv, "--win-ratio"))
+  {
+    config.winRatio = std::atof(winRatioStr);
+  }
+  if (const char* winRatioSpreadStr = getOption(argc, argv, "--win-ratio-spread"))
+  {
+    config.winRatioSpread = std::atof(winRatioSpreadStr);
+  }
+  if (const char* enemyRaceStr = getOption(argc, argv, "--enemy-race"))
+  {
+    for (const BWAPI::Race race : { BWAPI::Races::Zerg, BWAPI::Races::Terran, BWAPI::Races::Protoss, BWAPI::Races::Random, BWAPI::Races::Unknown })
+    {
+      if (race.getName() == enemyRaceStr)
+      {
+        config.enemyRace = race;
+      }
+    }
+  }
+  if (const char* seedStr = getOption(argc, argv, "--seed"))
+  {
+    config.seed = (unsigned int) std::atoi(seedStr);
+  }
+
+  return config;
+}
+
+// Times the learning path at the start of a game (see LearningStartBenchmark.h) for history
+// lengths of 100 games up to the given number, and prints how it scales.
+bool runLearningStartBenchmark(const int maxNumGames, const int numSamples, const LearningFileGenerator::Config& config, const char* folderPath)
+{
+  std::vector<int> historyLengths;
+  for (int numGames = 100; numGames <= maxNumGames; numGames *= 10)
+  {
+    historyLengths.push_back(numGames);
+    if (numGames * 3 <= maxNumGames)
+    {
+      historyLengths.push_back(numGames * 3);
+    }
+  }
+
+  std::vector<LearningStartBenchmark::Result> results;
+  std::string error;
+  if (!LearningStartBenchmark::run(config, historyLengths, numSamples, folderPath != nullptr ? folderPath : ".", results, error))
+  {
+    std::cout << error << std::endl;
+    return false;
+  }
+
+  LearningStartBenchmark::print(std::cout, results);
+  return true;
+}
+
+// Command line options:
+// --scenarios <file>: the scenarios to run (see Scenario.h), instead of the default ones.
+// --record <prefix>: where to write the game record of each scenario (<prefix><name>.zzkr).
+// --kernels <samples>: run the kernel benchmarks (with about this many samples each) instead.
+// --json <file>: where to write the results of the kernel benchmarks as JSON.
+// --check-assignment <trials>: check the mineral assignment solver against a brute-force search
+// on this many random inputs instead.
+// --check <record>: check the decisions of the bot on the frames of the record instead.
+// --learning <file>: the learning file (i.e. the one the bot keeps for the enemy) that the check
+// uses for the strategy selection.
+// --replay <record>...: play the records through the bot itself instead.
+// --sweep [<record>...]: sweep the maps with the records (see MapSweep.h) instead.
+// --p99-limit <us>: the p99 frame time over which the sweep flags a map (55000 by default).
+// --tsv <file>: where to write the results of the sweep as TSV.
+// --baseline <file>: the TSV of an earlier sweep to compare with.
+// --make-learning <file>: write a synthetic learning file (see LearningFileGenerator.h) instead.
+// --learning-start <games>: time the learning path at the start of a game on synthetic learning
+// files with up to this many games instead.
+// --games, --maps, --win-ratio, --win-ratio-spread, --enemy-race, --seed: the config of the
+// synthetic learning files.
+// --samples <n>: how many times the learning path is timed per history length (20 by default).
+// --folder <path>: where the learning path's files go (the current folder by default).
+int main(int argc, const char* argv[])
+{
+  if (const char* learningFilePath = getOption(argc, argv, "--make-learning"))
+  {
+    std::ofstream ofs(learningFilePath, std::ios::binary);
+    LearningFileGenerator::write(ofs, getLearningFileConfig(argc, argv));
+    if (!ofs)
+    {
+      std::cout << "Can't write " << learningFilePath << std::endl;
+      return 1;
+    }
+
+    return 0;
+  }
+
+  if (const char* maxNumGamesStr = getOption(argc, argv, "--learning-start"))
+  {
+    const char* numSamplesStr = getOption(argc, argv, "--samples");
+    return runLearningStartBenchmark(
+      std::atoi(maxNumGamesStr),
+      numSamplesStr != nullptr ? std::max(1, std::atoi(numSamplesStr)) : 20,
+      getLearningFileConfig(argc, argv),
+      getOption(argc, argv, "--folder")) ? 0 : 1;
+  }
+
+  for (int i = 1; i < argc; ++i)
+  {
+    if (std::strcmp(argv[i], "--replay") == 0)
+    {
+      std::vector<std::string> recordFilePaths;
+      for (int j = i + 1; j < argc && std::strncmp(argv[j], "--", 2) != 0; ++j)
+      {
+        recordFilePaths.push_back(argv[j]);
+      }
+
+      return runModuleReplay(recordFilePaths) ? 0 : 1;
+    }
+
+    if (std::strcmp(argv[i], "--sweep") == 0)
+    {
+      std::vector<std::string> recordFilePaths;
+      for (int j = i + 1; j < argc && std::strncmp(argv[j], "--", 2) != 0; ++j)
+      {
+        recordFilePaths.push_back(argv[j]);
+      }
+
+      return runMapSweep(recordFilePaths, getOption(argc, argv, "--p99-limit"), getOption(argc, argv, "--tsv"), getOption(argc, argv, "--baseline")) ? 0 : 1;
+    }
+  }
+
+  if (const char* recordFilePath = getOption(argc, argv, "--check"))
+  {
+    return runDecisionCheck(recordFilePath, getOption(argc, argv, "--learning")) ? 0 : 1;
+  }
+
+  if (const char* numTrialsStr = getOption(argc, argv, "--check-assignment"))
+  {
+    return runAssignmentCheck(std::max(1, std::atoi(numTrialsStr))) ? 0 : 1;
+  }
+
+  if (const char* numSamplesStr = getOption(argc, argv, "--kernels"))
+  {
+    return runKernelBenchmarks(std::max(1, std::atoi(numSamplesStr)), getOption(argc, argv, "--json")) ? 0 : 1;
+  }
+
+  std::vector<Scenario> scenarios;
+  std::string error;
+  if (const char* scenariosFilePath = getOption(argc, argv, "--scenarios"))
+  {
+    std::ifstream ifs(scenariosFilePath);
+    if (!ifs)
+    {
+      std::cout << "Can't read " << scenariosFilePath << std::endl;
+      return 1;
+    }
+
+    if (!Scenario::parse(ifs, scenarios, error))
+    {
+      std::cout << scenariosFilePath << ": " << error << std::endl;
+      return 1;
+    }
+  }
+  else
+  {
+    std::istringstream iss(defaultScenarios);
+    Scenario::parse(iss, scenarios, error);
+  }
+
+  const char* recordPathPrefix = getOption(argc, argv, "--record");
+  bool isOk = true;
+  for (const Scenario& scenario : scenarios)
+  {
+    isOk = runScenario(scenario, std::string(recordPathPrefix != nullptr ? recordPathPrefix : "ZZZKBot_bench_") + scenario.name + ".zzkr") && isOk;
+  }
+
+  return isOk ? 0 : 1;
+}
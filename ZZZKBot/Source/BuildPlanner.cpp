@@ -0,0 +1,439 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "BuildPlanner.h"
+#include <algorithm>
+#include <limits>
+
+// How far (in tiles) to search from the requested location, same as the default for
+// BWAPI's Game::getBuildLocation().
+static const int maxSearchRangeTiles = 64;
+
+// Creep spreads/recedes gradually, so keep refreshing the creep around a creep producer for this
+// many frames after it was created/completed/destroyed, at most once per refresh period.
+static const int creepChangeDurationFrames = 3 * 60 * 24;
+static const int creepRefreshPeriodFrames = 24;
+static const int creepRadiusTiles = 12;
+
+// Plans that haven't been requested for this many frames are dropped.
+static const int planExpiryFrames = 2 * 24;
+
+// How long a rejected location is avoided.
+static const int rejectedLocDurationFrames = 4 * 24;
+
+static bool isFootprintUnit(const BWAPI::UnitType unitType)
+{
+    return unitType.isBuilding() || unitType.isMineralField() || unitType == BWAPI::UnitTypes::Resource_Vespene_Geyser;
+}
+
+void BuildPlanner::onStart(BWAPI::Game& Broodwar, const BaseRegistry& baseRegistry)
+{
+    *this = BuildPlanner();
+
+    const int mapWidth = Broodwar->mapWidth();
+    const int mapHeight = Broodwar->mapHeight();
+    buildable.reset(mapWidth, mapHeight);
+    creep.reset(mapWidth, mapHeight);
+    occupied.reset(mapWidth, mapHeight);
+    keepClear.reset(mapWidth, mapHeight);
+    depotLocs.reset(mapWidth, mapHeight);
+    nearResources.reset(mapWidth, mapHeight);
+    reserved.reset(mapWidth, mapHeight);
+    groundHeight.assign((size_t) mapWidth * mapHeight, 0);
+
+    for (int y = 0; y < mapHeight; ++y)
+    {
+        for (int x = 0; x < mapWidth; ++x)
+        {
+            buildable.set(x, y, Broodwar->isBuildable(x, y));
+            creep.set(x, y, Broodwar->hasCreep(x, y));
+            groundHeight[(size_t) y * mapWidth + x] = Broodwar->getGroundHeight(x, y);
+        }
+    }
+
+    // Resources and other neutral buildings that exist from the start of the game.
+    for (const BWAPI::Unit u : Broodwar->getStaticNeutralUnits())
+    {
+        const BWAPI::UnitType unitType = u->getInitialType();
+        if (isFootprintUnit(unitType))
+        {
+            const BWAPI::TilePosition loc = u->getInitialTilePosition();
+            occupied.setRect(loc.x, loc.y, unitType.tileWidth(), unitType.tileHeight());
+            footprints[u] = Footprint{ loc, unitType };
+
+            if (unitType.isResourceContainer())
+            {
+                // Resource depots can't be built within 3 tiles of a resource.
+                nearResources.setRect(loc.x - 3, loc.y - 3, unitType.tileWidth() + 6, unitType.tileHeight() + 6);
+            }
+        }
+    }
+
+    // Keep the paths between resources and their resource depot clear, and don't build anything
+    // other than a resource depot on any base's resource depot location.
+    const BWAPI::UnitType depotType = BWAPI::UnitTypes::Zerg_Hatchery;
+    for (const BaseRegistry::Base& base : baseRegistry.getBases())
+    {
+        depotLocs.setRect(base.depotLoc.x, base.depotLoc.y, depotType.tileWidth(), depotType.tileHeight());
+
+        std::vector<BWAPI::Unit> resources = base.minerals;
+        resources.insert(resources.end(), base.geysers.begin(), base.geysers.end());
+        for (const BWAPI::Unit resource : resources)
+        {
+            const BWAPI::Position from = resource->getInitialPosition();
+            const BWAPI::Position to = base.depotPos;
+            const int numSteps = std::max(1, (int) from.getDistance(to) / 16);
+            for (int step = 0; step <= numSteps; ++step)
+            {
+                const BWAPI::Position pos = from + (to - from) * step / numSteps;
+                const BWAPI::TilePosition tile(pos.x / BWAPI::TILEPOSITION_SCALE, pos.y / BWAPI::TILEPOSITION_SCALE);
+
+                // The path ends at the centre of the depot, which mustn't stop the depot itself
+                // being placed.
+                if (tile.x < base.depotLoc.x || tile.x >= base.depotLoc.x + depotType.tileWidth() ||
+                    tile.y < base.depotLoc.y || tile.y >= base.depotLoc.y + depotType.tileHeight())
+                {
+                    keepClear.set(tile.x, tile.y);
+                }
+            }
+        }
+    }
+
+    // My starting buildings might not get a create event.
+    if (Broodwar->self() != nullptr)
+    {
+        for (const BWAPI::Unit u : Broodwar->self()->getUnits())
+        {
+            onUnitChanged(Broodwar, u);
+        }
+    }
+}
+
+void BuildPlanner::onUnitChanged(BWAPI::Game& Broodwar, BWAPI::Unit unit)
+{
+    if (unit == nullptr)
+    {
+        return;
+    }
+
+    const BWAPI::UnitType unitType = unit->getType();
+    const bool isOccupying = isFootprintUnit(unitType) && !unit->isLifted() && !unit->isFlying();
+    const BWAPI::TilePosition loc = unit->getTilePosition();
+
+    std::unordered_map<BWAPI::Unit, Footprint>::iterator footprintIter = footprints.find(unit);
+    if (footprintIter != footprints.end())
+    {
+        const Footprint& footprint = footprintIter->second;
+        if (isOccupying && footprint.loc == loc && footprint.unitType.tileWidth() == unitType.tileWidth() && footprint.unitType.tileHeight() == unitType.tileHeight())
+        {
+            // Nothing changed (e.g. a hatchery morphed into a lair).
+            if (unitType.producesCreep() && !footprint.unitType.producesCreep())
+            {
+                addCreepRegion(loc, Broodwar->getFrameCount());
+            }
+
+            footprintIter->second.unitType = unitType;
+            return;
+        }
+
+        onUnitDestroy(Broodwar, unit);
+    }
+
+    if (!isOccupying)
+    {
+        return;
+    }
+
+    occupied.setRect(loc.x, loc.y, unitType.tileWidth(), unitType.tileHeight());
+    footprints[unit] = Footprint{ loc, unitType };
+
+    if (unitType.producesCreep())
+    {
+        addCreepRegion(loc, Broodwar->getFrameCount());
+    }
+
+    // The building that was planned here has been started.
+    plans.erase(
+        std::remove_if(
+            plans.begin(),
+            plans.end(),
+            [&unitType, &loc](const Plan& plan)
+            {
+                return plan.buildingType == unitType && plan.loc == loc;
+            }),
+        plans.end());
+}
+
+void BuildPlanner::onUnitDestroy(BWAPI::Game& Broodwar, BWAPI::Unit unit)
+{
+    std::unordered_map<BWAPI::Unit, Footprint>::iterator footprintIter = footprints.find(unit);
+    if (footprintIter == footprints.end())
+    {
+        return;
+    }
+
+    const Footprint footprint = footprintIter->second;
+    footprints.erase(footprintIter);
+    occupied.setRect(footprint.loc.x, footprint.loc.y, footprint.unitType.tileWidth(), footprint.unitType.tileHeight(), false);
+
+    if (footprint.unitType.producesCreep())
+    {
+        addCreepRegion(footprint.loc, Broodwar->getFrameCount());
+    }
+}
+
+void BuildPlanner::addCreepRegion(const BWAPI::TilePosition centre, const int frameCount)
+{
+    CreepRegion region;
+    region.left = std::max(0, centre.x - creepRadiusTiles);
+    region.top = std::max(0, centre.y - creepRadiusTiles);
+    region.right = std::min(creep.getWidth() - 1, centre.x + creepRadiusTiles);
+    region.bottom = std::min(creep.getHeight() - 1, centre.y + creepRadiusTiles);
+    region.refreshUntilFrame = frameCount + creepChangeDurationFrames;
+    region.lastRefreshedFrame = std::numeric_limits<int>::min() / 2;
+    creepRegions.push_back(region);
+}
+
+void BuildPlanner::refreshCreep(BWAPI::Game& Broodwar, const CreepRegion& region)
+{
+    for (int y = region.top; y <= region.bottom; ++y)
+    {
+        for (int x = region.left; x <= region.right; ++x)
+        {
+            creep.set(x, y, Broodwar->hasCreep(x, y));
+        }
+    }
+}
+
+void BuildPlanner::request(BWAPI::Game& Broodwar, const BWAPI::UnitType buildingType, const BWAPI::TilePosition nearLoc, const TileBitmap& blockedByUnits)
+{
+    const int frameCount = Broodwar->getFrameCount();
+    for (Plan& plan : plans)
+    {
+        if (plan.buildingType == buildingType)
+        {
+            plan.nearLoc = nearLoc;
+            plan.lastRequestedFrame = frameCount;
+            return;
+        }
+    }
+
+    // Place a new request straight away (around the footprints that are already reserved) so
+    // that the caller can start building it this frame.
+    Plan plan;
+    plan.buildingType = buildingType;
+    plan.nearLoc = nearLoc;
+    plan.lastRequestedFrame = frameCount;
+    plan.loc = findLoc(Broodwar, buildingType, nearLoc, blockedByUnits);
+    if (plan.loc != BWAPI::TilePositions::None)
+    {
+        reserved.setRect(plan.loc.x, plan.loc.y, buildingType.tileWidth(), buildingType.tileHeight());
+    }
+
+    plans.push_back(plan);
+}
+
+void BuildPlanner::reject(const BWAPI::UnitType buildingType, const int frameCount)
+{
+    for (Plan& plan : plans)
+    {
+        if (plan.buildingType == buildingType && plan.loc != BWAPI::TilePositions::None)
+        {
+            rejectedLocs.push_back(RejectedLoc{ buildingType, plan.loc, frameCount + rejectedLocDurationFrames });
+            plan.loc = BWAPI::TilePositions::None;
+        }
+    }
+}
+
+void BuildPlanner::planPending(BWAPI::Game& Broodwar, const TileBitmap& blockedByUnits)
+{
+    const int frameCount = Broodwar->getFrameCount();
+
+    for (std::vector<CreepRegion>::iterator regionIter = creepRegions.begin(); regionIter != creepRegions.end(); )
+    {
+        if (frameCount >= regionIter->lastRefreshedFrame + creepRefreshPeriodFrames)
+        {
+            refreshCreep(Broodwar, *regionIter);
+            regionIter->lastRefreshedFrame = frameCount;
+        }
+
+        if (frameCount > regionIter->refreshUntilFrame)
+        {
+            regionIter = creepRegions.erase(regionIter);
+            continue;
+        }
+
+        ++regionIter;
+    }
+
+    rejectedLocs.erase(
+        std::remove_if(
+            rejectedLocs.begin(),
+            rejectedLocs.end(),
+            [&frameCount](const RejectedLoc& rejectedLoc)
+            {
+                return frameCount > rejectedLoc.untilFrame;
+            }),
+        rejectedLocs.end());
+
+    plans.erase(
+        std::remove_if(
+            plans.begin(),
+            plans.end(),
+            [&frameCount](const Plan& plan)
+            {
+                return frameCount > plan.lastRequestedFrame + planExpiryFrames;
+            }),
+        plans.end());
+
+    // Re-place every plan in priority order, keeping its location if it is still valid, and
+    // reserving each footprint before placing the next so that they can't collide.
+    reserved.clear();
+    for (Plan& plan : plans)
+    {
+        if (plan.loc == BWAPI::TilePositions::None ||
+            !isPlaceable(plan.buildingType, plan.loc) ||
+            !isOnSameGround(Broodwar, plan.buildingType, plan.nearLoc, plan.loc))
+        {
+            plan.loc = findLoc(Broodwar, plan.buildingType, plan.nearLoc, blockedByUnits);
+        }
+
+        if (plan.loc != BWAPI::TilePositions::None)
+        {
+            reserved.setRect(plan.loc.x, plan.loc.y, plan.buildingType.tileWidth(), plan.buildingType.tileHeight());
+        }
+    }
+}
+
+BWAPI::TilePosition BuildPlanner::getPlannedLoc(const BWAPI::UnitType buildingType) const
+{
+    for (const Plan& plan : plans)
+    {
+        if (plan.buildingType == buildingType)
+        {
+            return plan.loc;
+        }
+    }
+
+    return BWAPI::TilePositions::None;
+}
+
+bool BuildPlanner::isPlaceable(const BWAPI::UnitType buildingType, const BWAPI::TilePosition loc) const
+{
+    const int w = buildingType.tileWidth();
+    const int h = buildingType.tileHeight();
+
+    for (const RejectedLoc& rejectedLoc : rejectedLocs)
+    {
+        if (rejectedLoc.buildingType == buildingType && rejectedLoc.loc == loc)
+        {
+            return false;
+        }
+    }
+
+    for (int y = loc.y; y < loc.y + h; ++y)
+    {
+        const std::uint64_t mask = (std::uint64_t(1) << w) - 1;
+        if (buildable.getRowBits(loc.x, y, w) != mask ||
+            (occupied.getRowBits(loc.x, y, w) | reserved.getRowBits(loc.x, y, w) | keepClear.getRowBits(loc.x, y, w)) != 0 ||
+            (!buildingType.isResourceDepot() && depotLocs.getRowBits(loc.x, y, w) != 0) ||
+            (buildingType.requiresCreep() && creep.getRowBits(loc.x, y, w) != mask) ||
+            (buildingType.isResourceDepot() && nearResources.getRowBits(loc.x, y, w) != 0))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool BuildPlanner::isOnSameGround(BWAPI::Game& Broodwar, const BWAPI::UnitType buildingType, const BWAPI::TilePosition nearLoc, const BWAPI::TilePosition loc) const
+{
+    if (!buildable.isValid(nearLoc.x, nearLoc.y))
+    {
+        return false;
+    }
+
+    const int mapWidth = buildable.getWidth();
+    const int nearGroundHeight = groundHeight[(size_t) nearLoc.y * mapWidth + nearLoc.x];
+    for (int y = loc.y; y < loc.y + buildingType.tileHeight(); ++y)
+    {
+        for (int x = loc.x; x < loc.x + buildingType.tileWidth(); ++x)
+        {
+            if (!buildable.isValid(x, y) || groundHeight[(size_t) y * mapWidth + x] != nearGroundHeight)
+            {
+                return false;
+            }
+        }
+    }
+
+    // Check the centre of the footprint is reachable (e.g. not on an island, or on high ground
+    // that is only reachable from the other side of the map).
+    const BWAPI::Position nearPos(nearLoc.x * BWAPI::TILEPOSITION_SCALE + BWAPI::TILEPOSITION_SCALE / 2, nearLoc.y * BWAPI::TILEPOSITION_SCALE + BWAPI::TILEPOSITION_SCALE / 2);
+    const BWAPI::Position pos(
+        loc.x * BWAPI::TILEPOSITION_SCALE + buildingType.tileWidth() * BWAPI::TILEPOSITION_SCALE / 2,
+        loc.y * BWAPI::TILEPOSITION_SCALE + buildingType.tileHeight() * BWAPI::TILEPOSITION_SCALE / 2);
+    return Broodwar->hasPath(nearPos, pos);
+}
+
+BWAPI::TilePosition BuildPlanner::findLoc(BWAPI::Game& Broodwar, const BWAPI::UnitType buildingType, const BWAPI::TilePosition nearLoc, const TileBitmap& blockedByUnits) const
+{
+    if (nearLoc == BWAPI::TilePositions::None || nearLoc == BWAPI::TilePositions::Unknown || nearLoc == BWAPI::TilePositions::Invalid)
+    {
+        return BWAPI::TilePositions::None;
+    }
+
+    // Search rings of increasing size around nearLoc, picking the closest placeable location in
+    // the first ring that has one.
+    for (int range = 0; range <= maxSearchRangeTiles; ++range)
+    {
+        BWAPI::TilePosition bestLoc = BWAPI::TilePositions::None;
+        int bestDistSq = std::numeric_limits<int>::max();
+        for (int dy = -range; dy <= range; ++dy)
+        {
+            const bool isEdgeRow = dy == -range || dy == range;
+            for (int dx = -range; dx <= range; dx += (isEdgeRow ? 1 : 2 * range))
+            {
+                const BWAPI::TilePosition loc(nearLoc.x + dx, nearLoc.y + dy);
+                const int distSq = dx * dx + dy * dy;
+                if (distSq < bestDistSq &&
+                    isPlaceable(buildingType, loc) &&
+                    !blockedByUnits.isRectAnySet(loc.x, loc.y, buildingType.tileWidth(), buildingType.tileHeight()) &&
+                    isOnSameGround(Broodwar, buildingType, nearLoc, loc))
+                {
+                    bestLoc = loc;
+                    bestDistSq = distSq;
+                }
+
+                if (range == 0)
+                {
+                    break;
+                }
+            }
+        }
+
+        if (bestLoc != BWAPI::TilePositions::None)
+        {
+            return bestLoc;
+        }
+    }
+
+    return BWAPI::TilePositions::None;
+}
@@ -0,0 +1,137 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <BWAPI.h>
+#include <unordered_map>
+#include <vector>
+
+#include "BaseRegistry.h"
+#include "TileBitmap.h"
+
+// Chooses build locations for buildings. It keeps bitmaps of which tiles are buildable, have
+// creep or are occupied by a building/resource (updated from the unit events rather than
+// searched for every time). A building is placed when it is first requested, and all the
+// planned buildings are re-placed in one pass at the start of each frame, reserving the
+// footprint of each one so that two buildings are never planned on top of each other. A planned location is kept (and
+// re-validated against the bitmaps each frame) until the building appears or it stops being
+// requested, so there is no repeated search of the map for the same building. Like
+// Game::getBuildLocation(), a location is only chosen if it is on the same ground height as the
+// requested location and can be reached from it by ground.
+class BuildPlanner
+{
+public:
+    void onStart(BWAPI::Game& Broodwar, const BaseRegistry& baseRegistry);
+
+    // Call these from the corresponding AI module callbacks.
+    void onUnitDiscover(BWAPI::Game& Broodwar, BWAPI::Unit unit) { onUnitChanged(Broodwar, unit); }
+    void onUnitShow(BWAPI::Game& Broodwar, BWAPI::Unit unit) { onUnitChanged(Broodwar, unit); }
+    void onUnitCreate(BWAPI::Game& Broodwar, BWAPI::Unit unit) { onUnitChanged(Broodwar, unit); }
+    void onUnitMorph(BWAPI::Game& Broodwar, BWAPI::Unit unit) { onUnitChanged(Broodwar, unit); }
+    void onUnitComplete(BWAPI::Game& Broodwar, BWAPI::Unit unit) { onUnitChanged(Broodwar, unit); }
+    void onUnitRenegade(BWAPI::Game& Broodwar, BWAPI::Unit unit) { onUnitChanged(Broodwar, unit); }
+    void onUnitDestroy(BWAPI::Game& Broodwar, BWAPI::Unit unit);
+
+    // Asks for a location for a building of the type near nearLoc. The first request is placed
+    // immediately and after that the location is kept up-to-date by planPending(), so the caller
+    // should keep requesting it every frame for as long as it still wants to make the building.
+    // Only one building of each type is planned at a time.
+    void request(BWAPI::Game& Broodwar, const BWAPI::UnitType buildingType, const BWAPI::TilePosition nearLoc, const TileBitmap& blockedByUnits);
+
+    // Tells the planner that the planned location for the type can't be used (e.g. a unit is in
+    // the way), so it is avoided for a while and a new location is planned.
+    void reject(const BWAPI::UnitType buildingType, const int frameCount);
+
+    // Places all the pending requests in one pass (in the order in which they were first
+    // requested) and refreshes the parts of the creep bitmap that may be changing. New locations
+    // aren't chosen on tiles set in blockedByUnits (units move, so an existing planned location
+    // isn't dropped because of them - canBuild() and reject() deal with that).
+    void planPending(BWAPI::Game& Broodwar, const TileBitmap& blockedByUnits);
+
+    // Returns the planned location for the type, or BWAPI::TilePositions::None if there isn't
+    // one (yet).
+    BWAPI::TilePosition getPlannedLoc(const BWAPI::UnitType buildingType) const;
+
+    const TileBitmap& getBuildable() const { return buildable; }
+    const TileBitmap& getCreep() const { return creep; }
+    const TileBitmap& getOccupied() const { return occupied; }
+
+private:
+    struct Plan
+    {
+        BWAPI::UnitType buildingType;
+        BWAPI::TilePosition nearLoc = BWAPI::TilePositions::None;
+        BWAPI::TilePosition loc = BWAPI::TilePositions::None;
+        int lastRequestedFrame = 0;
+    };
+
+    struct Footprint
+    {
+        BWAPI::TilePosition loc;
+        BWAPI::UnitType unitType;
+    };
+
+    struct CreepRegion
+    {
+        int left;
+        int top;
+        int right;
+        int bottom;
+        int refreshUntilFrame;
+        int lastRefreshedFrame;
+    };
+
+    struct RejectedLoc
+    {
+        BWAPI::UnitType buildingType;
+        BWAPI::TilePosition loc;
+        int untilFrame;
+    };
+
+    void onUnitChanged(BWAPI::Game& Broodwar, BWAPI::Unit unit);
+    void addCreepRegion(const BWAPI::TilePosition centre, const int frameCount);
+    void refreshCreep(BWAPI::Game& Broodwar, const CreepRegion& region);
+    bool isPlaceable(const BWAPI::UnitType buildingType, const BWAPI::TilePosition loc) const;
+    bool isOnSameGround(BWAPI::Game& Broodwar, const BWAPI::UnitType buildingType, const BWAPI::TilePosition nearLoc, const BWAPI::TilePosition loc) const;
+    BWAPI::TilePosition findLoc(BWAPI::Game& Broodwar, const BWAPI::UnitType buildingType, const BWAPI::TilePosition nearLoc, const TileBitmap& blockedByUnits) const;
+
+    // Static: tiles that are buildable terrain.
+    TileBitmap buildable;
+    // Tiles that have creep (only kept up-to-date around creep producers that changed recently).
+    TileBitmap creep;
+    // Tiles covered by a building (of any player) or a resource.
+    TileBitmap occupied;
+    // Tiles between resources and where their resource depot goes, so that buildings don't block
+    // mining.
+    TileBitmap keepClear;
+    // The resource depot locations of all bases, which only resource depots may be built on.
+    TileBitmap depotLocs;
+    // Tiles that are too close to a resource for a resource depot to be built on them.
+    TileBitmap nearResources;
+    // Footprints of the buildings planned by the last planPending().
+    TileBitmap reserved;
+    // Static: the ground height of each tile (row by row).
+    std::vector<int> groundHeight;
+
+    std::vector<Plan> plans;
+    std::vector<CreepRegion> creepRegions;
+    std::vector<RejectedLoc> rejectedLocs;
+    std::unordered_map<BWAPI::Unit, Footprint> footprints;
+};
@@ -0,0 +1,60 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "CombatIntents.h"
+#include <algorithm>
+
+bool CombatIntent::operator==(const CombatIntent& other) const
+{
+    return
+        unit == other.unit &&
+        inRangeSelfThreatTarget == other.inRangeSelfThreatTarget &&
+        selfThreatTarget == other.selfThreatTarget &&
+        inRangeWorkerTarget == other.inRangeWorkerTarget &&
+        defenceTarget == other.defenceTarget &&
+        closestEnemyUnliftedBuilding == other.closestEnemyUnliftedBuilding &&
+        workerNearBuildingTarget == other.workerNearBuildingTarget &&
+        inRangeTacticalTarget == other.inRangeTacticalTarget &&
+        tacticalNearBuildingTarget == other.tacticalNearBuildingTarget &&
+        nonWorkerNearBuildingTarget == other.nonWorkerNearBuildingTarget;
+}
+
+void CombatIntents::reset(const std::vector<BWAPI::Unit>& units)
+{
+    std::fill(idToIndex.begin(), idToIndex.end(), -1);
+    intents.assign(units.size(), CombatIntent());
+    for (int i = 0; i < (int) units.size(); ++i)
+    {
+        const int id = units[i]->getID();
+        if (id >= (int) idToIndex.size())
+        {
+            idToIndex.resize(id + 1, -1);
+        }
+
+        intents[i].unit = units[i];
+        idToIndex[id] = i;
+    }
+}
+
+const CombatIntent* CombatIntents::find(const BWAPI::Unit unit) const
+{
+    const int id = unit->getID();
+    return id >= 0 && id < (int) idToIndex.size() && idToIndex[id] != -1 ? &intents[idToIndex[id]] : nullptr;
+}
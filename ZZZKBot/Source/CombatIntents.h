@@ -0,0 +1,107 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <BWAPI.h>
+#include <vector>
+
+#include "ThreadPool.h"
+
+// The targets that the target selection of one of my combat units found this frame, one per
+// tier (in the order the tiers are tried). A tier that wasn't reached (because an earlier tier
+// found a target) or found nothing is nullptr. Which tier's target is actually used is decided
+// when the intents are applied.
+struct CombatIntent
+{
+    BWAPI::Unit unit = nullptr;
+    BWAPI::Unit inRangeSelfThreatTarget = nullptr;
+    BWAPI::Unit selfThreatTarget = nullptr;
+    BWAPI::Unit inRangeWorkerTarget = nullptr;
+    BWAPI::Unit defenceTarget = nullptr;
+    BWAPI::Unit closestEnemyUnliftedBuilding = nullptr;
+    BWAPI::Unit workerNearBuildingTarget = nullptr;
+    BWAPI::Unit inRangeTacticalTarget = nullptr;
+    BWAPI::Unit tacticalNearBuildingTarget = nullptr;
+    BWAPI::Unit nonWorkerNearBuildingTarget = nullptr;
+
+    bool operator==(const CombatIntent& other) const;
+    bool operator!=(const CombatIntent& other) const { return !(*this == other); }
+};
+
+// The combat intents of all my units that may need a new target this frame. They are all
+// evaluated at the same time on the thread pool before any of them is applied, so the evaluator
+// must not call BWAPI (which isn't thread-safe) and must only read state that applying the
+// intents (i.e. issuing commands to my units one at a time in a fixed order) doesn't change,
+// e.g. the frame snapshot. Then applying them in order gives the same commands as evaluating
+// each unit just before its command is issued.
+class CombatIntents
+{
+public:
+    // Evaluates an intent for each of the units (the evaluator is passed an intent with only the
+    // unit set). The evaluator is a template parameter rather than a std::function so that it
+    // isn't copied to the heap each frame.
+    template <class Evaluator>
+    void evaluate(const std::vector<BWAPI::Unit>& units, const Evaluator& evaluator, ThreadPool& threadPool)
+    {
+        reset(units);
+
+        // Each task only writes its own intent.
+        threadPool.parallelFor(
+            (int) intents.size(),
+            [this, &evaluator](int i)
+            {
+                evaluator(intents[i]);
+            });
+    }
+
+    // Returns the unit's intent, or nullptr if it wasn't evaluated this frame.
+    const CombatIntent* find(const BWAPI::Unit unit) const;
+
+    // Evaluates all the intents again one after another on the calling thread with the other
+    // evaluator (e.g. one that uses BWAPI's unit queries, so it must be the main thread) and
+    // returns the number that differ from the ones that were evaluated in parallel.
+    template <class Evaluator>
+    int countMismatches(const Evaluator& evaluator) const
+    {
+        int numMismatches = 0;
+        for (const CombatIntent& intent : intents)
+        {
+            CombatIntent serialIntent;
+            serialIntent.unit = intent.unit;
+            evaluator(serialIntent);
+            if (serialIntent != intent)
+            {
+                ++numMismatches;
+            }
+        }
+
+        return numMismatches;
+    }
+
+private:
+    // Makes an intent with only the unit set for each of the units.
+    void reset(const std::vector<BWAPI::Unit>& units);
+
+    std::vector<CombatIntent> intents;
+
+    // Index in intents by unit ID (-1 if the unit wasn't evaluated this frame). It is only resized
+    // when a unit with a bigger ID is evaluated, so it doesn't allocate in most frames.
+    std::vector<int> idToIndex;
+};
@@ -0,0 +1,573 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "DecisionCheck.h"
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+#include "GameRecordReader.h"
+#include "Learning.h"
+#include "Rng.h"
+
+// How many seeds the strategy selection is compared with (its weighted random choice is
+// compared by giving both an RNG with the same seed).
+static const int numStrategySelectionSeeds = 32;
+
+static bool hasFlag(const GameRecord::UnitState& state, const GameRecord::UnitFlag flag)
+{
+    return (state.flags & flag) != 0;
+}
+
+static std::string describe(const GameRecord::UnitState& state)
+{
+    std::ostringstream oss;
+    oss << "unit " << state.id << " " << BWAPI::UnitType(state.typeID).getName() << " at (" << state.x << ", " << state.y << ")";
+    return oss.str();
+}
+
+static std::string describe(const BWAPI::TilePosition loc)
+{
+    std::ostringstream oss;
+    oss << "(" << loc.x << ", " << loc.y << ")";
+    return oss.str();
+}
+
+static std::string describe(const InitialCreep::Evidence evidence)
+{
+    return evidence == InitialCreep::Evidence::Creep ? "creep" : evidence == InitialCreep::Evidence::NoCreep ? "no creep" : "none";
+}
+
+static std::string describe(const StratSettings& ss)
+{
+    std::ostringstream oss;
+    oss << "4pool " << ss.is4PoolBO << ", speedling " << ss.isSpeedlingBO << ", hydra rush " << ss.isHydraRushBO
+        << ", muta rush decided after scout " << ss.isMutaRushBODecidedAfterScoutEnemyRace << ", muta rush " << ss.isMutaRushBO
+        << " (vs P " << ss.isMutaRushBOVsProtoss << ", T " << ss.isMutaRushBOVsTerran << ", Z " << ss.isMutaRushBOVsZerg << ")"
+        << ", speedling push deferred " << ss.isSpeedlingPushDeferred << ", enemy worker rusher " << ss.isEnemyWorkerRusher
+        << ", sunkens decided after scout " << ss.isNumSunkensDecidedAfterScoutEnemyRace << ", sunkens " << ss.numSunkens
+        << " (vs P " << ss.numSunkensVsProtoss << ", T " << ss.numSunkensVsTerran << ", Z " << ss.numSunkensVsZerg << ")";
+    return oss.str();
+}
+
+static std::string describe(const std::string& key)
+{
+    return key;
+}
+
+static std::string describe(const int key)
+{
+    return std::to_string(key);
+}
+
+// Recounts the outcomes of each scenario from the games in it (the lowest level has the games
+// themselves, and each other level is the sum of the levels below it).
+static void recountNumOutcomes(OutcomeMap& outcomeMap, std::pmr::map<int, StratSettings>& gameIDToStratSettings)
+{
+    outcomeMap.numOutcomes.clear();
+    for (const auto& isWinnerToTimerMap : outcomeMap.val)
+    {
+        for (const auto& timerToGameIDSet : isWinnerToTimerMap.second.val)
+        {
+            for (const int gameID : timerToGameIDSet.second.val)
+            {
+                ++outcomeMap.numOutcomes[isWinnerToTimerMap.first][gameIDToStratSettings[gameID]];
+            }
+        }
+    }
+}
+
+template <class MapWithNumOutcomesMap>
+static void recountNumOutcomes(MapWithNumOutcomesMap& mapWithNumOutcomesMap, std::pmr::map<int, StratSettings>& gameIDToStratSettings)
+{
+    mapWithNumOutcomesMap.numOutcomes.clear();
+    for (auto& keyToChild : mapWithNumOutcomesMap.val)
+    {
+        recountNumOutcomes(keyToChild.second, gameIDToStratSettings);
+        for (const auto& isWinnerToNumOutcomes : keyToChild.second.numOutcomes)
+        {
+            for (const auto& ssToNumOutcomes : isWinnerToNumOutcomes.second)
+            {
+                mapWithNumOutcomesMap.numOutcomes[isWinnerToNumOutcomes.first][ssToNumOutcomes.first] += ssToNumOutcomes.second;
+            }
+        }
+    }
+}
+
+// Returns whether the outcome counts of a scenario differ between the maps, and if so the path
+// of the first scenario that does.
+static bool findNumOutcomesDifference(const OutcomeMap& a, const OutcomeMap& b, const std::string& path, std::string& differencePath)
+{
+    if (a.numOutcomes != b.numOutcomes)
+    {
+        differencePath = path;
+        return true;
+    }
+
+    return false;
+}
+
+template <class MapWithNumOutcomesMap>
+static bool findNumOutcomesDifference(const MapWithNumOutcomesMap& a, const MapWithNumOutcomesMap& b, const std::string& path, std::string& differencePath)
+{
+    if (a.numOutcomes != b.numOutcomes || a.val.size() != b.val.size())
+    {
+        differencePath = path;
+        return true;
+    }
+
+    for (const auto& keyToChild : a.val)
+    {
+        const auto bIter = b.val.find(keyToChild.first);
+        if (bIter == b.val.end())
+        {
+            differencePath = path;
+            return true;
+        }
+
+        if (findNumOutcomesDifference(keyToChild.second, bIter->second, path + "/" + describe(keyToChild.first), differencePath))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool DecisionCheck::checkRecord(const std::string& recordFilePath, std::istream* learningFile, Divergence& divergence)
+{
+    divergence = Divergence();
+    GameRecordReader reader;
+    if (!reader.open(recordFilePath))
+    {
+        return false;
+    }
+
+    replay.onStart(reader.getMatchInfo());
+    moduleReplay.setCombatIntentCheckEnabled(true);
+    moduleReplay.setCreepInferenceCheckEnabled(true);
+    moduleReplay.start(reader.getMatchInfo());
+    numFramesChecked = 0;
+    numChecks.clear();
+    bool isStrategySelectionChecked = learningFile == nullptr;
+    GameRecord::Frame frame;
+    while (reader.readFrame(frame))
+    {
+        replay.onFrame(frame);
+
+        // The bot chooses its strategy on the first frame, when it knows its start location.
+        if (!isStrategySelectionChecked && replay.getMyStartLoc() != BWAPI::TilePositions::Unknown)
+        {
+            isStrategySelectionChecked = true;
+            if (!checkStrategySelection(*learningFile, frame.frameCount, divergence))
+            {
+                return false;
+            }
+        }
+
+        if (!checkTargetChoice(frame, divergence) ||
+            !checkGathererPairing(frame, divergence) ||
+            !checkStartLocationInference(frame, divergence) ||
+            !checkBot(frame, divergence))
+        {
+            return false;
+        }
+
+        ++numFramesChecked;
+    }
+
+    return true;
+}
+
+bool DecisionCheck::checkStrategySelection(std::istream& learningFile, const int frameCount, Divergence& divergence)
+{
+    const GameRecord::MatchInfo& matchInfo = replay.getMatchInfo();
+    const BWAPI::TilePosition myStartLoc = replay.getMyStartLoc();
+
+    // The same as what the bot reads for this match.
+    Learning::ParseContext context;
+    context.dataFileExtension = "dat";
+    context.pathFieldDelimiter = "_";
+    context.myVersionMajor = 1;
+    context.myVersionMinor = 7;
+    context.myRaceName = replay.getSelfRace().getName();
+    context.enemyRaceInit = replay.getEnemyRace();
+
+    // Read twice, once for each implementation.
+    std::ostringstream learningFileText;
+    learningFileText << learningFile.rdbuf();
+
+    LearningMap learningMap;
+    std::pmr::map<int, StratSettings> gameIDToStratSettings;
+    std::pmr::map<int, int> gameIDToOnEndFrameCount;
+    std::istringstream optimizedIss(learningFileText.str());
+    const int numGames = Learning::parse(optimizedIss, context, learningMap, gameIDToStratSettings, gameIDToOnEndFrameCount);
+
+    // Reference: the outcome counts recounted from the games.
+    LearningMap recountedLearningMap;
+    std::pmr::map<int, StratSettings> recountedGameIDToStratSettings;
+    std::pmr::map<int, int> recountedGameIDToOnEndFrameCount;
+    std::istringstream referenceIss(learningFileText.str());
+    Learning::parse(referenceIss, context, recountedLearningMap, recountedGameIDToStratSettings, recountedGameIDToOnEndFrameCount);
+    recountNumOutcomes(recountedLearningMap.enemyRaceInitMap, recountedGameIDToStratSettings);
+    recountedLearningMap.numOutcomes.clear();
+    for (const auto& isWinnerToNumOutcomes : recountedLearningMap.enemyRaceInitMap.numOutcomes)
+    {
+        for (const auto& ssToNumOutcomes : isWinnerToNumOutcomes.second)
+        {
+            recountedLearningMap.numOutcomes[isWinnerToNumOutcomes.first] += ssToNumOutcomes.second;
+        }
+    }
+
+    Learning::SelectionKey key;
+    key.enemyRaceInit = replay.getEnemyRace();
+    key.numStartLocations = (int) matchInfo.startLocations.size();
+    key.mapHash = matchInfo.mapHash;
+    key.myStartLoc = myStartLoc;
+    if (matchInfo.startLocations.size() == 2)
+    {
+        for (const std::pair<int, int>& startLocation : matchInfo.startLocations)
+        {
+            if (BWAPI::TilePosition(startLocation.first, startLocation.second) != myStartLoc)
+            {
+                key.enemyStartLocDeduced = BWAPI::TilePosition(startLocation.first, startLocation.second);
+            }
+        }
+    }
+
+    std::string differencePath;
+    const bool isNumOutcomesDifferent =
+        recountedLearningMap.numOutcomes != learningMap.numOutcomes ||
+        findNumOutcomesDifference(recountedLearningMap.enemyRaceInitMap, learningMap.enemyRaceInitMap, "", differencePath);
+
+    for (int seed = 1; seed <= numStrategySelectionSeeds; ++seed)
+    {
+        StratSettings referenceSS = {};
+        Rng referenceRng = Rng(seed).getSubstream(Rng::StratSelectionStream);
+        const bool isReferenceUpdated = Learning::selectStratSettings(recountedLearningMap, recountedGameIDToStratSettings, key, referenceRng, referenceSS);
+
+        StratSettings optimizedSS = {};
+        Rng optimizedRng = Rng(seed).getSubstream(Rng::StratSelectionStream);
+        const bool isOptimizedUpdated = Learning::selectStratSettings(learningMap, gameIDToStratSettings, key, optimizedRng, optimizedSS);
+
+        ++numChecks["strategy_selection"];
+        if (isReferenceUpdated != isOptimizedUpdated || !(referenceSS == optimizedSS) || isNumOutcomesDifferent)
+        {
+            std::ostringstream oss;
+            oss << numGames << " games in the learning file for " << context.myRaceName << " vs " << context.enemyRaceInit.getName()
+                << ", map " << key.mapHash << " with " << key.numStartLocations << " start locations, my start location " << describe(key.myStartLoc)
+                << ", enemy start location " << describe(key.enemyStartLocDeduced) << ", seed " << seed << std::endl;
+            oss << "  reference: " << (isReferenceUpdated ? describe(referenceSS) : "not chosen") << std::endl;
+            oss << "  optimized: " << (isOptimizedUpdated ? describe(optimizedSS) : "not chosen") << std::endl;
+            if (isNumOutcomesDifferent)
+            {
+                oss << "  the outcome counts differ from the recounted ones at scenario " << (differencePath.empty() ? "/" : differencePath) << std::endl;
+            }
+
+            divergence.decision = "strategy_selection";
+            divergence.frameCount = frameCount;
+            divergence.context = oss.str();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool DecisionCheck::checkTargetChoice(const GameRecord::Frame& frame, Divergence& divergence)
+{
+    // Reference: for each attacker, a scan of all the units of the frame.
+    const std::vector<const FrameReplay::FrameUnit*>& attackers = replay.getAttackers();
+    std::vector<FrameReplay::TargetChoice> referenceChoices(attackers.size());
+    for (size_t i = 0; i < attackers.size(); ++i)
+    {
+        const FrameReplay::FrameUnit& attacker = *attackers[i];
+        for (const GameRecord::UnitState& target : frame.units)
+        {
+            if (!replay.isEnemyPlayer(target.playerID))
+            {
+                continue;
+            }
+
+            const BWAPI::WeaponType weapon = hasFlag(target, GameRecord::flyingFlag) ? attacker.type.airWeapon() : attacker.type.groundWeapon();
+            if (weapon == BWAPI::WeaponTypes::None)
+            {
+                continue;
+            }
+
+            referenceChoices[i].consider(target.id, FrameReplay::getDistanceSquared(attacker.state->x, attacker.state->y, target.x, target.y), weapon.maxRange());
+        }
+    }
+
+    for (size_t i = 0; i < attackers.size(); ++i)
+    {
+        ++numChecks["target_choice"];
+        const FrameReplay::TargetChoice& reference = referenceChoices[i];
+        const FrameReplay::TargetChoice& optimized = replay.getTargetChoices()[i];
+        if (reference.targetID == optimized.targetID && reference.inRangeTargetID == optimized.inRangeTargetID)
+        {
+            continue;
+        }
+
+        const GameRecord::UnitState& attacker = *attackers[i]->state;
+        std::ostringstream oss;
+        oss << "attacker " << describe(attacker) << std::endl;
+        oss << "  reference: target " << reference.targetID << ", in range target " << reference.inRangeTargetID << std::endl;
+        oss << "  optimized: target " << optimized.targetID << ", in range target " << optimized.inRangeTargetID << std::endl;
+        oss << "  the enemy units that are no further away than either target:" << std::endl;
+        const long long maxDistanceSquared = std::max(reference.targetDistanceSquared, optimized.targetDistanceSquared);
+        for (const FrameReplay::FrameUnit& unit : replay.getEnemyUnits())
+        {
+            const long long distanceSquared = FrameReplay::getDistanceSquared(attacker.x, attacker.y, unit.state->x, unit.state->y);
+            if (distanceSquared <= maxDistanceSquared)
+            {
+                oss << "    " << describe(*unit.state) << (hasFlag(*unit.state, GameRecord::flyingFlag) ? " (flying)" : "")
+                    << ", distance squared " << distanceSquared << std::endl;
+            }
+        }
+
+        divergence.decision = "target_choice";
+        divergence.frameCount = frame.frameCount;
+        divergence.context = oss.str();
+        return false;
+    }
+
+    return true;
+}
+
+bool DecisionCheck::checkGathererPairing(const GameRecord::Frame& frame, Divergence& divergence)
+{
+    const std::vector<const GameRecord::UnitState*>& gatherers = replay.getGatherers();
+    const std::vector<const GameRecord::UnitState*>& minerals = replay.getMinerals();
+    const std::vector<std::vector<long long> >& costs = replay.getCosts();
+    if (gatherers.empty() || minerals.empty())
+    {
+        return true;
+    }
+
+    // Returns the total cost of an assignment (the mineral patch (index) of each gatherer, or -1).
+    const auto getTotalCost =
+        [&costs](const std::vector<int>& gathererToMineral)
+        {
+            long long totalCost = 0;
+            for (size_t i = 0; i < gathererToMineral.size(); ++i)
+            {
+                if (gathererToMineral[i] >= 0)
+                {
+                    totalCost += costs[i][gathererToMineral[i]];
+                }
+            }
+
+            return totalCost;
+        };
+
+    // Reference: solved from scratch (so the gatherers/mineral patches are the first rows/columns,
+    // and any other column is a dummy one).
+    AssignmentSolver referenceSolver;
+    for (size_t i = 0; i < gatherers.size(); ++i)
+    {
+        referenceSolver.addRow();
+    }
+    for (size_t j = 0; j < minerals.size(); ++j)
+    {
+        referenceSolver.addColumn();
+    }
+    for (size_t i = 0; i < gatherers.size(); ++i)
+    {
+        for (size_t j = 0; j < minerals.size(); ++j)
+        {
+            referenceSolver.setCost((int) i, (int) j, costs[i][j]);
+        }
+    }
+    referenceSolver.solve();
+
+    std::vector<int> referenceGathererToMineral(gatherers.size(), -1);
+    for (size_t i = 0; i < gatherers.size(); ++i)
+    {
+        const int col = referenceSolver.getAssignedColumn((int) i);
+        referenceGathererToMineral[i] = col < (int) minerals.size() ? col : -1;
+    }
+
+    // There may be more than one assignment with the lowest cost, so only the total cost and
+    // the number of gatherers that were assigned are compared.
+    const std::vector<int>& optimizedGathererToMineral = replay.getGathererToMineral();
+    const long long referenceCost = getTotalCost(referenceGathererToMineral);
+    const long long optimizedCost = getTotalCost(optimizedGathererToMineral);
+    const auto numAssigned = [](const std::vector<int>& gathererToMineral) { return gathererToMineral.size() - std::count(gathererToMineral.begin(), gathererToMineral.end(), -1); };
+    ++numChecks["gatherer_pairing"];
+    if (referenceCost == optimizedCost && numAssigned(referenceGathererToMineral) == numAssigned(optimizedGathererToMineral))
+    {
+        return true;
+    }
+
+    std::ostringstream oss;
+    oss << "depot " << describe(*replay.getMyResourceDepot()->state) << ", " << gatherers.size() << " gatherers, " << minerals.size() << " mineral patches" << std::endl;
+    oss << "  reference: total cost " << referenceCost << std::endl;
+    oss << "  optimized: total cost " << optimizedCost << std::endl;
+    const auto describeMineral =
+        [&minerals, &costs](const size_t gathererIndex, const int mineral)
+        {
+            return mineral >= 0 ? "mineral " + std::to_string(minerals[mineral]->id) + " (cost " + std::to_string(costs[gathererIndex][mineral]) + ")" : std::string("none");
+        };
+    for (size_t i = 0; i < gatherers.size(); ++i)
+    {
+        oss << "    gatherer " << describe(*gatherers[i]) << ": reference " << describeMineral(i, referenceGathererToMineral[i])
+            << ", optimized " << describeMineral(i, optimizedGathererToMineral[i]) << std::endl;
+    }
+
+    divergence.decision = "gatherer_pairing";
+    divergence.frameCount = frame.frameCount;
+    divergence.context = oss.str();
+    return false;
+}
+
+bool DecisionCheck::checkStartLocationInference(const GameRecord::Frame& frame, Divergence& divergence)
+{
+    if (!replay.isCreepChecked())
+    {
+        return true;
+    }
+
+    const std::map<BWAPI::TilePosition, std::set<BWAPI::TilePosition> >& initialCreepLocsMap = replay.getInitialCreepLocsMap();
+
+    // Reference: each tile is checked by going through the units (like Broodwar->isVisible(),
+    // getUnitsOnTile() and hasCreep() per tile).
+    auto isCheckableReference =
+        [this, &frame](const BWAPI::TilePosition loc)
+        {
+            bool isVisible = false;
+            for (const FrameReplay::FrameUnit& unit : replay.getMyUnits())
+            {
+                const int sightRange = unit.type.sightRange();
+                if (FrameReplay::getDistanceSquared(unit.state->x, unit.state->y, loc.x * 32 + 16, loc.y * 32 + 16) <= (long long) sightRange * sightRange)
+                {
+                    isVisible = true;
+                    break;
+                }
+            }
+
+            if (!isVisible)
+            {
+                return false;
+            }
+
+            for (const GameRecord::UnitState& state : frame.units)
+            {
+                const BWAPI::UnitType type(state.typeID);
+                if (type.isBuilding() && !hasFlag(state, GameRecord::liftedFlag))
+                {
+                    const BWAPI::TilePosition topLeft = FrameReplay::getFootprintTopLeft(state, type);
+                    if (loc.x >= topLeft.x && loc.x < topLeft.x + type.tileWidth() && loc.y >= topLeft.y && loc.y < topLeft.y + type.tileHeight())
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        };
+
+    auto hasCreepReference =
+        [this, &initialCreepLocsMap](const BWAPI::TilePosition loc)
+        {
+            for (const auto& startLocToCreepLocs : initialCreepLocsMap)
+            {
+                if (startLocToCreepLocs.second.find(loc) != startLocToCreepLocs.second.end() && replay.isEnemyZergBaseAt(startLocToCreepLocs.first))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        };
+
+    for (const FrameReplay::StartLocCheck& startLocCheck : replay.getStartLocChecks())
+    {
+        const std::set<BWAPI::TilePosition>& creepLocs = initialCreepLocsMap.at(startLocCheck.startLoc);
+        const InitialCreep::Evidence referenceEvidence =
+            InitialCreep::checkCreepLocs(creepLocs, replay.isStoppingAtNoCreep(), isCheckableReference, hasCreepReference);
+
+        ++numChecks["start_location_inference"];
+        if (referenceEvidence != startLocCheck.evidence)
+        {
+            std::ostringstream oss;
+            oss << "start location " << describe(startLocCheck.startLoc) << " (mine is " << describe(replay.getMyStartLoc()) << "), enemy race "
+                << replay.getEnemyRace().getName() << std::endl;
+            oss << "  reference: " << describe(referenceEvidence) << std::endl;
+            oss << "  optimized: " << describe(startLocCheck.evidence) << std::endl;
+            oss << "  the creep tiles where the inputs differ:" << std::endl;
+            for (const BWAPI::TilePosition loc : creepLocs)
+            {
+                const bool isReferenceCheckable = isCheckableReference(loc);
+                const bool isOptimizedCheckable = replay.isCheckable(loc);
+                const bool hasReferenceCreep = hasCreepReference(loc);
+                const bool hasOptimizedCreep = replay.hasCreep(loc);
+                if (isReferenceCheckable != isOptimizedCheckable || hasReferenceCreep != hasOptimizedCreep)
+                {
+                    oss << "    tile " << describe(loc) << ": checkable " << isReferenceCheckable << " vs " << isOptimizedCheckable
+                        << ", creep " << hasReferenceCreep << " vs " << hasOptimizedCreep << std::endl;
+                }
+            }
+
+            divergence.decision = "start_location_inference";
+            divergence.frameCount = frame.frameCount;
+            divergence.context = oss.str();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool DecisionCheck::checkBot(const GameRecord::Frame& frame, Divergence& divergence)
+{
+    // The bot counts the checks and mismatches of the whole match.
+    const ZZZKBotAIModule& bot = moduleReplay.getBot();
+    const int numCombatIntentsCheckedBefore = bot.numCombatIntentsChecked;
+    const int numCombatIntentMismatchesBefore = bot.numCombatIntentMismatches;
+    const int numCreepInferenceMismatchesBefore = bot.numCreepInferenceMismatches;
+    moduleReplay.playFrame(frame);
+    numChecks["bot_combat_intents"] = bot.numCombatIntentsChecked;
+    numChecks["bot_creep_inference"] = bot.numCreepInferencesChecked;
+
+    if (bot.numCombatIntentMismatches > numCombatIntentMismatchesBefore)
+    {
+        std::ostringstream oss;
+        oss << "  " << bot.numCombatIntentMismatches - numCombatIntentMismatchesBefore << " of the " << bot.numCombatIntentsChecked - numCombatIntentsCheckedBefore
+            << " combat intents evaluated from the frame snapshot differ from evaluateCombatIntentReference" << std::endl;
+        divergence.decision = "bot_combat_intents";
+        divergence.frameCount = frame.frameCount;
+        divergence.context = oss.str();
+        return false;
+    }
+
+    if (bot.numCreepInferenceMismatches > numCreepInferenceMismatchesBefore)
+    {
+        std::ostringstream oss;
+        oss << "  " << bot.numCreepInferenceMismatches - numCreepInferenceMismatchesBefore
+            << " start location inference(s) with the occupancy map differ from the ones with getUnitsOnTile()" << std::endl;
+        divergence.decision = "bot_creep_inference";
+        divergence.frameCount = frame.frameCount;
+        divergence.context = oss.str();
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,87 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <BWAPI.h>
+#include <istream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "FrameReplay.h"
+#include "GameRecord.h"
+#include "ModuleReplay.h"
+
+// Runs the reference implementation and the optimized implementation of each of the bot's
+// decisions side by side on the same input, frame by frame from a game record (see
+// GameRecord.h), and stops at the first frame where they decide differently, with everything
+// that went into the decision. The reference implementation is the straightforward form that
+// the optimized one replaced, so that a change that makes a decision faster can be checked
+// against recorded games before it is merged. The optimized side is FrameReplay's (see
+// FrameReplay.h), and the reference side is:
+// - target choice: a scan of all the units per attacker,
+// - gatherer pairing: solved from scratch each frame,
+// - start location inference: per-tile queries of the units (like Broodwar->isVisible(),
+//   getUnitsOnTile() and hasCreep() per tile),
+// - strategy selection (which FrameReplay doesn't do): from the learning data with the
+//   per-scenario outcome counts recounted from the games vs. with the counts that are
+//   accumulated while the file is read.
+// The record is also played through the bot itself (see ModuleReplay.h) with its own checks
+// enabled, which compare its decisions with the BWAPI unit queries that they replaced:
+// - bot combat intents: evaluateCombatIntent() on the frame snapshot vs.
+//   evaluateCombatIntentReference (the getBestUnit() queries),
+// - bot creep inference: the enemy start location inference with the occupancy map vs. with
+//   getUnitsOnTile() per tile.
+class DecisionCheck
+{
+public:
+    struct Divergence
+    {
+        std::string decision;
+        int frameCount = -1;
+
+        // The input and both answers.
+        std::string context;
+    };
+
+    // Checks the decisions on every frame of the record, and the strategy selection for its
+    // match if there is a learning file (i.e. the file that the bot keeps for the enemy). Returns
+    // false if the record can't be read or a decision diverged, in which case divergence is the
+    // first one (and its decision is empty if the record couldn't be read).
+    bool checkRecord(const std::string& recordFilePath, std::istream* learningFile, Divergence& divergence);
+
+    int getNumFramesChecked() const { return numFramesChecked; }
+
+    // The number of decisions that were compared, by decision.
+    const std::map<std::string, int>& getNumChecks() const { return numChecks; }
+
+private:
+    bool checkStrategySelection(std::istream& learningFile, const int frameCount, Divergence& divergence);
+    bool checkTargetChoice(const GameRecord::Frame& frame, Divergence& divergence);
+    bool checkGathererPairing(const GameRecord::Frame& frame, Divergence& divergence);
+    bool checkStartLocationInference(const GameRecord::Frame& frame, Divergence& divergence);
+    bool checkBot(const GameRecord::Frame& frame, Divergence& divergence);
+
+    FrameReplay replay;
+    ModuleReplay moduleReplay;
+
+    int numFramesChecked = 0;
+    std::map<std::string, int> numChecks;
+};
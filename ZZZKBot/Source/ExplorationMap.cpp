@@ -0,0 +1,333 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "ExplorationMap.h"
+#include <algorithm>
+#include <limits>
+
+// Width/height of a cell in tiles. Must divide 64 so that a cell never straddles two words of a
+// row of the visibility bitmap.
+static const int cellSizeTiles = 4;
+
+// Granularity of the last seen frames in the queue.
+static const int staleBucketFrames = 24;
+
+// A unit gives up on a cell if it hasn't been seen this long after the unit was sent there (same
+// as how often the targets used to be re-randomized).
+static const int maxClaimFrames = 60 * 24;
+
+// The target is the closest to the unit of this many of the stalest cells.
+static const int numCandidateCells = 8;
+
+void ExplorationMap::onStart(BWAPI::Game& Broodwar)
+{
+    *this = ExplorationMap();
+
+    mapWidth = Broodwar->mapWidth();
+    mapHeight = Broodwar->mapHeight();
+    cellsPerRow = (mapWidth + cellSizeTiles - 1) / cellSizeTiles;
+    const int cellsPerColumn = (mapHeight + cellSizeTiles - 1) / cellSizeTiles;
+
+    tileLastSeenFrames.assign((size_t) mapWidth * mapHeight, -1);
+    visible.reset(mapWidth, mapHeight);
+    inSightRange.reset(mapWidth, mapHeight);
+    cells.resize((size_t) cellsPerRow * cellsPerColumn);
+
+    // Only cells that ground units could get to from my start location are explored.
+    const BWAPI::TilePosition myStartLoc = Broodwar->self() ? Broodwar->self()->getStartLocation() : BWAPI::TilePositions::Unknown;
+    const bool isMyStartLocKnown = myStartLoc != BWAPI::TilePositions::None && myStartLoc != BWAPI::TilePositions::Unknown;
+    const BWAPI::Position myStartPos =
+        BWAPI::Position(myStartLoc) +
+        BWAPI::Position(
+            (BWAPI::UnitTypes::Special_Start_Location.tileWidth() * BWAPI::TILEPOSITION_SCALE) / 2,
+            (BWAPI::UnitTypes::Special_Start_Location.tileHeight() * BWAPI::TILEPOSITION_SCALE) / 2);
+
+    // Try the tiles of a cell in order of distance from the centre of the cell.
+    std::vector<std::pair<int, int>> offsets;
+    for (int dy = 0; dy < cellSizeTiles; ++dy)
+    {
+        for (int dx = 0; dx < cellSizeTiles; ++dx)
+        {
+            offsets.push_back(std::make_pair(dx, dy));
+        }
+    }
+
+    std::sort(
+        offsets.begin(),
+        offsets.end(),
+        [](const std::pair<int, int>& offset1, const std::pair<int, int>& offset2)
+        {
+            const int twiceCentre = cellSizeTiles - 1;
+            const int distSq1 = (2 * offset1.first - twiceCentre) * (2 * offset1.first - twiceCentre) + (2 * offset1.second - twiceCentre) * (2 * offset1.second - twiceCentre);
+            const int distSq2 = (2 * offset2.first - twiceCentre) * (2 * offset2.first - twiceCentre) + (2 * offset2.second - twiceCentre) * (2 * offset2.second - twiceCentre);
+            return distSq1 < distSq2;
+        });
+
+    for (int cellIndex = 0; cellIndex < (int) cells.size(); ++cellIndex)
+    {
+        Cell& cell = cells[cellIndex];
+        const int cellX = (cellIndex % cellsPerRow) * cellSizeTiles;
+        const int cellY = (cellIndex / cellsPerRow) * cellSizeTiles;
+
+        for (const std::pair<int, int>& offset : offsets)
+        {
+            const int tileX = cellX + offset.first;
+            const int tileY = cellY + offset.second;
+            if (tileX >= mapWidth || tileY >= mapHeight)
+            {
+                continue;
+            }
+
+            // Check the walk tile in the middle of the tile.
+            const BWAPI::Position pos(tileX * BWAPI::TILEPOSITION_SCALE + BWAPI::TILEPOSITION_SCALE / 2, tileY * BWAPI::TILEPOSITION_SCALE + BWAPI::TILEPOSITION_SCALE / 2);
+            if (Broodwar->isWalkable(BWAPI::WalkPosition(pos)) &&
+                (!isMyStartLocKnown || Broodwar->hasPath(pos, myStartPos)))
+            {
+                cell.pos = pos;
+                cell.isReachable = true;
+                staleCells.insert(std::make_pair(getBucket(cell.lastSeenFrame), cellIndex));
+                break;
+            }
+        }
+    }
+}
+
+void ExplorationMap::updateVisibility(BWAPI::Game& Broodwar)
+{
+    const int frameCount = Broodwar->getFrameCount();
+    visibleFrame = frameCount;
+
+    // Give up on the cells that units have been trying to get to for too long (or that belong to
+    // units that have been taken over or something).
+    expiredUnits.clear();
+    for (const std::pair<const BWAPI::Unit, Claim>& claim : claims)
+    {
+        if (frameCount > claim.second.claimedFrame + maxClaimFrames || !claim.first->exists())
+        {
+            expiredUnits.push_back(claim.first);
+        }
+    }
+
+    for (const BWAPI::Unit unit : expiredUnits)
+    {
+        release(unit);
+    }
+
+    // BWAPI only answers visibility a tile at a time, so only ask about the tiles that one of my
+    // units could see (a tile of margin is allowed because the sight range is measured from the
+    // unit's position rather than its tile). When the whole map may be revealed, ask about every
+    // tile.
+    const bool isEveryTileAsked =
+        Broodwar->isReplay() ||
+        Broodwar->isFlagEnabled(BWAPI::Flag::CompleteMapInformation) ||
+        Broodwar->self() == nullptr;
+    if (!isEveryTileAsked)
+    {
+        inSightRange.clear();
+        for (const BWAPI::Unit unit : Broodwar->self()->getUnits())
+        {
+            const BWAPI::TilePosition tile(unit->getPosition());
+            const int rangeTiles = (Broodwar->self()->sightRange(unit->getType()) + BWAPI::TILEPOSITION_SCALE - 1) / BWAPI::TILEPOSITION_SCALE + 1;
+            for (int y = tile.y - rangeTiles; y <= tile.y + rangeTiles; ++y)
+            {
+                inSightRange.setRowRange(tile.x - rangeTiles, y, 2 * rangeTiles + 1);
+            }
+        }
+    }
+
+    const int wordsPerRow = visible.getWordsPerRow();
+    for (int y = 0; y < mapHeight; ++y)
+    {
+        // Build the row of the visibility bitmap a word at a time from the tiles that may be
+        // visible.
+        std::uint64_t* visibleRow = visible.getRow(y);
+        const std::uint64_t* inSightRangeRow = inSightRange.getRow(y);
+        for (int wordIndex = 0; wordIndex < wordsPerRow; ++wordIndex)
+        {
+            const int firstX = wordIndex * 64;
+            std::uint64_t candidates =
+                !isEveryTileAsked ? inSightRangeRow[wordIndex] :
+                mapWidth - firstX >= 64 ? ~std::uint64_t(0) :
+                (std::uint64_t(1) << (mapWidth - firstX)) - 1;
+            std::uint64_t word = 0;
+            for (int x = firstX; candidates != 0; ++x, candidates >>= 1)
+            {
+                if ((candidates & 1) && Broodwar->isVisible(x, y))
+                {
+                    word |= std::uint64_t(1) << (x - firstX);
+                }
+            }
+
+            visibleRow[wordIndex] = word;
+        }
+    }
+}
+
+void ExplorationMap::update()
+{
+    const int frameCount = visibleFrame;
+    const int wordsPerRow = visible.getWordsPerRow();
+    for (int y = 0; y < mapHeight; ++y)
+    {
+        const std::uint64_t* visibleRow = visible.getRow(y);
+
+        // Stamp the last seen frame of the visible tiles a word at a time, skipping words with
+        // nothing visible and filling whole words that are all visible.
+        int* lastSeenRow = &tileLastSeenFrames[(size_t) y * mapWidth];
+        for (int wordIndex = 0; wordIndex < wordsPerRow; ++wordIndex)
+        {
+            const std::uint64_t word = visibleRow[wordIndex];
+            const int firstX = wordIndex * 64;
+            if (word == 0)
+            {
+                continue;
+            }
+            else if (word == ~std::uint64_t(0))
+            {
+                std::fill(lastSeenRow + firstX, lastSeenRow + firstX + 64, frameCount);
+            }
+            else
+            {
+                std::uint64_t bits = word;
+                for (int x = firstX; bits != 0; ++x, bits >>= 1)
+                {
+                    if (bits & 1)
+                    {
+                        lastSeenRow[x] = frameCount;
+                    }
+                }
+            }
+        }
+    }
+
+    // A cell is seen if any of its tiles are visible, i.e. if any of its bits are set in any of its
+    // rows (cells never straddle two words).
+    const std::uint64_t cellMask = (std::uint64_t(1) << cellSizeTiles) - 1;
+    for (int cellIndex = 0; cellIndex < (int) cells.size(); ++cellIndex)
+    {
+        const int cellX = (cellIndex % cellsPerRow) * cellSizeTiles;
+        const int cellY = (cellIndex / cellsPerRow) * cellSizeTiles;
+        const int endY = std::min(cellY + cellSizeTiles, mapHeight);
+        for (int y = cellY; y < endY; ++y)
+        {
+            if (((visible.getRow(y)[cellX >> 6] >> (cellX & 63)) & cellMask) != 0)
+            {
+                markSeen(cellIndex, frameCount);
+                break;
+            }
+        }
+    }
+}
+
+BWAPI::Position ExplorationMap::getTarget(const BWAPI::Unit unit, const int frameCount)
+{
+    std::unordered_map<BWAPI::Unit, Claim>::const_iterator claimIter = claims.find(unit);
+    if (claimIter != claims.end())
+    {
+        const Cell& cell = cells[claimIter->second.cellIndex];
+        if (cell.lastSeenFrame < claimIter->second.claimedFrame &&
+            frameCount <= claimIter->second.claimedFrame + maxClaimFrames)
+        {
+            return cell.pos;
+        }
+
+        release(unit);
+    }
+
+    const BWAPI::Position unitPos = unit->getPosition();
+    std::set<std::pair<int, int>>::iterator bestIter = staleCells.end();
+    int bestDist = std::numeric_limits<int>::max();
+    int numCandidates = 0;
+    for (std::set<std::pair<int, int>>::iterator iter = staleCells.begin();
+         iter != staleCells.end() && numCandidates < numCandidateCells;
+         ++iter, ++numCandidates)
+    {
+        const int dist = unitPos.getApproxDistance(cells[iter->second].pos);
+        if (dist < bestDist)
+        {
+            bestIter = iter;
+            bestDist = dist;
+        }
+    }
+
+    if (bestIter == staleCells.end())
+    {
+        return BWAPI::Positions::Unknown;
+    }
+
+    const int cellIndex = bestIter->second;
+    staleCells.erase(bestIter);
+    cells[cellIndex].isClaimed = true;
+    Claim& claim = claims[unit];
+    claim.cellIndex = cellIndex;
+    claim.claimedFrame = frameCount;
+    return cells[cellIndex].pos;
+}
+
+int ExplorationMap::getLastSeenFrame(const BWAPI::TilePosition loc) const
+{
+    if (loc.x < 0 || loc.y < 0 || loc.x >= mapWidth || loc.y >= mapHeight)
+    {
+        return -1;
+    }
+
+    return tileLastSeenFrames[(size_t) loc.y * mapWidth + loc.x];
+}
+
+int ExplorationMap::getBucket(const int lastSeenFrame)
+{
+    return lastSeenFrame < 0 ? -1 : lastSeenFrame / staleBucketFrames;
+}
+
+void ExplorationMap::release(const BWAPI::Unit unit)
+{
+    std::unordered_map<BWAPI::Unit, Claim>::iterator claimIter = claims.find(unit);
+    if (claimIter == claims.end())
+    {
+        return;
+    }
+
+    const int cellIndex = claimIter->second.cellIndex;
+    cells[cellIndex].isClaimed = false;
+    staleCells.insert(std::make_pair(getBucket(cells[cellIndex].lastSeenFrame), cellIndex));
+    claims.erase(claimIter);
+}
+
+void ExplorationMap::markSeen(const int cellIndex, const int frameCount)
+{
+    Cell& cell = cells[cellIndex];
+    if (cell.isReachable && !cell.isClaimed && getBucket(cell.lastSeenFrame) != getBucket(frameCount))
+    {
+        // Move the cell's node to its new bucket rather than erasing it and inserting a new one,
+        // so that sweeping the seen tiles doesn't allocate.
+        std::set<std::pair<int, int>>::node_type node = staleCells.extract(std::make_pair(getBucket(cell.lastSeenFrame), cellIndex));
+        if (node)
+        {
+            node.value().first = getBucket(frameCount);
+            staleCells.insert(std::move(node));
+        }
+        else
+        {
+            staleCells.insert(std::make_pair(getBucket(frameCount), cellIndex));
+        }
+    }
+
+    cell.lastSeenFrame = frameCount;
+}
@@ -0,0 +1,103 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <BWAPI.h>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "TileBitmap.h"
+
+// Remembers the frame that each tile was last seen, and hands out exploration targets for units
+// that don't have anything better to do: the reachable areas of the map that haven't been seen for
+// the longest time. The map is divided into cells of a few tiles, and the cells that aren't
+// claimed by a unit are kept in a queue ordered by when they were last seen (bucketed to the
+// second, so a cell that stays in view only moves in the queue once a second), so getting a
+// target is a lookup at the front of the queue rather than random tries, and two units are never
+// sent to the same cell.
+class ExplorationMap
+{
+public:
+    void onStart(BWAPI::Game& Broodwar);
+
+    // Reads which tiles are visible now, and gives up the claims that have expired. This is the
+    // part of the update that calls BWAPI, so it must be called on the main thread.
+    void updateVisibility(BWAPI::Game& Broodwar);
+
+    // Updates the last seen frames from what updateVisibility() read. It doesn't call BWAPI, so
+    // it can run on the thread pool. Call these two once per frame.
+    void update();
+
+    // Call this from the corresponding AI module callback.
+    void onUnitDestroy(BWAPI::Unit unit) { release(unit); }
+
+    // Returns the centre of the cell that the unit should explore, or BWAPI::Positions::Unknown if
+    // there isn't one. The unit keeps the same cell until the cell has been seen or the unit has
+    // taken too long to get there (e.g. because it has no path there).
+    BWAPI::Position getTarget(const BWAPI::Unit unit, const int frameCount);
+
+    // Returns the frame that the tile was last visible, or -1 if it has never been visible.
+    int getLastSeenFrame(const BWAPI::TilePosition loc) const;
+
+private:
+    struct Cell
+    {
+        // Centre of a walkable tile in the cell.
+        BWAPI::Position pos = BWAPI::Positions::None;
+        int lastSeenFrame = -1;
+        bool isReachable = false;
+        bool isClaimed = false;
+    };
+
+    struct Claim
+    {
+        int cellIndex;
+        int claimedFrame;
+    };
+
+    static int getBucket(const int lastSeenFrame);
+    void release(const BWAPI::Unit unit);
+    void markSeen(const int cellIndex, const int frameCount);
+
+    int mapWidth = 0;
+    int mapHeight = 0;
+    int cellsPerRow = 0;
+
+    std::vector<int> tileLastSeenFrames;
+    TileBitmap visible;
+
+    // The frame that visible was read.
+    int visibleFrame = -1;
+
+    // The tiles within sight range of one of my units, i.e. the only ones that can be visible
+    // (unless the whole map is revealed), so update() only asks BWAPI about those.
+    TileBitmap inSightRange;
+
+    // Reused by update() so that it doesn't allocate.
+    std::vector<BWAPI::Unit> expiredUnits;
+    std::vector<Cell> cells;
+
+    // The reachable unclaimed cells, ordered by (bucket of last seen frame, cell index).
+    std::set<std::pair<int, int>> staleCells;
+
+    std::unordered_map<BWAPI::Unit, Claim> claims;
+};
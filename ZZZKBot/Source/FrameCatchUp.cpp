@@ -0,0 +1,52 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "FrameCatchUp.h"
+#include <algorithm>
+
+void FrameCatchUp::onStart()
+{
+    lag = std::chrono::microseconds(0);
+    maxLag = std::chrono::microseconds(0);
+    numConsecutiveCoalescedFrames = 0;
+    numFrames = 0;
+    numCoalescedFrames = 0;
+}
+
+bool FrameCatchUp::shouldCoalesce(const bool isCoalescable)
+{
+    if (isCoalescable && lag >= policy.framePeriod && numConsecutiveCoalescedFrames < policy.maxConsecutiveCoalescedFrames)
+    {
+        ++numConsecutiveCoalescedFrames;
+        ++numCoalescedFrames;
+        return true;
+    }
+
+    numConsecutiveCoalescedFrames = 0;
+    return false;
+}
+
+void FrameCatchUp::onFrameProcessed(const std::chrono::microseconds duration)
+{
+    // A frame that took less than the frame period makes up some of the lag.
+    lag = std::max(std::chrono::microseconds(0), lag + duration - policy.framePeriod);
+    maxLag = std::max(maxLag, lag);
+    ++numFrames;
+}
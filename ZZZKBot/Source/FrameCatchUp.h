@@ -0,0 +1,69 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <chrono>
+
+// Keeps track of how far behind real time the bot is (i.e. how many game frames have gone by
+// that the bot hasn't caught up with yet), assuming that the game advances one frame every frame
+// period, and decides when to coalesce a stale frame, i.e. deliver its events but skip
+// onFrame() so that the bot catches up.
+// If the server waits for the bot every frame (e.g. when the game speed is 0), each frame is
+// received as soon as the previous one is sent, so the bot is never counted as behind unless
+// the frames themselves take longer than the frame period.
+class FrameCatchUp
+{
+public:
+    struct Policy
+    {
+        // The real time per game frame (42ms at the Fastest game speed).
+        std::chrono::microseconds framePeriod{ 42000 };
+
+        // How many frames in a row may be coalesced. It is off (0) unless asked for, because a
+        // coalesced frame issues no commands; how far behind the bot is is measured either way.
+        int maxConsecutiveCoalescedFrames = 0;
+    };
+
+    explicit FrameCatchUp(const Policy& newPolicy) : policy(newPolicy) {}
+
+    // Resets the measurements at the start of each match.
+    void onStart();
+
+    // Call before each frame with whether the bot allows onFrame() to be skipped for it (see
+    // ZZZKBotAIModule::isFrameCoalescable()). Returns whether onFrame() should be skipped.
+    bool shouldCoalesce(const bool isCoalescable);
+
+    // Call after each frame with the real time that the whole frame took (delivering its events,
+    // onFrame() if it wasn't coalesced, and the client update that received the next frame).
+    void onFrameProcessed(const std::chrono::microseconds duration);
+
+    double getFramesBehind() const { return (double) lag.count() / policy.framePeriod.count(); }
+    double getMaxFramesBehind() const { return (double) maxLag.count() / policy.framePeriod.count(); }
+    int getNumFrames() const { return numFrames; }
+    int getNumCoalescedFrames() const { return numCoalescedFrames; }
+
+private:
+    Policy policy;
+    std::chrono::microseconds lag{ 0 };
+    std::chrono::microseconds maxLag{ 0 };
+    int numConsecutiveCoalescedFrames = 0;
+    int numFrames = 0;
+    int numCoalescedFrames = 0;
+};
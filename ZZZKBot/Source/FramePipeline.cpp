@@ -0,0 +1,125 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "FramePipeline.h"
+#include <algorithm>
+
+void FramePipeline::clear()
+{
+    stages.clear();
+    stageWaves.clear();
+    waveCallingThreadStages.clear();
+    waveTasks.clear();
+}
+
+void FramePipeline::addStage(const std::string& name, const DataMask reads, const DataMask writes, const StageFunction& fn, const bool isCallingThreadStage)
+{
+    int wave = 0;
+    for (int i = 0; i < (int) stages.size(); ++i)
+    {
+        const Stage& other = stages[i];
+        if ((writes & (other.reads | other.writes)) != 0 || (reads & other.writes) != 0)
+        {
+            wave = std::max(wave, stageWaves[i] + 1);
+        }
+    }
+
+    Stage stage;
+    stage.name = name;
+    stage.reads = reads;
+    stage.writes = writes;
+    stage.fn = fn;
+    stage.isCallingThreadStage = isCallingThreadStage;
+    stages.push_back(stage);
+    stageWaves.push_back(wave);
+
+    if (wave >= (int) waveTasks.size())
+    {
+        waveCallingThreadStages.resize(wave + 1);
+        waveTasks.resize(wave + 1);
+    }
+
+    // Stages are never removed (only cleared all at once), and the vector of stages may
+    // reallocate as more are added, so stages are referred to by index.
+    const int stageIndex = (int) stages.size() - 1;
+    if (isCallingThreadStage)
+    {
+        waveCallingThreadStages[wave].push_back(stageIndex);
+        return;
+    }
+
+    waveTasks[wave].push_back(
+        [this, stageIndex]()
+        {
+            Stage& stage = stages[stageIndex];
+            stage.fn(stage.intents);
+        });
+}
+
+void FramePipeline::run(ThreadPool& threadPool)
+{
+    for (Stage& stage : stages)
+    {
+        stage.intents.clear();
+    }
+
+    for (int wave = 0; wave < (int) waveTasks.size(); ++wave)
+    {
+        for (const int stageIndex : waveCallingThreadStages[wave])
+        {
+            Stage& stage = stages[stageIndex];
+            stage.fn(stage.intents);
+        }
+
+        threadPool.run(waveTasks[wave]);
+    }
+
+    for (const Stage& stage : stages)
+    {
+        for (const BWAPI::UnitCommand& command : stage.intents)
+        {
+            command.getUnit()->issueCommand(command);
+        }
+    }
+}
+
+std::string FramePipeline::getScheduleString() const
+{
+    std::string str;
+    for (int wave = 0; wave < (int) waveTasks.size(); ++wave)
+    {
+        if (wave > 0)
+        {
+            str += " -> ";
+        }
+
+        bool isFirst = true;
+        for (int i = 0; i < (int) stages.size(); ++i)
+        {
+            if (stageWaves[i] == wave)
+            {
+                str += (isFirst ? "" : ",") + stages[i].name;
+                isFirst = false;
+            }
+        }
+    }
+
+    return str;
+}
@@ -0,0 +1,83 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <BWAPI.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "ThreadPool.h"
+
+// Part of a frame split into stages that each declare which data they read and which data they
+// write (as bitmasks of data identifiers chosen by the caller, e.g. one bit for the game state
+// and one for each component that a stage fills in). A stage runs after every earlier-added
+// stage that it conflicts with (i.e. one writes something that the other reads or writes), and
+// stages that don't conflict run at the same time on the thread pool, so the results are the
+// same as running them one after another in the order they were added.
+// The BWAPI client isn't thread-safe, so a stage that calls BWAPI at all must be added as a
+// calling-thread stage, which runs on the thread that calls run() (before the other stages of its
+// wave); the others must only read data that earlier stages filled in (e.g. a snapshot).
+// Stages mustn't issue BWAPI commands themselves (issuing a command changes the client's copy
+// of the unit's state, which the other stages may be reading). Instead they append command
+// intents to the vector that they are passed, and once every stage has finished the intents are
+// issued on the calling thread in the order the stages were added, so that the order of the
+// commands doesn't depend on which thread finished first.
+class FramePipeline
+{
+public:
+    typedef unsigned int DataMask;
+    typedef std::function<void(std::vector<BWAPI::UnitCommand>& intents)> StageFunction;
+
+    FramePipeline() = default;
+
+    // The tasks point back at the pipeline.
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+
+    void clear();
+
+    void addStage(const std::string& name, const DataMask reads, const DataMask writes, const StageFunction& fn, const bool isCallingThreadStage = false);
+
+    // Runs all the stages then issues their intents.
+    void run(ThreadPool& threadPool);
+
+    // For debugging, e.g. "occupancy,exploration,snapshot" means those three run at the same time.
+    std::string getScheduleString() const;
+
+private:
+    struct Stage
+    {
+        std::string name;
+        DataMask reads = 0;
+        DataMask writes = 0;
+        StageFunction fn;
+        bool isCallingThreadStage = false;
+        std::vector<BWAPI::UnitCommand> intents;
+    };
+
+    // Each wave is the stages that don't conflict with each other (the calling-thread stages by
+    // index, the others as thread pool tasks), and a wave only starts once the previous one has
+    // finished.
+    std::vector<Stage> stages;
+    std::vector<int> stageWaves;
+    std::vector<std::vector<int>> waveCallingThreadStages;
+    std::vector<std::vector<ThreadPool::Task>> waveTasks;
+};
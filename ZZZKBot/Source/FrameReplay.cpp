@@ -0,0 +1,464 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "FrameReplay.h"
+#include <algorithm>
+#include <cmath>
+
+static bool hasFlag(const GameRecord::UnitState& state, const GameRecord::UnitFlag flag)
+{
+    return (state.flags & flag) != 0;
+}
+
+void FrameReplay::TargetChoice::consider(const int id, const long long distanceSquared, const int range)
+{
+    if (targetID < 0 || distanceSquared < targetDistanceSquared || (distanceSquared == targetDistanceSquared && id < targetID))
+    {
+        targetID = id;
+        targetDistanceSquared = distanceSquared;
+    }
+
+    if (distanceSquared <= (long long) range * range &&
+        (inRangeTargetID < 0 || distanceSquared < inRangeTargetDistanceSquared || (distanceSquared == inRangeTargetDistanceSquared && id < inRangeTargetID)))
+    {
+        inRangeTargetID = id;
+        inRangeTargetDistanceSquared = distanceSquared;
+    }
+}
+
+long long FrameReplay::getDistanceSquared(const int x1, const int y1, const int x2, const int y2)
+{
+    const long long dx = x2 - x1;
+    const long long dy = y2 - y1;
+    return dx * dx + dy * dy;
+}
+
+int FrameReplay::getDistance(const GameRecord::UnitState& a, const GameRecord::UnitState& b)
+{
+    return (int) std::sqrt((double) getDistanceSquared(a.x, a.y, b.x, b.y));
+}
+
+BWAPI::TilePosition FrameReplay::getFootprintTopLeft(const GameRecord::UnitState& state, const BWAPI::UnitType type)
+{
+    return BWAPI::TilePosition((state.x - type.tileWidth() * 16) / 32, (state.y - type.tileHeight() * 16) / 32);
+}
+
+void FrameReplay::onStart(const GameRecord::MatchInfo& newMatchInfo)
+{
+    matchInfo = newMatchInfo;
+    selfPlayers.clear();
+    enemyPlayers.clear();
+    selfRace = BWAPI::Races::Unknown;
+    enemyRace = BWAPI::Races::Unknown;
+    for (const GameRecord::PlayerInfo& player : matchInfo.players)
+    {
+        if (player.id < 0)
+        {
+            continue;
+        }
+
+        if (player.id >= (int) selfPlayers.size())
+        {
+            selfPlayers.resize(player.id + 1, false);
+            enemyPlayers.resize(player.id + 1, false);
+        }
+
+        selfPlayers[player.id] = player.isSelf;
+        enemyPlayers[player.id] = player.isEnemy;
+        if (player.isSelf)
+        {
+            selfRace = BWAPI::Race(player.raceID);
+        }
+        else if (player.isEnemy && enemyRace == BWAPI::Races::Unknown)
+        {
+            enemyRace = BWAPI::Race(player.raceID);
+        }
+    }
+
+    myUnits.clear();
+    enemyUnits.clear();
+    neutralUnits.clear();
+    myResourceDepot = nullptr;
+    myStartLoc = BWAPI::TilePositions::Unknown;
+    numCommands = 0;
+
+    attackers.clear();
+    targetChoices.clear();
+    attackerIDToTargetID.clear();
+
+    gatherers.clear();
+    minerals.clear();
+    costs.clear();
+    gathererToMineral.clear();
+    solver.clear();
+    gathererIDToRow.clear();
+    mineralIDToCol.clear();
+    gathererIDToMineralID.clear();
+
+    initialCreepLocsMap.clear();
+    InitialCreep::forEachStartLoc(
+        matchInfo.mapHash,
+        [this](const BWAPI::TilePosition startLoc, const std::vector<int>& creepLocXY)
+        {
+            for (unsigned int i = 0; i + 1 < creepLocXY.size(); i += 2)
+            {
+                initialCreepLocsMap[startLoc].insert(BWAPI::TilePosition(creepLocXY[i], creepLocXY[i + 1]));
+            }
+        });
+    scoutedOtherStartLocs.clear();
+    startLocChecks.clear();
+    visibleTiles.reset(matchInfo.mapWidth, matchInfo.mapHeight);
+    buildingTiles.reset(matchInfo.mapWidth, matchInfo.mapHeight);
+    creepTiles.reset(matchInfo.mapWidth, matchInfo.mapHeight);
+}
+
+void FrameReplay::onFrame(const GameRecord::Frame& frame)
+{
+    numCommands = 0;
+    classifyUnits(frame);
+    chooseTargets();
+    pairGatherers();
+    checkStartLocations(frame);
+}
+
+bool FrameReplay::isCreepChecked() const
+{
+    // Like the bot, only against an enemy that is (or may be) Zerg.
+    return
+        !initialCreepLocsMap.empty() &&
+        myStartLoc != BWAPI::TilePositions::Unknown &&
+        (enemyRace == BWAPI::Races::Zerg || enemyRace == BWAPI::Races::Random);
+}
+
+bool FrameReplay::isEnemyZergBaseAt(const BWAPI::TilePosition startLoc) const
+{
+    for (const FrameUnit& unit : enemyUnits)
+    {
+        if ((unit.type == BWAPI::UnitTypes::Zerg_Hatchery || unit.type == BWAPI::UnitTypes::Zerg_Lair || unit.type == BWAPI::UnitTypes::Zerg_Hive) &&
+            getFootprintTopLeft(*unit.state, unit.type) == startLoc)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void FrameReplay::classifyUnits(const GameRecord::Frame& frame)
+{
+    myUnits.clear();
+    enemyUnits.clear();
+    neutralUnits.clear();
+    for (const GameRecord::UnitState& state : frame.units)
+    {
+        const FrameUnit unit = { &state, BWAPI::UnitType(state.typeID) };
+        if (isSelfPlayer(state.playerID))
+        {
+            myUnits.push_back(unit);
+        }
+        else if (isEnemyPlayer(state.playerID))
+        {
+            enemyUnits.push_back(unit);
+        }
+        else
+        {
+            neutralUnits.push_back(unit);
+        }
+    }
+
+    myResourceDepot = nullptr;
+    for (const FrameUnit& unit : myUnits)
+    {
+        if (unit.type.isResourceDepot() && hasFlag(*unit.state, GameRecord::completedFlag) && !hasFlag(*unit.state, GameRecord::liftedFlag))
+        {
+            myResourceDepot = &unit;
+            break;
+        }
+    }
+
+    if (myStartLoc == BWAPI::TilePositions::Unknown && myResourceDepot != nullptr)
+    {
+        long long bestDistanceSquared = 0;
+        for (const std::pair<int, int>& startLocation : matchInfo.startLocations)
+        {
+            const BWAPI::TilePosition startLoc(startLocation.first, startLocation.second);
+            const long long distanceSquared = getDistanceSquared(myResourceDepot->state->x, myResourceDepot->state->y, startLoc.x * 32 + 64, startLoc.y * 32 + 48);
+            if (myStartLoc == BWAPI::TilePositions::Unknown || distanceSquared < bestDistanceSquared)
+            {
+                myStartLoc = startLoc;
+                bestDistanceSquared = distanceSquared;
+            }
+        }
+    }
+}
+
+void FrameReplay::chooseTargets()
+{
+    attackers.clear();
+    for (const FrameUnit& unit : myUnits)
+    {
+        if (hasFlag(*unit.state, GameRecord::completedFlag) &&
+            (unit.type.groundWeapon() != BWAPI::WeaponTypes::None || unit.type.airWeapon() != BWAPI::WeaponTypes::None))
+        {
+            attackers.push_back(&unit);
+        }
+    }
+
+    // The positions of the candidates are copied into arrays (one set for ground targets and one
+    // for air targets) once per frame, then all the attackers are evaluated at the same time.
+    for (Candidates* candidates : { &groundCandidates, &airCandidates })
+    {
+        candidates->ids.clear();
+        candidates->xs.clear();
+        candidates->ys.clear();
+    }
+    for (const FrameUnit& unit : enemyUnits)
+    {
+        Candidates& candidates = hasFlag(*unit.state, GameRecord::flyingFlag) ? airCandidates : groundCandidates;
+        candidates.ids.push_back(unit.state->id);
+        candidates.xs.push_back(unit.state->x);
+        candidates.ys.push_back(unit.state->y);
+    }
+
+    targetChoices.assign(attackers.size(), TargetChoice());
+    threadPool.parallelFor(
+        (int) attackers.size(),
+        [this](const int i)
+        {
+            const FrameUnit& attacker = *attackers[i];
+            TargetChoice& choice = targetChoices[i];
+            const std::pair<const Candidates*, BWAPI::WeaponType> candidatesAndWeapons[] =
+            {
+                std::make_pair(&groundCandidates, attacker.type.groundWeapon()),
+                std::make_pair(&airCandidates, attacker.type.airWeapon())
+            };
+
+            for (const std::pair<const Candidates*, BWAPI::WeaponType>& candidatesAndWeapon : candidatesAndWeapons)
+            {
+                if (candidatesAndWeapon.second == BWAPI::WeaponTypes::None)
+                {
+                    continue;
+                }
+
+                const Candidates& candidates = *candidatesAndWeapon.first;
+                const int range = candidatesAndWeapon.second.maxRange();
+                for (size_t j = 0; j < candidates.ids.size(); ++j)
+                {
+                    choice.consider(candidates.ids[j], getDistanceSquared(attacker.state->x, attacker.state->y, candidates.xs[j], candidates.ys[j]), range);
+                }
+            }
+        });
+
+    // Like the bot, a target in range is preferred.
+    for (size_t i = 0; i < attackers.size(); ++i)
+    {
+        const int targetID = targetChoices[i].inRangeTargetID >= 0 ? targetChoices[i].inRangeTargetID : targetChoices[i].targetID;
+        int& lastTargetID = attackerIDToTargetID.emplace(attackers[i]->state->id, -1).first->second;
+        if (targetID >= 0 && targetID != lastTargetID)
+        {
+            ++numCommands;
+        }
+        lastTargetID = targetID;
+    }
+}
+
+void FrameReplay::pairGatherers()
+{
+    gatherers.clear();
+    minerals.clear();
+    if (myResourceDepot != nullptr)
+    {
+        const GameRecord::UnitState& depot = *myResourceDepot->state;
+        for (const FrameUnit& unit : myUnits)
+        {
+            if (unit.type.isWorker() &&
+                hasFlag(*unit.state, GameRecord::completedFlag) &&
+                (hasFlag(*unit.state, GameRecord::idleFlag) || hasFlag(*unit.state, GameRecord::gatheringMineralsFlag)) &&
+                getDistance(*unit.state, depot) <= maxGathererDistance)
+            {
+                gatherers.push_back(unit.state);
+            }
+        }
+
+        for (const FrameUnit& unit : neutralUnits)
+        {
+            if (unit.type.isMineralField() && getDistance(*unit.state, depot) <= maxMineralDistance)
+            {
+                minerals.push_back(unit.state);
+            }
+        }
+    }
+
+    // The same cost as the bot's: mainly the distance from the mineral patch to the depot, then
+    // the distance from the gatherer to the mineral patch.
+    costs.resize(gatherers.size());
+    for (size_t i = 0; i < gatherers.size(); ++i)
+    {
+        costs[i].resize(minerals.size());
+        for (size_t j = 0; j < minerals.size(); ++j)
+        {
+            costs[i][j] = 8LL * getDistance(*minerals[j], *myResourceDepot->state) + getDistance(*gatherers[i], *minerals[j]);
+        }
+    }
+
+    // The gatherers/mineral patches that are no longer there are removed from the solver and the
+    // new ones are added.
+    for (std::map<int, int>::iterator iter = gathererIDToRow.begin(); iter != gathererIDToRow.end(); )
+    {
+        if (std::none_of(gatherers.begin(), gatherers.end(), [&iter](const GameRecord::UnitState* gatherer) { return gatherer->id == iter->first; }))
+        {
+            solver.removeRow(iter->second);
+            gathererIDToMineralID.erase(iter->first);
+            gathererIDToRow.erase(iter++);
+            continue;
+        }
+
+        ++iter;
+    }
+    for (std::map<int, int>::iterator iter = mineralIDToCol.begin(); iter != mineralIDToCol.end(); )
+    {
+        if (std::none_of(minerals.begin(), minerals.end(), [&iter](const GameRecord::UnitState* mineral) { return mineral->id == iter->first; }))
+        {
+            solver.removeColumn(iter->second);
+            mineralIDToCol.erase(iter++);
+            continue;
+        }
+
+        ++iter;
+    }
+
+    for (const GameRecord::UnitState* gatherer : gatherers)
+    {
+        if (gathererIDToRow.find(gatherer->id) == gathererIDToRow.end())
+        {
+            gathererIDToRow[gatherer->id] = solver.addRow();
+        }
+    }
+    for (const GameRecord::UnitState* mineral : minerals)
+    {
+        if (mineralIDToCol.find(mineral->id) == mineralIDToCol.end())
+        {
+            mineralIDToCol[mineral->id] = solver.addColumn();
+        }
+    }
+    for (size_t i = 0; i < gatherers.size(); ++i)
+    {
+        for (size_t j = 0; j < minerals.size(); ++j)
+        {
+            solver.setCost(gathererIDToRow[gatherers[i]->id], mineralIDToCol[minerals[j]->id], costs[i][j]);
+        }
+    }
+    solver.solve();
+
+    std::vector<int> colToMineral(solver.getSize(), -1);
+    for (size_t j = 0; j < minerals.size(); ++j)
+    {
+        colToMineral[mineralIDToCol[minerals[j]->id]] = (int) j;
+    }
+
+    gathererToMineral.assign(gatherers.size(), -1);
+    for (size_t i = 0; i < gatherers.size(); ++i)
+    {
+        const int col = solver.getAssignedColumn(gathererIDToRow[gatherers[i]->id]);
+        gathererToMineral[i] = col >= 0 ? colToMineral[col] : -1;
+
+        const int mineralID = gathererToMineral[i] >= 0 ? minerals[gathererToMineral[i]]->id : -1;
+        int& lastMineralID = gathererIDToMineralID.emplace(gatherers[i]->id, -1).first->second;
+        if (mineralID >= 0 && mineralID != lastMineralID)
+        {
+            ++numCommands;
+        }
+        lastMineralID = mineralID;
+    }
+}
+
+void FrameReplay::checkStartLocations(const GameRecord::Frame& frame)
+{
+    startLocChecks.clear();
+    if (!isCreepChecked())
+    {
+        return;
+    }
+
+    // Tile bitmaps of what is visible, what is covered by buildings and what has creep, built
+    // once per frame (like the occupancy map).
+    visibleTiles.clear();
+    for (const FrameUnit& unit : myUnits)
+    {
+        const int sightRange = unit.type.sightRange();
+        for (int y = (unit.state->y - sightRange) / 32 - 1; y <= (unit.state->y + sightRange) / 32 + 1; ++y)
+        {
+            for (int x = (unit.state->x - sightRange) / 32 - 1; x <= (unit.state->x + sightRange) / 32 + 1; ++x)
+            {
+                if (getDistanceSquared(unit.state->x, unit.state->y, x * 32 + 16, y * 32 + 16) <= (long long) sightRange * sightRange)
+                {
+                    visibleTiles.set(x, y);
+                }
+            }
+        }
+    }
+
+    buildingTiles.clear();
+    for (const GameRecord::UnitState& state : frame.units)
+    {
+        const BWAPI::UnitType type(state.typeID);
+        if (type.isBuilding() && !hasFlag(state, GameRecord::liftedFlag))
+        {
+            const BWAPI::TilePosition topLeft = getFootprintTopLeft(state, type);
+            buildingTiles.setRect(topLeft.x, topLeft.y, type.tileWidth(), type.tileHeight());
+        }
+    }
+
+    creepTiles.clear();
+    for (const auto& startLocToCreepLocs : initialCreepLocsMap)
+    {
+        if (isEnemyZergBaseAt(startLocToCreepLocs.first))
+        {
+            for (const BWAPI::TilePosition loc : startLocToCreepLocs.second)
+            {
+                creepTiles.set(loc.x, loc.y);
+            }
+        }
+    }
+
+    for (const std::pair<int, int>& startLocation : matchInfo.startLocations)
+    {
+        const BWAPI::TilePosition otherStartLoc(startLocation.first, startLocation.second);
+        const auto creepLocsIter = initialCreepLocsMap.find(otherStartLoc);
+        if (otherStartLoc == myStartLoc ||
+            scoutedOtherStartLocs.find(otherStartLoc) != scoutedOtherStartLocs.end() ||
+            creepLocsIter == initialCreepLocsMap.end())
+        {
+            continue;
+        }
+
+        const InitialCreep::Evidence evidence =
+            InitialCreep::checkCreepLocs(
+                creepLocsIter->second,
+                isStoppingAtNoCreep(),
+                [this](const BWAPI::TilePosition loc) { return isCheckable(loc); },
+                [this](const BWAPI::TilePosition loc) { return hasCreep(loc); });
+        startLocChecks.push_back({ otherStartLoc, evidence });
+        if (evidence == InitialCreep::Evidence::NoCreep)
+        {
+            scoutedOtherStartLocs.insert(otherStartLoc);
+        }
+    }
+}
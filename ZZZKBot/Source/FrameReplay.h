@@ -0,0 +1,196 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <BWAPI.h>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "AssignmentSolver.h"
+#include "GameRecord.h"
+#include "InitialCreep.h"
+#include "ThreadPool.h"
+#include "TileBitmap.h"
+
+// Plays the frames of a game record (see GameRecord.h) or of a mock game through the decisions
+// of the bot's onFrame() that don't need the game, in the same (optimized) form as the bot makes
+// them, so that they can be checked and timed offline:
+// - target choice: the nearest enemy that each of my units can hit (and the nearest one in
+//   range), from per-frame arrays of the candidates evaluated on the thread pool (like the frame
+//   snapshot and the combat intents),
+// - gatherer pairing: the mineral assignment of the workers near my main base, by one solver
+//   kept between frames (like the bot's),
+// - start location inference: the creep check of the other start locations, with per-frame tile
+//   bitmaps (like the occupancy map).
+// It only uses BWAPI's value types (not the game), so the inputs are rebuilt from what a record
+// has: e.g. a tile is visible if one of my units is within its sight range, and it has creep if
+// it is in the initial creep of a start location that an enemy hatchery/lair/hive is at.
+class FrameReplay
+{
+public:
+    // A unit of the current frame with its type.
+    struct FrameUnit
+    {
+        const GameRecord::UnitState* state;
+        BWAPI::UnitType type;
+    };
+
+    // The nearest enemy unit that an attacker can hit, and the nearest one that it can hit from
+    // where it is (by the distance between centres, because a record doesn't have the unit
+    // dimensions). Ties go to the lower unit ID.
+    struct TargetChoice
+    {
+        int targetID = -1;
+        long long targetDistanceSquared = 0;
+        int inRangeTargetID = -1;
+        long long inRangeTargetDistanceSquared = 0;
+
+        void consider(const int id, const long long distanceSquared, const int range);
+    };
+
+    // The creep check of one of the other start locations.
+    struct StartLocCheck
+    {
+        BWAPI::TilePosition startLoc;
+        InitialCreep::Evidence evidence;
+    };
+
+    // How far from my main base's resource depot the workers/mineral patches of the gatherer
+    // pairing can be (in pixels).
+    static const int maxGathererDistance = 384;
+    static const int maxMineralDistance = 320;
+
+    static long long getDistanceSquared(const int x1, const int y1, const int x2, const int y2);
+    static int getDistance(const GameRecord::UnitState& a, const GameRecord::UnitState& b);
+
+    // The top left tile of the footprint of a building.
+    static BWAPI::TilePosition getFootprintTopLeft(const GameRecord::UnitState& state, const BWAPI::UnitType type);
+
+    void onStart(const GameRecord::MatchInfo& newMatchInfo);
+
+    // Makes the decisions for the frame. The frame must stay unchanged until the next call (the
+    // units of the frame point into it).
+    void onFrame(const GameRecord::Frame& frame);
+
+    const GameRecord::MatchInfo& getMatchInfo() const { return matchInfo; }
+    bool isSelfPlayer(const int playerID) const { return isPlayerIn(selfPlayers, playerID); }
+    bool isEnemyPlayer(const int playerID) const { return isPlayerIn(enemyPlayers, playerID); }
+    BWAPI::Race getSelfRace() const { return selfRace; }
+    BWAPI::Race getEnemyRace() const { return enemyRace; }
+
+    // The units of the current frame (mine, the enemy's, and the neutral ones), in order of ID.
+    const std::vector<FrameUnit>& getMyUnits() const { return myUnits; }
+    const std::vector<FrameUnit>& getEnemyUnits() const { return enemyUnits; }
+    const std::vector<FrameUnit>& getNeutralUnits() const { return neutralUnits; }
+
+    // My main base's resource depot (the first completed one in order of ID), or nullptr.
+    const FrameUnit* getMyResourceDepot() const { return myResourceDepot; }
+
+    // The start location nearest to my first resource depot (Unknown until there is one).
+    BWAPI::TilePosition getMyStartLoc() const { return myStartLoc; }
+
+    // Target choice: my units that can attack, and the choice of each.
+    const std::vector<const FrameUnit*>& getAttackers() const { return attackers; }
+    const std::vector<TargetChoice>& getTargetChoices() const { return targetChoices; }
+
+    // Gatherer pairing: the gatherers and mineral patches, the cost of each pair, and the mineral
+    // patch (index) assigned to each gatherer (or -1).
+    const std::vector<const GameRecord::UnitState*>& getGatherers() const { return gatherers; }
+    const std::vector<const GameRecord::UnitState*>& getMinerals() const { return minerals; }
+    const std::vector<std::vector<long long> >& getCosts() const { return costs; }
+    const std::vector<int>& getGathererToMineral() const { return gathererToMineral; }
+
+    // Start location inference: the initial creep of each start location of the map, whether the
+    // enemy may be Zerg (otherwise there are no checks), and the checks of this frame.
+    const std::map<BWAPI::TilePosition, std::set<BWAPI::TilePosition> >& getInitialCreepLocsMap() const { return initialCreepLocsMap; }
+    bool isCreepChecked() const;
+    bool isStoppingAtNoCreep() const { return enemyRace == BWAPI::Races::Zerg; }
+    const std::vector<StartLocCheck>& getStartLocChecks() const { return startLocChecks; }
+    bool isCheckable(const BWAPI::TilePosition loc) const { return visibleTiles.get(loc.x, loc.y) && !buildingTiles.get(loc.x, loc.y); }
+    bool hasCreep(const BWAPI::TilePosition loc) const { return creepTiles.get(loc.x, loc.y); }
+
+    // Whether an enemy hatchery/lair/hive is at the start location (i.e. its initial creep is there).
+    bool isEnemyZergBaseAt(const BWAPI::TilePosition startLoc) const;
+
+    // The number of commands that the decisions of the frame would have issued, i.e. the number
+    // of attackers whose targets changed plus the number of gatherers whose mineral patches did.
+    int getNumCommands() const { return numCommands; }
+
+private:
+    static bool isPlayerIn(const std::vector<bool>& isPlayer, const int playerID)
+    {
+        return playerID >= 0 && playerID < (int) isPlayer.size() && isPlayer[playerID];
+    }
+
+    void classifyUnits(const GameRecord::Frame& frame);
+    void chooseTargets();
+    void pairGatherers();
+    void checkStartLocations(const GameRecord::Frame& frame);
+
+    GameRecord::MatchInfo matchInfo;
+    std::vector<bool> selfPlayers;
+    std::vector<bool> enemyPlayers;
+    BWAPI::Race selfRace;
+    BWAPI::Race enemyRace;
+
+    std::vector<FrameUnit> myUnits;
+    std::vector<FrameUnit> enemyUnits;
+    std::vector<FrameUnit> neutralUnits;
+    const FrameUnit* myResourceDepot = nullptr;
+    BWAPI::TilePosition myStartLoc = BWAPI::TilePositions::Unknown;
+    int numCommands = 0;
+
+    ThreadPool threadPool;
+
+    // Target choice, with the arrays of the ground/air candidates, and the targets of the last
+    // frame (by attacker ID) to count the changes.
+    struct Candidates
+    {
+        std::vector<int> ids;
+        std::vector<int> xs;
+        std::vector<int> ys;
+    };
+
+    std::vector<const FrameUnit*> attackers;
+    std::vector<TargetChoice> targetChoices;
+    Candidates groundCandidates;
+    Candidates airCandidates;
+    std::map<int, int> attackerIDToTargetID;
+
+    // Gatherer pairing, with the rows/columns of the gatherers/mineral patches (by unit ID), and
+    // the mineral patches of the last frame (by gatherer ID) to count the changes.
+    std::vector<const GameRecord::UnitState*> gatherers;
+    std::vector<const GameRecord::UnitState*> minerals;
+    std::vector<std::vector<long long> > costs;
+    std::vector<int> gathererToMineral;
+    AssignmentSolver solver;
+    std::map<int, int> gathererIDToRow;
+    std::map<int, int> mineralIDToCol;
+    std::map<int, int> gathererIDToMineralID;
+
+    // Start location inference.
+    std::map<BWAPI::TilePosition, std::set<BWAPI::TilePosition> > initialCreepLocsMap;
+    std::set<BWAPI::TilePosition> scoutedOtherStartLocs;
+    std::vector<StartLocCheck> startLocChecks;
+    TileBitmap visibleTiles;
+    TileBitmap buildingTiles;
+    TileBitmap creepTiles;
+};
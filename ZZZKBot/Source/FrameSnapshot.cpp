@@ -0,0 +1,302 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <cstdlib>
+
+#include "FrameSnapshot.h"
+
+void FrameSnapshot::update(BWAPI::Game& Broodwar)
+{
+    // Only reset the entries of the units in the previous snapshot rather than the whole map.
+    for (const int id : ids)
+    {
+        idToIndex[id] = -1;
+    }
+
+    units.clear();
+    ids.clear();
+    types.clear();
+    players.clear();
+    positions.clear();
+    hitPoints.clear();
+    shields.clear();
+    defenseMatrixPoints.clear();
+    groundWeaponCooldowns.clear();
+    airWeaponCooldowns.clear();
+    spellCooldowns.clear();
+    orders.clear();
+    targets.clear();
+    orderTargets.clear();
+    interceptorCounts.clear();
+    acidSporeCounts.clear();
+    killCounts.clear();
+    lefts.clear();
+    tops.clear();
+    rights.clear();
+    bottoms.clear();
+    flags.clear();
+    indexesByLeft.clear();
+    maxWidth = 0;
+
+    const BWAPI::Player self = Broodwar->self();
+
+    for (const BWAPI::Unit unit : Broodwar->getAllUnits())
+    {
+        const int id = unit->getID();
+        if (id < 0)
+        {
+            continue;
+        }
+
+        if (id >= (int) idToIndex.size())
+        {
+            idToIndex.resize(id + 1, -1);
+        }
+
+        idToIndex[id] = (int) units.size();
+        units.push_back(unit);
+        ids.push_back(id);
+        types.push_back(unit->getType());
+        players.push_back(unit->getPlayer());
+        positions.push_back(unit->getPosition());
+        hitPoints.push_back(unit->getHitPoints());
+        shields.push_back(unit->getShields());
+        defenseMatrixPoints.push_back(unit->getDefenseMatrixPoints());
+        groundWeaponCooldowns.push_back(unit->getGroundWeaponCooldown());
+        airWeaponCooldowns.push_back(unit->getAirWeaponCooldown());
+        spellCooldowns.push_back(unit->getSpellCooldown());
+        orders.push_back(unit->getOrder());
+        targets.push_back(unit->getTarget());
+        orderTargets.push_back(unit->getOrderTarget());
+        interceptorCounts.push_back(unit->getInterceptorCount());
+        acidSporeCounts.push_back(unit->getAcidSporeCount());
+        killCounts.push_back(unit->getKillCount());
+        lefts.push_back(unit->getLeft());
+        tops.push_back(unit->getTop());
+        rights.push_back(unit->getRight());
+        bottoms.push_back(unit->getBottom());
+        indexesByLeft.push_back(idToIndex[id]);
+        maxWidth = std::max(maxWidth, unit->getRight() - unit->getLeft());
+
+        unsigned long long unitFlags = 0;
+        unitFlags |= unit->isCompleted() ? (unsigned long long) completedFlag : 0;
+        unitFlags |= unit->isFlying() ? (unsigned long long) flyingFlag : 0;
+        unitFlags |= unit->isMoving() ? (unsigned long long) movingFlag : 0;
+        unitFlags |= unit->isIdle() ? (unsigned long long) idleFlag : 0;
+        unitFlags |= unit->isPowered() ? (unsigned long long) poweredFlag : 0;
+        unitFlags |= unit->isLockedDown() ? (unsigned long long) lockedDownFlag : 0;
+        unitFlags |= unit->isMaelstrommed() ? (unsigned long long) maelstrommedFlag : 0;
+        unitFlags |= unit->isIrradiated() ? (unsigned long long) irradiatedFlag : 0;
+        unitFlags |= unit->isBeingHealed() ? (unsigned long long) beingHealedFlag : 0;
+        unitFlags |= unit->isRepairing() ? (unsigned long long) repairingFlag : 0;
+        unitFlags |= unit->isConstructing() ? (unsigned long long) constructingFlag : 0;
+        unitFlags |= unit->isPlagued() ? (unsigned long long) plaguedFlag : 0;
+        unitFlags |= unit->isAttacking() ? (unsigned long long) attackingFlag : 0;
+        unitFlags |= unit->isStartingAttack() ? (unsigned long long) startingAttackFlag : 0;
+        unitFlags |= unit->isAttackFrame() ? (unsigned long long) attackFrameFlag : 0;
+        unitFlags |= unit->isHoldingPosition() ? (unsigned long long) holdingPositionFlag : 0;
+        unitFlags |= unit->isBraking() ? (unsigned long long) brakingFlag : 0;
+        unitFlags |= unit->isAccelerating() ? (unsigned long long) acceleratingFlag : 0;
+        unitFlags |= unit->isMorphing() ? (unsigned long long) morphingFlag : 0;
+        unitFlags |= unit->isBeingConstructed() ? (unsigned long long) beingConstructedFlag : 0;
+        unitFlags |= unit->isCarryingGas() ? (unsigned long long) carryingGasFlag : 0;
+        unitFlags |= unit->isCarryingMinerals() ? (unsigned long long) carryingMineralsFlag : 0;
+        unitFlags |= unit->isGatheringMinerals() ? (unsigned long long) gatheringMineralsFlag : 0;
+        unitFlags |= unit->isGatheringGas() ? (unsigned long long) gatheringGasFlag : 0;
+        unitFlags |= unit->isBlind() ? (unsigned long long) blindFlag : 0;
+        unitFlags |= unit->isUnderAttack() ? (unsigned long long) underAttackFlag : 0;
+        unitFlags |= unit->isDetected() ? (unsigned long long) detectedFlag : 0;
+        unitFlags |= unit->isVisible() ? (unsigned long long) visibleFlag : 0;
+        unitFlags |= unit->getPowerUp() != nullptr ? (unsigned long long) powerUpFlag : 0;
+        unitFlags |= unit->isStasised() ? (unsigned long long) stasisedFlag : 0;
+        unitFlags |= unit->isLifted() ? (unsigned long long) liftedFlag : 0;
+        unitFlags |= unit->isInvincible() ? (unsigned long long) invincibleFlag : 0;
+        unitFlags |= unit->isLoaded() ? (unsigned long long) loadedFlag : 0;
+        unitFlags |= unit->getPlayer()->isEnemy(self) ? (unsigned long long) enemyFlag : 0;
+        unitFlags |= unit->getPlayer() == self ? (unsigned long long) mineFlag : 0;
+        flags.push_back(unitFlags);
+    }
+
+    std::sort(
+        indexesByLeft.begin(),
+        indexesByLeft.end(),
+        [this](const int i, const int j)
+        {
+            return lefts[i] < lefts[j] || (lefts[i] == lefts[j] && i < j);
+        });
+
+    for (const BWAPI::Player player : Broodwar->getPlayers())
+    {
+        const int offset = player->getID() * BWAPI::WeaponTypes::Enum::MAX;
+        if (offset + BWAPI::WeaponTypes::Enum::MAX > (int) weaponMaxRanges.size())
+        {
+            weaponMaxRanges.resize(offset + BWAPI::WeaponTypes::Enum::MAX, 0);
+        }
+
+        for (int weaponID = 0; weaponID < BWAPI::WeaponTypes::Enum::MAX; ++weaponID)
+        {
+            weaponMaxRanges[offset + weaponID] = player->weaponMaxRange(BWAPI::WeaponType(weaponID));
+        }
+    }
+}
+
+int FrameSnapshot::getIndex(const BWAPI::Unit unit) const
+{
+    if (unit == nullptr)
+    {
+        return -1;
+    }
+
+    const int id = unit->getID();
+    return id >= 0 && id < (int) idToIndex.size() ? idToIndex[id] : -1;
+}
+
+int FrameSnapshot::getWeaponMaxRange(const int i, const BWAPI::WeaponType weapon) const
+{
+    const int index = players[i]->getID() * BWAPI::WeaponTypes::Enum::MAX + weapon.getID();
+    return index >= 0 && index < (int) weaponMaxRanges.size() ? weaponMaxRanges[index] : 0;
+}
+
+// The same approximation as Position::getApproxDistance().
+static int getApproxDistance(int xDist, int yDist)
+{
+    xDist = std::abs(xDist);
+    yDist = std::abs(yDist);
+    const int minDist = std::min(xDist, yDist);
+    const int maxDist = std::max(xDist, yDist);
+    if (minDist < (maxDist >> 2))
+    {
+        return maxDist;
+    }
+
+    const int minCalc = (3 * minDist) >> 3;
+    return (minCalc >> 5) + minCalc + maxDist - (maxDist >> 4) - (maxDist >> 6);
+}
+
+int FrameSnapshot::getDistance(const int i, const int j) const
+{
+    int xDist = lefts[i] - (rights[j] + 1);
+    if (xDist < 0)
+    {
+        xDist = lefts[j] - (rights[i] + 1);
+        if (xDist < 0)
+        {
+            xDist = 0;
+        }
+    }
+
+    int yDist = tops[i] - (bottoms[j] + 1);
+    if (yDist < 0)
+    {
+        yDist = tops[j] - (bottoms[i] + 1);
+        if (yDist < 0)
+        {
+            yDist = 0;
+        }
+    }
+
+    return getApproxDistance(xDist, yDist);
+}
+
+int FrameSnapshot::getDistance(const int i, const BWAPI::Position pos) const
+{
+    int xDist = lefts[i] - (pos.x + 1);
+    if (xDist < 0)
+    {
+        xDist = (pos.x - 1) - rights[i];
+        if (xDist < 0)
+        {
+            xDist = 0;
+        }
+    }
+
+    int yDist = tops[i] - (pos.y + 1);
+    if (yDist < 0)
+    {
+        yDist = (pos.y - 1) - bottoms[i];
+        if (yDist < 0)
+        {
+            yDist = 0;
+        }
+    }
+
+    return getApproxDistance(xDist, yDist);
+}
+
+bool FrameSnapshot::isInWeaponRange(const int i, const int j) const
+{
+    const BWAPI::WeaponType weapon = isFlying(j) ? types[i].airWeapon() : types[i].groundWeapon();
+    if (weapon == BWAPI::WeaponTypes::None || weapon == BWAPI::WeaponTypes::Unknown)
+    {
+        return false;
+    }
+
+    const int minRange = weapon.minRange();
+    const int maxRange = getWeaponMaxRange(i, weapon);
+    const int distance = getDistance(i, j);
+    return (minRange == 0 || minRange < distance) && distance <= maxRange;
+}
+
+bool FrameSnapshot::canAttack(const int i, const int j) const
+{
+    if (i == j)
+    {
+        return false;
+    }
+
+    const BWAPI::UnitType targetType = types[j];
+    if (!isCompleted(j) &&
+        !targetType.isBuilding() &&
+        !isMorphing(j) &&
+        targetType != BWAPI::UnitTypes::Protoss_Archon &&
+        targetType != BWAPI::UnitTypes::Protoss_Dark_Archon)
+    {
+        return false;
+    }
+
+    if (targetType == BWAPI::UnitTypes::Spell_Scanner_Sweep ||
+        targetType == BWAPI::UnitTypes::Spell_Dark_Swarm ||
+        targetType == BWAPI::UnitTypes::Spell_Disruption_Web ||
+        targetType == BWAPI::UnitTypes::Special_Map_Revealer ||
+        isInvincible(j))
+    {
+        return false;
+    }
+
+    const BWAPI::UnitType type = types[i];
+    const BWAPI::WeaponType weapon = isFlying(j) ? type.airWeapon() : type.groundWeapon();
+    if (weapon == BWAPI::WeaponTypes::None)
+    {
+        if (type == BWAPI::UnitTypes::Protoss_Reaver || type == BWAPI::UnitTypes::Hero_Warbringer)
+        {
+            if (isFlying(j))
+            {
+                return false;
+            }
+        }
+        else if (type != BWAPI::UnitTypes::Protoss_Carrier && type != BWAPI::UnitTypes::Hero_Gantrithor)
+        {
+            return false;
+        }
+    }
+
+    return (type.canMove() && type != BWAPI::UnitTypes::Zerg_Lurker) || isInWeaponRange(i, j);
+}
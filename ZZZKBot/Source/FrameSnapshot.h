@@ -0,0 +1,234 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+#include <BWAPI.h>
+#include <algorithm>
+#include <vector>
+
+// A copy of the state of every unit that is accessible this frame, taken once at the start of
+// the frame and stored as structure-of-arrays (one array per field, indexed by the unit's index
+// in the snapshot), so that hot code such as target selection comparators reads plain arrays
+// instead of going through the client game state for the same units over and over.
+// It isn't changed again until the next update(), so it is safe to read from other threads while
+// the frame is being processed.
+class FrameSnapshot
+{
+public:
+    // Re-copies the state of all the accessible units. Call this once at the start of each frame.
+    void update(BWAPI::Game& Broodwar);
+
+    int size() const { return (int) units.size(); }
+
+    // Returns the index of the unit in the snapshot, or -1 if it isn't in it (every unit that is
+    // accessible this frame is, e.g. all those returned by getUnitsInRadius() etc).
+    int getIndex(const BWAPI::Unit unit) const;
+
+    BWAPI::Unit getUnit(const int i) const { return units[i]; }
+    int getID(const int i) const { return ids[i]; }
+    BWAPI::UnitType getType(const int i) const { return types[i]; }
+    BWAPI::Player getPlayer(const int i) const { return players[i]; }
+    BWAPI::Position getPosition(const int i) const { return positions[i]; }
+    int getHitPoints(const int i) const { return hitPoints[i]; }
+    int getShields(const int i) const { return shields[i]; }
+    int getDefenseMatrixPoints(const int i) const { return defenseMatrixPoints[i]; }
+    int getGroundWeaponCooldown(const int i) const { return groundWeaponCooldowns[i]; }
+    int getAirWeaponCooldown(const int i) const { return airWeaponCooldowns[i]; }
+    int getSpellCooldown(const int i) const { return spellCooldowns[i]; }
+    BWAPI::Order getOrder(const int i) const { return orders[i]; }
+    BWAPI::Unit getTarget(const int i) const { return targets[i]; }
+    BWAPI::Unit getOrderTarget(const int i) const { return orderTargets[i]; }
+    int getInterceptorCount(const int i) const { return interceptorCounts[i]; }
+    int getAcidSporeCount(const int i) const { return acidSporeCounts[i]; }
+    int getKillCount(const int i) const { return killCounts[i]; }
+
+    bool isCompleted(const int i) const { return hasFlag(i, completedFlag); }
+    bool isFlying(const int i) const { return hasFlag(i, flyingFlag); }
+    bool isMoving(const int i) const { return hasFlag(i, movingFlag); }
+    bool isIdle(const int i) const { return hasFlag(i, idleFlag); }
+    bool isPowered(const int i) const { return hasFlag(i, poweredFlag); }
+    bool isLockedDown(const int i) const { return hasFlag(i, lockedDownFlag); }
+    bool isMaelstrommed(const int i) const { return hasFlag(i, maelstrommedFlag); }
+    bool isIrradiated(const int i) const { return hasFlag(i, irradiatedFlag); }
+    bool isBeingHealed(const int i) const { return hasFlag(i, beingHealedFlag); }
+    bool isRepairing(const int i) const { return hasFlag(i, repairingFlag); }
+    bool isConstructing(const int i) const { return hasFlag(i, constructingFlag); }
+    bool isPlagued(const int i) const { return hasFlag(i, plaguedFlag); }
+    bool isAttacking(const int i) const { return hasFlag(i, attackingFlag); }
+    bool isStartingAttack(const int i) const { return hasFlag(i, startingAttackFlag); }
+    bool isAttackFrame(const int i) const { return hasFlag(i, attackFrameFlag); }
+    bool isHoldingPosition(const int i) const { return hasFlag(i, holdingPositionFlag); }
+    bool isBraking(const int i) const { return hasFlag(i, brakingFlag); }
+    bool isAccelerating(const int i) const { return hasFlag(i, acceleratingFlag); }
+    bool isMorphing(const int i) const { return hasFlag(i, morphingFlag); }
+    bool isBeingConstructed(const int i) const { return hasFlag(i, beingConstructedFlag); }
+    bool isCarryingGas(const int i) const { return hasFlag(i, carryingGasFlag); }
+    bool isCarryingMinerals(const int i) const { return hasFlag(i, carryingMineralsFlag); }
+    bool isGatheringMinerals(const int i) const { return hasFlag(i, gatheringMineralsFlag); }
+    bool isGatheringGas(const int i) const { return hasFlag(i, gatheringGasFlag); }
+    bool isBlind(const int i) const { return hasFlag(i, blindFlag); }
+    bool isUnderAttack(const int i) const { return hasFlag(i, underAttackFlag); }
+    bool isDetected(const int i) const { return hasFlag(i, detectedFlag); }
+    bool isVisible(const int i) const { return hasFlag(i, visibleFlag); }
+    bool hasPowerUp(const int i) const { return hasFlag(i, powerUpFlag); }
+    bool isStasised(const int i) const { return hasFlag(i, stasisedFlag); }
+    bool isLifted(const int i) const { return hasFlag(i, liftedFlag); }
+    bool isInvincible(const int i) const { return hasFlag(i, invincibleFlag); }
+    bool isLoaded(const int i) const { return hasFlag(i, loadedFlag); }
+
+    // Whether the unit's player is an enemy of mine / is me.
+    bool isEnemy(const int i) const { return hasFlag(i, enemyFlag); }
+    bool isMine(const int i) const { return hasFlag(i, mineFlag); }
+
+    int getLeft(const int i) const { return lefts[i]; }
+    int getTop(const int i) const { return tops[i]; }
+    int getRight(const int i) const { return rights[i]; }
+    int getBottom(const int i) const { return bottoms[i]; }
+
+    // The maximum range of the weapon for the unit's player, i.e. including upgrades, like
+    // Player::weaponMaxRange().
+    int getWeaponMaxRange(const int i, const BWAPI::WeaponType weapon) const;
+
+    // The distance between the edges of the units (or from the edges of the unit to the
+    // position), using the same approximation as Unit::getDistance().
+    int getDistance(const int i, const int j) const;
+    int getDistance(const int i, const BWAPI::Position pos) const;
+
+    // Like Unit::isInWeaponRange(), i.e. whether unit j is within range of the weapon that unit i
+    // would use against it.
+    bool isInWeaponRange(const int i, const int j) const;
+
+    // Like Unit::canAttack(target) but only the checks that depend on the target, i.e. the caller
+    // must already know that unit i can be commanded to attack at all (Unit::canAttack()).
+    bool canAttack(const int i, const int j) const;
+
+    // Calls fn(j) for each unit j whose bounding box overlaps the rectangle (inclusive), like
+    // Game::getUnitsInRectangle() does, in order of their left edges. Stops at the first unit for
+    // which fn returns true and returns its index, or returns -1.
+    template <class Function>
+    int findInRectangle(const int left, const int top, const int right, const int bottom, Function fn) const
+    {
+        // Units are sorted by their left edges, and no unit is wider than maxWidth, so units that
+        // start before left - maxWidth can't reach the rectangle.
+        auto it = std::lower_bound(
+            indexesByLeft.begin(),
+            indexesByLeft.end(),
+            left - maxWidth,
+            [this](const int i, const int x)
+            {
+                return lefts[i] < x;
+            });
+        for (; it != indexesByLeft.end() && lefts[*it] <= right; ++it)
+        {
+            const int j = *it;
+            if (rights[j] >= left && tops[j] <= bottom && bottoms[j] >= top && fn(j))
+            {
+                return j;
+            }
+        }
+
+        return -1;
+    }
+
+    // Like findInRectangle() for the square that Game::getBestUnit() etc search for the radius.
+    template <class Function>
+    int findInRadius(const BWAPI::Position center, const int radius, Function fn) const
+    {
+        return findInRectangle(center.x - radius, center.y - radius, center.x + radius, center.y + radius, fn);
+    }
+
+private:
+    enum Flag : unsigned long long
+    {
+        completedFlag = 1u << 0,
+        flyingFlag = 1u << 1,
+        movingFlag = 1u << 2,
+        idleFlag = 1u << 3,
+        poweredFlag = 1u << 4,
+        lockedDownFlag = 1u << 5,
+        maelstrommedFlag = 1u << 6,
+        irradiatedFlag = 1u << 7,
+        beingHealedFlag = 1u << 8,
+        repairingFlag = 1u << 9,
+        constructingFlag = 1u << 10,
+        plaguedFlag = 1u << 11,
+        attackingFlag = 1u << 12,
+        startingAttackFlag = 1u << 13,
+        attackFrameFlag = 1u << 14,
+        holdingPositionFlag = 1u << 15,
+        brakingFlag = 1u << 16,
+        acceleratingFlag = 1u << 17,
+        morphingFlag = 1u << 18,
+        beingConstructedFlag = 1u << 19,
+        carryingGasFlag = 1u << 20,
+        carryingMineralsFlag = 1u << 21,
+        gatheringMineralsFlag = 1u << 22,
+        gatheringGasFlag = 1u << 23,
+        blindFlag = 1u << 24,
+        underAttackFlag = 1u << 25,
+        detectedFlag = 1u << 26,
+        visibleFlag = 1u << 27,
+        powerUpFlag = 1u << 28,
+        stasisedFlag = 1u << 29,
+        liftedFlag = 1u << 30,
+        invincibleFlag = 1u << 31,
+        enemyFlag = 1ull << 32,
+        mineFlag = 1ull << 33,
+        loadedFlag = 1ull << 34
+    };
+
+    bool hasFlag(const int i, const Flag flag) const { return (flags[i] & flag) != 0; }
+
+    std::vector<BWAPI::Unit> units;
+    std::vector<int> ids;
+    std::vector<BWAPI::UnitType> types;
+    std::vector<BWAPI::Player> players;
+    std::vector<BWAPI::Position> positions;
+    std::vector<int> hitPoints;
+    std::vector<int> shields;
+    std::vector<int> defenseMatrixPoints;
+    std::vector<int> groundWeaponCooldowns;
+    std::vector<int> airWeaponCooldowns;
+    std::vector<int> spellCooldowns;
+    std::vector<BWAPI::Order> orders;
+    std::vector<BWAPI::Unit> targets;
+    std::vector<BWAPI::Unit> orderTargets;
+    std::vector<int> interceptorCounts;
+    std::vector<int> acidSporeCounts;
+    std::vector<int> killCounts;
+    std::vector<int> lefts;
+    std::vector<int> tops;
+    std::vector<int> rights;
+    std::vector<int> bottoms;
+    std::vector<unsigned long long> flags;
+
+    // Indexes of all the units sorted by their left edges, and the widest unit's right minus left
+    // edge, for findInRectangle().
+    std::vector<int> indexesByLeft;
+    int maxWidth = 0;
+
+    // Player::weaponMaxRange() by player ID * WeaponTypes::Enum::MAX + weapon ID, for every
+    // player.
+    std::vector<int> weaponMaxRanges;
+
+    // Index in the snapshot by unit ID (-1 if not in it).
+    std::vector<int> idToIndex;
+};
@@ -0,0 +1,63 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "FrameTimeStats.h"
+#include <algorithm>
+#include <cmath>
+
+std::chrono::microseconds FrameTimeStats::getPercentile(const double fraction) const
+{
+    if (durations.empty())
+    {
+        return std::chrono::microseconds{ 0 };
+    }
+
+    // Nearest rank.
+    const std::size_t rank = (std::size_t) std::ceil(std::max(0.0, std::min(1.0, fraction)) * durations.size());
+    const std::size_t index = rank > 0 ? rank - 1 : 0;
+    scratch = durations;
+    std::nth_element(scratch.begin(), scratch.begin() + index, scratch.end());
+    return scratch[index];
+}
+
+std::chrono::microseconds FrameTimeStats::getMax() const
+{
+    return durations.empty() ? std::chrono::microseconds{ 0 } : *std::max_element(durations.begin(), durations.end());
+}
+
+std::chrono::microseconds FrameTimeStats::getTotal() const
+{
+    std::chrono::microseconds total{ 0 };
+    for (const std::chrono::microseconds duration : durations)
+    {
+        total += duration;
+    }
+
+    return total;
+}
+
+int FrameTimeStats::countLongerThan(const std::chrono::microseconds threshold) const
+{
+    return (int) std::count_if(durations.begin(), durations.end(), [threshold](const std::chrono::microseconds duration)
+    {
+        return duration > threshold;
+    });
+}
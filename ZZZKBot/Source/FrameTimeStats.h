@@ -0,0 +1,53 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+#include <chrono>
+#include <vector>
+
+// Collects the duration of every frame (or of one stage of every frame) so that the distribution
+// can be summarized afterwards, e.g. the median, the 99th percentile and the maximum, which say
+// far more about whether the bot keeps up than the mean does.
+class FrameTimeStats
+{
+public:
+    void clear() { durations.clear(); }
+
+    void add(const std::chrono::microseconds duration) { durations.push_back(duration); }
+
+    int getNumFrames() const { return (int) durations.size(); }
+
+    // Returns the duration that the given fraction (0 to 1) of the frames took at most, e.g. 0.99
+    // for the 99th percentile (0 if there are no frames).
+    std::chrono::microseconds getPercentile(const double fraction) const;
+
+    std::chrono::microseconds getMax() const;
+    std::chrono::microseconds getTotal() const;
+
+    // The number of frames that took longer than the threshold.
+    int countLongerThan(const std::chrono::microseconds threshold) const;
+
+private:
+    std::vector<std::chrono::microseconds> durations;
+
+    // A copy of the durations for selecting percentiles (so the order they were added in is kept).
+    mutable std::vector<std::chrono::microseconds> scratch;
+};
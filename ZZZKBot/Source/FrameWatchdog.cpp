@@ -0,0 +1,215 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "FrameWatchdog.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+const FrameWatchdog::Limit FrameWatchdog::limits[FrameWatchdog::numLimits] =
+{
+    { std::chrono::milliseconds{ 55 }, 320 },
+    { std::chrono::milliseconds{ 1000 }, 10 },
+    { std::chrono::milliseconds{ 10000 }, 1 }
+};
+
+void FrameWatchdog::onStart()
+{
+    stageIndex = -1;
+    stages.clear();
+    std::fill(std::begin(numFramesOver), std::end(numFramesOver), 0);
+    maxFrameDuration = std::chrono::microseconds{ 0 };
+    lastSlowFrameCount = -1;
+    numShedFrames = 0;
+    numCoalescedFrames = 0;
+    isShed = false;
+    isShedForRestOfGame = false;
+    std::fill(std::begin(lastDeferredWorkFrameCount), std::end(lastDeferredWorkFrameCount), 0);
+    frameStart = Clock::now();
+    isFrameEnded = false;
+    isMatchEnded = false;
+}
+
+void FrameWatchdog::onFrameStart()
+{
+    if (isMatchEnded)
+    {
+        return;
+    }
+
+    const Clock::time_point now = Clock::now();
+    if (isFrameEnded)
+    {
+        finishFrame(now, endedFrameCount, isEndedFrameCoalesced);
+    }
+
+    frameStart = now;
+    stageStart = frameStart;
+    stageIndex = -1;
+    beginStage("events");
+}
+
+void FrameWatchdog::beginStage(const char* name)
+{
+    const Clock::time_point now = Clock::now();
+    endStage(now);
+    stageStart = now;
+
+    // There are only a handful of stages, so a linear search is fine.
+    stageIndex = -1;
+    for (int i = 0; i < (int) stages.size(); ++i)
+    {
+        if (std::strcmp(stages[i].name, name) == 0)
+        {
+            stageIndex = i;
+            break;
+        }
+    }
+
+    if (stageIndex < 0)
+    {
+        stageIndex = (int) stages.size();
+        stages.push_back(StageStats());
+        stages.back().name = name;
+    }
+}
+
+void FrameWatchdog::endStage(const Clock::time_point now)
+{
+    if (stageIndex < 0)
+    {
+        return;
+    }
+
+    StageStats& stage = stages[stageIndex];
+    const std::chrono::microseconds duration = std::chrono::duration_cast<std::chrono::microseconds>(now - stageStart);
+    stage.maxDuration = std::max(stage.maxDuration, duration);
+    stage.totalDuration += duration;
+    stageIndex = -1;
+}
+
+void FrameWatchdog::onFrameEnd(const int frameCount, const bool isCoalesced)
+{
+    if (isMatchEnded)
+    {
+        return;
+    }
+
+    isFrameEnded = true;
+    endedFrameCount = frameCount;
+    isEndedFrameCoalesced = isCoalesced;
+    beginStage("update");
+}
+
+void FrameWatchdog::onMatchEnd(const int frameCount)
+{
+    if (isMatchEnded)
+    {
+        return;
+    }
+
+    const Clock::time_point now = Clock::now();
+    if (isFrameEnded)
+    {
+        // The previous frame's update hasn't been followed by onFrameStart().
+        finishFrame(now, endedFrameCount, isEndedFrameCoalesced);
+    }
+    else
+    {
+        finishFrame(now, frameCount, false);
+    }
+
+    isMatchEnded = true;
+}
+
+void FrameWatchdog::finishFrame(const Clock::time_point now, const int frameCount, const bool isCoalesced)
+{
+    endStage(now);
+    isFrameEnded = false;
+
+    if (isShed)
+    {
+        ++numShedFrames;
+    }
+
+    const std::chrono::microseconds duration = std::chrono::duration_cast<std::chrono::microseconds>(now - frameStart);
+    maxFrameDuration = std::max(maxFrameDuration, duration);
+    for (int i = 0; i < numLimits; ++i)
+    {
+        if (duration > limits[i].duration)
+        {
+            ++numFramesOver[i];
+            if (numFramesOver[i] >= std::max(1, (int) std::ceil(policy.shedFraction * limits[i].maxFrames)))
+            {
+                isShedForRestOfGame = true;
+            }
+        }
+    }
+
+    if (isCoalesced)
+    {
+        ++numCoalescedFrames;
+    }
+
+    if (duration > limits[0].duration || isCoalesced)
+    {
+        lastSlowFrameCount = frameCount;
+    }
+
+    isShed =
+        isShedForRestOfGame ||
+        (lastSlowFrameCount >= 0 && frameCount < lastSlowFrameCount + policy.shedFramesAfterSlowFrame);
+}
+
+bool FrameWatchdog::isDeferredWorkDue(const DeferredWork work, const int frameCount)
+{
+    // Some work is only done every other frame (see onFrame()), so this counts the frames since
+    // it was last done rather than checking the frame count modulo the period.
+    if (isShed && frameCount < lastDeferredWorkFrameCount[work] + policy.deferredWorkPeriodFrames)
+    {
+        return false;
+    }
+
+    lastDeferredWorkFrameCount[work] = frameCount;
+    return true;
+}
+
+std::string FrameWatchdog::getWorstStagesString(const int maxNumStages) const
+{
+    std::vector<const StageStats*> worstStages;
+    for (const StageStats& stage : stages)
+    {
+        worstStages.push_back(&stage);
+    }
+
+    std::sort(worstStages.begin(), worstStages.end(), [](const StageStats* a, const StageStats* b)
+    {
+        return a->maxDuration > b->maxDuration;
+    });
+
+    std::ostringstream oss;
+    for (int i = 0; i < (int) worstStages.size() && i < maxNumStages; ++i)
+    {
+        oss << (i > 0 ? ";" : "") << worstStages[i]->name << "=" << worstStages[i]->maxDuration.count();
+    }
+
+    return oss.str();
+}
@@ -0,0 +1,140 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Keeps count, while the game is being played, of the frames that took longer than each of the
+// time limits of the competitions (a bot loses if it has 320 frames over 55ms, 10 frames over 1s
+// or 1 frame over 10s), and of how long each stage of a frame took. Once the slow frames have
+// used up a fraction of any limit's allowance (or just after a slow frame), it tells the bot to
+// shed the work that it can do without for a while (see isShedding() and isDeferredWorkDue()).
+// A frame lasts from the return of one client update to the return of the next, so it includes
+// the transport. It is counted at the start of the next frame, so which work is shed is decided
+// then and doesn't change during a frame (the work that runs on the thread pool reads it too).
+class FrameWatchdog
+{
+public:
+    struct Limit
+    {
+        std::chrono::milliseconds duration;
+        int maxFrames;
+    };
+
+    static const int numLimits = 3;
+    static const Limit limits[numLimits];
+
+    struct Policy
+    {
+        // Start shedding for the rest of the game once any limit has this fraction of its
+        // maxFrames frames longer than its duration.
+        double shedFraction = 0.25;
+
+        // Also shed for this many frames after each frame longer than the shortest limit.
+        int shedFramesAfterSlowFrame = 24;
+
+        // While shedding, deferred work runs at most once every this many frames.
+        int deferredWorkPeriodFrames = 8;
+    };
+
+    // The work that is put off (rather than skipped) while shedding.
+    enum DeferredWork
+    {
+        ExplorationUpdate,
+        BuildLocationPlanning,
+        NumDeferredWork
+    };
+
+    struct StageStats
+    {
+        const char* name;
+        std::chrono::microseconds maxDuration{ 0 };
+        std::chrono::microseconds totalDuration{ 0 };
+    };
+
+    void setPolicy(const Policy& newPolicy) { policy = newPolicy; }
+
+    // Resets the counts at the start of each match.
+    void onStart();
+
+    // Call at the start of each frame (as soon as the client update returns, before its events
+    // are delivered), then beginStage() at the start of each part of the frame worth reporting (a
+    // stage lasts until the next one begins), then onFrameEnd() before the client update that
+    // sends its commands (the update is the frame's last stage). Frames whose onFrame() was
+    // skipped to catch up (isCoalesced) are reported too. Such a frame means the bot is behind, so
+    // it is treated like a slow frame (work is shed for a while).
+    // The stage names are kept by pointer, so they must be string literals.
+    void onFrameStart();
+    void beginStage(const char* name);
+    void onFrameEnd(const int frameCount, const bool isCoalesced);
+
+    // Counts the frame that is in progress (up to now) and stops counting for the rest of the
+    // match. onEnd() calls it before logging the counts, because it is called in the middle of the
+    // last frame (while its events are delivered).
+    void onMatchEnd(const int frameCount);
+
+    bool isShedding() const { return isShed; }
+
+    // Returns whether the work should be done this frame (always, unless shedding). Each kind of
+    // deferred work must only be asked about from one thread at a time.
+    bool isDeferredWorkDue(const DeferredWork work, const int frameCount);
+
+    int getNumFramesOver(const int limitIndex) const { return numFramesOver[limitIndex]; }
+    int getNumShedFrames() const { return numShedFrames; }
+    int getNumCoalescedFrames() const { return numCoalescedFrames; }
+    std::chrono::microseconds getMaxFrameDuration() const { return maxFrameDuration; }
+    const std::vector<StageStats>& getStages() const { return stages; }
+
+    // E.g. "mainLoop=61234;build=2150" for the maxNumStages stages that took the longest in any
+    // one frame (the durations are their maximums in microseconds).
+    std::string getWorstStagesString(const int maxNumStages) const;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    void endStage(const Clock::time_point now);
+
+    // Counts the frame that started at frameStart and ended now.
+    void finishFrame(const Clock::time_point now, const int frameCount, const bool isCoalesced);
+
+    Policy policy;
+    Clock::time_point frameStart;
+    Clock::time_point stageStart;
+    int stageIndex = -1;
+    std::vector<StageStats> stages;
+    int numFramesOver[numLimits] = {};
+    std::chrono::microseconds maxFrameDuration{ 0 };
+    int lastSlowFrameCount = -1;
+    int numShedFrames = 0;
+    int numCoalescedFrames = 0;
+    bool isShed = false;
+    bool isShedForRestOfGame = false;
+    int lastDeferredWorkFrameCount[NumDeferredWork] = {};
+
+    // Whether onFrameEnd() has been called for the frame that started at frameStart (it is counted
+    // at the next onFrameStart()), and its arguments.
+    bool isFrameEnded = false;
+    int endedFrameCount = 0;
+    bool isEndedFrameCoalesced = false;
+
+    bool isMatchEnded = false;
+};
@@ -0,0 +1,176 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "GameRecord.h"
+
+const std::uint32_t GameRecord::magic;
+const int GameRecord::version;
+const int GameRecord::frameChunkTag;
+const int GameRecord::endTag;
+
+// Strings longer than this are treated as corrupt rather than allocated.
+static const std::uint64_t maxStringLength = 1 << 20;
+
+unsigned int GameRecord::getChangedFields(const UnitState& from, const UnitState& to)
+{
+    unsigned int fields = 0;
+    if (from.typeID != to.typeID)
+    {
+        fields |= typeField;
+    }
+
+    if (from.playerID != to.playerID)
+    {
+        fields |= playerField;
+    }
+
+    if (from.x != to.x || from.y != to.y)
+    {
+        fields |= positionField;
+    }
+
+    if (from.hitPoints != to.hitPoints)
+    {
+        fields |= hitPointsField;
+    }
+
+    if (from.shields != to.shields)
+    {
+        fields |= shieldsField;
+    }
+
+    if (from.energy != to.energy)
+    {
+        fields |= energyField;
+    }
+
+    if (from.resources != to.resources)
+    {
+        fields |= resourcesField;
+    }
+
+    if (from.orderID != to.orderID)
+    {
+        fields |= orderField;
+    }
+
+    if (from.targetID != to.targetID)
+    {
+        fields |= targetField;
+    }
+
+    if (from.orderTargetID != to.orderTargetID)
+    {
+        fields |= orderTargetField;
+    }
+
+    if (from.groundWeaponCooldown != to.groundWeaponCooldown || from.airWeaponCooldown != to.airWeaponCooldown)
+    {
+        fields |= cooldownField;
+    }
+
+    if (from.flags != to.flags)
+    {
+        fields |= flagsField;
+    }
+
+    return fields;
+}
+
+void GameRecord::writeVarUInt(std::string& out, std::uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back((char) ((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+
+    out.push_back((char) value);
+}
+
+void GameRecord::writeVarInt(std::string& out, const std::int64_t value)
+{
+    // Zigzag, so that small negative numbers are small too.
+    writeVarUInt(out, ((std::uint64_t) value << 1) ^ (std::uint64_t) (value >> 63));
+}
+
+void GameRecord::writeString(std::string& out, const std::string& value)
+{
+    writeVarUInt(out, value.size());
+    out += value;
+}
+
+bool GameRecord::readVarUInt(std::istream& is, std::uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        const int c = is.get();
+        if (c == std::char_traits<char>::eof())
+        {
+            return false;
+        }
+
+        value |= (std::uint64_t) (c & 0x7f) << shift;
+        if ((c & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool GameRecord::readVarInt(std::istream& is, std::int64_t& value)
+{
+    std::uint64_t zigzag = 0;
+    if (!readVarUInt(is, zigzag))
+    {
+        return false;
+    }
+
+    value = (std::int64_t) (zigzag >> 1) ^ -(std::int64_t) (zigzag & 1);
+    return true;
+}
+
+bool GameRecord::readInt(std::istream& is, int& value)
+{
+    std::int64_t tmp = 0;
+    if (!readVarInt(is, tmp))
+    {
+        return false;
+    }
+
+    value = (int) tmp;
+    return true;
+}
+
+bool GameRecord::readString(std::istream& is, std::string& value)
+{
+    std::uint64_t size = 0;
+    if (!readVarUInt(is, size) || size > maxStringLength)
+    {
+        return false;
+    }
+
+    value.resize((std::size_t) size);
+    return size == 0 || is.read(&value[0], (std::streamsize) size).good();
+}
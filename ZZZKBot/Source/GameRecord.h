@@ -0,0 +1,190 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// The format of the game records that GameRecorder writes and GameRecordReader reads. It doesn't
+// depend on BWAPI (unit types, orders, commands etc. are stored by their BWAPI IDs, and units and
+// players by their IDs), so a record can be read by tools that don't link BWAPI.
+//
+// A record is a header (magic number, version and the match info) followed by one chunk per
+// frame. A frame chunk only holds what changed since the previous frame: the units that became
+// accessible or whose state changed (each with a bit mask of the fields that changed, and each
+// field as the difference from its previous value), the IDs of the units that are no longer
+// accessible, then all the events of the frame and the commands that the bot issued. All integers
+// are LEB128 varints (signed ones are zigzag encoded first), so a typical frame takes a few
+// hundred bytes.
+struct GameRecord
+{
+    static const std::uint32_t magic = 0x524b5a5a;
+    static const int version = 1;
+
+    // Marks the start of each frame chunk and the end of the record.
+    static const int frameChunkTag = 'F';
+    static const int endTag = 'E';
+
+    struct PlayerInfo
+    {
+        int id = -1;
+        std::string name;
+        int raceID = 0;
+        int typeID = 0;
+        bool isSelf = false;
+        bool isEnemy = false;
+        bool isAlly = false;
+        bool isNeutral = false;
+    };
+
+    struct MatchInfo
+    {
+        std::string mapName;
+        std::string mapFileName;
+        std::string mapHash;
+        int mapWidth = 0;
+        int mapHeight = 0;
+        int latencyFrames = 0;
+        int selfID = -1;
+
+        // Tile positions.
+        std::vector<std::pair<int, int>> startLocations;
+
+        std::vector<PlayerInfo> players;
+    };
+
+    enum UnitFlag : unsigned int
+    {
+        completedFlag = 1u << 0,
+        flyingFlag = 1u << 1,
+        movingFlag = 1u << 2,
+        idleFlag = 1u << 3,
+        visibleFlag = 1u << 4,
+        detectedFlag = 1u << 5,
+        burrowedFlag = 1u << 6,
+        cloakedFlag = 1u << 7,
+        liftedFlag = 1u << 8,
+        morphingFlag = 1u << 9,
+        constructingFlag = 1u << 10,
+        beingConstructedFlag = 1u << 11,
+        attackingFlag = 1u << 12,
+        underAttackFlag = 1u << 13,
+        carryingMineralsFlag = 1u << 14,
+        carryingGasFlag = 1u << 15,
+        gatheringMineralsFlag = 1u << 16,
+        gatheringGasFlag = 1u << 17,
+        stuckFlag = 1u << 18
+    };
+
+    struct UnitState
+    {
+        int id = -1;
+        int typeID = 0;
+        int playerID = -1;
+        int x = 0;
+        int y = 0;
+        int hitPoints = 0;
+        int shields = 0;
+        int energy = 0;
+        int resources = 0;
+        int orderID = 0;
+        int targetID = -1;
+        int orderTargetID = -1;
+        int groundWeaponCooldown = 0;
+        int airWeaponCooldown = 0;
+        unsigned int flags = 0;
+    };
+
+    // The bits of the mask of the fields of a unit that changed.
+    enum UnitField : unsigned int
+    {
+        typeField = 1u << 0,
+        playerField = 1u << 1,
+        positionField = 1u << 2,
+        hitPointsField = 1u << 3,
+        shieldsField = 1u << 4,
+        energyField = 1u << 5,
+        resourcesField = 1u << 6,
+        orderField = 1u << 7,
+        targetField = 1u << 8,
+        orderTargetField = 1u << 9,
+        cooldownField = 1u << 10,
+        flagsField = 1u << 11
+    };
+
+    // Returns the mask of the fields that differ.
+    static unsigned int getChangedFields(const UnitState& from, const UnitState& to);
+
+    struct EventInfo
+    {
+        int typeID = 0;
+        int unitID = -1;
+        int playerID = -1;
+        int x = 0;
+        int y = 0;
+        std::string text;
+        bool isWinner = false;
+    };
+
+    struct CommandInfo
+    {
+        int unitID = -1;
+        int typeID = 0;
+        int targetID = -1;
+        int x = 0;
+        int y = 0;
+
+        // The unit type, tech type or upgrade type ID, depending on the command type.
+        int extra = 0;
+    };
+
+    struct Frame
+    {
+        int frameCount = 0;
+        int remainingLatencyFrames = 0;
+
+        // Mine.
+        int minerals = 0;
+        int gas = 0;
+        int supplyUsed = 0;
+        int supplyTotal = 0;
+
+        // All the accessible units (in order of ID).
+        std::vector<UnitState> units;
+
+        std::vector<EventInfo> events;
+        std::vector<CommandInfo> commands;
+    };
+
+    // Encoding (appends to out).
+    static void writeVarUInt(std::string& out, std::uint64_t value);
+    static void writeVarInt(std::string& out, std::int64_t value);
+    static void writeString(std::string& out, const std::string& value);
+
+    // Decoding (returns false at the end of the stream or if it is malformed).
+    static bool readVarUInt(std::istream& is, std::uint64_t& value);
+    static bool readVarInt(std::istream& is, std::int64_t& value);
+    static bool readInt(std::istream& is, int& value);
+    static bool readString(std::istream& is, std::string& value);
+};
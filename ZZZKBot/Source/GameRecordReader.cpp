@@ -0,0 +1,335 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "GameRecordReader.h"
+#include <algorithm>
+
+// IDs and per-frame counts beyond these are treated as corrupt rather than allocated for.
+static const int maxUnitID = 1 << 20;
+static const std::uint64_t maxCount = 1 << 16;
+
+bool GameRecordReader::open(const std::string& filePath)
+{
+    ifs.close();
+    ifs.clear();
+    matchInfo = GameRecord::MatchInfo();
+    corrupt = false;
+    states.clear();
+    isAccessible.clear();
+    accessibleIDs.clear();
+
+    ifs.open(filePath, std::ios::binary);
+    if (!ifs)
+    {
+        return false;
+    }
+
+    std::uint64_t magic = 0;
+    std::uint64_t version = 0;
+    if (!GameRecord::readVarUInt(ifs, magic) || magic != GameRecord::magic ||
+        !GameRecord::readVarUInt(ifs, version) || version != (std::uint64_t) GameRecord::version ||
+        !readMatchInfo())
+    {
+        ifs.close();
+        return false;
+    }
+
+    return true;
+}
+
+bool GameRecordReader::readMatchInfo()
+{
+    if (!GameRecord::readString(ifs, matchInfo.mapName) ||
+        !GameRecord::readString(ifs, matchInfo.mapFileName) ||
+        !GameRecord::readString(ifs, matchInfo.mapHash) ||
+        !GameRecord::readInt(ifs, matchInfo.mapWidth) ||
+        !GameRecord::readInt(ifs, matchInfo.mapHeight) ||
+        !GameRecord::readInt(ifs, matchInfo.latencyFrames) ||
+        !GameRecord::readInt(ifs, matchInfo.selfID))
+    {
+        return false;
+    }
+
+    std::uint64_t numStartLocations = 0;
+    if (!GameRecord::readVarUInt(ifs, numStartLocations) || numStartLocations > 256)
+    {
+        return false;
+    }
+
+    matchInfo.startLocations.resize((std::size_t) numStartLocations);
+    for (std::pair<int, int>& startLocation : matchInfo.startLocations)
+    {
+        if (!GameRecord::readInt(ifs, startLocation.first) || !GameRecord::readInt(ifs, startLocation.second))
+        {
+            return false;
+        }
+    }
+
+    std::uint64_t numPlayers = 0;
+    if (!GameRecord::readVarUInt(ifs, numPlayers) || numPlayers > 256)
+    {
+        return false;
+    }
+
+    matchInfo.players.resize((std::size_t) numPlayers);
+    for (GameRecord::PlayerInfo& player : matchInfo.players)
+    {
+        std::uint64_t relation = 0;
+        if (!GameRecord::readInt(ifs, player.id) ||
+            !GameRecord::readString(ifs, player.name) ||
+            !GameRecord::readInt(ifs, player.raceID) ||
+            !GameRecord::readInt(ifs, player.typeID) ||
+            !GameRecord::readVarUInt(ifs, relation))
+        {
+            return false;
+        }
+
+        player.isSelf = (relation & 1) != 0;
+        player.isEnemy = (relation & 2) != 0;
+        player.isAlly = (relation & 4) != 0;
+        player.isNeutral = (relation & 8) != 0;
+    }
+
+    return true;
+}
+
+bool GameRecordReader::readFrame(GameRecord::Frame& frame)
+{
+    if (!ifs.is_open())
+    {
+        return false;
+    }
+
+    const int tag = ifs.get();
+    if (tag == GameRecord::frameChunkTag)
+    {
+        if (readFrameChunk(frame))
+        {
+            return true;
+        }
+
+        corrupt = true;
+    }
+    else if (tag != GameRecord::endTag)
+    {
+        // E.g. the process was killed before the record was finished.
+        corrupt = true;
+    }
+
+    ifs.close();
+    return false;
+}
+
+bool GameRecordReader::readFrameChunk(GameRecord::Frame& frame)
+{
+    std::uint64_t frameCount = 0;
+    if (!GameRecord::readVarUInt(ifs, frameCount) ||
+        !GameRecord::readInt(ifs, frame.remainingLatencyFrames) ||
+        !GameRecord::readInt(ifs, frame.minerals) ||
+        !GameRecord::readInt(ifs, frame.gas) ||
+        !GameRecord::readInt(ifs, frame.supplyUsed) ||
+        !GameRecord::readInt(ifs, frame.supplyTotal))
+    {
+        return false;
+    }
+
+    frame.frameCount = (int) frameCount;
+
+    std::uint64_t numChangedUnits = 0;
+    if (!GameRecord::readVarUInt(ifs, numChangedUnits) || numChangedUnits > maxCount)
+    {
+        return false;
+    }
+
+    newAccessibleIDs.clear();
+    int id = 0;
+    for (std::uint64_t i = 0; i < numChangedUnits; ++i)
+    {
+        std::uint64_t idDeltaAndIsNew = 0;
+        if (!GameRecord::readVarUInt(ifs, idDeltaAndIsNew))
+        {
+            return false;
+        }
+
+        id += (int) (idDeltaAndIsNew >> 1);
+        if (id < 0 || id > maxUnitID)
+        {
+            return false;
+        }
+
+        if (id >= (int) states.size())
+        {
+            states.resize(id + 1);
+            isAccessible.resize(id + 1, false);
+        }
+
+        if ((idDeltaAndIsNew & 1) != 0)
+        {
+            states[id] = GameRecord::UnitState();
+            states[id].id = id;
+            if (!isAccessible[id])
+            {
+                isAccessible[id] = true;
+                newAccessibleIDs.push_back(id);
+            }
+        }
+
+        if (!readUnitState(states[id]))
+        {
+            return false;
+        }
+    }
+
+    std::uint64_t numRemovedUnits = 0;
+    if (!GameRecord::readVarUInt(ifs, numRemovedUnits))
+    {
+        return false;
+    }
+
+    id = 0;
+    for (std::uint64_t i = 0; i < numRemovedUnits; ++i)
+    {
+        std::uint64_t idDelta = 0;
+        if (!GameRecord::readVarUInt(ifs, idDelta))
+        {
+            return false;
+        }
+
+        id += (int) idDelta;
+        if (id >= 0 && id < (int) isAccessible.size())
+        {
+            isAccessible[id] = false;
+        }
+    }
+
+    // Merge the new units into the (sorted) accessible IDs and drop the removed ones.
+    if (!newAccessibleIDs.empty() || numRemovedUnits > 0)
+    {
+        accessibleIDs.erase(std::remove_if(accessibleIDs.begin(), accessibleIDs.end(), [this](const int accessibleID)
+        {
+            return !isAccessible[accessibleID];
+        }), accessibleIDs.end());
+        std::sort(newAccessibleIDs.begin(), newAccessibleIDs.end());
+        const std::size_t numOldIDs = accessibleIDs.size();
+        accessibleIDs.insert(accessibleIDs.end(), newAccessibleIDs.begin(), newAccessibleIDs.end());
+        std::inplace_merge(accessibleIDs.begin(), accessibleIDs.begin() + numOldIDs, accessibleIDs.end());
+    }
+
+    frame.units.clear();
+    for (const int accessibleID : accessibleIDs)
+    {
+        frame.units.push_back(states[accessibleID]);
+    }
+
+    std::uint64_t numEvents = 0;
+    if (!GameRecord::readVarUInt(ifs, numEvents) || numEvents > maxCount)
+    {
+        return false;
+    }
+
+    frame.events.resize((std::size_t) numEvents);
+    for (GameRecord::EventInfo& e : frame.events)
+    {
+        std::uint64_t isWinner = 0;
+        if (!GameRecord::readInt(ifs, e.typeID) ||
+            !GameRecord::readInt(ifs, e.unitID) ||
+            !GameRecord::readInt(ifs, e.playerID) ||
+            !GameRecord::readInt(ifs, e.x) ||
+            !GameRecord::readInt(ifs, e.y) ||
+            !GameRecord::readString(ifs, e.text) ||
+            !GameRecord::readVarUInt(ifs, isWinner))
+        {
+            return false;
+        }
+
+        e.isWinner = isWinner != 0;
+    }
+
+    std::uint64_t numCommands = 0;
+    if (!GameRecord::readVarUInt(ifs, numCommands) || numCommands > maxCount)
+    {
+        return false;
+    }
+
+    frame.commands.resize((std::size_t) numCommands);
+    for (GameRecord::CommandInfo& command : frame.commands)
+    {
+        if (!GameRecord::readInt(ifs, command.unitID) ||
+            !GameRecord::readInt(ifs, command.typeID) ||
+            !GameRecord::readInt(ifs, command.targetID) ||
+            !GameRecord::readInt(ifs, command.x) ||
+            !GameRecord::readInt(ifs, command.y) ||
+            !GameRecord::readInt(ifs, command.extra))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool GameRecordReader::readUnitState(GameRecord::UnitState& state)
+{
+    std::uint64_t fields = 0;
+    if (!GameRecord::readVarUInt(ifs, fields))
+    {
+        return false;
+    }
+
+    const auto readFlags = [this, &state]()
+    {
+        std::uint64_t flags = 0;
+        if (!GameRecord::readVarUInt(ifs, flags))
+        {
+            return false;
+        }
+
+        state.flags = (unsigned int) flags;
+        return true;
+    };
+
+    // Reads the difference from the previous value into the field.
+    int delta = 0;
+    const auto readDelta = [this, &delta](int& field)
+    {
+        if (!GameRecord::readInt(ifs, delta))
+        {
+            return false;
+        }
+
+        field += delta;
+        return true;
+    };
+
+    return
+        (!(fields & GameRecord::typeField) || readDelta(state.typeID)) &&
+        (!(fields & GameRecord::playerField) || readDelta(state.playerID)) &&
+        (!(fields & GameRecord::positionField) || (readDelta(state.x) && readDelta(state.y))) &&
+        (!(fields & GameRecord::hitPointsField) || readDelta(state.hitPoints)) &&
+        (!(fields & GameRecord::shieldsField) || readDelta(state.shields)) &&
+        (!(fields & GameRecord::energyField) || readDelta(state.energy)) &&
+        (!(fields & GameRecord::resourcesField) || readDelta(state.resources)) &&
+        (!(fields & GameRecord::orderField) || readDelta(state.orderID)) &&
+        (!(fields & GameRecord::targetField) || GameRecord::readInt(ifs, state.targetID)) &&
+        (!(fields & GameRecord::orderTargetField) || GameRecord::readInt(ifs, state.orderTargetID)) &&
+        (!(fields & GameRecord::cooldownField) || (GameRecord::readInt(ifs, state.groundWeaponCooldown) && GameRecord::readInt(ifs, state.airWeaponCooldown))) &&
+        (!(fields & GameRecord::flagsField) || readFlags());
+}
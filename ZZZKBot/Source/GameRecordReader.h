@@ -0,0 +1,62 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "GameRecord.h"
+
+// Reads a game record (see GameRecord.h) back frame by frame, applying the changes of each frame
+// to rebuild the full state of all the accessible units as of that frame. It doesn't depend on
+// BWAPI.
+class GameRecordReader
+{
+public:
+    // Opens the record and reads the match info. Returns false if the file couldn't be opened or
+    // isn't a game record of a supported version.
+    bool open(const std::string& filePath);
+
+    const GameRecord::MatchInfo& getMatchInfo() const { return matchInfo; }
+
+    // Reads the next frame. Returns false at the end of the record (or if the rest of it is
+    // corrupt, e.g. the match was cut short, in which case isCorrupt() is true).
+    bool readFrame(GameRecord::Frame& frame);
+
+    bool isCorrupt() const { return corrupt; }
+
+private:
+    bool readMatchInfo();
+    bool readFrameChunk(GameRecord::Frame& frame);
+    bool readUnitState(GameRecord::UnitState& state);
+
+    std::ifstream ifs;
+    GameRecord::MatchInfo matchInfo;
+    bool corrupt = false;
+
+    // The current state of each unit (by ID), whether each unit is accessible, and the IDs of the
+    // accessible units (in order of ID).
+    std::vector<GameRecord::UnitState> states;
+    std::vector<bool> isAccessible;
+    std::vector<int> accessibleIDs;
+    std::vector<int> newAccessibleIDs;
+};
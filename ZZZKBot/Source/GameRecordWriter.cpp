@@ -0,0 +1,265 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "GameRecordWriter.h"
+#include <algorithm>
+
+bool GameRecordWriter::open(const std::string& filePath, const GameRecord::MatchInfo& matchInfo)
+{
+    close();
+    previousStates.clear();
+    previousIDs.clear();
+    numFramesWritten = 0;
+    numBytesWritten = 0;
+
+    ofs.open(filePath, std::ios::binary | std::ios::trunc);
+    if (!ofs)
+    {
+        return false;
+    }
+
+    buffer.clear();
+    GameRecord::writeVarUInt(buffer, GameRecord::magic);
+    GameRecord::writeVarUInt(buffer, GameRecord::version);
+    GameRecord::writeString(buffer, matchInfo.mapName);
+    GameRecord::writeString(buffer, matchInfo.mapFileName);
+    GameRecord::writeString(buffer, matchInfo.mapHash);
+    GameRecord::writeVarInt(buffer, matchInfo.mapWidth);
+    GameRecord::writeVarInt(buffer, matchInfo.mapHeight);
+    GameRecord::writeVarInt(buffer, matchInfo.latencyFrames);
+    GameRecord::writeVarInt(buffer, matchInfo.selfID);
+
+    GameRecord::writeVarUInt(buffer, matchInfo.startLocations.size());
+    for (const std::pair<int, int>& startLocation : matchInfo.startLocations)
+    {
+        GameRecord::writeVarInt(buffer, startLocation.first);
+        GameRecord::writeVarInt(buffer, startLocation.second);
+    }
+
+    GameRecord::writeVarUInt(buffer, matchInfo.players.size());
+    for (const GameRecord::PlayerInfo& player : matchInfo.players)
+    {
+        GameRecord::writeVarInt(buffer, player.id);
+        GameRecord::writeString(buffer, player.name);
+        GameRecord::writeVarInt(buffer, player.raceID);
+        GameRecord::writeVarInt(buffer, player.typeID);
+        GameRecord::writeVarUInt(buffer,
+            (player.isSelf ? 1 : 0) |
+            (player.isEnemy ? 2 : 0) |
+            (player.isAlly ? 4 : 0) |
+            (player.isNeutral ? 8 : 0));
+    }
+
+    ofs.write(buffer.data(), buffer.size());
+    numBytesWritten += buffer.size();
+    return true;
+}
+
+void GameRecordWriter::writeFrame(const GameRecord::Frame& frame)
+{
+    if (!isOpen())
+    {
+        return;
+    }
+
+    buffer.clear();
+    buffer.push_back((char) GameRecord::frameChunkTag);
+    GameRecord::writeVarUInt(buffer, frame.frameCount);
+    GameRecord::writeVarInt(buffer, frame.remainingLatencyFrames);
+    GameRecord::writeVarInt(buffer, frame.minerals);
+    GameRecord::writeVarInt(buffer, frame.gas);
+    GameRecord::writeVarInt(buffer, frame.supplyUsed);
+    GameRecord::writeVarInt(buffer, frame.supplyTotal);
+
+    // The units that are new or changed. They are encoded into their own buffer because their
+    // count, which comes first, isn't known until they have all been compared.
+    if (!frame.units.empty() && frame.units.back().id >= (int) previousStates.size())
+    {
+        previousStates.resize(frame.units.back().id + 1);
+    }
+
+    {
+        // Block to restrict scope of variables.
+        unitsBuffer.clear();
+        std::size_t numChangedUnits = 0;
+        int lastID = 0;
+        std::vector<int>::const_iterator previousIter = previousIDs.begin();
+        currentIDs.clear();
+        for (const GameRecord::UnitState& state : frame.units)
+        {
+            const int id = state.id;
+            currentIDs.push_back(id);
+            while (previousIter != previousIDs.end() && *previousIter < id)
+            {
+                ++previousIter;
+            }
+
+            const bool wasAccessible = previousIter != previousIDs.end() && *previousIter == id;
+            const GameRecord::UnitState from = wasAccessible ? previousStates[id] : GameRecord::UnitState();
+            const unsigned int fields = GameRecord::getChangedFields(from, state);
+            if (!wasAccessible || fields != 0)
+            {
+                // IDs are written as the difference from the last one, with whether the unit is new
+                // in the lowest bit (so that a new unit whose fields are all the defaults still has
+                // a record).
+                GameRecord::writeVarUInt(unitsBuffer, ((std::uint64_t) (id - lastID) << 1) | (wasAccessible ? 0 : 1));
+                lastID = id;
+                writeUnitState(unitsBuffer, from, state, fields);
+                ++numChangedUnits;
+            }
+
+            previousStates[id] = state;
+        }
+
+        GameRecord::writeVarUInt(buffer, numChangedUnits);
+        buffer += unitsBuffer;
+    }
+
+    {
+        // Block to restrict scope of variables.
+        std::size_t numRemovedUnits = 0;
+        for (const int id : previousIDs)
+        {
+            if (!std::binary_search(currentIDs.begin(), currentIDs.end(), id))
+            {
+                ++numRemovedUnits;
+            }
+        }
+
+        GameRecord::writeVarUInt(buffer, numRemovedUnits);
+        int lastID = 0;
+        for (const int id : previousIDs)
+        {
+            if (!std::binary_search(currentIDs.begin(), currentIDs.end(), id))
+            {
+                GameRecord::writeVarUInt(buffer, id - lastID);
+                lastID = id;
+            }
+        }
+    }
+
+    previousIDs.swap(currentIDs);
+
+    GameRecord::writeVarUInt(buffer, frame.events.size());
+    for (const GameRecord::EventInfo& e : frame.events)
+    {
+        GameRecord::writeVarInt(buffer, e.typeID);
+        GameRecord::writeVarInt(buffer, e.unitID);
+        GameRecord::writeVarInt(buffer, e.playerID);
+        GameRecord::writeVarInt(buffer, e.x);
+        GameRecord::writeVarInt(buffer, e.y);
+        GameRecord::writeString(buffer, e.text);
+        GameRecord::writeVarUInt(buffer, e.isWinner ? 1 : 0);
+    }
+
+    GameRecord::writeVarUInt(buffer, frame.commands.size());
+    for (const GameRecord::CommandInfo& command : frame.commands)
+    {
+        GameRecord::writeVarInt(buffer, command.unitID);
+        GameRecord::writeVarInt(buffer, command.typeID);
+        GameRecord::writeVarInt(buffer, command.targetID);
+        GameRecord::writeVarInt(buffer, command.x);
+        GameRecord::writeVarInt(buffer, command.y);
+        GameRecord::writeVarInt(buffer, command.extra);
+    }
+
+    ofs.write(buffer.data(), buffer.size());
+    numBytesWritten += buffer.size();
+    ++numFramesWritten;
+}
+
+void GameRecordWriter::close()
+{
+    if (!isOpen())
+    {
+        return;
+    }
+
+    ofs.put((char) GameRecord::endTag);
+    ++numBytesWritten;
+    ofs.close();
+}
+
+void GameRecordWriter::writeUnitState(std::string& out, const GameRecord::UnitState& from, const GameRecord::UnitState& to, const unsigned int fields)
+{
+    GameRecord::writeVarUInt(out, fields);
+    if (fields & GameRecord::typeField)
+    {
+        GameRecord::writeVarInt(out, to.typeID - from.typeID);
+    }
+
+    if (fields & GameRecord::playerField)
+    {
+        GameRecord::writeVarInt(out, to.playerID - from.playerID);
+    }
+
+    if (fields & GameRecord::positionField)
+    {
+        GameRecord::writeVarInt(out, to.x - from.x);
+        GameRecord::writeVarInt(out, to.y - from.y);
+    }
+
+    if (fields & GameRecord::hitPointsField)
+    {
+        GameRecord::writeVarInt(out, to.hitPoints - from.hitPoints);
+    }
+
+    if (fields & GameRecord::shieldsField)
+    {
+        GameRecord::writeVarInt(out, to.shields - from.shields);
+    }
+
+    if (fields & GameRecord::energyField)
+    {
+        GameRecord::writeVarInt(out, to.energy - from.energy);
+    }
+
+    if (fields & GameRecord::resourcesField)
+    {
+        GameRecord::writeVarInt(out, to.resources - from.resources);
+    }
+
+    if (fields & GameRecord::orderField)
+    {
+        GameRecord::writeVarInt(out, to.orderID - from.orderID);
+    }
+
+    if (fields & GameRecord::targetField)
+    {
+        GameRecord::writeVarInt(out, to.targetID);
+    }
+
+    if (fields & GameRecord::orderTargetField)
+    {
+        GameRecord::writeVarInt(out, to.orderTargetID);
+    }
+
+    if (fields & GameRecord::cooldownField)
+    {
+        GameRecord::writeVarInt(out, to.groundWeaponCooldown);
+        GameRecord::writeVarInt(out, to.airWeaponCooldown);
+    }
+
+    if (fields & GameRecord::flagsField)
+    {
+        GameRecord::writeVarUInt(out, to.flags);
+    }
+}
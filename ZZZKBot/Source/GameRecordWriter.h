@@ -0,0 +1,69 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "GameRecord.h"
+
+// Writes a game record (see GameRecord.h) from frames that hold the full state of the accessible
+// units, encoding only what changed since the previous frame. It doesn't depend on BWAPI, so
+// records can also be made from synthetic frames.
+class GameRecordWriter
+{
+public:
+    // Starts a new record in the file (replacing it if it exists). Returns false if the file
+    // couldn't be opened.
+    bool open(const std::string& filePath, const GameRecord::MatchInfo& matchInfo);
+
+    // Appends the frame. Its units must be in order of ID.
+    void writeFrame(const GameRecord::Frame& frame);
+
+    // Finishes and closes the record.
+    void close();
+
+    bool isOpen() const { return ofs.is_open(); }
+
+    std::uint64_t getNumFramesWritten() const { return numFramesWritten; }
+    std::uint64_t getNumBytesWritten() const { return numBytesWritten; }
+
+private:
+    static void writeUnitState(std::string& out, const GameRecord::UnitState& from, const GameRecord::UnitState& to, const unsigned int fields);
+
+    std::ofstream ofs;
+
+    // The encoded chunk of the current frame and its unit records (reused so they don't allocate
+    // once they have grown).
+    std::string buffer;
+    std::string unitsBuffer;
+
+    // The state of each unit (by ID) as of the previous frame, and the IDs of the units that were
+    // accessible in it (in order of ID).
+    std::vector<GameRecord::UnitState> previousStates;
+    std::vector<int> previousIDs;
+    std::vector<int> currentIDs;
+
+    std::uint64_t numFramesWritten = 0;
+    std::uint64_t numBytesWritten = 0;
+};
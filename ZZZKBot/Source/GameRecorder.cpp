@@ -0,0 +1,159 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "GameRecorder.h"
+#include <algorithm>
+
+bool GameRecorder::onStart(BWAPI::Game& Broodwar, const std::string& filePath)
+{
+    GameRecord::MatchInfo matchInfo;
+    matchInfo.mapName = Broodwar->mapName();
+    matchInfo.mapFileName = Broodwar->mapFileName();
+    matchInfo.mapHash = Broodwar->mapHash();
+    matchInfo.mapWidth = Broodwar->mapWidth();
+    matchInfo.mapHeight = Broodwar->mapHeight();
+    matchInfo.latencyFrames = Broodwar->getLatencyFrames();
+    matchInfo.selfID = Broodwar->self() ? Broodwar->self()->getID() : -1;
+    for (const BWAPI::TilePosition tp : Broodwar->getStartLocations())
+    {
+        matchInfo.startLocations.emplace_back(tp.x, tp.y);
+    }
+
+    for (const BWAPI::Player p : Broodwar->getPlayers())
+    {
+        GameRecord::PlayerInfo player;
+        player.id = p->getID();
+        player.name = p->getName();
+        player.raceID = p->getRace().getID();
+        player.typeID = p->getType().getID();
+        player.isSelf = p == Broodwar->self();
+        player.isEnemy = Broodwar->self() && Broodwar->self()->isEnemy(p);
+        player.isAlly = Broodwar->self() && p != Broodwar->self() && Broodwar->self()->isAlly(p);
+        player.isNeutral = p->isNeutral();
+        matchInfo.players.push_back(player);
+    }
+
+    return writer.open(filePath, matchInfo);
+}
+
+void GameRecorder::onFrame(BWAPI::Game& Broodwar, const std::list<BWAPI::Event>& events)
+{
+    if (!isRecording())
+    {
+        return;
+    }
+
+    const BWAPI::Player self = Broodwar->self();
+    frame.frameCount = Broodwar->getFrameCount();
+    frame.remainingLatencyFrames = Broodwar->getRemainingLatencyFrames();
+    frame.minerals = self ? self->minerals() : 0;
+    frame.gas = self ? self->gas() : 0;
+    frame.supplyUsed = self ? self->supplyUsed() : 0;
+    frame.supplyTotal = self ? self->supplyTotal() : 0;
+
+    frame.units.clear();
+    for (const BWAPI::Unit u : Broodwar->getAllUnits())
+    {
+        frame.units.push_back(getUnitState(u));
+    }
+
+    std::sort(frame.units.begin(), frame.units.end(), [](const GameRecord::UnitState& a, const GameRecord::UnitState& b)
+    {
+        return a.id < b.id;
+    });
+
+    frame.events.resize(events.size());
+    std::size_t i = 0;
+    for (const BWAPI::Event& e : events)
+    {
+        GameRecord::EventInfo& eventInfo = frame.events[i++];
+        eventInfo.typeID = e.getType();
+        eventInfo.unitID = e.getUnit() ? e.getUnit()->getID() : -1;
+        eventInfo.playerID = e.getPlayer() ? e.getPlayer()->getID() : -1;
+        eventInfo.x = e.getPosition().x;
+        eventInfo.y = e.getPosition().y;
+        eventInfo.text = e.getText();
+        eventInfo.isWinner = e.isWinner();
+    }
+
+    // The commands that my units were given during this frame.
+    frame.commands.clear();
+    if (self)
+    {
+        for (const BWAPI::Unit u : self->getUnits())
+        {
+            if (u->getLastCommandFrame() == frame.frameCount)
+            {
+                const BWAPI::UnitCommand command = u->getLastCommand();
+                GameRecord::CommandInfo commandInfo;
+                commandInfo.unitID = u->getID();
+                commandInfo.typeID = command.getType().getID();
+                commandInfo.targetID = command.getTarget() ? command.getTarget()->getID() : -1;
+                commandInfo.x = command.x;
+                commandInfo.y = command.y;
+                commandInfo.extra = command.extra;
+                frame.commands.push_back(commandInfo);
+            }
+        }
+    }
+
+    writer.writeFrame(frame);
+}
+
+GameRecord::UnitState GameRecorder::getUnitState(const BWAPI::Unit unit)
+{
+    GameRecord::UnitState state;
+    state.id = unit->getID();
+    state.typeID = unit->getType().getID();
+    state.playerID = unit->getPlayer() ? unit->getPlayer()->getID() : -1;
+    state.x = unit->getPosition().x;
+    state.y = unit->getPosition().y;
+    state.hitPoints = unit->getHitPoints();
+    state.shields = unit->getShields();
+    state.energy = unit->getEnergy();
+    state.resources = unit->getResources();
+    state.orderID = unit->getOrder().getID();
+    state.targetID = unit->getTarget() ? unit->getTarget()->getID() : -1;
+    state.orderTargetID = unit->getOrderTarget() ? unit->getOrderTarget()->getID() : -1;
+    state.groundWeaponCooldown = unit->getGroundWeaponCooldown();
+    state.airWeaponCooldown = unit->getAirWeaponCooldown();
+    state.flags =
+        (unit->isCompleted() ? (unsigned int) GameRecord::completedFlag : 0u) |
+        (unit->isFlying() ? (unsigned int) GameRecord::flyingFlag : 0u) |
+        (unit->isMoving() ? (unsigned int) GameRecord::movingFlag : 0u) |
+        (unit->isIdle() ? (unsigned int) GameRecord::idleFlag : 0u) |
+        (unit->isVisible() ? (unsigned int) GameRecord::visibleFlag : 0u) |
+        (unit->isDetected() ? (unsigned int) GameRecord::detectedFlag : 0u) |
+        (unit->isBurrowed() ? (unsigned int) GameRecord::burrowedFlag : 0u) |
+        (unit->isCloaked() ? (unsigned int) GameRecord::cloakedFlag : 0u) |
+        (unit->isLifted() ? (unsigned int) GameRecord::liftedFlag : 0u) |
+        (unit->isMorphing() ? (unsigned int) GameRecord::morphingFlag : 0u) |
+        (unit->isConstructing() ? (unsigned int) GameRecord::constructingFlag : 0u) |
+        (unit->isBeingConstructed() ? (unsigned int) GameRecord::beingConstructedFlag : 0u) |
+        (unit->isAttacking() ? (unsigned int) GameRecord::attackingFlag : 0u) |
+        (unit->isUnderAttack() ? (unsigned int) GameRecord::underAttackFlag : 0u) |
+        (unit->isCarryingMinerals() ? (unsigned int) GameRecord::carryingMineralsFlag : 0u) |
+        (unit->isCarryingGas() ? (unsigned int) GameRecord::carryingGasFlag : 0u) |
+        (unit->isGatheringMinerals() ? (unsigned int) GameRecord::gatheringMineralsFlag : 0u) |
+        (unit->isGatheringGas() ? (unsigned int) GameRecord::gatheringGasFlag : 0u) |
+        (unit->isStuck() ? (unsigned int) GameRecord::stuckFlag : 0u);
+    return state;
+}
@@ -0,0 +1,62 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+#include <BWAPI.h>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "GameRecord.h"
+#include "GameRecordWriter.h"
+
+// Writes a game record (see GameRecord.h) of a match as it's played: the match info at the
+// start, then per frame the state of the accessible units, the events that were delivered to the
+// bot and the commands that it issued. It only reads the game, so recording doesn't change what
+// the bot does.
+class GameRecorder
+{
+public:
+    // Starts a new record in the file (replacing it if it exists). Returns false if the file
+    // couldn't be opened, in which case nothing is recorded for the match.
+    bool onStart(BWAPI::Game& Broodwar, const std::string& filePath);
+
+    // Appends the current frame. Call it after the bot's onFrame() and before the client update,
+    // so that the commands the bot issued during the frame are recorded with it.
+    void onFrame(BWAPI::Game& Broodwar, const std::list<BWAPI::Event>& events);
+
+    // Finishes and closes the record.
+    void onEnd() { writer.close(); }
+
+    bool isRecording() const { return writer.isOpen(); }
+
+    std::uint64_t getNumFramesWritten() const { return writer.getNumFramesWritten(); }
+    std::uint64_t getNumBytesWritten() const { return writer.getNumBytesWritten(); }
+
+private:
+    static GameRecord::UnitState getUnitState(const BWAPI::Unit unit);
+
+    GameRecordWriter writer;
+
+    // The current frame (reused so it doesn't allocate once it has grown).
+    GameRecord::Frame frame;
+};
@@ -0,0 +1,168 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "GathererRegistry.h"
+#include <algorithm>
+
+void GathererRegistry::onStart(const BaseRegistry& newBaseRegistry)
+{
+    *this = GathererRegistry();
+    baseRegistry = &newBaseRegistry;
+    numMineralGatherers.assign(baseRegistry->getBases().size(), 0);
+    numGasGatherers.assign(baseRegistry->getBases().size(), 0);
+}
+
+void GathererRegistry::onUnitMorph(BWAPI::Unit unit)
+{
+    // E.g. a drone morphed into a building, or a refinery was destroyed (so it is a geyser again).
+    if (gathererToResource.find(unit) != gathererToResource.end() && !unit->getType().isWorker())
+    {
+        unassign(unit);
+    }
+
+    if (resources.find(unit) != resources.end() && !unit->getType().isMineralField() && !unit->getType().isRefinery())
+    {
+        removeResource(unit);
+    }
+}
+
+void GathererRegistry::onUnitRenegade(BWAPI::Unit unit)
+{
+    // E.g. a gatherer was mind controlled.
+    if (gathererToResource.find(unit) != gathererToResource.end())
+    {
+        unassign(unit);
+    }
+
+    if (resources.find(unit) != resources.end())
+    {
+        removeResource(unit);
+    }
+}
+
+void GathererRegistry::onUnitDestroy(BWAPI::Unit unit)
+{
+    unassign(unit);
+    removeResource(unit);
+}
+
+void GathererRegistry::assign(const BWAPI::Unit gatherer, const BWAPI::Unit resource)
+{
+    std::unordered_map<BWAPI::Unit, BWAPI::Unit>::iterator gathererIter = gathererToResource.find(gatherer);
+    if (gathererIter != gathererToResource.end())
+    {
+        if (gathererIter->second == resource)
+        {
+            return;
+        }
+
+        unassign(gatherer);
+    }
+
+    std::unordered_map<BWAPI::Unit, ResourceEntry>::iterator resourceIter = resources.find(resource);
+    if (resourceIter == resources.end())
+    {
+        ResourceEntry entry;
+        entry.isMineral = resource->getType().isMineralField();
+        entry.baseIndex = baseRegistry ? baseRegistry->getBaseIndex(resource) : -1;
+        resourceIter = resources.emplace(resource, entry).first;
+    }
+
+    ResourceEntry& entry = resourceIter->second;
+    entry.gatherers.push_back(gatherer);
+    gathererToResource[gatherer] = resource;
+    if (entry.baseIndex >= 0)
+    {
+        ++(entry.isMineral ? numMineralGatherers : numGasGatherers)[entry.baseIndex];
+    }
+}
+
+void GathererRegistry::unassign(const BWAPI::Unit gatherer)
+{
+    std::unordered_map<BWAPI::Unit, BWAPI::Unit>::iterator gathererIter = gathererToResource.find(gatherer);
+    if (gathererIter == gathererToResource.end())
+    {
+        return;
+    }
+
+    std::unordered_map<BWAPI::Unit, ResourceEntry>::iterator resourceIter = resources.find(gathererIter->second);
+    if (resourceIter != resources.end())
+    {
+        ResourceEntry& entry = resourceIter->second;
+        std::vector<BWAPI::Unit>::iterator iter = std::find(entry.gatherers.begin(), entry.gatherers.end(), gatherer);
+        if (iter != entry.gatherers.end())
+        {
+            // The order of the gatherers doesn't matter, so swap-remove.
+            *iter = entry.gatherers.back();
+            entry.gatherers.pop_back();
+            if (entry.baseIndex >= 0)
+            {
+                --(entry.isMineral ? numMineralGatherers : numGasGatherers)[entry.baseIndex];
+            }
+        }
+    }
+
+    gathererToResource.erase(gathererIter);
+}
+
+BWAPI::Unit GathererRegistry::getResource(const BWAPI::Unit gatherer) const
+{
+    std::unordered_map<BWAPI::Unit, BWAPI::Unit>::const_iterator gathererIter = gathererToResource.find(gatherer);
+    return gathererIter != gathererToResource.end() ? gathererIter->second : nullptr;
+}
+
+const std::vector<BWAPI::Unit>& GathererRegistry::getGatherers(const BWAPI::Unit resource) const
+{
+    static const std::vector<BWAPI::Unit> noGatherers;
+    std::unordered_map<BWAPI::Unit, ResourceEntry>::const_iterator resourceIter = resources.find(resource);
+    return resourceIter != resources.end() ? resourceIter->second.gatherers : noGatherers;
+}
+
+int GathererRegistry::getNumMineralGatherers(const int baseIndex) const
+{
+    return baseIndex >= 0 && baseIndex < (int) numMineralGatherers.size() ? numMineralGatherers[baseIndex] : 0;
+}
+
+int GathererRegistry::getNumGasGatherers(const int baseIndex) const
+{
+    return baseIndex >= 0 && baseIndex < (int) numGasGatherers.size() ? numGasGatherers[baseIndex] : 0;
+}
+
+void GathererRegistry::removeResource(const BWAPI::Unit resource)
+{
+    std::unordered_map<BWAPI::Unit, ResourceEntry>::iterator resourceIter = resources.find(resource);
+    if (resourceIter == resources.end())
+    {
+        return;
+    }
+
+    const ResourceEntry& entry = resourceIter->second;
+    for (const BWAPI::Unit gatherer : entry.gatherers)
+    {
+        gathererToResource.erase(gatherer);
+    }
+
+    if (entry.baseIndex >= 0)
+    {
+        (entry.isMineral ? numMineralGatherers : numGasGatherers)[entry.baseIndex] -= (int) entry.gatherers.size();
+    }
+
+    resources.erase(resourceIter);
+}
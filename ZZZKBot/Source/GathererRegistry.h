@@ -0,0 +1,76 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <BWAPI.h>
+#include <unordered_map>
+#include <vector>
+
+#include "BaseRegistry.h"
+
+// Which resource (mineral patch or refinery) each of my gatherers has been told to gather from,
+// and the reverse (all the gatherers of each resource), plus the number of gatherers on the
+// minerals/gas of each base (i.e. its saturation). Everything is updated in place when a gatherer
+// is assigned/unassigned or a unit dies, so nothing needs to be rebuilt or copied per frame.
+class GathererRegistry
+{
+public:
+    void onStart(const BaseRegistry& newBaseRegistry);
+
+    // Call these from the corresponding AI module callbacks.
+    void onUnitMorph(BWAPI::Unit unit);
+    void onUnitRenegade(BWAPI::Unit unit);
+    void onUnitDestroy(BWAPI::Unit unit);
+
+    // Records that the gatherer was told to gather from the resource (replacing whatever it was
+    // gathering from before).
+    void assign(const BWAPI::Unit gatherer, const BWAPI::Unit resource);
+
+    // Records that the gatherer isn't gathering from anything any more (e.g. it was taken to build
+    // something or to fight).
+    void unassign(const BWAPI::Unit gatherer);
+
+    // Returns the resource that the gatherer was told to gather from, or nullptr.
+    BWAPI::Unit getResource(const BWAPI::Unit gatherer) const;
+
+    // Returns the gatherers that were told to gather from the resource.
+    const std::vector<BWAPI::Unit>& getGatherers(const BWAPI::Unit resource) const;
+
+    // The number of gatherers on the mineral patches/refineries of the base (by the base index of
+    // the base registry).
+    int getNumMineralGatherers(const int baseIndex) const;
+    int getNumGasGatherers(const int baseIndex) const;
+
+private:
+    struct ResourceEntry
+    {
+        std::vector<BWAPI::Unit> gatherers;
+        int baseIndex = -1;
+        bool isMineral = false;
+    };
+
+    void removeResource(const BWAPI::Unit resource);
+
+    const BaseRegistry* baseRegistry = nullptr;
+    std::unordered_map<BWAPI::Unit, BWAPI::Unit> gathererToResource;
+    std::unordered_map<BWAPI::Unit, ResourceEntry> resources;
+    std::vector<int> numMineralGatherers;
+    std::vector<int> numGasGatherers;
+};
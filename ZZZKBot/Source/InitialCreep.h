@@ -0,0 +1,84 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <BWAPI.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+// For the various maps and possible start locations, the tile positions of creep around a Zerg
+// base at the start of the game (dumped from games and hard-coded), which are used when scouting
+// against a Zerg or Random race bot to help guess their start location. It only uses BWAPI's
+// value types (not the game), so it is also used by the benchmarks.
+class InitialCreep
+{
+public:
+    // The mapHash() of Plasma 1.0 (which needs some special handling).
+    static inline const std::string plasmaMapHash = "6f5295624a7e3887470f3f2e14727b1411321a67";
+
+    // Calls addCreepLocs(startLoc, creepLocXY) for each start location of the map that there is
+    // data for, where creepLocXY holds the x and y of each tile with creep. Returns whether there
+    // is data for the map.
+    static bool forEachStartLoc(
+        const std::string& mapHash,
+        const std::function<void(const BWAPI::TilePosition, const std::vector<int>&)>& addCreepLocs);
+
+    // The mapHash()es of the maps that there is data for.
+    static const std::vector<std::string>& getMapHashes();
+
+    // What checkCreepLocs() found.
+    enum class Evidence
+    {
+        None,
+        Creep,
+        NoCreep
+    };
+
+    // Checks the tiles where creep would be if a Zerg started at a start location, in order. The
+    // first tile that can be checked (i.e. is visible and isn't covered by a building) decides:
+    // Creep if it has creep, otherwise NoCreep if isStoppingAtNoCreep, otherwise it is skipped
+    // (e.g. a random race enemy might not be Zerg, so a tile without creep proves nothing).
+    // Returns None if no tile decides.
+    template <class CreepLocs, class IsCheckable, class HasCreep>
+    static Evidence checkCreepLocs(
+        const CreepLocs& creepLocs,
+        const bool isStoppingAtNoCreep,
+        const IsCheckable& isCheckable,
+        const HasCreep& hasCreep)
+    {
+        for (const BWAPI::TilePosition tmpLoc : creepLocs)
+        {
+            if (isCheckable(tmpLoc))
+            {
+                if (hasCreep(tmpLoc))
+                {
+                    return Evidence::Creep;
+                }
+                else if (isStoppingAtNoCreep)
+                {
+                    return Evidence::NoCreep;
+                }
+            }
+        }
+
+        return Evidence::None;
+    }
+};
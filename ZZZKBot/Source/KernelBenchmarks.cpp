@@ -0,0 +1,597 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "KernelBenchmarks.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+
+#include "AssignmentSolver.h"
+#include "InitialCreep.h"
+#include "Learning.h"
+#include "LearningFileGenerator.h"
+#include "MockGame.h"
+#include "Rng.h"
+#include "Scenario.h"
+#include "TileBitmap.h"
+
+typedef std::chrono::steady_clock Clock;
+
+// Runs op() numOpsPerSample times per sample (after one run that isn't timed, to warm up the
+// caches), adding what it returns to the checksum.
+template <class Op>
+static KernelBenchmarks::Result measure(
+    const std::string& name,
+    const std::vector<std::pair<std::string, int> >& params,
+    const int numSamples,
+    const int numOpsPerSample,
+    const Op& op)
+{
+    KernelBenchmarks::Result result;
+    result.name = name;
+    result.params = params;
+    result.numOpsPerSample = numOpsPerSample;
+    result.checksum = op();
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        const Clock::time_point start = Clock::now();
+        for (int i = 0; i < numOpsPerSample; ++i)
+        {
+            result.checksum += op();
+        }
+        result.sampleDurations.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start));
+    }
+
+    return result;
+}
+
+// Fewer samples for inputs that take a long time per op (at least 3).
+static int getNumSamples(const int numSamples, const int size, const int smallSize)
+{
+    return std::max(3, (int) ((long long) numSamples * smallSize / std::max(size, smallSize)));
+}
+
+// The target selection of the bot itself is a comparator inside onFrame() that needs the frame
+// snapshot of a whole frame, so it is timed through the bot by the scenarios instead (see
+// ModuleReplay.h). This is MockGame's own target selection (MockGame::findNearestTarget(), not the
+// bot's), which has the same shape of problem: one unit choosing the nearest of N enemy units that
+// it can hit. Its name says so, so that it isn't mistaken for the bot's.
+static void runTargetSelection(const int numSamples, std::vector<KernelBenchmarks::Result>& results)
+{
+    for (const int numCandidates : { 10, 100, 1000, 4000 })
+    {
+        Scenario scenario;
+        scenario.name = "mockgame_target_selection";
+        scenario.numFrames = 1;
+        scenario.players.resize(2);
+        scenario.players[0].id = 0;
+        scenario.players[0].isSelf = true;
+        scenario.players[1].id = 1;
+        scenario.players[1].isEnemy = true;
+        scenario.unitGroups.resize(2);
+        scenario.unitGroups[0] = { 1, "Zerg_Zergling", 0, 2000, 2000, 0 };
+        scenario.unitGroups[1] = { numCandidates, "Terran_Marine", 1, 2400, 2000, 400 };
+
+        MockGame game;
+        std::string error;
+        game.start(scenario, error);
+        results.push_back(measure(
+            "mockgame_target_selection",
+            { { "candidates", numCandidates } },
+            getNumSamples(numSamples, numCandidates, 100),
+            1000,
+            [&game]()
+            {
+                return (long long) game.findNearestTarget(0, false);
+            }));
+    }
+}
+
+// The gatherers are spread around a base with the patches in an arc (like the bot's mineral
+// assignment), and the cost is the distance in pixels. 24 drones on 8 patches is a saturated
+// main base, and 70 drones on 24 patches is three saturated bases (about the most the bot has).
+static void runAssignment(const int numSamples, std::vector<KernelBenchmarks::Result>& results)
+{
+    for (const std::pair<int, int>& size :
+         { std::make_pair(8, 8), std::make_pair(16, 8), std::make_pair(24, 8), std::make_pair(24, 12), std::make_pair(48, 24), std::make_pair(70, 24), std::make_pair(96, 48) })
+    {
+        const int numWorkers = size.first;
+        const int numPatches = size.second;
+        std::mt19937 rng(12345);
+        std::uniform_real_distribution<double> workerPos(-400.0, 400.0);
+
+        std::vector<std::pair<double, double> > patchPositions;
+        for (int i = 0; i < numPatches; ++i)
+        {
+            const double angle = 3.0 * i / numPatches;
+            patchPositions.emplace_back(256.0 * std::cos(angle), 256.0 * std::sin(angle));
+        }
+
+        // Enough positions for every op of every sample to move a worker somewhere else.
+        const int numMoves = 4096;
+        std::vector<std::pair<double, double> > workerPositions;
+        for (int i = 0; i < numWorkers + numMoves; ++i)
+        {
+            workerPositions.emplace_back(workerPos(rng), workerPos(rng));
+        }
+
+        auto getCost =
+            [&patchPositions](const std::pair<double, double>& workerPosition, const int patch)
+            {
+                const double dx = workerPosition.first - patchPositions[patch].first;
+                const double dy = workerPosition.second - patchPositions[patch].second;
+                return (long long) std::sqrt(dx * dx + dy * dy);
+            };
+
+        const std::vector<std::pair<std::string, int> > params = { { "workers", numWorkers }, { "patches", numPatches } };
+        results.push_back(measure(
+            "assignment_full",
+            params,
+            getNumSamples(numSamples, numWorkers * numWorkers * numWorkers, 16 * 16 * 16),
+            10,
+            [numWorkers, numPatches, &workerPositions, &getCost]()
+            {
+                AssignmentSolver solver;
+                for (int worker = 0; worker < numWorkers; ++worker)
+                {
+                    solver.addRow();
+                }
+                for (int patch = 0; patch < numPatches; ++patch)
+                {
+                    solver.addColumn();
+                }
+                for (int worker = 0; worker < numWorkers; ++worker)
+                {
+                    for (int patch = 0; patch < numPatches; ++patch)
+                    {
+                        solver.setCost(worker, patch, getCost(workerPositions[worker], patch));
+                    }
+                }
+                solver.solve();
+
+                long long checksum = 0;
+                for (int worker = 0; worker < numWorkers; ++worker)
+                {
+                    checksum += solver.getAssignedColumn(worker);
+                }
+                return checksum;
+            }));
+
+        // One worker moves (i.e. all of its costs change) between solves.
+        AssignmentSolver solver;
+        for (int worker = 0; worker < numWorkers; ++worker)
+        {
+            solver.addRow();
+        }
+        for (int patch = 0; patch < numPatches; ++patch)
+        {
+            solver.addColumn();
+        }
+        for (int worker = 0; worker < numWorkers; ++worker)
+        {
+            for (int patch = 0; patch < numPatches; ++patch)
+            {
+                solver.setCost(worker, patch, getCost(workerPositions[worker], patch));
+            }
+        }
+        solver.solve();
+
+        int moveIndex = 0;
+        results.push_back(measure(
+            "assignment_incremental",
+            params,
+            getNumSamples(numSamples, numWorkers * numWorkers, 16 * 16),
+            100,
+            [numWorkers, numPatches, numMoves, &solver, &moveIndex, &workerPositions, &getCost]()
+            {
+                const int worker = moveIndex % numWorkers;
+                const std::pair<double, double>& workerPosition = workerPositions[numWorkers + moveIndex % numMoves];
+                ++moveIndex;
+                for (int patch = 0; patch < numPatches; ++patch)
+                {
+                    solver.setCost(worker, patch, getCost(workerPosition, patch));
+                }
+                solver.solve();
+                return (long long) solver.getAssignedColumn(worker);
+            }));
+    }
+}
+
+// Returns the lowest total cost of assigning the real rows to the real columns (a row that isn't
+// assigned, or is assigned a pair that isn't allowed, costs unassignedCost) by trying every
+// permutation, for checking the solver on small inputs.
+static long long getBruteForceAssignmentCost(const std::vector<std::vector<long long> >& costs, const int numCols)
+{
+    const int numRows = (int) costs.size();
+    std::vector<int> perm(std::max(numRows, numCols));
+    for (int i = 0; i < (int) perm.size(); ++i)
+    {
+        perm[i] = i;
+    }
+
+    long long bestCost = std::numeric_limits<long long>::max();
+    do
+    {
+        long long totalCost = 0;
+        for (int row = 0; row < numRows; ++row)
+        {
+            totalCost += perm[row] < numCols ? std::min(costs[row][perm[row]], AssignmentSolver::unassignedCost) : AssignmentSolver::unassignedCost;
+        }
+
+        bestCost = std::min(bestCost, totalCost);
+    }
+    while (std::next_permutation(perm.begin(), perm.end()));
+
+    return bestCost;
+}
+
+bool KernelBenchmarks::checkAssignment(const int numTrials, std::string& error)
+{
+    Rng rng(12345);
+    for (int trial = 0; trial < numTrials; ++trial)
+    {
+        const int numRows = 1 + rng.nextInt(7);
+        const int numCols = 1 + rng.nextInt(7);
+
+        // Small costs so that there are ties, and some pairs that aren't allowed.
+        const auto getRandomCost =
+            [&rng]()
+            {
+                return rng.nextInt(8) == 0 ? AssignmentSolver::unassignedCost : (long long) rng.nextInt(20);
+            };
+
+        // The solver's indexes of the rows/columns (which are reused after a removal) and the
+        // costs by the order in which they were added.
+        AssignmentSolver solver;
+        std::vector<int> rows;
+        std::vector<int> cols;
+        std::vector<std::vector<long long> > costs;
+        for (int col = 0; col < numCols; ++col)
+        {
+            cols.push_back(solver.addColumn());
+        }
+        for (int row = 0; row < numRows; ++row)
+        {
+            rows.push_back(solver.addRow());
+            costs.emplace_back();
+            for (int col = 0; col < numCols; ++col)
+            {
+                costs.back().push_back(getRandomCost());
+                solver.setCost(rows.back(), cols[col], costs.back().back());
+            }
+        }
+
+        // Solve from scratch, then after each of some changes like the ones the bot makes (a
+        // gatherer moving, or a gatherer/patch coming or going).
+        for (int step = 0; step < 16; ++step)
+        {
+            solver.solve();
+
+            long long totalCost = 0;
+            std::vector<bool> isColUsed(cols.size(), false);
+            for (int row = 0; row < (int) rows.size(); ++row)
+            {
+                const int solverCol = solver.getAssignedColumn(rows[row]);
+                const int col = (int) (std::find(cols.begin(), cols.end(), solverCol) - cols.begin());
+                if (solverCol == -1)
+                {
+                    totalCost += AssignmentSolver::unassignedCost;
+                }
+                else if (col == (int) cols.size() || isColUsed[col])
+                {
+                    error = "trial " + std::to_string(trial) + " step " + std::to_string(step) + ": row " + std::to_string(row) + " assigned an invalid column";
+                    return false;
+                }
+                else
+                {
+                    isColUsed[col] = true;
+                    totalCost += costs[row][col];
+                }
+            }
+
+            const long long bruteForceCost = getBruteForceAssignmentCost(costs, (int) cols.size());
+            if (totalCost != bruteForceCost)
+            {
+                error = "trial " + std::to_string(trial) + " step " + std::to_string(step) + ": cost " + std::to_string(totalCost) + " but brute force found " + std::to_string(bruteForceCost);
+                return false;
+            }
+
+            const int change = rng.nextInt(5);
+            if (change == 0 && rows.size() < 7)
+            {
+                rows.push_back(solver.addRow());
+                costs.emplace_back();
+                for (int col = 0; col < (int) cols.size(); ++col)
+                {
+                    costs.back().push_back(getRandomCost());
+                    solver.setCost(rows.back(), cols[col], costs.back().back());
+                }
+            }
+            else if (change == 1 && rows.size() > 1)
+            {
+                const int row = rng.nextInt((int) rows.size());
+                solver.removeRow(rows[row]);
+                rows.erase(rows.begin() + row);
+                costs.erase(costs.begin() + row);
+            }
+            else if (change == 2 && cols.size() > 1)
+            {
+                const int col = rng.nextInt((int) cols.size());
+                solver.removeColumn(cols[col]);
+                cols.erase(cols.begin() + col);
+                for (std::vector<long long>& rowCosts : costs)
+                {
+                    rowCosts.erase(rowCosts.begin() + col);
+                }
+            }
+            else
+            {
+                const int row = rng.nextInt((int) rows.size());
+                for (int col = 0; col < (int) cols.size(); ++col)
+                {
+                    costs[row][col] = getRandomCost();
+                    solver.setCost(rows[row], cols[col], costs[row][col]);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+static Learning::ParseContext getLearningParseContext()
+{
+    Learning::ParseContext context;
+    context.dataFileExtension = "dat";
+    context.pathFieldDelimiter = "_";
+    context.myVersionMajor = 1;
+    context.myVersionMinor = 7;
+    context.myRaceName = BWAPI::Races::Zerg.getName();
+    context.enemyRaceInit = BWAPI::Races::Terran;
+    return context;
+}
+
+static void runLearning(const int numSamples, std::vector<KernelBenchmarks::Result>& results)
+{
+    const Learning::ParseContext context = getLearningParseContext();
+    for (const int numGames : { 1000, 10000, 100000 })
+    {
+        const int numMaps = 8;
+        LearningFileGenerator::Config config;
+        config.numGames = numGames;
+        config.numMaps = numMaps;
+        config.winRatio = 0.6;
+        const std::string learningFile = LearningFileGenerator::makeText(config);
+        const std::vector<std::pair<std::string, int> > params = { { "games", numGames }, { "maps", numMaps } };
+
+        results.push_back(measure(
+            "learning_parse",
+            params,
+            getNumSamples(numSamples, numGames, 1000),
+            1,
+            [&learningFile, &context]()
+            {
+                LearningMap learningMap;
+                std::pmr::map<int, StratSettings> gameIDToStratSettings;
+                std::pmr::map<int, int> gameIDToOnEndFrameCount;
+                std::istringstream iss(learningFile);
+                return (long long) Learning::parse(iss, context, learningMap, gameIDToStratSettings, gameIDToOnEndFrameCount);
+            }));
+
+        LearningMap learningMap;
+        std::pmr::map<int, StratSettings> gameIDToStratSettings;
+        std::pmr::map<int, int> gameIDToOnEndFrameCount;
+        std::istringstream iss(learningFile);
+        Learning::parse(iss, context, learningMap, gameIDToStratSettings, gameIDToOnEndFrameCount);
+
+        // The scenarios of the games in the file (and some that aren't in it, so the less specific
+        // fallbacks are used too).
+        std::vector<Learning::SelectionKey> keys;
+        for (int i = 0; i < numMaps + 2; ++i)
+        {
+            keys.push_back(LearningFileGenerator::makeSelectionKey(config, i, 0));
+        }
+
+        Rng rng(1);
+        int keyIndex = 0;
+        results.push_back(measure(
+            "strategy_selection",
+            params,
+            numSamples,
+            100,
+            [&learningMap, &gameIDToStratSettings, &keys, &keyIndex, &rng]()
+            {
+                StratSettings ss = {};
+                const bool isUpdated = Learning::selectStratSettings(learningMap, gameIDToStratSettings, keys[keyIndex++ % keys.size()], rng, ss);
+                return (isUpdated ? 1000LL : 0LL) + ss.numSunkens + (ss.is4PoolBO ? 100 : 0) + (ss.isSpeedlingBO ? 200 : 0) + (ss.isHydraRushBO ? 400 : 0);
+            }));
+    }
+}
+
+static void runInitialCreep(const int numSamples, std::vector<KernelBenchmarks::Result>& results)
+{
+    typedef std::map<BWAPI::TilePosition, std::set<BWAPI::TilePosition> > CreepLocsMap;
+    auto loadCreepLocs =
+        [](const std::string& mapHash, CreepLocsMap& creepLocsMap)
+        {
+            InitialCreep::forEachStartLoc(
+                mapHash,
+                [&creepLocsMap](const BWAPI::TilePosition startLoc, const std::vector<int>& creepLocXY)
+                {
+                    for (unsigned int i = 0; i + 1 < creepLocXY.size(); i += 2)
+                    {
+                        creepLocsMap[startLoc].insert(BWAPI::TilePosition(creepLocXY[i], creepLocXY[i + 1]));
+                    }
+                });
+        };
+
+    const std::vector<std::string>& mapHashes = InitialCreep::getMapHashes();
+    results.push_back(measure(
+        "creep_tables_load",
+        { { "maps", (int) mapHashes.size() } },
+        numSamples,
+        1,
+        [&mapHashes, &loadCreepLocs]()
+        {
+            long long numTiles = 0;
+            for (const std::string& mapHash : mapHashes)
+            {
+                CreepLocsMap creepLocsMap;
+                loadCreepLocs(mapHash, creepLocsMap);
+                for (const std::pair<const BWAPI::TilePosition, std::set<BWAPI::TilePosition> >& startLocCreepLocs : creepLocsMap)
+                {
+                    numTiles += startLocCreepLocs.second.size();
+                }
+            }
+            return numTiles;
+        }));
+
+    std::vector<CreepLocsMap> creepLocsMaps(mapHashes.size());
+    for (size_t i = 0; i < mapHashes.size(); ++i)
+    {
+        loadCreepLocs(mapHashes[i], creepLocsMaps[i]);
+    }
+
+    // With nothing visible, every tile of every start location is looked at (the worst case,
+    // e.g. before the overlords arrive). With everything visible and the creep of one start
+    // location on the map, the first tile of each start location decides.
+    for (const bool isAllVisible : { false, true })
+    {
+        TileBitmap visibleMask;
+        visibleMask.reset(256, 256);
+        visibleMask.setRect(0, 0, 256, 256, isAllVisible);
+
+        std::vector<TileBitmap> creepMasks(mapHashes.size());
+        for (size_t i = 0; i < mapHashes.size(); ++i)
+        {
+            creepMasks[i].reset(256, 256);
+            if (!creepLocsMaps[i].empty())
+            {
+                for (const BWAPI::TilePosition creepLoc : creepLocsMaps[i].rbegin()->second)
+                {
+                    creepMasks[i].set(creepLoc.x, creepLoc.y);
+                }
+            }
+        }
+
+        results.push_back(measure(
+            "creep_check",
+            { { "maps", (int) mapHashes.size() }, { "visible", isAllVisible ? 1 : 0 } },
+            numSamples,
+            10,
+            [&visibleMask, &creepLocsMaps, &creepMasks]()
+            {
+                long long checksum = 0;
+                for (size_t i = 0; i < creepLocsMaps.size(); ++i)
+                {
+                    const TileBitmap& creepMask = creepMasks[i];
+                    for (const std::pair<const BWAPI::TilePosition, std::set<BWAPI::TilePosition> >& startLocCreepLocs : creepLocsMaps[i])
+                    {
+                        const InitialCreep::Evidence evidence =
+                            InitialCreep::checkCreepLocs(
+                                startLocCreepLocs.second,
+                                true,
+                                [&visibleMask](const BWAPI::TilePosition tmpLoc)
+                                {
+                                    return visibleMask.get(tmpLoc.x, tmpLoc.y);
+                                },
+                                [&creepMask](const BWAPI::TilePosition tmpLoc)
+                                {
+                                    return creepMask.get(tmpLoc.x, tmpLoc.y);
+                                });
+                        checksum += (long long) evidence;
+                    }
+                }
+                return checksum;
+            }));
+    }
+}
+
+double KernelBenchmarks::Result::getNanosecondsPerOp(const double fraction) const
+{
+    if (sampleDurations.empty() || numOpsPerSample <= 0)
+    {
+        return 0.0;
+    }
+
+    std::vector<std::chrono::nanoseconds> sorted = sampleDurations;
+    std::sort(sorted.begin(), sorted.end());
+    const size_t index = std::min(sorted.size() - 1, (size_t) (fraction * (sorted.size() - 1) + 0.5));
+    return (double) sorted[index].count() / numOpsPerSample;
+}
+
+std::vector<KernelBenchmarks::Result> KernelBenchmarks::runAll(const int numSamples)
+{
+    std::vector<Result> results;
+    runTargetSelection(numSamples, results);
+    runAssignment(numSamples, results);
+    runLearning(numSamples, results);
+    runInitialCreep(numSamples, results);
+    return results;
+}
+
+void KernelBenchmarks::print(std::ostream& os, const Result& result)
+{
+    std::ostringstream name;
+    name << result.name << "(";
+    for (size_t i = 0; i < result.params.size(); ++i)
+    {
+        name << (i > 0 ? ", " : "") << result.params[i].first << "=" << result.params[i].second;
+    }
+    name << ")";
+
+    os << std::left << std::setw(50) << name.str() << std::right << std::fixed << std::setprecision(1)
+       << " min " << std::setw(12) << result.getNanosecondsPerOp(0.0) << " ns"
+       << ", p50 " << std::setw(12) << result.getNanosecondsPerOp(0.5) << " ns"
+       << ", p90 " << std::setw(12) << result.getNanosecondsPerOp(0.9) << " ns"
+       << " (" << result.sampleDurations.size() << " x " << result.numOpsPerSample << ")" << std::endl;
+    os.unsetf(std::ios_base::floatfield);
+}
+
+void KernelBenchmarks::writeJson(std::ostream& os, const std::vector<Result>& results)
+{
+    os << "{" << std::endl << "  \"benchmarks\": [" << std::endl;
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const Result& result = results[i];
+        os << "    {\"name\": \"" << result.name << "\", \"params\": {";
+        for (size_t j = 0; j < result.params.size(); ++j)
+        {
+            os << (j > 0 ? ", " : "") << "\"" << result.params[j].first << "\": " << result.params[j].second;
+        }
+        os << "}, \"samples\": " << result.sampleDurations.size()
+           << ", \"opsPerSample\": " << result.numOpsPerSample
+           << std::fixed << std::setprecision(1)
+           << ", \"nsPerOp\": {\"min\": " << result.getNanosecondsPerOp(0.0)
+           << ", \"p50\": " << result.getNanosecondsPerOp(0.5)
+           << ", \"p90\": " << result.getNanosecondsPerOp(0.9)
+           << ", \"max\": " << result.getNanosecondsPerOp(1.0) << "}"
+           << ", \"checksum\": " << result.checksum << "}"
+           << (i + 1 < results.size() ? "," : "") << std::endl;
+        os.unsetf(std::ios_base::floatfield);
+    }
+    os << "  ]" << std::endl << "}" << std::endl;
+}
@@ -0,0 +1,74 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Microbenchmarks of the bot's hot kernels on synthetic inputs of a range of sizes, so that a
+// change to one of them can be measured on its own (and its scaling seen) rather than only by
+// its effect on whole frames:
+// - MockGame's target selection over N candidates (a stand-in for the bot's, see the note in
+//   the .cpp),
+// - the mineral assignment solve of W workers to P patches, from scratch and incrementally,
+// - reading the learning file for an enemy with 1k/10k/100k games in it,
+// - choosing the strategy settings from the learning data,
+// - loading the initial creep tables, and the creep check of the other start locations.
+class KernelBenchmarks
+{
+public:
+    struct Result
+    {
+        std::string name;
+
+        // The size of the input, e.g. ("workers", 24).
+        std::vector<std::pair<std::string, int> > params;
+
+        // How many times the kernel ran in each sample, and how long each sample took.
+        int numOpsPerSample = 0;
+        std::vector<std::chrono::nanoseconds> sampleDurations;
+
+        // Something computed from what the kernel returned (so the work can't be optimized away,
+        // and two builds can be checked for getting the same answers).
+        long long checksum = 0;
+
+        // Returns the time per op of the sample at the given fraction (0 to 1) of the sorted
+        // samples, e.g. 0.5 for the median.
+        double getNanosecondsPerOp(const double fraction) const;
+    };
+
+    // Runs all the benchmarks (each for about the given number of samples, fewer for the slowest
+    // inputs).
+    static std::vector<Result> runAll(const int numSamples);
+
+    // Checks the mineral assignment solver against a brute-force search of every assignment, on
+    // random inputs of up to 7x7 with ties and pairs that aren't allowed, after solving from
+    // scratch and after each of a series of incremental changes. Returns false (with what went
+    // wrong in error) if the solver's total cost is ever different.
+    static bool checkAssignment(const int numTrials, std::string& error);
+
+    static void print(std::ostream& os, const Result& result);
+
+    // Writes the results as a JSON object with one element per result in "benchmarks".
+    static void writeJson(std::ostream& os, const std::vector<Result>& results);
+};
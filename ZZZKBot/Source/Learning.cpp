@@ -0,0 +1,963 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "Learning.h"
+#include <sstream>
+#include <vector>
+
+// Returns whether it updated the strategy settings.
+template <class MapWithNumOutcomesMap>
+static bool updateStratSettings(
+    MapWithNumOutcomesMap& mapWithNumOutcomesMap,
+    std::pmr::map<int, StratSettings>& gameIDToStratSettings,
+    int& mostSpecificLostGameID,
+    Rng& rng,
+    StratSettings& ss)
+{
+    if (mapWithNumOutcomesMap.gameIDIfWonLastGame >= 0)
+    {
+        ss = gameIDToStratSettings[mapWithNumOutcomesMap.gameIDIfWonLastGame];
+        return true;
+    }
+    else
+    {
+        if (mostSpecificLostGameID < 0 && mapWithNumOutcomesMap.gameIDIfLostLastGame >= 0)
+        {
+            mostSpecificLostGameID = mapWithNumOutcomesMap.gameIDIfLostLastGame;
+        }
+
+        // If we have won with any other strategies in this scenario, pick a strategy from
+        // amongst the other strategies we have won with in this scenario, but pick randomly,
+        // weighted by each strategy's individual win ratio in this scenario.
+        std::map<StratSettings, double> ssToTotWinRatiosSoFarMap;
+        double totWinRatios = 0.0;
+        double expectation = 0.0;
+        for (auto& ssToWinsIter : mapWithNumOutcomesMap.numOutcomes[true])
+        {
+            const StratSettings ssTmp = ssToWinsIter.first;
+            if (mostSpecificLostGameID >= 0 && gameIDToStratSettings[mostSpecificLostGameID] == ssTmp)
+            {
+                continue;
+            }
+
+            const double numWins = ssToWinsIter.second;
+            if (numWins == 0.0)
+            {
+                continue;
+            }
+
+            auto ssToLossesIter = mapWithNumOutcomesMap.numOutcomes[false].find(ssTmp);
+            const double numOutcomes =
+                numWins +
+                (ssToLossesIter == mapWithNumOutcomesMap.numOutcomes[false].end() ? 0.0 : ssToLossesIter->second);
+            // Just for safety (shouldn't happen).
+            if (numOutcomes == 0.0)
+            {
+                continue;
+            }
+            const double winRatio = numWins / numOutcomes;
+            expectation = ((expectation * totWinRatios) + (winRatio * winRatio)) / (totWinRatios + winRatio);
+            totWinRatios += winRatio;
+            ssToTotWinRatiosSoFarMap[ssTmp] = totWinRatios;
+        }
+
+        // Treat expectation of 75% win ratio or more as good enough.
+        if (expectation >= 0.75)
+        {
+            const double randDouble = rng.nextDouble() * totWinRatios;
+            for (auto& ssToTotWinRatiosSoFarIter : ssToTotWinRatiosSoFarMap)
+            {
+                if (randDouble <= ssToTotWinRatiosSoFarIter.second)
+                {
+                    ss = ssToTotWinRatiosSoFarIter.first;
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+bool Learning::parseLine(
+    std::string line,
+    const int gameID,
+    const ParseContext& context,
+    LearningMap& learningMap,
+    std::pmr::map<int, StratSettings>& gameIDToStratSettings,
+    std::pmr::map<int, int>& gameIDToOnEndFrameCount)
+{
+    std::vector<std::string> fields;
+    // Block to restrict scope of variables.
+    {
+        std::size_t pos = 0;
+        std::string field;
+        while ((pos = line.find(delim)) != std::string::npos)
+        {
+            field = line.substr(0, pos);
+            fields.push_back(field);
+            line.erase(0, pos + delim.length());
+        }
+        fields.push_back(line);
+    }
+
+    // Validate the types of fields in the line are in the expected sequence and complete,
+    // and read and validate the relevant fields into variables.
+
+    const size_t minInitUpdateFields = 91;
+    size_t minFieldsExpected = minInitUpdateFields;
+    if (fields.size() < minInitUpdateFields ||
+        fields.at(fields.size() - 1) != endOfLineSentinel ||
+        fields.at(fields.size() - 2) != endOfUpdateSentinel ||
+        fields.at(0) != startOfLineSentinel ||
+        fields.at(1) != endOfLineSentinel ||
+        fields.at(2) != startOfUpdateSentinel ||
+        fields.at(3) != endOfUpdateSentinel ||
+        fields.at(4) != initUpdateSignifier ||
+        fields.at(5) != context.dataFileExtension ||
+        fields.at(6) != context.pathFieldDelimiter ||
+        fields.at(7) != std::to_string(context.myVersionMajor) ||
+        fields.at(8) != std::to_string(context.myVersionMinor))
+    {
+        // TODO: corrupt or incomplete line detected (e.g. bot killed before onEnd()), so provide an error message?
+        return false;
+    }
+
+    // Variables for parsing relevant fields for learning purposes.
+    const int myRacePickedInd = 28;
+    std::string tmpMyRacePicked = fields.at(myRacePickedInd);
+    if (tmpMyRacePicked != context.myRaceName)
+    {
+        return false;
+    }
+
+    const int myRaceRolledInd = 29;
+    std::string tmpMyRaceRolled = fields.at(myRaceRolledInd);
+    if (tmpMyRaceRolled != context.myRaceName)
+    {
+        return false;
+    }
+
+    const int myStartLocXInd = 30;
+    int tmpMyStartLocX = -1;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(myStartLocXInd));
+        if (! (iss >> tmpMyStartLocX))
+        {
+            return false;
+        }
+    }
+
+    const int myStartLocYInd = 31;
+    int tmpMyStartLocY = -1;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(myStartLocYInd));
+        if (! (iss >> tmpMyStartLocY))
+        {
+            return false;
+        }
+    }
+
+    const int enemyPlayerIDInd = 33;
+    int tmpEnemyPlayerID = -1;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(enemyPlayerIDInd));
+        if (! (iss >> tmpEnemyPlayerID))
+        {
+            return false;
+        }
+    }
+
+    const int enemyPlayerNameInd = 35;
+    std::string tmpEnemyPlayerName = fields.at(enemyPlayerNameInd);
+
+    const int enemyRacePickedInd = 36;
+    std::string tmpEnemyRacePicked = fields.at(enemyRacePickedInd);
+
+    const int enemyRaceInitInd = 37;
+    std::string tmpEnemyRaceInit = fields.at(enemyRaceInitInd);
+
+    const int enemyStartLocDeducedXInd = 38;
+    int tmpEnemyStartLocDeducedX = -1;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(enemyStartLocDeducedXInd));
+        if (! (iss >> tmpEnemyStartLocDeducedX))
+        {
+            return false;
+        }
+    }
+
+    const int enemyStartLocDeducedYInd = 39;
+    int tmpEnemyStartLocDeducedY = -1;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(enemyStartLocDeducedYInd));
+        if (! (iss >> tmpEnemyStartLocDeducedY))
+        {
+            return false;
+        }
+    }
+
+    const int mapHashInd = 46;
+    std::string tmpMapHash = fields.at(mapHashInd);
+
+    // TODO: could consider using these for learning too (and/or map area).
+    //int tmpMapWidth;
+    //int tmpMapHeight;
+
+    const int isCompleteMapInformationEnabledInd = 49;
+    bool tmpIsCompleteMapInformationEnabled = false;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(isCompleteMapInformationEnabledInd));
+        if (! (iss >> tmpIsCompleteMapInformationEnabled))
+        {
+            return false;
+        }
+    }
+    if (tmpIsCompleteMapInformationEnabled) //&&
+        //!Broodwar->isFlagEnabled(BWAPI::Flag::CompleteMapInformation))
+    {
+        return false;
+    }
+
+    const int numStartLocationsInd = 51;
+    int tmpNumStartLocations = -1;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(numStartLocationsInd));
+        if (! (iss >> tmpNumStartLocations))
+        {
+            return false;
+        }
+    }
+    if (tmpNumStartLocations < 0)
+    {
+        // TODO: corrupt or incomplete line detected (e.g. bot killed before onEnd()), so provide an error message?
+        return false;
+    }
+    // If there are exactly two start locations on this map then deduce where the enemy start location is.
+    if (BWAPI::TilePosition(tmpEnemyStartLocDeducedX, tmpEnemyStartLocDeducedY) == BWAPI::TilePositions::Unknown &&
+        tmpNumStartLocations == 2)
+    {
+        for (int startLocXInd = numStartLocationsInd + 1, startLocYInd = numStartLocationsInd + 2; startLocXInd < numStartLocationsInd + (tmpNumStartLocations * 2); startLocXInd += 2, startLocYInd += 2)
+        {
+            int tmpStartLocX = -1;
+            // Block to restrict scope of variables.
+            {
+                std::istringstream iss(fields.at(startLocXInd));
+                if (! (iss >> tmpStartLocX))
+                {
+                    continue;
+                }
+            }
+
+            int tmpStartLocY = -1;
+            // Block to restrict scope of variables.
+            {
+                std::istringstream iss(fields.at(startLocYInd));
+                if (! (iss >> tmpStartLocY))
+                {
+                    continue;
+                }
+            }
+
+            if (tmpStartLocX != tmpMyStartLocX &&
+                tmpStartLocY != tmpMyStartLocY &&
+                BWAPI::TilePosition(tmpStartLocX, tmpStartLocY) != BWAPI::TilePositions::Unknown)
+            {
+                tmpEnemyStartLocDeducedX = tmpStartLocX;
+                tmpEnemyStartLocDeducedY = tmpStartLocY;
+                break;
+            }
+        }
+    }
+
+    const int tmpOffset = tmpNumStartLocations * 2;
+    minFieldsExpected += tmpOffset;
+
+    // Since the RNG seed has been logged, it is the last field of the init update (after the
+    // strategy settings). Lines written before then don't have it.
+    if (fields.size() >= minFieldsExpected &&
+        fields.at(minFieldsExpected - 2) != endOfUpdateSentinel)
+    {
+        ++minFieldsExpected;
+    }
+
+    if (fields.size() < minFieldsExpected ||
+        fields.at(minFieldsExpected - 2) != endOfUpdateSentinel)
+    {
+        // TODO: corrupt or incomplete line detected (e.g. bot killed before onEnd()), so provide an error message?
+        return false;
+    }
+
+    // TODO: could consider using these for learning too.
+    //std::string tmpGameType;
+    //int tmpLatency;
+    //int tmpLatencyFrames;
+    //bool tmpIsLatComEnabled;
+
+    const int timerAtGameStartInd = 74 + tmpOffset;
+    int tmpTimerAtGameStart = -1;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(timerAtGameStartInd));
+        if (! (iss >> tmpTimerAtGameStart))
+        {
+            return false;
+        }
+    }
+
+    const int is4PoolBOInd = 74 + tmpOffset;
+    bool tmpIs4PoolBO = false;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(is4PoolBOInd));
+        if (! (iss >> tmpIs4PoolBO))
+        {
+            return false;
+        }
+    }
+
+    const int isSpeedlingBOInd = 75 + tmpOffset;
+    bool tmpIsSpeedlingBO = false;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(isSpeedlingBOInd));
+        if (! (iss >> tmpIsSpeedlingBO))
+        {
+            return false;
+        }
+    }
+
+    const int isHydraRushBOInd = 76 + tmpOffset;
+    bool tmpIsHydraRushBO = false;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(isHydraRushBOInd));
+        if (! (iss >> tmpIsHydraRushBO))
+        {
+            return false;
+        }
+    }
+
+    const int isMutaRushBODecidedAfterScoutEnemyRaceInd = 77 + tmpOffset;
+    bool tmpIsMutaRushBODecidedAfterScoutEnemyRace = false;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(isMutaRushBODecidedAfterScoutEnemyRaceInd));
+        if (! (iss >> tmpIsMutaRushBODecidedAfterScoutEnemyRace))
+        {
+            return false;
+        }
+    }
+
+    const int isMutaRushBOInd = 78 + tmpOffset;
+    bool tmpIsMutaRushBO = false;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(isMutaRushBOInd));
+        if (! (iss >> tmpIsMutaRushBO))
+        {
+            return false;
+        }
+    }
+
+    const int isMutaRushBOVsProtossInd = 79 + tmpOffset;
+    bool tmpIsMutaRushBOVsProtoss = false;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(isMutaRushBOVsProtossInd));
+        if (! (iss >> tmpIsMutaRushBOVsProtoss))
+        {
+            return false;
+        }
+    }
+
+    const int isMutaRushBOVsTerranInd = 80 + tmpOffset;
+    bool tmpIsMutaRushBOVsTerran = false;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(isMutaRushBOVsTerranInd));
+        if (! (iss >> tmpIsMutaRushBOVsTerran))
+        {
+            return false;
+        }
+    }
+
+    const int isMutaRushBOVsZergInd = 81 + tmpOffset;
+    bool tmpIsMutaRushBOVsZerg = false;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(isMutaRushBOVsZergInd));
+        if (! (iss >> tmpIsMutaRushBOVsZerg))
+        {
+            return false;
+        }
+    }
+
+    const int isSpeedlingPushDeferredInd = 82 + tmpOffset;
+    bool tmpIsSpeedlingPushDeferred = false;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(isSpeedlingPushDeferredInd));
+        if (! (iss >> tmpIsSpeedlingPushDeferred))
+        {
+            return false;
+        }
+    }
+
+    const int isEnemyWorkerRusherInd = 83 + tmpOffset;
+    bool tmpIsEnemyWorkerRusher = false;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(isEnemyWorkerRusherInd));
+        if (! (iss >> tmpIsEnemyWorkerRusher))
+        {
+            return false;
+        }
+    }
+
+    const int isNumSunkensDecidedAfterScoutEnemyRaceInd = 84 + tmpOffset;
+    bool tmpIsNumSunkensDecidedAfterScoutEnemyRace = false;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(isNumSunkensDecidedAfterScoutEnemyRaceInd));
+        if (! (iss >> tmpIsNumSunkensDecidedAfterScoutEnemyRace))
+        {
+            return false;
+        }
+    }
+
+    const int numSunkensInd = 85 + tmpOffset;
+    int tmpNumSunkens = -1;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(numSunkensInd));
+        if (! (iss >> tmpNumSunkens))
+        {
+            return false;
+        }
+    }
+
+    const int numSunkensVsProtossInd = 86 + tmpOffset;
+    int tmpNumSunkensVsProtoss = -1;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(numSunkensVsProtossInd));
+        if (! (iss >> tmpNumSunkensVsProtoss))
+        {
+            return false;
+        }
+    }
+
+    const int numSunkensVsTerranInd = 87 + tmpOffset;
+    int tmpNumSunkensVsTerran = -1;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(numSunkensVsTerranInd));
+        if (! (iss >> tmpNumSunkensVsTerran))
+        {
+            return false;
+        }
+    }
+
+    const int numSunkensVsZergInd = 88 + tmpOffset;
+    int tmpNumSunkensVsZerg = -1;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(numSunkensVsZergInd));
+        if (! (iss >> tmpNumSunkensVsZerg))
+        {
+            return false;
+        }
+    }
+
+    StratSettings tmpStratSettings =
+    {
+        tmpIs4PoolBO,
+        tmpIsSpeedlingBO,
+        tmpIsHydraRushBO,
+        tmpIsMutaRushBODecidedAfterScoutEnemyRace,
+        tmpIsMutaRushBO,
+        tmpIsMutaRushBOVsProtoss,
+        tmpIsMutaRushBOVsTerran,
+        tmpIsMutaRushBOVsZerg,
+        tmpIsSpeedlingPushDeferred,
+        tmpIsEnemyWorkerRusher,
+        tmpIsNumSunkensDecidedAfterScoutEnemyRace,
+        tmpNumSunkens,
+        tmpNumSunkensVsProtoss,
+        tmpNumSunkensVsTerran,
+        tmpNumSunkensVsZerg
+    };
+
+    if (fields.size() < minFieldsExpected + 1 ||
+        fields.at(minFieldsExpected - 1) != startOfUpdateSentinel)
+    {
+        // TODO: corrupt or incomplete line detected (e.g. bot killed before onEnd()), so provide an error message?
+        return false;
+    }
+
+    int tmpEnemyPlayerLeftFrameCount = -1;
+    bool tmpIsEnemyPlayerLeft = false;
+
+    int tmpEnemyRaceScoutedFrameCount = -1;
+    std::string tmpEnemyRaceScouted;
+    if (tmpEnemyRaceInit != BWAPI::Races::Unknown.getName())
+    {
+        tmpEnemyRaceScouted = tmpEnemyRaceInit;
+    }
+
+    bool isSkipping = false;
+    while (fields.at(minFieldsExpected) == onPlayerLeftUpdateSignifier ||
+           fields.at(minFieldsExpected) == raceScoutedUpdateSignifier)
+    {
+        const int tmpUpdateSignifierInd = minFieldsExpected;
+        const std::string tmpUpdateSignifier = fields.at(tmpUpdateSignifierInd);
+        if (tmpUpdateSignifier == onPlayerLeftUpdateSignifier)
+        {
+            minFieldsExpected += 10;
+        }
+        else if (tmpUpdateSignifier == raceScoutedUpdateSignifier)
+        {
+            minFieldsExpected += 9;
+        }
+
+        if (fields.size() < minFieldsExpected ||
+            fields.at(minFieldsExpected - 2) != endOfUpdateSentinel)
+        {
+            // TODO: corrupt or incomplete line detected (e.g. bot killed before onEnd()), so provide an error message?
+            isSkipping = true;
+            break;
+        }
+
+        if (fields.size() < minFieldsExpected + 1 ||
+            fields.at(minFieldsExpected - 1) != startOfUpdateSentinel)
+        {
+            // TODO: corrupt or incomplete line detected (e.g. bot killed before onEnd()), so provide an error message?
+            isSkipping = true;
+            break;
+        }
+
+        if (tmpUpdateSignifier == onPlayerLeftUpdateSignifier)
+        {
+            const int onEnemyPlayerLeftFrameCountInd = tmpUpdateSignifierInd + 1;
+            int tmpOnEnemyPlayerLeftFrameCount = -1;
+            // Block to restrict scope of variables.
+            {
+                std::istringstream iss(fields.at(onEnemyPlayerLeftFrameCountInd));
+                if (! (iss >> tmpOnEnemyPlayerLeftFrameCount))
+                {
+                    isSkipping = true;
+                    break;
+                }
+            }
+
+            const int onEnemyPlayerLeftPlayerIDInd = tmpUpdateSignifierInd + 6;
+            int tmpOnEnemyPlayerLeftPlayerID = -1;
+            // Block to restrict scope of variables.
+            {
+                std::istringstream iss(fields.at(onEnemyPlayerLeftPlayerIDInd));
+                if (! (iss >> tmpOnEnemyPlayerLeftPlayerID))
+                {
+                    isSkipping = true;
+                    break;
+                }
+            }
+
+            if (tmpOnEnemyPlayerLeftPlayerID == tmpEnemyPlayerID)
+            {
+                tmpIsEnemyPlayerLeft = true;
+                tmpEnemyPlayerLeftFrameCount = tmpOnEnemyPlayerLeftFrameCount;
+            }
+        }
+        else if (tmpUpdateSignifier == raceScoutedUpdateSignifier)
+        {
+            const int enemyRaceScoutedFrameCountInd = tmpUpdateSignifierInd + 1;
+            // Block to restrict scope of variables.
+            {
+                std::istringstream iss(fields.at(enemyRaceScoutedFrameCountInd));
+                if (! (iss >> tmpEnemyRaceScoutedFrameCount))
+                {
+                    isSkipping = true;
+                    break;
+                }
+            }
+
+            const int enemyRaceScoutedInd = tmpUpdateSignifierInd + 6;
+            tmpEnemyRaceScouted = fields.at(enemyRaceScoutedInd);
+        }
+    }
+
+    if (isSkipping)
+    {
+        return false;
+    }
+
+    if (context.enemyRaceInit != BWAPI::Races::Unknown)
+    {
+        if (tmpEnemyRaceInit != BWAPI::Races::Unknown.getName())
+        {
+            if (tmpEnemyRaceInit != context.enemyRaceInit.getName())
+            {
+                return false;
+            }
+        }
+        else
+        {
+            // Assumption that the enemy race was eventually scouted and was
+            // scouted early enough in the game for there not to be much
+            // difference in how the whole game played out compared with if
+            // the race had been known at the start of the game.
+            if (tmpEnemyRaceScouted != context.enemyRaceInit.getName())
+            {
+                return false;
+            }
+        }
+    }
+
+    if (fields.at(minFieldsExpected) != onEndUpdateSignifier)
+    {
+        // TODO: corrupt or incomplete line detected (e.g. bot killed before onEnd()) or oversized line detected,
+        // so provide an error message?
+        return false;
+    }
+
+    const size_t onEndUpdateSignifierInd = minFieldsExpected;
+    minFieldsExpected += 9;
+
+    // Since the slow frames have been logged, their counts and the worst stages of the frames
+    // follow isWinner. Lines written before then don't have them.
+    const size_t numSlowFrameFields = 5;
+    if (fields.size() == minFieldsExpected + numSlowFrameFields)
+    {
+        minFieldsExpected += numSlowFrameFields;
+    }
+
+    if (fields.size() < minFieldsExpected)
+    {
+        // TODO: corrupt or incomplete line detected (e.g. bot killed before onEnd()), so provide an error message?
+        return false;
+    }
+
+    if (fields.size() > minFieldsExpected)
+    {
+        // TODO: corrupt or oversized line detected, so provide an error message?
+        return false;
+    }
+
+    const int onEndFrameCountInd = onEndUpdateSignifierInd + 1;
+    int tmpOnEndFrameCount = -1;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(onEndFrameCountInd));
+        if (! (iss >> tmpOnEndFrameCount))
+        {
+            return false;
+        }
+    }
+
+    const int isWinnerInd = onEndUpdateSignifierInd + 6;
+    bool tmpIsWinner = false;
+    // Block to restrict scope of variables.
+    {
+        std::istringstream iss(fields.at(isWinnerInd));
+        if (! (iss >> tmpIsWinner))
+        {
+            return false;
+        }
+    }
+
+    // Add the data to lookup maps for learning purposes.
+    auto& enemyRaceInitMap = learningMap.enemyRaceInitMap;
+    auto& enemyRaceScoutedMap = enemyRaceInitMap.val[tmpEnemyRaceInit];
+    auto& numStartLocationsMap = enemyRaceScoutedMap.val[tmpEnemyRaceScouted];
+    auto& mapHashMap = numStartLocationsMap.val[tmpNumStartLocations];
+    auto& myStartLocationMap = mapHashMap.val[tmpMapHash];
+    auto& enemyStartLocDeducedMap = myStartLocationMap.val[BWAPI::TilePosition(tmpMyStartLocX, tmpMyStartLocY)];
+    auto& outcomeMap = enemyStartLocDeducedMap.val[BWAPI::TilePosition(tmpEnemyStartLocDeducedX, tmpEnemyStartLocDeducedY)];
+    auto& timerAtGameStartMap = outcomeMap.val[tmpIsWinner];
+    auto& gameIDSet = timerAtGameStartMap.val[tmpTimerAtGameStart];
+    gameIDSet.val.insert(gameID);
+    gameIDToOnEndFrameCount.emplace(gameID, tmpOnEndFrameCount);
+    gameIDToStratSettings.emplace(gameID, tmpStratSettings);
+    ++learningMap.numOutcomes[tmpIsWinner];
+    ++enemyRaceInitMap.numOutcomes[tmpIsWinner][tmpStratSettings];
+    ++enemyRaceScoutedMap.numOutcomes[tmpIsWinner][tmpStratSettings];
+    ++numStartLocationsMap.numOutcomes[tmpIsWinner][tmpStratSettings];
+    ++mapHashMap.numOutcomes[tmpIsWinner][tmpStratSettings];
+    ++myStartLocationMap.numOutcomes[tmpIsWinner][tmpStratSettings];
+    ++enemyStartLocDeducedMap.numOutcomes[tmpIsWinner][tmpStratSettings];
+    ++outcomeMap.numOutcomes[tmpIsWinner][tmpStratSettings];
+
+    if ((outcomeMap.gameIDIfWonLastGame >= 0 && tmpTimerAtGameStart >= outcomeMap.val[true].val.rbegin()->first) ||
+        (outcomeMap.gameIDIfLostLastGame >= 0 && tmpTimerAtGameStart >= outcomeMap.val[false].val.rbegin()->first) ||
+        (outcomeMap.gameIDIfWonLastGame < 0 && outcomeMap.gameIDIfLostLastGame < 0))
+    {
+        if (tmpIsWinner)
+        {
+            outcomeMap.gameIDIfWonLastGame = gameID;
+            enemyStartLocDeducedMap.gameIDIfWonLastGame = gameID;
+            myStartLocationMap.gameIDIfWonLastGame = gameID;
+            mapHashMap.gameIDIfWonLastGame = gameID;
+            numStartLocationsMap.gameIDIfWonLastGame = gameID;
+            enemyRaceScoutedMap.gameIDIfWonLastGame = gameID;
+            enemyRaceInitMap.gameIDIfWonLastGame = gameID;
+            learningMap.gameIDIfWonLastGame = gameID;
+            outcomeMap.gameIDIfLostLastGame = -1;
+            enemyStartLocDeducedMap.gameIDIfLostLastGame = -1;
+            myStartLocationMap.gameIDIfLostLastGame = -1;
+            mapHashMap.gameIDIfLostLastGame = -1;
+            numStartLocationsMap.gameIDIfLostLastGame = -1;
+            enemyRaceScoutedMap.gameIDIfLostLastGame = -1;
+            enemyRaceInitMap.gameIDIfLostLastGame = -1;
+            learningMap.gameIDIfLostLastGame = -1;
+        }
+        else
+        {
+            outcomeMap.gameIDIfLostLastGame = gameID;
+            enemyStartLocDeducedMap.gameIDIfLostLastGame = gameID;
+            myStartLocationMap.gameIDIfLostLastGame = gameID;
+            mapHashMap.gameIDIfLostLastGame = gameID;
+            numStartLocationsMap.gameIDIfLostLastGame = gameID;
+            enemyRaceScoutedMap.gameIDIfLostLastGame = gameID;
+            enemyRaceInitMap.gameIDIfLostLastGame = gameID;
+            learningMap.gameIDIfLostLastGame = gameID;
+            outcomeMap.gameIDIfWonLastGame = -1;
+            enemyStartLocDeducedMap.gameIDIfWonLastGame = -1;
+            myStartLocationMap.gameIDIfWonLastGame = -1;
+            mapHashMap.gameIDIfWonLastGame = -1;
+            numStartLocationsMap.gameIDIfWonLastGame = -1;
+            enemyRaceScoutedMap.gameIDIfWonLastGame = -1;
+            enemyRaceInitMap.gameIDIfWonLastGame = -1;
+            learningMap.gameIDIfWonLastGame = -1;
+        }
+    }
+
+    return true;
+}
+
+int Learning::parse(
+    std::istream& is,
+    const ParseContext& context,
+    LearningMap& learningMap,
+    std::pmr::map<int, StratSettings>& gameIDToStratSettings,
+    std::pmr::map<int, int>& gameIDToOnEndFrameCount)
+{
+    int numGamesAdded = 0;
+    int gameID = -1;
+    std::string line;
+    while (getline(is, line) && is)
+    {
+        ++gameID;
+        if (parseLine(line, gameID, context, learningMap, gameIDToStratSettings, gameIDToOnEndFrameCount))
+        {
+            ++numGamesAdded;
+        }
+    }
+
+    return numGamesAdded;
+}
+
+bool Learning::selectStratSettings(
+    LearningMap& learningMap,
+    std::pmr::map<int, StratSettings>& gameIDToStratSettings,
+    const SelectionKey& key,
+    Rng& rng,
+    StratSettings& ss)
+{
+    int mostSpecificLostGameID = -1;
+    bool isUpdatedStratSettings = false;
+    auto& enemyRaceInitMap = learningMap.enemyRaceInitMap;
+    auto enemyRaceInitIter = enemyRaceInitMap.val.find(key.enemyRaceInit.getName());
+    if (enemyRaceInitIter != learningMap.enemyRaceInitMap.val.end())
+    {
+        auto& enemyRaceScoutedMap = enemyRaceInitIter->second;
+        auto enemyRaceScoutedIter = enemyRaceScoutedMap.val.find(key.enemyRaceInit.getName());
+        if (enemyRaceScoutedIter != enemyRaceScoutedMap.val.end())
+        {
+            auto& numStartLocationsMap = enemyRaceScoutedIter->second;
+            auto numStartLocationsIter = numStartLocationsMap.val.find(key.numStartLocations);
+            if (numStartLocationsIter != numStartLocationsMap.val.end())
+            {
+                auto& mapHashMap = numStartLocationsIter->second;
+                auto mapHashIter = mapHashMap.val.find(key.mapHash);
+                if (mapHashIter != mapHashMap.val.end())
+                {
+                    auto& myStartLocationMap = mapHashIter->second;
+                    auto myStartLocIter = myStartLocationMap.val.find(key.myStartLoc);
+                    if (myStartLocIter != myStartLocationMap.val.end())
+                    {
+                        auto& enemyStartLocDeducedMap = myStartLocIter->second;
+                        auto enemyStartLocDeducedIter = enemyStartLocDeducedMap.val.find(key.enemyStartLocDeduced);
+                        if (enemyStartLocDeducedIter != enemyStartLocDeducedMap.val.end())
+                        {
+                            auto& outcomeMap = enemyStartLocDeducedIter->second;
+                            isUpdatedStratSettings = updateStratSettings(outcomeMap, gameIDToStratSettings, mostSpecificLostGameID, rng, ss);
+                        }
+
+                        if (!isUpdatedStratSettings)
+                        {
+                            isUpdatedStratSettings = updateStratSettings(enemyStartLocDeducedMap, gameIDToStratSettings, mostSpecificLostGameID, rng, ss);
+                        }
+                    }
+
+                    if (!isUpdatedStratSettings)
+                    {
+                        isUpdatedStratSettings = updateStratSettings(myStartLocationMap, gameIDToStratSettings, mostSpecificLostGameID, rng, ss);
+                    }
+                }
+
+                if (!isUpdatedStratSettings)
+                {
+                    isUpdatedStratSettings = updateStratSettings(mapHashMap, gameIDToStratSettings, mostSpecificLostGameID, rng, ss);
+                }
+            }
+
+            if (!isUpdatedStratSettings)
+            {
+                isUpdatedStratSettings = updateStratSettings(numStartLocationsMap, gameIDToStratSettings, mostSpecificLostGameID, rng, ss);
+            }
+        }
+
+        if (!isUpdatedStratSettings)
+        {
+            isUpdatedStratSettings = updateStratSettings(enemyRaceScoutedMap, gameIDToStratSettings, mostSpecificLostGameID, rng, ss);
+        }
+    }
+
+    if (!isUpdatedStratSettings)
+    {
+        isUpdatedStratSettings = updateStratSettings(enemyRaceInitMap, gameIDToStratSettings, mostSpecificLostGameID, rng, ss);
+    }
+
+    return isUpdatedStratSettings;
+}
+
+bool Learning::exploreStratSettings(
+    LearningMap& learningMap,
+    const bool isMapPlasma,
+    const BWAPI::Race enemyRaceInit,
+    Rng& rng,
+    StratSettings& ss)
+{
+    // If have lost at least 5 games and win ratio is less than 80%...
+    if (learningMap.numOutcomes[false] >= 5 &&
+        learningMap.numOutcomes[false] * 4 > learningMap.numOutcomes[true])
+    {
+        // I.E. is4PoolBO vs isSpeedlingBO vs isHydraRushBO vs neither.
+        const int randBONum = rng.nextInt(4);
+
+        ss.is4PoolBO = (randBONum == 0);
+        ss.isSpeedlingBO = (randBONum == 1);
+        ss.isHydraRushBO = (randBONum == 2);
+        ss.isMutaRushBODecidedAfterScoutEnemyRace =
+            (isMapPlasma &&
+             enemyRaceInit == BWAPI::Races::Unknown &&
+             (rng.nextInt(100) < 20));
+        ss.isMutaRushBO = (rng.nextInt(100) < 85);
+        ss.isMutaRushBOVsProtoss = true;
+        ss.isMutaRushBOVsTerran = true;
+        ss.isMutaRushBOVsZerg = true;
+        if (ss.isMutaRushBODecidedAfterScoutEnemyRace)
+        {
+            while (ss.isMutaRushBOVsProtoss == ss.isMutaRushBOVsTerran &&
+                   ss.isMutaRushBOVsTerran == ss.isMutaRushBOVsZerg)
+            {
+                ss.isMutaRushBOVsProtoss = (rng.nextInt(100) < 85);
+                ss.isMutaRushBOVsTerran = (rng.nextInt(100) < 85);
+                ss.isMutaRushBOVsZerg = (rng.nextInt(100) < 85);
+            }
+        }
+
+        ss.isSpeedlingPushDeferred = (randBONum == 1 && (rng.nextInt(100) < 25));
+        ss.isEnemyWorkerRusher = (rng.nextInt(100) < 15);
+
+        const int randNumSunkensIn = rng.nextInt(100);
+        ss.numSunkens = 0;
+        if (randNumSunkensIn < 20)
+        {
+            ss.numSunkens = 0;
+        }
+        else if (randNumSunkensIn < 50)
+        {
+            ss.numSunkens = 1;
+        }
+        else if (randNumSunkensIn < 65)
+        {
+            ss.numSunkens = 2;
+        }
+        else if (randNumSunkensIn < 75)
+        {
+            ss.numSunkens = 3;
+        }
+        else if (randNumSunkensIn < 80)
+        {
+            ss.numSunkens = 5;
+        }
+        else if (randNumSunkensIn < 85)
+        {
+            ss.numSunkens = 8;
+        }
+        else if (randNumSunkensIn < 90)
+        {
+            ss.numSunkens = 11;
+        }
+        else if (randNumSunkensIn < 95)
+        {
+            ss.numSunkens = 15;
+        }
+        else
+        {
+            ss.numSunkens = 19;
+        }
+
+        ss.isNumSunkensDecidedAfterScoutEnemyRace =
+            (enemyRaceInit == BWAPI::Races::Unknown &&
+             (rng.nextInt(100) < 20));
+
+        ss.numSunkensVsProtoss = 1;
+        ss.numSunkensVsTerran = 1;
+        ss.numSunkensVsZerg = 1;
+        if (ss.isNumSunkensDecidedAfterScoutEnemyRace)
+        {
+            while (ss.numSunkensVsProtoss == ss.numSunkensVsTerran &&
+                   ss.numSunkensVsTerran == ss.numSunkensVsZerg)
+            {
+                ss.numSunkensVsProtoss = (ss.numSunkens + (rng.nextInt(8) - 4));
+                ss.numSunkensVsTerran = (ss.numSunkens + (rng.nextInt(8) - 4));
+                ss.numSunkensVsZerg = (ss.numSunkens + (rng.nextInt(8) - 4));
+
+                ss.numSunkensVsProtoss *= (ss.numSunkensVsProtoss < 0 ? -1 : 1);
+                ss.numSunkensVsTerran *= (ss.numSunkensVsTerran < 0 ? -1 : 1);
+                ss.numSunkensVsZerg *= (ss.numSunkensVsZerg < 0 ? -1 : 1);
+            }
+        }
+
+        return true;
+    }
+
+    return false;
+}
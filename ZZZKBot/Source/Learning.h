@@ -0,0 +1,340 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <BWAPI.h>
+#include <istream>
+#include <map>
+#include <memory_resource>
+#include <set>
+#include <string>
+
+#include "Rng.h"
+
+// The strategy settings of a game.
+struct StratSettings
+{
+    bool is4PoolBO;
+    bool isSpeedlingBO;
+    bool isHydraRushBO;
+    bool isMutaRushBODecidedAfterScoutEnemyRace;
+    bool isMutaRushBO;
+
+    // For normal queries, query isMutaRushBO, not these because they are only used
+    // in conjunction with isMutaRushBODecidedAfterScoutEnemyRace.
+    bool isMutaRushBOVsProtoss;
+    bool isMutaRushBOVsTerran;
+    bool isMutaRushBOVsZerg;
+
+    bool isSpeedlingPushDeferred;
+    bool isEnemyWorkerRusher;
+    bool isNumSunkensDecidedAfterScoutEnemyRace;
+    int numSunkens;
+
+    // For normal queries, query numSunkens, not these because they are only used
+    // in conjunction with isNumSunkensDecidedAfterScoutEnemyRace.
+    int numSunkensVsProtoss;
+    int numSunkensVsTerran;
+    int numSunkensVsZerg;
+
+    // The learning maps are keyed by the settings, so this must be a strict weak ordering, i.e.
+    // equal settings aren't less. (It used to return true for equal settings, so a strategy's
+    // losses were never counted with its wins; strategy selection depends on this.)
+    inline bool operator <(const StratSettings& other) const
+    {
+        if (!is4PoolBO && other.is4PoolBO) return true;
+        if (is4PoolBO && !other.is4PoolBO) return false;
+        if (!isSpeedlingBO && other.isSpeedlingBO) return true;
+        if (isSpeedlingBO && !other.isSpeedlingBO) return false;
+        if (!isHydraRushBO && other.isHydraRushBO) return true;
+        if (isHydraRushBO && !other.isHydraRushBO) return false;
+        if (!isMutaRushBODecidedAfterScoutEnemyRace && other.isMutaRushBODecidedAfterScoutEnemyRace) return true;
+        if (isMutaRushBODecidedAfterScoutEnemyRace && !other.isMutaRushBODecidedAfterScoutEnemyRace) return false;
+        if (!isMutaRushBO && other.isMutaRushBO) return true;
+        if (isMutaRushBO && !other.isMutaRushBO) return false;
+        if (!isMutaRushBOVsProtoss && other.isMutaRushBOVsProtoss) return true;
+        if (isMutaRushBOVsProtoss && !other.isMutaRushBOVsProtoss) return false;
+        if (!isMutaRushBOVsTerran && other.isMutaRushBOVsTerran) return true;
+        if (isMutaRushBOVsTerran && !other.isMutaRushBOVsTerran) return false;
+        if (!isMutaRushBOVsZerg && other.isMutaRushBOVsZerg) return true;
+        if (isMutaRushBOVsZerg && !other.isMutaRushBOVsZerg) return false;
+        if (!isSpeedlingPushDeferred && other.isSpeedlingPushDeferred) return true;
+        if (isSpeedlingPushDeferred && !other.isSpeedlingPushDeferred) return false;
+        if (!isEnemyWorkerRusher && other.isEnemyWorkerRusher) return true;
+        if (isEnemyWorkerRusher && !other.isEnemyWorkerRusher) return false;
+        if (!isNumSunkensDecidedAfterScoutEnemyRace && other.isNumSunkensDecidedAfterScoutEnemyRace) return true;
+        if (isNumSunkensDecidedAfterScoutEnemyRace && !other.isNumSunkensDecidedAfterScoutEnemyRace) return false;
+        if (numSunkens < other.numSunkens) return true;
+        if (numSunkens > other.numSunkens) return false;
+        if (numSunkensVsProtoss < other.numSunkensVsProtoss) return true;
+        if (numSunkensVsProtoss > other.numSunkensVsProtoss) return false;
+        if (numSunkensVsTerran < other.numSunkensVsTerran) return true;
+        if (numSunkensVsTerran > other.numSunkensVsTerran) return false;
+        if (numSunkensVsZerg < other.numSunkensVsZerg) return true;
+        if (numSunkensVsZerg > other.numSunkensVsZerg) return false;
+        // Equal (so not less).
+        return false;
+    }
+
+    inline bool operator ==(const StratSettings& other) const
+    {
+        if (is4PoolBO != other.is4PoolBO) return false;
+        if (isSpeedlingBO != other.isSpeedlingBO) return false;
+        if (isHydraRushBO != other.isHydraRushBO) return false;
+        if (isMutaRushBODecidedAfterScoutEnemyRace != other.isMutaRushBODecidedAfterScoutEnemyRace) return false;
+        if (isMutaRushBO != other.isMutaRushBO) return false;
+        if (isMutaRushBOVsProtoss != other.isMutaRushBOVsProtoss) return false;
+        if (isMutaRushBOVsTerran != other.isMutaRushBOVsTerran) return false;
+        if (isMutaRushBOVsZerg != other.isMutaRushBOVsZerg) return false;
+        if (isSpeedlingPushDeferred != other.isSpeedlingPushDeferred) return false;
+        if (isEnemyWorkerRusher != other.isEnemyWorkerRusher) return false;
+        if (isNumSunkensDecidedAfterScoutEnemyRace != other.isNumSunkensDecidedAfterScoutEnemyRace) return false;
+        if (numSunkens != other.numSunkens) return false;
+        if (numSunkensVsProtoss != other.numSunkensVsProtoss) return false;
+        if (numSunkensVsTerran != other.numSunkensVsTerran) return false;
+        if (numSunkensVsZerg != other.numSunkensVsZerg) return false;
+        return true;
+    }
+};
+
+// The learning data is allocated from the match arena (see MatchState), so each of these
+// passes its allocator on to its containers.
+struct GameIDSet
+{
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+    explicit GameIDSet(const allocator_type& alloc = {}) : val(alloc) {}
+
+    // The value is the game ID.
+    std::pmr::set<int> val;
+};
+
+struct TimerAtGameStartMap
+{
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+    explicit TimerAtGameStartMap(const allocator_type& alloc = {}) : val(alloc) {}
+
+    // The key is the timer at the start of the game.
+    std::pmr::map<int, GameIDSet> val;
+};
+
+struct OutcomeMap
+{
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+    explicit OutcomeMap(const allocator_type& alloc = {}) : val(alloc), numOutcomes(alloc) {}
+
+    // The key is whether the value is about wins (i.e. true) or losses (i.e. false).
+    std::pmr::map<bool, TimerAtGameStartMap> val;
+
+    // The key is whether the value is about wins (i.e. true) or losses (i.e. false).
+    std::pmr::map<bool, std::pmr::map<StratSettings, int> > numOutcomes;
+
+    int gameIDIfWonLastGame = -1;
+    int gameIDIfLostLastGame = -1;
+};
+
+struct EnemyStartLocDeducedMap
+{
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+    explicit EnemyStartLocDeducedMap(const allocator_type& alloc = {}) : val(alloc), numOutcomes(alloc) {}
+
+    // The key is the enemy start location if it is known at the start of the
+    // game (e.g. if the CompleteMapInformation flag is enabled) or if it is.
+    // deduced at the start of the game, otherwise it is Unknown.
+    std::pmr::map<const BWAPI::TilePosition, OutcomeMap> val;
+
+    // The key is whether the value is about wins (i.e. true) or losses (i.e. false).
+    std::pmr::map<bool, std::pmr::map<StratSettings, int> > numOutcomes;
+
+    int gameIDIfWonLastGame = -1;
+    int gameIDIfLostLastGame = -1;
+};
+
+struct MyStartLocationMap
+{
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+    explicit MyStartLocationMap(const allocator_type& alloc = {}) : val(alloc), numOutcomes(alloc) {}
+
+    // The key is my start location.
+    std::pmr::map<const BWAPI::TilePosition, EnemyStartLocDeducedMap> val;
+
+    // The key is whether the value is about wins (i.e. true) or losses (i.e. false).
+    std::pmr::map<bool, std::pmr::map<StratSettings, int> > numOutcomes;
+
+    int gameIDIfWonLastGame = -1;
+    int gameIDIfLostLastGame = -1;
+};
+
+struct MapHashMap
+{
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+    explicit MapHashMap(const allocator_type& alloc = {}) : val(alloc), numOutcomes(alloc) {}
+
+    // The key is the mapHash().
+    std::pmr::map<std::string, MyStartLocationMap> val;
+
+    // The key is whether the value is about wins (i.e. true) or losses (i.e. false).
+    std::pmr::map<bool, std::pmr::map<StratSettings, int> > numOutcomes;
+
+    int gameIDIfWonLastGame = -1;
+    int gameIDIfLostLastGame = -1;
+};
+
+struct NumStartLocationsMap
+{
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+    explicit NumStartLocationsMap(const allocator_type& alloc = {}) : val(alloc), numOutcomes(alloc) {}
+
+    // The key is the total number of start locations for the map.
+    std::pmr::map<int, MapHashMap> val;
+
+    // The key is whether the value is about wins (i.e. true) or losses (i.e. false).
+    std::pmr::map<bool, std::pmr::map<StratSettings, int> > numOutcomes;
+
+    int gameIDIfWonLastGame = -1;
+    int gameIDIfLostLastGame = -1;
+};
+
+struct EnemyRaceScoutedMap
+{
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+    explicit EnemyRaceScoutedMap(const allocator_type& alloc = {}) : val(alloc), numOutcomes(alloc) {}
+
+    // The key is enemyRaceInit if the enemy race is known at the start of the game,
+    // otherwise if the enemy race is eventually scouted it is the enemy race scouted,
+    // otherwise it is empty.
+    std::pmr::map<std::string, NumStartLocationsMap> val;
+
+    // The key is whether the value is about wins (i.e. true) or losses (i.e. false).
+    std::pmr::map<bool, std::pmr::map<StratSettings, int> > numOutcomes;
+
+    int gameIDIfWonLastGame = -1;
+    int gameIDIfLostLastGame = -1;
+};
+
+struct EnemyRaceInitMap
+{
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+    explicit EnemyRaceInitMap(const allocator_type& alloc = {}) : val(alloc), numOutcomes(alloc) {}
+
+    // The key is the enemy race at the start of the game (which may be Unknown).
+    std::pmr::map<std::string, EnemyRaceScoutedMap> val;
+
+    // The key is whether the value is about wins (i.e. true) or losses (i.e. false).
+    std::pmr::map<bool, std::pmr::map<StratSettings, int> > numOutcomes;
+
+    int gameIDIfWonLastGame = -1;
+    int gameIDIfLostLastGame = -1;
+};
+
+struct LearningMap
+{
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+    explicit LearningMap(const allocator_type& alloc = {}) : enemyRaceInitMap(alloc), numOutcomes(alloc) {}
+
+    EnemyRaceInitMap enemyRaceInitMap;
+
+    // The key is whether the value is about wins (i.e. true) or losses (i.e. false).
+    std::pmr::map<bool, int> numOutcomes;
+
+    int gameIDIfWonLastGame = -1;
+    int gameIDIfLostLastGame = -1;
+};
+
+// Reading the learning data (the lines that the bot appends to the file for each enemy, one line
+// per game) into a LearningMap, and choosing the strategy settings for a game from it. It only
+// uses BWAPI's value types (not the game), so it is also used by the benchmarks.
+class Learning
+{
+public:
+    // The sentinels and signifiers of the lines in the file for each enemy.
+    static inline const std::string startOfLineSentinel = "||->";
+    static inline const std::string endOfLineSentinel = "<-||";
+    static inline const std::string startOfUpdateSentinel = "|->";
+    static inline const std::string endOfUpdateSentinel = "<-|";
+
+    static inline const std::string delim = "\t";
+
+    static inline const std::string initUpdateSignifier = "init";
+    static inline const std::string raceScoutedUpdateSignifier = "raceScouted";
+    static inline const std::string onPlayerLeftUpdateSignifier = "onPlayerLeft";
+    static inline const std::string onEndUpdateSignifier = "onEnd";
+
+    // What a line has to match to be used for this game.
+    struct ParseContext
+    {
+        std::string dataFileExtension;
+        std::string pathFieldDelimiter;
+        int myVersionMajor = -1;
+        int myVersionMinor = -1;
+        std::string myRaceName;
+        BWAPI::Race enemyRaceInit;
+    };
+
+    // The scenario of this game, most specific last.
+    struct SelectionKey
+    {
+        BWAPI::Race enemyRaceInit;
+        int numStartLocations = 0;
+        std::string mapHash;
+        BWAPI::TilePosition myStartLoc = BWAPI::TilePositions::Unknown;
+        BWAPI::TilePosition enemyStartLocDeduced = BWAPI::TilePositions::Unknown;
+    };
+
+    // Adds the game on the line to the learning data if the line is complete and matches the
+    // context. The game ID is the index of the line in the file. Returns whether it was added.
+    static bool parseLine(
+        std::string line,
+        const int gameID,
+        const ParseContext& context,
+        LearningMap& learningMap,
+        std::pmr::map<int, StratSettings>& gameIDToStratSettings,
+        std::pmr::map<int, int>& gameIDToOnEndFrameCount);
+
+    // Calls parseLine() for each line. Returns the number of games that were added.
+    static int parse(
+        std::istream& is,
+        const ParseContext& context,
+        LearningMap& learningMap,
+        std::pmr::map<int, StratSettings>& gameIDToStratSettings,
+        std::pmr::map<int, int>& gameIDToOnEndFrameCount);
+
+    // For the most specific scenario that matches the key and that we have played a game for,
+    // if we won the last game we played in that scenario, chooses the same strategy settings as
+    // we used then, otherwise if we have won with other strategy settings in that scenario and
+    // the expected win ratio is good enough, chooses one of them at random (weighted by their win
+    // ratios), otherwise tries the next less specific scenario. Returns whether it chose any
+    // (otherwise ss is unchanged).
+    static bool selectStratSettings(
+        LearningMap& learningMap,
+        std::pmr::map<int, StratSettings>& gameIDToStratSettings,
+        const SelectionKey& key,
+        Rng& rng,
+        StratSettings& ss);
+
+    // For when selectStratSettings() didn't choose any: if we have lost at least 5 games against
+    // the enemy and won less than 80% of them, chooses random strategy settings to explore with.
+    // Returns whether it chose any (otherwise ss is unchanged).
+    static bool exploreStratSettings(
+        LearningMap& learningMap,
+        const bool isMapPlasma,
+        const BWAPI::Race enemyRaceInit,
+        Rng& rng,
+        StratSettings& ss);
+};
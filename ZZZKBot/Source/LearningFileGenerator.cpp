@@ -0,0 +1,171 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "LearningFileGenerator.h"
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "InitialCreep.h"
+
+// The strategy settings that the games were played with: 4 pool, speedlings, hydras, or none of
+// those (i.e. mutas), with a varying number of sunkens.
+static const StratSettings stratSettingsVariants[LearningFileGenerator::numStratSettingsVariants] =
+{
+    { true, false, false, false, true, true, true, true, false, false, false, 1, 1, 1, 1 },
+    { false, true, false, false, true, true, true, true, false, false, false, 0, 0, 0, 0 },
+    { false, false, true, false, false, false, false, false, false, false, false, 2, 2, 2, 2 },
+    { false, false, false, false, true, true, true, true, false, true, false, 3, 3, 3, 3 }
+};
+
+// The start locations of the maps (the first 2 on maps with 2 of them).
+static const BWAPI::TilePosition corners[] =
+{
+    BWAPI::TilePosition(7, 7),
+    BWAPI::TilePosition(117, 117),
+    BWAPI::TilePosition(117, 7),
+    BWAPI::TilePosition(7, 117)
+};
+
+static std::string getMapHash(const int mapIndex)
+{
+    const std::vector<std::string>& mapHashes = InitialCreep::getMapHashes();
+    return mapIndex < (int) mapHashes.size() ? mapHashes[mapIndex] : "synthetic" + std::to_string(mapIndex);
+}
+
+static int getNumStartLocations(const int mapIndex)
+{
+    return mapIndex % 2 == 0 ? 2 : 4;
+}
+
+double LearningFileGenerator::getWinRatio(const Config& config, const int stratSettingsIndex)
+{
+    const double offset = config.winRatioSpread * ((double) stratSettingsIndex / (numStratSettingsVariants - 1) - 0.5);
+    return std::max(0.0, std::min(1.0, config.winRatio + offset));
+}
+
+Learning::SelectionKey LearningFileGenerator::makeSelectionKey(const Config& config, const int mapIndex, const int myStartLocIndex)
+{
+    Learning::SelectionKey key;
+    key.enemyRaceInit = config.enemyRace;
+    key.numStartLocations = getNumStartLocations(mapIndex);
+    key.mapHash = getMapHash(mapIndex);
+    key.myStartLoc = corners[myStartLocIndex % key.numStartLocations];
+    key.enemyStartLocDeduced = key.numStartLocations == 2 ? corners[1 - myStartLocIndex % 2] : BWAPI::TilePositions::Unknown;
+    return key;
+}
+
+void LearningFileGenerator::write(std::ostream& os, const Config& config)
+{
+    std::mt19937 rng(config.seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<std::string> fields;
+    for (int gameID = 0; gameID < config.numGames; ++gameID)
+    {
+        const int mapIndex = (int) (rng() % (unsigned int) std::max(config.numMaps, 1));
+        const int numStartLocations = getNumStartLocations(mapIndex);
+        const int myStartLocIndex = (int) (rng() % (unsigned int) numStartLocations);
+        const Learning::SelectionKey key = makeSelectionKey(config, mapIndex, myStartLocIndex);
+        const int stratSettingsIndex = (int) (rng() % numStratSettingsVariants);
+        const StratSettings& ss = stratSettingsVariants[stratSettingsIndex];
+        const bool isWinner = uniform(rng) < getWinRatio(config, stratSettingsIndex);
+
+        // The layout is the one that Learning::parseLine() reads (the fields it doesn't read are
+        // filled with placeholders): the init update with the start locations (ending with the RNG
+        // seed), then the onEnd update (ending with the slow frame counts and the worst stages).
+        const int offset = numStartLocations * 2;
+        fields.assign(106 + offset, "0");
+        fields[0] = Learning::startOfLineSentinel;
+        fields[1] = Learning::endOfLineSentinel;
+        fields[2] = Learning::startOfUpdateSentinel;
+        fields[3] = Learning::endOfUpdateSentinel;
+        fields[4] = Learning::initUpdateSignifier;
+        fields[5] = "dat";
+        fields[6] = "_";
+        fields[7] = "1";
+        fields[8] = "7";
+        fields[12] = "v";
+        fields[13] = ".";
+        fields[14] = "1.7.0.0.0";
+        fields[19] = "ZZZKBot";
+        fields[28] = config.myRace.getName();
+        fields[29] = config.myRace.getName();
+        fields[30] = std::to_string(key.myStartLoc.x);
+        fields[31] = std::to_string(key.myStartLoc.y);
+        fields[32] = "vs";
+        fields[33] = "1";
+        fields[35] = "SyntheticBot";
+        fields[36] = config.enemyRace.getName();
+        fields[37] = config.enemyRace.getName();
+        fields[38] = std::to_string(key.enemyStartLocDeduced.x);
+        fields[39] = std::to_string(key.enemyStartLocDeduced.y);
+        fields[46] = key.mapHash;
+        fields[47] = "128";
+        fields[48] = "128";
+        fields[51] = std::to_string(numStartLocations);
+        for (int i = 0; i < numStartLocations; ++i)
+        {
+            fields[52 + i * 2] = std::to_string(corners[i].x);
+            fields[53 + i * 2] = std::to_string(corners[i].y);
+        }
+        const int stratSettingsInd = 74 + offset;
+        fields[stratSettingsInd] = std::to_string(ss.is4PoolBO);
+        fields[stratSettingsInd + 1] = std::to_string(ss.isSpeedlingBO);
+        fields[stratSettingsInd + 2] = std::to_string(ss.isHydraRushBO);
+        fields[stratSettingsInd + 3] = std::to_string(ss.isMutaRushBODecidedAfterScoutEnemyRace);
+        fields[stratSettingsInd + 4] = std::to_string(ss.isMutaRushBO);
+        fields[stratSettingsInd + 5] = std::to_string(ss.isMutaRushBOVsProtoss);
+        fields[stratSettingsInd + 6] = std::to_string(ss.isMutaRushBOVsTerran);
+        fields[stratSettingsInd + 7] = std::to_string(ss.isMutaRushBOVsZerg);
+        fields[stratSettingsInd + 8] = std::to_string(ss.isSpeedlingPushDeferred);
+        fields[stratSettingsInd + 9] = std::to_string(ss.isEnemyWorkerRusher);
+        fields[stratSettingsInd + 10] = std::to_string(ss.isNumSunkensDecidedAfterScoutEnemyRace);
+        fields[stratSettingsInd + 11] = std::to_string(ss.numSunkens);
+        fields[stratSettingsInd + 12] = std::to_string(ss.numSunkensVsProtoss);
+        fields[stratSettingsInd + 13] = std::to_string(ss.numSunkensVsTerran);
+        fields[stratSettingsInd + 14] = std::to_string(ss.numSunkensVsZerg);
+        fields[89 + offset] = std::to_string(config.seed + gameID);
+        fields[90 + offset] = Learning::endOfUpdateSentinel;
+
+        fields[91 + offset] = Learning::startOfUpdateSentinel;
+        fields[92 + offset] = Learning::onEndUpdateSignifier;
+        fields[93 + offset] = std::to_string(10000 + (int) (rng() % 20000));
+        fields[96 + offset] = "2017-01-01";
+        fields[97 + offset] = "00:00:00";
+        fields[98 + offset] = std::to_string(isWinner);
+        fields[103 + offset] = "mainLoop=20000;intents=8000;pipeline=3000";
+        fields[104 + offset] = Learning::endOfUpdateSentinel;
+        fields[105 + offset] = Learning::endOfLineSentinel;
+
+        for (size_t i = 0; i < fields.size(); ++i)
+        {
+            os << (i > 0 ? Learning::delim : "") << fields[i];
+        }
+        os << std::endl;
+    }
+}
+
+std::string LearningFileGenerator::makeText(const Config& config)
+{
+    std::ostringstream oss;
+    write(oss, config);
+    return oss.str();
+}
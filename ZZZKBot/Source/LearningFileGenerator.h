@@ -0,0 +1,65 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <BWAPI.h>
+#include <ostream>
+#include <string>
+
+#include "Learning.h"
+
+// Makes synthetic learning files, i.e. the file that the bot keeps for an enemy (one line per
+// game, in the same format as the bot writes, see Learning.h), e.g. to measure how the learning
+// scales with the length of the history. The games are spread over a number of maps with 2 or 4
+// start locations, and are played with one of a few strategy settings variants, each of which
+// wins with its own probability. It is deterministic for a given config.
+class LearningFileGenerator
+{
+public:
+    struct Config
+    {
+        int numGames = 1000;
+
+        // How many maps the games are spread over (evenly). The first ones are the maps that
+        // InitialCreep has data for, then made-up ones.
+        int numMaps = 8;
+
+        // The mean win ratio, and how much the win ratios of the strategy settings variants
+        // differ from it (they are spread evenly over winRatio +/- winRatioSpread / 2).
+        double winRatio = 0.6;
+        double winRatioSpread = 0.0;
+
+        BWAPI::Race myRace = BWAPI::Races::Zerg;
+        BWAPI::Race enemyRace = BWAPI::Races::Terran;
+        unsigned int seed = 1;
+    };
+
+    static void write(std::ostream& os, const Config& config);
+    static std::string makeText(const Config& config);
+
+    // The scenario of a game on one of the maps of the file, as the bot looks it up at the start
+    // of the game.
+    static Learning::SelectionKey makeSelectionKey(const Config& config, const int mapIndex, const int myStartLocIndex);
+
+    // The win ratio of one of the strategy settings variants.
+    static double getWinRatio(const Config& config, const int stratSettingsIndex);
+
+    static const int numStratSettingsVariants = 4;
+};
@@ -0,0 +1,180 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "LearningStartBenchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+
+#include "InitialCreep.h"
+#include "Learning.h"
+#include "Rng.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static std::chrono::microseconds getMicroseconds(const Clock::time_point start, const Clock::time_point end)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+}
+
+bool LearningStartBenchmark::run(
+    const LearningFileGenerator::Config& config,
+    const std::vector<int>& historyLengths,
+    const int numSamples,
+    const std::string& folderPath,
+    std::vector<Result>& results,
+    std::string& error)
+{
+    const std::string readFilePath = folderPath + "/ZZZKBot_bench_learning_read.dat";
+    const std::string writeFilePath = folderPath + "/ZZZKBot_bench_learning_write.dat";
+    const std::string tmpFilePath = writeFilePath + ".0.tmp";
+
+    // The same as what the bot reads.
+    Learning::ParseContext context;
+    context.dataFileExtension = "dat";
+    context.pathFieldDelimiter = "_";
+    context.myVersionMajor = 1;
+    context.myVersionMinor = 7;
+    context.myRaceName = config.myRace.getName();
+    context.enemyRaceInit = config.enemyRace;
+
+    // The line for the new game.
+    LearningFileGenerator::Config newGameConfig = config;
+    newGameConfig.numGames = 1;
+    newGameConfig.seed = config.seed + 1;
+    const std::string newGameLine = LearningFileGenerator::makeText(newGameConfig);
+
+    results.clear();
+    for (const int numGames : historyLengths)
+    {
+        LearningFileGenerator::Config historyConfig = config;
+        historyConfig.numGames = numGames;
+
+        // Block to restrict scope of variables.
+        {
+            std::ofstream readFileOFS(readFilePath, std::ios::binary);
+            LearningFileGenerator::write(readFileOFS, historyConfig);
+            readFileOFS.flush();
+            if (!readFileOFS)
+            {
+                error = "can't write " + readFilePath;
+                return false;
+            }
+
+            results.emplace_back();
+            results.back().numGames = numGames;
+            results.back().numFileBytes = (std::int64_t) readFileOFS.tellp();
+        }
+
+        Result& result = results.back();
+        const int numSamplesForLength = std::max(3, (int) ((long long) numSamples * 1000 / std::max(numGames, 1000)));
+        for (int sample = 0; sample < numSamplesForLength; ++sample)
+        {
+            remove(writeFilePath.c_str());
+            const Clock::time_point copyStart = Clock::now();
+
+            // Block to restrict scope of variables.
+            {
+                std::ifstream readFileIFS(readFilePath, std::ios::binary);
+                std::ofstream tmpFileOFS(tmpFilePath, std::ios::binary);
+                tmpFileOFS << readFileIFS.rdbuf();
+            }
+            if (rename(tmpFilePath.c_str(), writeFilePath.c_str()) != 0)
+            {
+                error = "can't write " + writeFilePath;
+                return false;
+            }
+
+            const Clock::time_point parseStart = Clock::now();
+            LearningMap learningMap;
+            std::pmr::map<int, StratSettings> gameIDToStratSettings;
+            std::pmr::map<int, int> gameIDToOnEndFrameCount;
+
+            // Block to restrict scope of variables.
+            {
+                std::ifstream writeFileIFS(writeFilePath);
+                Learning::parse(writeFileIFS, context, learningMap, gameIDToStratSettings, gameIDToOnEndFrameCount);
+            }
+
+            const Clock::time_point selectStart = Clock::now();
+            const Learning::SelectionKey key = LearningFileGenerator::makeSelectionKey(historyConfig, sample % (historyConfig.numMaps + 2), sample);
+            StratSettings ss = {};
+            const Rng rng(config.seed + sample);
+            Rng stratSelectionRng = rng.getSubstream(Rng::StratSelectionStream);
+            Rng stratExplorationRng = rng.getSubstream(Rng::StratExplorationStream);
+            if (Learning::selectStratSettings(learningMap, gameIDToStratSettings, key, stratSelectionRng, ss))
+            {
+                ++result.numSelected;
+            }
+            else if (Learning::exploreStratSettings(learningMap, key.mapHash == InitialCreep::plasmaMapHash, key.enemyRaceInit, stratExplorationRng, ss))
+            {
+                ++result.numExplored;
+            }
+
+            const Clock::time_point appendStart = Clock::now();
+
+            // Block to restrict scope of variables.
+            {
+                std::ofstream writeFileOFS(writeFilePath, std::ios_base::out | std::ios_base::app);
+                writeFileOFS << newGameLine;
+            }
+
+            const Clock::time_point end = Clock::now();
+            result.copyStats.add(getMicroseconds(copyStart, parseStart));
+            result.parseStats.add(getMicroseconds(parseStart, selectStart));
+            result.selectStats.add(getMicroseconds(selectStart, appendStart));
+            result.appendStats.add(getMicroseconds(appendStart, end));
+            result.totalStats.add(getMicroseconds(copyStart, end));
+        }
+    }
+
+    remove(readFilePath.c_str());
+    remove(writeFilePath.c_str());
+    return true;
+}
+
+void LearningStartBenchmark::print(std::ostream& os, const std::vector<Result>& results)
+{
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const Result& result = results[i];
+        const long long total = result.totalStats.getPercentile(0.5).count();
+        os << std::setw(7) << result.numGames << " games, " << std::setw(9) << result.numFileBytes << " bytes, "
+           << result.totalStats.getNumFrames() << " samples (" << result.numSelected << " selected, " << result.numExplored << " explored):"
+           << " copy " << result.copyStats.getPercentile(0.5).count() << " us"
+           << ", parse " << result.parseStats.getPercentile(0.5).count() << " us"
+           << ", select " << result.selectStats.getPercentile(0.5).count() << " us"
+           << ", append " << result.appendStats.getPercentile(0.5).count() << " us"
+           << ", total p50 " << total << " us, max " << result.totalStats.getMax().count() << " us";
+        if (i > 0 && total > 0 && results[i - 1].totalStats.getPercentile(0.5).count() > 0 && result.numGames != results[i - 1].numGames)
+        {
+            const double exponent =
+                std::log((double) total / results[i - 1].totalStats.getPercentile(0.5).count()) /
+                std::log((double) result.numGames / results[i - 1].numGames);
+            os << std::fixed << std::setprecision(2) << ", scaling ~games^" << exponent;
+            os.unsetf(std::ios_base::floatfield);
+        }
+        os << std::endl;
+    }
+}
@@ -0,0 +1,77 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "FrameTimeStats.h"
+#include "LearningFileGenerator.h"
+
+// Times the whole learning path that the bot runs at the start of a game, end to end, on
+// synthetic learning files (see LearningFileGenerator.h) of a range of history lengths, to show
+// how it scales with the number of games against the enemy. Each sample does what onStart() does
+// with the file for the enemy:
+// - copy: copies it from the read folder to the write folder (through a temporary file that
+//   replaces the old one, like the first game of a session),
+// - parse: reads it into the learning data,
+// - select: chooses the strategy settings (falling back to random exploration if none were
+//   chosen),
+// - append: appends the line for the new game.
+// The samples cycle over the maps of the file plus two that aren't in it (so that the less
+// specific scenarios and the exploration are used too).
+class LearningStartBenchmark
+{
+public:
+    struct Result
+    {
+        int numGames = 0;
+        std::int64_t numFileBytes = 0;
+
+        // The duration of each stage and of the whole path, one per sample.
+        FrameTimeStats copyStats;
+        FrameTimeStats parseStats;
+        FrameTimeStats selectStats;
+        FrameTimeStats appendStats;
+        FrameTimeStats totalStats;
+
+        // How many of the samples chose strategy settings from the learning data, and how many
+        // explored.
+        int numSelected = 0;
+        int numExplored = 0;
+    };
+
+    // Runs the samples for each history length (fewer for the longest ones), with the files in
+    // the folder (which are removed afterwards). Returns false with a description in error if a
+    // file can't be written.
+    static bool run(
+        const LearningFileGenerator::Config& config,
+        const std::vector<int>& historyLengths,
+        const int numSamples,
+        const std::string& folderPath,
+        std::vector<Result>& results,
+        std::string& error);
+
+    // Prints the median of each stage per history length, and how the total grows with the
+    // history length (as the exponent k in time ~ games^k from the previous length).
+    static void print(std::ostream& os, const std::vector<Result>& results);
+};
@@ -0,0 +1,399 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "MapSweep.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+#include "AllocationCounter.h"
+#include "FrameTimeStats.h"
+#include "GameRecordReader.h"
+#include "InitialCreep.h"
+#include "MockGame.h"
+#include "ModuleReplay.h"
+
+// The map sizes (in tiles) that a synthetic map is rounded up to.
+static const int standardMapSizes[] = { 64, 96, 128, 192, 256 };
+
+// A map that is being swept: its result so far and the durations of all the frames on it.
+struct MapSweepEntry
+{
+    MapSweep::MapResult result;
+    FrameTimeStats stats;
+};
+
+const std::vector<MapSweep::SlowFrameLimit>& MapSweep::getSlowFrameLimits()
+{
+    static const std::vector<SlowFrameLimit> slowFrameLimits =
+    {
+        { std::chrono::milliseconds(55), 320 },
+        { std::chrono::milliseconds(1000), 10 },
+        { std::chrono::milliseconds(10000), 1 }
+    };
+
+    return slowFrameLimits;
+}
+
+// Replays one game, with readFrame() returning each frame in turn and then nullptr.
+template <class ReadFrame>
+static void replayGame(const GameRecord::MatchInfo& matchInfo, const ReadFrame& readFrame, MapSweepEntry& entry)
+{
+    const std::int64_t numBytesInUseBefore = AllocationCounter::getNumBytesInUse();
+    AllocationCounter::resetPeakNumBytesInUse();
+
+    FrameTimeStats gameStats;
+    {
+        // Block to restrict scope of variables.
+        ModuleReplay moduleReplay;
+        moduleReplay.start(matchInfo);
+        while (const GameRecord::Frame* frame = readFrame())
+        {
+            const std::chrono::microseconds duration = moduleReplay.playFrame(*frame);
+            gameStats.add(duration);
+            entry.stats.add(duration);
+            entry.result.numRecordedCommands += (std::int64_t) frame->commands.size();
+        }
+        entry.result.numReplayCommands += moduleReplay.getResult().numCommands;
+    }
+
+    MapSweep::MapResult& result = entry.result;
+    if (result.mapName.empty())
+    {
+        result.mapName = matchInfo.mapName;
+    }
+    result.numStartLocations = (int) matchInfo.startLocations.size();
+    ++result.numGames;
+    result.numFrames += gameStats.getNumFrames();
+    result.numSlowFrames.resize(MapSweep::getSlowFrameLimits().size(), 0);
+    for (size_t i = 0; i < MapSweep::getSlowFrameLimits().size(); ++i)
+    {
+        result.numSlowFrames[i] = std::max(result.numSlowFrames[i], gameStats.countLongerThan(MapSweep::getSlowFrameLimits()[i].duration));
+    }
+    result.peakNumBytesInUse = std::max(result.peakNumBytesInUse, AllocationCounter::getPeakNumBytesInUse() - numBytesInUseBefore);
+}
+
+static void addFlagReason(MapSweep::MapResult& result, const std::string& reason)
+{
+    result.isFlagged = true;
+    result.flagReason += (result.flagReason.empty() ? "" : "; ") + reason;
+}
+
+bool MapSweep::run(const std::vector<std::string>& recordFilePaths, std::string& error)
+{
+    std::map<std::string, MapSweepEntry> mapHashToEntry;
+    for (const std::string& recordFilePath : recordFilePaths)
+    {
+        GameRecordReader reader;
+        if (!reader.open(recordFilePath))
+        {
+            error = "can't read " + recordFilePath;
+            return false;
+        }
+
+        MapSweepEntry& entry = mapHashToEntry[reader.getMatchInfo().mapHash];
+        entry.result.mapHash = reader.getMatchInfo().mapHash;
+        GameRecord::Frame frame;
+        replayGame(
+            reader.getMatchInfo(),
+            [&reader, &frame]() { return reader.readFrame(frame) ? &frame : nullptr; },
+            entry);
+        if (reader.isCorrupt())
+        {
+            error = recordFilePath + " is corrupt";
+            return false;
+        }
+    }
+
+    for (const std::string& mapHash : InitialCreep::getMapHashes())
+    {
+        if (mapHashToEntry.find(mapHash) != mapHashToEntry.end())
+        {
+            continue;
+        }
+
+        std::vector<std::pair<int, int>> startLocations;
+        InitialCreep::forEachStartLoc(
+            mapHash,
+            [&startLocations](const BWAPI::TilePosition startLoc, const std::vector<int>&)
+            {
+                startLocations.emplace_back(startLoc.x, startLoc.y);
+            });
+
+        MockGame game;
+        if (!game.start(syntheticScenario(mapHash, startLocations, numSyntheticFrames), error))
+        {
+            return false;
+        }
+
+        MapSweepEntry& entry = mapHashToEntry[mapHash];
+        entry.result.mapHash = mapHash;
+        entry.result.isSynthetic = true;
+        replayGame(
+            game.getMatchInfo(),
+            [&game]() { return game.step() ? &game.getFrame() : nullptr; },
+            entry);
+    }
+
+    results.clear();
+    for (std::pair<const std::string, MapSweepEntry>& mapHashAndEntry : mapHashToEntry)
+    {
+        MapResult& result = mapHashAndEntry.second.result;
+        const FrameTimeStats& stats = mapHashAndEntry.second.stats;
+        result.p50 = stats.getPercentile(0.5);
+        result.p99 = stats.getPercentile(0.99);
+        result.max = stats.getMax();
+        if (result.p99 > p99Limit)
+        {
+            addFlagReason(result, "p99 " + std::to_string(result.p99.count()) + " us is over " + std::to_string(p99Limit.count()) + " us");
+        }
+
+        for (size_t i = 0; i < getSlowFrameLimits().size(); ++i)
+        {
+            if (result.numSlowFrames[i] >= getSlowFrameLimits()[i].numFrames)
+            {
+                addFlagReason(result, std::to_string(result.numSlowFrames[i]) + " frames over " + std::to_string(getSlowFrameLimits()[i].duration.count()) + " ms in a game");
+            }
+        }
+
+        results.push_back(result);
+    }
+
+    return true;
+}
+
+void MapSweep::compare(const std::vector<MapResult>& baselineResults)
+{
+    for (MapResult& result : results)
+    {
+        const auto baselineIter =
+            std::find_if(baselineResults.begin(), baselineResults.end(), [&result](const MapResult& baselineResult) { return baselineResult.mapHash == result.mapHash; });
+        if (baselineIter == baselineResults.end())
+        {
+            continue;
+        }
+
+        result.baselineP99 = baselineIter->p99;
+        if (result.isFlagged && !baselineIter->isFlagged)
+        {
+            result.flagReason = "regressed: " + result.flagReason;
+        }
+    }
+}
+
+void MapSweep::print(std::ostream& os) const
+{
+    int numFlagged = 0;
+    for (const MapResult& result : results)
+    {
+        os << result.mapHash.substr(0, 8) << " " << std::left << std::setw(24) << (result.mapName.empty() ? "-" : result.mapName.substr(0, 24)) << std::right
+           << (result.isSynthetic ? " synthetic" : " recorded ") << ", " << result.numStartLocations << " start locations, "
+           << result.numGames << " games, " << result.numFrames << " frames:"
+           << " p50 " << std::setw(6) << result.p50.count() << " us"
+           << ", p99 " << std::setw(6) << result.p99.count() << " us";
+        if (result.baselineP99.count() >= 0)
+        {
+            os << " (was " << result.baselineP99.count() << " us)";
+        }
+        os << ", max " << std::setw(6) << result.max.count() << " us"
+           << ", heap peak " << result.peakNumBytesInUse << " bytes"
+           << ", commands " << result.numRecordedCommands << " recorded / " << result.numReplayCommands << " replayed" << std::endl;
+        if (result.isFlagged)
+        {
+            os << "  FLAGGED: " << result.flagReason << std::endl;
+            ++numFlagged;
+        }
+    }
+
+    os << results.size() << " maps, " << numFlagged << " flagged" << std::endl;
+}
+
+void MapSweep::writeTsv(std::ostream& os, const std::vector<MapResult>& results)
+{
+    os << "map_hash\tmap_name\tsource\tstart_locations\tgames\tframes\tp50_us\tp99_us\tmax_us";
+    for (const SlowFrameLimit& slowFrameLimit : getSlowFrameLimits())
+    {
+        os << "\tover_" << slowFrameLimit.duration.count() << "ms";
+    }
+    os << "\theap_peak_bytes\trecorded_commands\treplay_commands\tflagged\tflag_reason" << std::endl;
+
+    for (const MapResult& result : results)
+    {
+        os << result.mapHash << "\t" << (result.mapName.empty() ? "-" : result.mapName) << "\t" << (result.isSynthetic ? "synthetic" : "recorded")
+           << "\t" << result.numStartLocations << "\t" << result.numGames << "\t" << result.numFrames
+           << "\t" << result.p50.count() << "\t" << result.p99.count() << "\t" << result.max.count();
+        for (size_t i = 0; i < getSlowFrameLimits().size(); ++i)
+        {
+            os << "\t" << (i < result.numSlowFrames.size() ? result.numSlowFrames[i] : 0);
+        }
+        os << "\t" << result.peakNumBytesInUse << "\t" << result.numRecordedCommands << "\t" << result.numReplayCommands
+           << "\t" << result.isFlagged << "\t" << (result.flagReason.empty() ? "-" : result.flagReason) << std::endl;
+    }
+}
+
+bool MapSweep::readTsv(std::istream& is, std::vector<MapResult>& results)
+{
+    std::string line;
+    if (!std::getline(is, line))
+    {
+        return false;
+    }
+
+    while (std::getline(is, line))
+    {
+        if (line.empty())
+        {
+            continue;
+        }
+
+        std::vector<std::string> fields;
+        std::istringstream lineIss(line);
+        std::string field;
+        while (std::getline(lineIss, field, '\t'))
+        {
+            fields.push_back(field);
+        }
+
+        const size_t numSlowFrameLimits = getSlowFrameLimits().size();
+        if (fields.size() != 14 + numSlowFrameLimits)
+        {
+            return false;
+        }
+
+        MapResult result;
+        size_t i = 0;
+        result.mapHash = fields[i++];
+        result.mapName = fields[i] == "-" ? "" : fields[i];
+        ++i;
+        result.isSynthetic = fields[i++] == "synthetic";
+        result.numStartLocations = std::atoi(fields[i++].c_str());
+        result.numGames = std::atoi(fields[i++].c_str());
+        result.numFrames = std::atoi(fields[i++].c_str());
+        result.p50 = std::chrono::microseconds(std::atoll(fields[i++].c_str()));
+        result.p99 = std::chrono::microseconds(std::atoll(fields[i++].c_str()));
+        result.max = std::chrono::microseconds(std::atoll(fields[i++].c_str()));
+        for (size_t j = 0; j < numSlowFrameLimits; ++j)
+        {
+            result.numSlowFrames.push_back(std::atoi(fields[i++].c_str()));
+        }
+        result.peakNumBytesInUse = std::atoll(fields[i++].c_str());
+        result.numRecordedCommands = std::atoll(fields[i++].c_str());
+        result.numReplayCommands = std::atoll(fields[i++].c_str());
+        result.isFlagged = fields[i++] == "1";
+        result.flagReason = fields[i] == "-" ? "" : fields[i];
+        results.push_back(result);
+    }
+
+    return true;
+}
+
+Scenario MapSweep::syntheticScenario(const std::string& mapHash, const std::vector<std::pair<int, int>>& startLocations, const int numFrames)
+{
+    Scenario scenario;
+    scenario.name = "synthetic_" + mapHash.substr(0, 8);
+    scenario.mapHash = mapHash;
+    scenario.startLocations = startLocations;
+    scenario.numFrames = numFrames;
+
+    // The smallest standard size with room for a base (4 tiles wide and 3 high) and its mineral
+    // line (up to about 8 tiles away) beyond the furthest start location.
+    int maxX = 0;
+    int maxY = 0;
+    for (const std::pair<int, int>& startLocation : startLocations)
+    {
+        maxX = std::max(maxX, startLocation.first + 4 + 8);
+        maxY = std::max(maxY, startLocation.second + 3 + 8);
+    }
+    scenario.mapWidth = *std::find_if(std::begin(standardMapSizes), std::end(standardMapSizes) - 1, [maxX](const int size) { return size >= maxX; });
+    scenario.mapHeight = *std::find_if(std::begin(standardMapSizes), std::end(standardMapSizes) - 1, [maxY](const int size) { return size >= maxY; });
+
+    // My economy (player 0) holds, and my army (player 1) and the enemy's (player 2) attack.
+    const int economyPlayerID = 0;
+    const int armyPlayerID = 1;
+    const int enemyPlayerID = 2;
+    const int neutralPlayerID = 3;
+    scenario.players.resize(4);
+    scenario.players[economyPlayerID].id = economyPlayerID;
+    scenario.players[economyPlayerID].isSelf = true;
+    scenario.players[armyPlayerID].id = armyPlayerID;
+    scenario.players[armyPlayerID].isSelf = true;
+    scenario.players[armyPlayerID].order = Scenario::Order::Attack;
+    scenario.players[enemyPlayerID].id = enemyPlayerID;
+    scenario.players[enemyPlayerID].isEnemy = true;
+    scenario.players[enemyPlayerID].order = Scenario::Order::Attack;
+    scenario.players[neutralPlayerID].id = neutralPlayerID;
+    scenario.players[neutralPlayerID].isNeutral = true;
+
+    const auto addUnits =
+        [&scenario](const int count, const char* typeName, const int playerID, const int x, const int y, const int radius)
+        {
+            Scenario::UnitGroup unitGroup;
+            unitGroup.count = count;
+            unitGroup.typeName = typeName;
+            unitGroup.playerID = playerID;
+            unitGroup.x = x;
+            unitGroup.y = y;
+            unitGroup.radius = radius;
+            scenario.unitGroups.push_back(unitGroup);
+        };
+
+    // The centre of a resource depot at a start location.
+    const auto getDepotX = [](const std::pair<int, int>& startLocation) { return startLocation.first * 32 + 64; };
+    const auto getDepotY = [](const std::pair<int, int>& startLocation) { return startLocation.second * 32 + 48; };
+    const int centreX = scenario.mapWidth * 16;
+    const int centreY = scenario.mapHeight * 16;
+    if (startLocations.empty())
+    {
+        addUnits(24, "Zerg_Zergling", enemyPlayerID, centreX, centreY, 160);
+        addUnits(12, "Zerg_Hydralisk", enemyPlayerID, centreX, centreY, 160);
+        return scenario;
+    }
+
+    // The mineral line is on the side of the base away from the centre of the map.
+    const int depotX = getDepotX(startLocations.front());
+    const int depotY = getDepotY(startLocations.front());
+    const double length = std::hypot(depotX - centreX, depotY - centreY);
+    const double dirX = length > 0 ? (depotX - centreX) / length : -1.0;
+    const double dirY = length > 0 ? (depotY - centreY) / length : 0.0;
+    addUnits(1, "Zerg_Hatchery", economyPlayerID, depotX, depotY, 0);
+    addUnits(12, "Zerg_Drone", economyPlayerID, depotX + (int) (dirX * 96), depotY + (int) (dirY * 96), 48);
+    addUnits(8, "Resource_Mineral_Field", neutralPlayerID, depotX + (int) (dirX * 224), depotY + (int) (dirY * 224), 64);
+    addUnits(24, "Zerg_Zergling", armyPlayerID, depotX - (int) (dirX * 160), depotY - (int) (dirY * 160), 96);
+    addUnits(12, "Zerg_Hydralisk", armyPlayerID, depotX - (int) (dirX * 160), depotY - (int) (dirY * 160), 96);
+
+    const int enemyX = startLocations.size() > 1 ? getDepotX(startLocations.back()) : centreX;
+    const int enemyY = startLocations.size() > 1 ? getDepotY(startLocations.back()) : centreY;
+    if (startLocations.size() > 1)
+    {
+        addUnits(1, "Zerg_Hatchery", enemyPlayerID, enemyX, enemyY, 0);
+    }
+    addUnits(24, "Zerg_Zergling", enemyPlayerID, enemyX, enemyY, 160);
+    addUnits(12, "Zerg_Hydralisk", enemyPlayerID, enemyX, enemyY, 160);
+
+    for (size_t i = 1; i < startLocations.size(); ++i)
+    {
+        addUnits(1, "Zerg_Overlord", armyPlayerID, getDepotX(startLocations[i]), getDepotY(startLocations[i]), 0);
+    }
+
+    return scenario;
+}
@@ -0,0 +1,114 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "GameRecord.h"
+#include "Scenario.h"
+
+// Plays frame streams through the bot itself (see ModuleReplay.h) map by map and reports the
+// onFrame time distribution (the events and onFrame() of each frame), the heap peak and the command counts of each map, so that a change
+// that slows the bot down on some maps (e.g. the big ones, or the ones with many start
+// locations) shows up before it is merged. The streams of a map are the game records given for
+// it, or, for each map that InitialCreep has data for but no record was given for, a synthetic
+// game on MockGame (see syntheticScenario()). A map is flagged if its p99 is over the limit or
+// a game on it had as many slow frames as would lose a competition game (see the limits below).
+class MapSweep
+{
+public:
+    // The slow frame limits of the competitions (e.g. AIIDE and SSCAIT): a bot loses a game if it
+    // has this many frames that take longer than the duration.
+    struct SlowFrameLimit
+    {
+        std::chrono::milliseconds duration;
+        int numFrames;
+    };
+
+    static const std::vector<SlowFrameLimit>& getSlowFrameLimits();
+
+    struct MapResult
+    {
+        std::string mapHash;
+        std::string mapName;
+        bool isSynthetic = false;
+        int numStartLocations = 0;
+        int numGames = 0;
+        int numFrames = 0;
+        std::chrono::microseconds p50{0};
+        std::chrono::microseconds p99{0};
+        std::chrono::microseconds max{0};
+
+        // The most frames that took longer than each of the slow frame limits' durations in any
+        // one game on the map.
+        std::vector<int> numSlowFrames;
+
+        // The most heap in use during a game on the map, over what was in use before it.
+        std::int64_t peakNumBytesInUse = 0;
+
+        // The commands that the bot issued in the recorded games, and the ones that it issued when
+        // they were played through it again.
+        std::int64_t numRecordedCommands = 0;
+        std::int64_t numReplayCommands = 0;
+
+        bool isFlagged = false;
+        std::string flagReason;
+
+        // The p99 of the baseline (see compare()), or -1 if there is none.
+        std::chrono::microseconds baselineP99{-1};
+    };
+
+    // Frames that take longer than this flag the map (when they are more than 1%).
+    std::chrono::microseconds p99Limit{55000};
+
+    // How many frames the synthetic games run for.
+    int numSyntheticFrames = 2000;
+
+    // Replays the records (adding a synthetic game for each other map that InitialCreep has data
+    // for). Returns false with a description in error if a record can't be read.
+    bool run(const std::vector<std::string>& recordFilePaths, std::string& error);
+
+    const std::vector<MapResult>& getResults() const { return results; }
+
+    // Compares with the results of an earlier sweep (by map hash), flagging the maps that weren't
+    // flagged before.
+    void compare(const std::vector<MapResult>& baselineResults);
+
+    void print(std::ostream& os) const;
+
+    // The results as tab-separated values, one line per map after a header line, e.g. to be
+    // compared against later.
+    static void writeTsv(std::ostream& os, const std::vector<MapResult>& results);
+    static bool readTsv(std::istream& is, std::vector<MapResult>& results);
+
+    // A synthetic game on the map: my base (a hatchery, drones and mineral patches) at the first
+    // start location, an enemy Zerg base at the last one, an army of each that attack each other,
+    // and an overlord of mine at each of the other start locations (for the creep checks). The map
+    // size is estimated from the start locations, because InitialCreep doesn't have it.
+    static Scenario syntheticScenario(const std::string& mapHash, const std::vector<std::pair<int, int>>& startLocations, const int numFrames);
+
+private:
+    std::vector<MapResult> results;
+};
@@ -0,0 +1,382 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "MockGame.h"
+#include <algorithm>
+#include <cmath>
+
+// BWAPI IDs.
+static const int orderGuardID = 2;
+static const int orderMoveID = 6;
+static const int orderAttackUnitID = 10;
+static const int orderHoldPositionID = 107;
+static const int eventMatchEndID = 1;
+static const int eventUnitDiscoverID = 8;
+static const int eventUnitDestroyID = 13;
+
+static const MockGame::UnitTypeInfo unitTypeInfos[] =
+{
+    // name, id, hit points, shields, armor, top speed, ground range, air range, ground damage, air damage, cooldown, is flying, is worker
+    { "Terran_Marine", 0, 40, 0, 0, 4.0, 128, 128, 6, 6, 15, false, false },
+    { "Terran_SCV", 7, 60, 0, 0, 4.92, 10, 0, 5, 0, 15, false, true },
+    { "Terran_Command_Center", 106, 1500, 0, 1, 0.0, 0, 0, 0, 0, 0, false, false },
+    { "Terran_Missile_Turret", 124, 200, 0, 0, 0.0, 0, 224, 0, 20, 15, false, false },
+    { "Zerg_Zergling", 37, 35, 0, 0, 5.49, 15, 0, 5, 0, 8, false, false },
+    { "Zerg_Hydralisk", 38, 80, 0, 0, 3.66, 128, 128, 10, 10, 15, false, false },
+    { "Zerg_Drone", 41, 40, 0, 0, 4.92, 32, 0, 5, 0, 22, false, true },
+    { "Zerg_Overlord", 42, 200, 0, 0, 0.83, 0, 0, 0, 0, 0, true, false },
+    { "Zerg_Mutalisk", 43, 120, 0, 0, 6.67, 96, 96, 9, 9, 30, true, false },
+    { "Zerg_Hatchery", 131, 1250, 0, 1, 0.0, 0, 0, 0, 0, 0, false, false },
+    { "Zerg_Sunken_Colony", 146, 300, 0, 2, 0.0, 224, 0, 40, 0, 32, false, false },
+    { "Zerg_Spore_Colony", 144, 400, 0, 0, 0.0, 0, 224, 0, 15, 15, false, false },
+    { "Protoss_Probe", 64, 20, 20, 0, 4.92, 32, 0, 5, 0, 22, false, true },
+    { "Protoss_Zealot", 65, 100, 60, 1, 4.0, 15, 0, 16, 0, 22, false, false },
+    { "Protoss_Dragoon", 66, 100, 80, 1, 5.0, 128, 128, 20, 20, 30, false, false },
+    { "Protoss_Nexus", 154, 750, 750, 1, 0.0, 0, 0, 0, 0, 0, false, false },
+    { "Protoss_Photon_Cannon", 162, 100, 100, 0, 0.0, 224, 224, 20, 20, 22, false, false },
+    { "Resource_Mineral_Field", 176, 100000, 0, 0, 0.0, 0, 0, 0, 0, 0, false, false }
+};
+
+// The distance between the centres of two units at which they touch (roughly, because the real
+// unit dimensions aren't modelled).
+static const double contactDistance = 16.0;
+
+const MockGame::UnitTypeInfo* MockGame::findUnitType(const std::string& name)
+{
+    for (const UnitTypeInfo& unitTypeInfo : unitTypeInfos)
+    {
+        if (name == unitTypeInfo.name)
+        {
+            return &unitTypeInfo;
+        }
+    }
+
+    return nullptr;
+}
+
+bool MockGame::start(const Scenario& newScenario, std::string& error)
+{
+    scenario = newScenario;
+    units.clear();
+    frame = GameRecord::Frame();
+    frame.frameCount = -1;
+
+    matchInfo = GameRecord::MatchInfo();
+    matchInfo.mapName = scenario.name;
+    matchInfo.mapFileName = scenario.name + ".scx";
+    matchInfo.mapWidth = scenario.mapWidth;
+    matchInfo.mapHeight = scenario.mapHeight;
+    matchInfo.mapHash = scenario.mapHash;
+    matchInfo.startLocations = scenario.startLocations;
+    matchInfo.latencyFrames = 2;
+    for (const Scenario::Player& scenarioPlayer : scenario.players)
+    {
+        GameRecord::PlayerInfo player;
+        player.id = scenarioPlayer.id;
+        player.name = "Player " + std::to_string(scenarioPlayer.id);
+        player.isSelf = scenarioPlayer.isSelf;
+        player.isEnemy = scenarioPlayer.isEnemy;
+        player.isNeutral = scenarioPlayer.isNeutral;
+        matchInfo.players.push_back(player);
+        if (player.isSelf)
+        {
+            matchInfo.selfID = player.id;
+        }
+    }
+
+    for (const Scenario::UnitGroup& unitGroup : scenario.unitGroups)
+    {
+        const UnitTypeInfo* type = findUnitType(unitGroup.typeName);
+        if (type == nullptr)
+        {
+            error = "unsupported unit type " + unitGroup.typeName;
+            return false;
+        }
+
+        // Spread the units evenly over the disc (a sunflower spiral) rather than randomly, so that
+        // the scenario is the same every time.
+        for (int i = 0; i < unitGroup.count; ++i)
+        {
+            const double r = unitGroup.radius * std::sqrt((i + 0.5) / unitGroup.count);
+            const double theta = i * 2.39996322972865332;
+            MockUnit unit;
+            unit.type = type;
+            unit.playerID = unitGroup.playerID;
+            unit.x = std::max(0.0, std::min(scenario.mapWidth * 32.0 - 1, unitGroup.x + r * std::cos(theta)));
+            unit.y = std::max(0.0, std::min(scenario.mapHeight * 32.0 - 1, unitGroup.y + r * std::sin(theta)));
+            unit.hitPoints = type->hitPoints;
+            unit.shields = type->shields;
+            unit.isAlive = true;
+            units.push_back(unit);
+        }
+    }
+
+    damage.assign(units.size(), 0);
+    return true;
+}
+
+bool MockGame::step()
+{
+    if (frame.frameCount + 1 >= scenario.numFrames)
+    {
+        return false;
+    }
+
+    ++frame.frameCount;
+    frame.events.clear();
+    if (frame.frameCount == 0)
+    {
+        for (int i = 0; i < (int) units.size(); ++i)
+        {
+            GameRecord::EventInfo e;
+            e.typeID = eventUnitDiscoverID;
+            e.unitID = i;
+            e.playerID = units[i].playerID;
+            frame.events.push_back(e);
+        }
+
+        updateFrame();
+        return true;
+    }
+
+    // Everyone picks a target and moves or attacks based on the state at the start of the frame,
+    // then the damage is applied, so the order of the units doesn't matter.
+    std::fill(damage.begin(), damage.end(), 0);
+    for (int i = 0; i < (int) units.size(); ++i)
+    {
+        MockUnit& unit = units[i];
+        if (!unit.isAlive)
+        {
+            continue;
+        }
+
+        unit.isUnderAttack = false;
+        unit.isAttacking = false;
+        unit.isMoving = false;
+        unit.cooldown = std::max(0, unit.cooldown - 1);
+        const Scenario::Player* player = scenario.findPlayer(unit.playerID);
+        if (player->order == Scenario::Order::Move)
+        {
+            unit.targetIndex = -1;
+            moveTowards(unit, player->orderX, player->orderY, 0.0);
+            continue;
+        }
+
+        // Keep the target while it's alive and (when holding) in range.
+        if (unit.targetIndex < 0 || !units[unit.targetIndex].isAlive ||
+            (player->order == Scenario::Order::Hold && !isInRange(unit, units[unit.targetIndex])))
+        {
+            unit.targetIndex = findNearestTarget(i, player->order == Scenario::Order::Hold);
+        }
+
+        if (unit.targetIndex < 0)
+        {
+            continue;
+        }
+
+        const MockUnit& target = units[unit.targetIndex];
+        if (isInRange(unit, target))
+        {
+            unit.isAttacking = true;
+            if (unit.cooldown == 0)
+            {
+                const int weaponDamage = target.type->isFlying ? unit.type->airDamage : unit.type->groundDamage;
+                damage[unit.targetIndex] += weaponDamage;
+                unit.cooldown = unit.type->cooldown;
+            }
+        }
+        else
+        {
+            const int range = target.type->isFlying ? unit.type->airRange : unit.type->groundRange;
+            moveTowards(unit, target.x, target.y, range + contactDistance);
+        }
+    }
+
+    for (int i = 0; i < (int) units.size(); ++i)
+    {
+        MockUnit& unit = units[i];
+        if (!unit.isAlive || damage[i] == 0)
+        {
+            continue;
+        }
+
+        unit.isUnderAttack = true;
+        int remainingDamage = damage[i];
+        const int shieldDamage = std::min(unit.shields, remainingDamage);
+        unit.shields -= shieldDamage;
+        remainingDamage -= shieldDamage;
+        if (remainingDamage > 0)
+        {
+            unit.hitPoints -= std::max(1, remainingDamage - unit.type->armor);
+        }
+
+        if (unit.hitPoints <= 0)
+        {
+            unit.isAlive = false;
+            GameRecord::EventInfo e;
+            e.typeID = eventUnitDestroyID;
+            e.unitID = i;
+            e.playerID = unit.playerID;
+            e.x = (int) unit.x;
+            e.y = (int) unit.y;
+            frame.events.push_back(e);
+        }
+    }
+
+    if (frame.frameCount + 1 == scenario.numFrames)
+    {
+        GameRecord::EventInfo e;
+        e.typeID = eventMatchEndID;
+        e.isWinner = getNumUnits(matchInfo.selfID) > 0;
+        frame.events.push_back(e);
+    }
+
+    updateFrame();
+    return true;
+}
+
+int MockGame::getNumUnits(const int playerID) const
+{
+    return (int) std::count_if(units.begin(), units.end(), [playerID](const MockUnit& unit)
+    {
+        return unit.isAlive && unit.playerID == playerID;
+    });
+}
+
+bool MockGame::canHit(const MockUnit& attacker, const MockUnit& target) const
+{
+    const Scenario::Player* attackerPlayer = scenario.findPlayer(attacker.playerID);
+    const Scenario::Player* targetPlayer = scenario.findPlayer(target.playerID);
+    return
+        target.isAlive &&
+        !attackerPlayer->isNeutral &&
+        !targetPlayer->isNeutral &&
+        attackerPlayer->isSelf != targetPlayer->isSelf &&
+        (target.type->isFlying ? attacker.type->airDamage : attacker.type->groundDamage) > 0;
+}
+
+bool MockGame::isInRange(const MockUnit& attacker, const MockUnit& target) const
+{
+    const int range = target.type->isFlying ? attacker.type->airRange : attacker.type->groundRange;
+    const double dx = target.x - attacker.x;
+    const double dy = target.y - attacker.y;
+    const double maxDistance = range + contactDistance;
+    return dx * dx + dy * dy <= maxDistance * maxDistance;
+}
+
+int MockGame::findNearestTarget(const int attackerIndex, const bool mustBeInRange) const
+{
+    const MockUnit& attacker = units[attackerIndex];
+    int bestIndex = -1;
+    double bestDistanceSquared = 0;
+    for (int i = 0; i < (int) units.size(); ++i)
+    {
+        const MockUnit& target = units[i];
+        if (!canHit(attacker, target) || (mustBeInRange && !isInRange(attacker, target)))
+        {
+            continue;
+        }
+
+        const double dx = target.x - attacker.x;
+        const double dy = target.y - attacker.y;
+        const double distanceSquared = dx * dx + dy * dy;
+        if (bestIndex < 0 || distanceSquared < bestDistanceSquared)
+        {
+            bestIndex = i;
+            bestDistanceSquared = distanceSquared;
+        }
+    }
+
+    return bestIndex;
+}
+
+void MockGame::moveTowards(MockUnit& unit, const double x, const double y, const double stopDistance)
+{
+    const double dx = x - unit.x;
+    const double dy = y - unit.y;
+    const double distance = std::sqrt(dx * dx + dy * dy);
+    if (unit.type->topSpeed <= 0 || distance <= stopDistance)
+    {
+        return;
+    }
+
+    const double moveDistance = std::min(unit.type->topSpeed, distance - stopDistance);
+    unit.x += dx / distance * moveDistance;
+    unit.y += dy / distance * moveDistance;
+    unit.isMoving = true;
+}
+
+void MockGame::updateFrame()
+{
+    frame.minerals = 50;
+    frame.supplyUsed = getNumUnits(matchInfo.selfID) * 2;
+    frame.supplyTotal = 400;
+    frame.remainingLatencyFrames = matchInfo.latencyFrames;
+    frame.commands.clear();
+
+    // The IDs are the indexes, so the units are already in order of ID.
+    frame.units.clear();
+    for (int i = 0; i < (int) units.size(); ++i)
+    {
+        const MockUnit& unit = units[i];
+        if (!unit.isAlive)
+        {
+            continue;
+        }
+
+        const Scenario::Player* player = scenario.findPlayer(unit.playerID);
+        const int targetIndex = unit.targetIndex >= 0 && units[unit.targetIndex].isAlive ? unit.targetIndex : -1;
+        GameRecord::UnitState state;
+        state.id = i;
+        state.typeID = unit.type->id;
+        state.playerID = unit.playerID;
+        state.x = (int) unit.x;
+        state.y = (int) unit.y;
+        state.hitPoints = unit.hitPoints;
+        state.shields = unit.shields;
+        state.orderID =
+            player->order == Scenario::Order::Move ? orderMoveID :
+            targetIndex >= 0 ? orderAttackUnitID :
+            player->order == Scenario::Order::Hold ? orderHoldPositionID :
+            orderGuardID;
+        state.targetID = targetIndex;
+        state.orderTargetID = targetIndex;
+        if (targetIndex >= 0 && units[targetIndex].type->isFlying)
+        {
+            state.airWeaponCooldown = unit.cooldown;
+        }
+        else
+        {
+            state.groundWeaponCooldown = unit.cooldown;
+        }
+
+        state.flags =
+            GameRecord::completedFlag |
+            GameRecord::visibleFlag |
+            GameRecord::detectedFlag |
+            (unit.type->isFlying ? (unsigned int) GameRecord::flyingFlag : 0u) |
+            (unit.isMoving ? (unsigned int) GameRecord::movingFlag : 0u) |
+            (!unit.isMoving && !unit.isAttacking ? (unsigned int) GameRecord::idleFlag : 0u) |
+            (unit.isAttacking ? (unsigned int) GameRecord::attackingFlag : 0u) |
+            (unit.isUnderAttack ? (unsigned int) GameRecord::underAttackFlag : 0u);
+        frame.units.push_back(state);
+    }
+}
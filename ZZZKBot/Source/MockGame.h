@@ -0,0 +1,115 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+#include <string>
+#include <vector>
+
+#include "GameRecord.h"
+#include "Scenario.h"
+
+// A lightweight stand-in for the game that plays out a Scenario: units move, pick the nearest
+// enemy that they can hit, attack with their weapon cooldowns, take damage (shields first) and
+// die. It only models what's needed to put realistic loads (unit counts, positions, orders,
+// targets, cooldowns and flags) on the code that consumes frames, not the game's exact rules.
+// Each frame is produced in the same form as a game record frame (see GameRecord.h), so it can
+// be written by GameRecordWriter and fed to anything that reads records. It doesn't depend on
+// BWAPI (unit types, orders and events are identified by their BWAPI IDs) and it is
+// deterministic.
+class MockGame
+{
+public:
+    // The properties of the unit types that scenarios can use (the game's values, except that
+    // upgrades are ignored).
+    struct UnitTypeInfo
+    {
+        const char* name;
+        int id;
+        int hitPoints;
+        int shields;
+        int armor;
+
+        // In pixels per frame (0 for buildings).
+        double topSpeed;
+
+        // In pixels, and 0 if the type can't attack ground/air units.
+        int groundRange;
+        int airRange;
+        int groundDamage;
+        int airDamage;
+        int cooldown;
+
+        bool isFlying;
+        bool isWorker;
+    };
+
+    // Returns the type with the BWAPI name, or nullptr if scenarios can't use it.
+    static const UnitTypeInfo* findUnitType(const std::string& name);
+
+    // Sets up the scenario. Returns false with a description of the problem in error if it uses a
+    // unit type that isn't supported.
+    bool start(const Scenario& scenario, std::string& error);
+
+    // Advances to the next frame. Returns false once all the frames of the scenario have been
+    // played.
+    bool step();
+
+    const GameRecord::MatchInfo& getMatchInfo() const { return matchInfo; }
+    const GameRecord::Frame& getFrame() const { return frame; }
+
+    // The number of units of the player that are alive.
+    int getNumUnits(const int playerID) const;
+
+    // Returns the ID of the nearest unit that the unit can hit (only those it can hit from where
+    // it is if mustBeInRange), or -1 if there aren't any. This is what a unit that needs a new
+    // target uses each frame.
+    int findNearestTarget(const int attackerIndex, const bool mustBeInRange) const;
+
+private:
+    struct MockUnit
+    {
+        const UnitTypeInfo* type = nullptr;
+        int playerID = -1;
+        double x = 0;
+        double y = 0;
+        int hitPoints = 0;
+        int shields = 0;
+        int cooldown = 0;
+        int targetIndex = -1;
+        bool isMoving = false;
+        bool isAttacking = false;
+        bool isUnderAttack = false;
+        bool isAlive = false;
+    };
+
+    bool canHit(const MockUnit& attacker, const MockUnit& target) const;
+    bool isInRange(const MockUnit& attacker, const MockUnit& target) const;
+    void moveTowards(MockUnit& unit, const double x, const double y, const double stopDistance);
+    void updateFrame();
+
+    Scenario scenario;
+    GameRecord::MatchInfo matchInfo;
+    GameRecord::Frame frame;
+
+    // By unit ID.
+    std::vector<MockUnit> units;
+    std::vector<int> damage;
+};
@@ -0,0 +1,106 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "ModuleReplay.h"
+
+#include <chrono>
+
+#include "AllocationCounter.h"
+#include "GameRecordReader.h"
+#include "MockGame.h"
+
+void ModuleReplay::start(const GameRecord::MatchInfo& matchInfo)
+{
+    bot.reset(new ZZZKBotAIModule());
+    bot->isCombatIntentCheckEnabled = isCombatIntentCheckEnabled;
+    bot->isCreepInferenceCheckEnabled = isCreepInferenceCheckEnabled;
+    bot->Broodwar->startMatch(matchInfo);
+    isOnStartCalled = false;
+    result = Result();
+}
+
+std::chrono::microseconds ModuleReplay::playFrame(const GameRecord::Frame& frame)
+{
+    bot->Broodwar->setFrame(frame);
+
+    // Like main.cpp, onStart() is called after the first update, and isn't part of a frame.
+    if (!isOnStartCalled)
+    {
+        bot->onStart();
+        isOnStartCalled = true;
+    }
+
+    const std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+    const std::uint64_t numAllocationsBefore = AllocationCounter::getNumAllocations();
+    bot->frameWatchdog.onFrameStart();
+    for (const BWAPI::Event& e : bot->Broodwar->getEvents())
+    {
+        if (e.getType() != BWAPI::EventType::MatchEnd)
+        {
+            bot->onEvent(e);
+        }
+    }
+
+    bot->onFrame();
+    bot->frameWatchdog.onFrameEnd(bot->Broodwar->getFrameCount(), false);
+    const std::uint64_t numAllocations = AllocationCounter::getNumAllocations() - numAllocationsBefore;
+    const std::chrono::microseconds duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - frameStart);
+    result.frameTimes.add(duration);
+    result.numAllocationsByFrame.push_back(numAllocations);
+    ++result.numFrames;
+    result.numCommands += (std::int64_t) bot->Broodwar->getIssuedCommands().size();
+    return duration;
+}
+
+bool ModuleReplay::playRecord(const std::string& recordFilePath, std::string& error)
+{
+    GameRecordReader reader;
+    if (!reader.open(recordFilePath))
+    {
+        error = "Can't read " + recordFilePath;
+        return false;
+    }
+
+    start(reader.getMatchInfo());
+    GameRecord::Frame frame;
+    while (reader.readFrame(frame))
+    {
+        playFrame(frame);
+    }
+
+    return true;
+}
+
+bool ModuleReplay::playScenario(const Scenario& scenario, std::string& error)
+{
+    MockGame game;
+    if (!game.start(scenario, error))
+    {
+        return false;
+    }
+
+    start(game.getMatchInfo());
+    while (game.step())
+    {
+        playFrame(game.getFrame());
+    }
+
+    return true;
+}
@@ -0,0 +1,89 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <BWAPI.h>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "FrameTimeStats.h"
+#include "GameRecord.h"
+#include "Scenario.h"
+#include "ZZZKBotAIModule.h"
+
+// Plays matches through the real bot (ZZZKBotAIModule) in the bench, which builds it against a
+// stand-in for BWAPI's game (see BenchBWAPI/include/BWAPI.h): each frame of a game record or of a
+// MockGame scenario is made the stand-in's game state, then the bot is called the way main.cpp
+// calls it in a live game, i.e. onStart() after the first frame, then every frame the events and
+// onFrame(), between the frame watchdog's onFrameStart() and onFrameEnd(). The match end event
+// isn't delivered, so the bot doesn't write to its learning files.
+class ModuleReplay
+{
+public:
+    struct Result
+    {
+        int numFrames = 0;
+
+        // How long the events and onFrame() of each frame took.
+        FrameTimeStats frameTimes;
+
+        // The commands that the bot issued.
+        std::int64_t numCommands = 0;
+
+        // The heap allocations (see AllocationCounter) that the events and onFrame() of each frame
+        // made, by frame, e.g. to check that the bot doesn't allocate once it has warmed up.
+        std::vector<std::uint64_t> numAllocationsByFrame;
+    };
+
+    // Starts a match with a new bot (dropping the one of the last match).
+    void start(const GameRecord::MatchInfo& matchInfo);
+
+    // Whether the bots of the next matches also evaluate their combat intents with the BWAPI unit
+    // queries every frame (see ZZZKBotAIModule::isCombatIntentCheckEnabled).
+    void setCombatIntentCheckEnabled(const bool isEnabled) { isCombatIntentCheckEnabled = isEnabled; }
+
+    // Likewise for the creep inference (see ZZZKBotAIModule::isCreepInferenceCheckEnabled).
+    void setCreepInferenceCheckEnabled(const bool isEnabled) { isCreepInferenceCheckEnabled = isEnabled; }
+
+    // Makes the frame the game state and plays it through the bot. Returns how long the events
+    // and onFrame() took.
+    std::chrono::microseconds playFrame(const GameRecord::Frame& frame);
+
+    // Starts a match and plays all the frames of the record. Returns false with a description in
+    // error if it can't be read.
+    bool playRecord(const std::string& recordFilePath, std::string& error);
+
+    // Starts a match and plays all the frames of the scenario on MockGame. Returns false with a
+    // description in error if the scenario isn't supported.
+    bool playScenario(const Scenario& scenario, std::string& error);
+
+    ZZZKBotAIModule& getBot() { return *bot; }
+    const Result& getResult() const { return result; }
+
+private:
+    std::unique_ptr<ZZZKBotAIModule> bot;
+    bool isOnStartCalled = false;
+    bool isCombatIntentCheckEnabled = false;
+    bool isCreepInferenceCheckEnabled = false;
+    Result result;
+};
@@ -0,0 +1,72 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "MyUnitBuckets.h"
+
+void MyUnitBuckets::update(BWAPI::Game& Broodwar)
+{
+    units.clear();
+    completedNonLarvaUnits.clear();
+    completedBuildings.clear();
+    for (std::vector<BWAPI::Unit>& typeUnits : unitsByType)
+    {
+        typeUnits.clear();
+    }
+
+    for (const BWAPI::Unit u : Broodwar->self()->getUnits())
+    {
+        if (!u->exists())
+        {
+            continue;
+        }
+
+        const BWAPI::UnitType type = u->getType();
+        units.push_back(u);
+
+        const int typeID = type.getID();
+        if (typeID >= (int) unitsByType.size())
+        {
+            unitsByType.resize(typeID + 1);
+        }
+
+        unitsByType[typeID].push_back(u);
+
+        if (u->isCompleted())
+        {
+            if (type != BWAPI::UnitTypes::Zerg_Larva && type != BWAPI::UnitTypes::Zerg_Egg)
+            {
+                completedNonLarvaUnits.push_back(u);
+            }
+
+            if (type.isBuilding())
+            {
+                completedBuildings.push_back(u);
+            }
+        }
+    }
+}
+
+const std::vector<BWAPI::Unit>& MyUnitBuckets::getUnits(const BWAPI::UnitType type) const
+{
+    static const std::vector<BWAPI::Unit> noUnits;
+    const int typeID = type.getID();
+    return typeID >= 0 && typeID < (int) unitsByType.size() ? unitsByType[typeID] : noUnits;
+}
@@ -0,0 +1,57 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+#include <BWAPI.h>
+#include <vector>
+
+// My units, classified once per frame into contiguous arrays (all of them, by type, and a few
+// other groups that several parts of onFrame() look for), so that each part only iterates the
+// units that it cares about instead of walking Broodwar->self()->getUnits() and calling
+// exists()/getType()/isCompleted() on every unit again.
+// The arrays are cleared rather than freed each frame, so once they have grown there is no
+// allocation.
+class MyUnitBuckets
+{
+public:
+    // Re-classifies all my units. Call this once per frame before any of the queries.
+    void update(BWAPI::Game& Broodwar);
+
+    // All my units that exist.
+    const std::vector<BWAPI::Unit>& getUnits() const { return units; }
+
+    // My units of the type that exist (whether completed or not).
+    const std::vector<BWAPI::Unit>& getUnits(const BWAPI::UnitType type) const;
+
+    // My completed units other than larvae/eggs (i.e. those that can move/fight etc).
+    const std::vector<BWAPI::Unit>& getCompletedNonLarvaUnits() const { return completedNonLarvaUnits; }
+
+    // My completed buildings.
+    const std::vector<BWAPI::Unit>& getCompletedBuildings() const { return completedBuildings; }
+
+private:
+    std::vector<BWAPI::Unit> units;
+    std::vector<BWAPI::Unit> completedNonLarvaUnits;
+    std::vector<BWAPI::Unit> completedBuildings;
+
+    // By unit type ID.
+    std::vector<std::vector<BWAPI::Unit>> unitsByType;
+};
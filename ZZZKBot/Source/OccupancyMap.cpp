@@ -0,0 +1,94 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "OccupancyMap.h"
+
+void OccupancyMap::onStart(BWAPI::Game& Broodwar)
+{
+    const int mapWidth = Broodwar->mapWidth();
+    const int mapHeight = Broodwar->mapHeight();
+    building.reset(mapWidth, mapHeight);
+    enemyBuilding.reset(mapWidth, mapHeight);
+    enemyNonRefineryBuilding.reset(mapWidth, mapHeight);
+    myBlockingUnit.reset(mapWidth, mapHeight);
+    enemyRefineries.clear();
+}
+
+void OccupancyMap::update(const FrameSnapshot& snapshot)
+{
+    building.clear();
+    enemyBuilding.clear();
+    enemyNonRefineryBuilding.clear();
+    myBlockingUnit.clear();
+    enemyRefineries.clear();
+
+    // The snapshot has every accessible unit, i.e. all of those that exist.
+    for (int i = 0; i < snapshot.size(); ++i)
+    {
+        if (!snapshot.isVisible(i))
+        {
+            continue;
+        }
+
+        const BWAPI::UnitType unitType = snapshot.getType(i);
+        if (unitType.isBuilding())
+        {
+            if (snapshot.isLifted(i))
+            {
+                continue;
+            }
+
+            setUnitTiles(building, snapshot, i);
+
+            if (snapshot.isEnemy(i))
+            {
+                setUnitTiles(enemyBuilding, snapshot, i);
+
+                if (unitType.isRefinery())
+                {
+                    enemyRefineries.push_back(
+                        Refinery{
+                            snapshot.getUnit(i),
+                            snapshot.getLeft(i) / BWAPI::TILEPOSITION_SCALE,
+                            snapshot.getTop(i) / BWAPI::TILEPOSITION_SCALE,
+                            snapshot.getRight(i) / BWAPI::TILEPOSITION_SCALE,
+                            snapshot.getBottom(i) / BWAPI::TILEPOSITION_SCALE });
+                }
+                else
+                {
+                    setUnitTiles(enemyNonRefineryBuilding, snapshot, i);
+                }
+            }
+        }
+        else if (snapshot.isMine(i) && !unitType.isWorker() && !snapshot.isFlying(i) && !snapshot.isLoaded(i))
+        {
+            setUnitTiles(myBlockingUnit, snapshot, i);
+        }
+    }
+}
+
+void OccupancyMap::setUnitTiles(TileBitmap& plane, const FrameSnapshot& snapshot, const int i)
+{
+    const int left = snapshot.getLeft(i) / BWAPI::TILEPOSITION_SCALE;
+    const int top = snapshot.getTop(i) / BWAPI::TILEPOSITION_SCALE;
+    const int right = snapshot.getRight(i) / BWAPI::TILEPOSITION_SCALE;
+    const int bottom = snapshot.getBottom(i) / BWAPI::TILEPOSITION_SCALE;
+    plane.setRect(left, top, right - left + 1, bottom - top + 1);
+}
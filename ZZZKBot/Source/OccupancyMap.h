@@ -0,0 +1,105 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <BWAPI.h>
+#include <vector>
+
+#include "FrameSnapshot.h"
+#include "TileBitmap.h"
+
+// Which tiles are covered by which kinds of visible units this frame. It is rebuilt from the
+// frame snapshot once at the start of each frame, so that checks like "is there a
+// visible enemy building on this tile" are a bit lookup rather than a call to
+// Broodwar->getUnitsOnTile() that builds a Unitset through a composed filter.
+// A unit covers the tiles that its bounding box (getLeft() to getRight(), getTop() to
+// getBottom()) overlaps.
+class OccupancyMap
+{
+public:
+    void onStart(BWAPI::Game& Broodwar);
+
+    // Rebuilds all the bitplanes from the snapshot (it doesn't call BWAPI, so it can run on the
+    // thread pool). Call this once per frame, after the snapshot is updated and before any of the
+    // queries.
+    void update(const FrameSnapshot& snapshot);
+
+    // Equivalent to !Broodwar->getUnitsOnTile(loc, IsVisible && Exists && IsBuilding && !IsLifted).empty().
+    bool hasBuilding(const BWAPI::TilePosition loc) const { return building.get(loc.x, loc.y); }
+
+    // Equivalent to !Broodwar->getUnitsOnTile(loc, IsEnemy && IsVisible && Exists && IsBuilding && !IsLifted).empty().
+    bool hasEnemyBuilding(const BWAPI::TilePosition loc) const { return enemyBuilding.get(loc.x, loc.y); }
+
+    // Same as above except that enemy refineries only count if isRefineryIncluded returns true
+    // for them (e.g. to ignore stolen gas). Enemy refineries are rare so the predicate is only
+    // evaluated for the ones whose footprint covers the tile.
+    template <typename Pred>
+    bool hasEnemyBuilding(const BWAPI::TilePosition loc, Pred isRefineryIncluded) const
+    {
+        if (enemyNonRefineryBuilding.get(loc.x, loc.y))
+        {
+            return true;
+        }
+
+        if (enemyBuilding.get(loc.x, loc.y))
+        {
+            for (const Refinery& refinery : enemyRefineries)
+            {
+                if (loc.x >= refinery.left && loc.x <= refinery.right && loc.y >= refinery.top && loc.y <= refinery.bottom &&
+                    isRefineryIncluded(refinery.unit))
+                {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    // Whether one of my ground units that isn't a worker or a building is on the tile, i.e.
+    // something that would stop a building being placed there (workers are left out because one
+    // of them is usually the builder and the others get out of the way while mining).
+    bool hasMyBlockingUnit(const BWAPI::TilePosition loc) const { return myBlockingUnit.get(loc.x, loc.y); }
+
+    const TileBitmap& getBuildingPlane() const { return building; }
+    const TileBitmap& getEnemyBuildingPlane() const { return enemyBuilding; }
+    const TileBitmap& getMyBlockingUnitPlane() const { return myBlockingUnit; }
+
+private:
+    // A refinery and the tiles that it covers.
+    struct Refinery
+    {
+        BWAPI::Unit unit;
+        int left;
+        int top;
+        int right;
+        int bottom;
+    };
+
+    static void setUnitTiles(TileBitmap& plane, const FrameSnapshot& snapshot, const int i);
+
+    TileBitmap building;
+    TileBitmap enemyBuilding;
+    TileBitmap enemyNonRefineryBuilding;
+    TileBitmap myBlockingUnit;
+
+    // Visible unlifted enemy refineries.
+    std::vector<Refinery> enemyRefineries;
+};
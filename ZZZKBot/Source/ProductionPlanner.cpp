@@ -0,0 +1,105 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "ProductionPlanner.h"
+#include <algorithm>
+
+void ProductionPlanner::clear()
+{
+    requests.clear();
+    numAllocated.clear();
+    requestArena.reset();
+}
+
+void ProductionPlanner::allocate(const std::vector<BWAPI::Unit>& producers, ResourceLedger& resourceLedger)
+{
+    freeProducers.assign(producers.begin(), producers.end());
+    for (const Request& request : requests)
+    {
+        const BWAPI::UnitType producerType = request.type.whatBuilds().first;
+        const ResourceLedger::Cost cost(request.type);
+        while (resourceLedger.canAfford(cost) && request.callIsNeeded(request.isNeeded))
+        {
+            bool isAllocated = false;
+            for (std::vector<BWAPI::Unit>::iterator iter = freeProducers.begin(); iter != freeProducers.end(); ++iter)
+            {
+                const BWAPI::Unit producer = *iter;
+                if (producer->getType() != producerType)
+                {
+                    continue;
+                }
+
+                // Larvae train, whereas e.g. a hatchery morphs into a lair.
+                if (producer->canTrain(request.type))
+                {
+                    producer->train(request.type);
+                }
+                else if (producer->canMorph(request.type))
+                {
+                    producer->morph(request.type);
+                }
+                else
+                {
+                    continue;
+                }
+
+                // The order of the producers doesn't matter, so swap-remove.
+                *iter = freeProducers.back();
+                freeProducers.pop_back();
+                isAllocated = true;
+                break;
+            }
+
+            if (!isAllocated)
+            {
+                break;
+            }
+
+            resourceLedger.commit(request.type);
+            const int typeID = request.type.getID();
+            if (typeID >= (int) numAllocated.size())
+            {
+                numAllocated.resize(typeID + 1, 0);
+            }
+
+            ++numAllocated[typeID];
+        }
+    }
+}
+
+int ProductionPlanner::getNumAllocated(const BWAPI::UnitType type) const
+{
+    const int typeID = type.getID();
+    return typeID < (int) numAllocated.size() ? numAllocated[typeID] : 0;
+}
+
+void ProductionPlanner::getProducerTypes(std::vector<BWAPI::UnitType>& producerTypes) const
+{
+    producerTypes.clear();
+    for (const Request& request : requests)
+    {
+        const BWAPI::UnitType producerType = request.type.whatBuilds().first;
+        if (std::find(producerTypes.begin(), producerTypes.end(), producerType) == producerTypes.end())
+        {
+            producerTypes.push_back(producerType);
+        }
+    }
+}
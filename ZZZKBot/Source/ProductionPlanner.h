@@ -0,0 +1,89 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+#include <BWAPI.h>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "Arena.h"
+#include "ResourceLedger.h"
+
+// Decides what all my larvae (and the other units that morph into something, e.g. hatcheries into
+// lairs or mutalisks into guardians) make this frame, in one pass over the requests in priority
+// order against the resource ledger. Each request gets as many producers as it needs before the
+// next one is looked at, and pays for them in the ledger, so lower priority requests only get
+// what is left over and no two commands are issued for the same minerals/gas/supply.
+class ProductionPlanner
+{
+public:
+    // Forgets the requests and allocations of the previous frame.
+    void clear();
+
+    // Requests more of the unit type for as long as isNeeded returns true (it is called again
+    // after each one is allocated, so it may depend on getNumAllocated()). Requests are allocated
+    // in the order that they were made. isNeeded is copied into an arena that is reset by clear()
+    // rather than into a std::function, so that making requests doesn't allocate once the arena has
+    // warmed up, which means it must be trivially destructible (e.g. a lambda that only captures
+    // by reference).
+    template <class IsNeeded>
+    void request(const BWAPI::UnitType type, const IsNeeded& isNeeded)
+    {
+        static_assert(std::is_trivially_destructible<IsNeeded>::value, "isNeeded is never destroyed");
+        Request newRequest;
+        newRequest.type = type;
+        newRequest.isNeeded = new (requestArena.allocate(sizeof(IsNeeded), alignof(IsNeeded))) IsNeeded(isNeeded);
+        newRequest.callIsNeeded = [](const void* isNeeded) { return (*static_cast<const IsNeeded*>(isNeeded))(); };
+        requests.push_back(newRequest);
+    }
+
+    // Issues the train/morph commands for the requests using the producers (which must be free to
+    // be given a command) and commits their costs to the ledger.
+    void allocate(const std::vector<BWAPI::Unit>& producers, ResourceLedger& resourceLedger);
+
+    // The number of the unit type that were allocated this frame.
+    int getNumAllocated(const BWAPI::UnitType type) const;
+
+    // Sets producerTypes to the types of unit that make the requested types (e.g. larvae and
+    // hatcheries), without duplicates. It is an out parameter so that the caller can reuse it.
+    void getProducerTypes(std::vector<BWAPI::UnitType>& producerTypes) const;
+
+private:
+    struct Request
+    {
+        BWAPI::UnitType type;
+        const void* isNeeded;
+        bool (*callIsNeeded)(const void* isNeeded);
+    };
+
+    std::vector<Request> requests;
+
+    // Holds the isNeeded of the requests.
+    Arena requestArena{4 * 1024};
+
+    // The producers that haven't been given a command yet in allocate(). It is a member so that
+    // it doesn't allocate in most frames.
+    std::vector<BWAPI::Unit> freeProducers;
+
+    // By unit type ID.
+    std::vector<int> numAllocated;
+};
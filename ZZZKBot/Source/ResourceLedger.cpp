@@ -0,0 +1,85 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "ResourceLedger.h"
+#include <algorithm>
+
+ResourceLedger::Cost::Cost(const BWAPI::UnitType type, const int count) :
+    minerals(type.mineralPrice() * count),
+    gas(type.gasPrice() * count),
+    supply(std::max(0, type.supplyRequired() * (type.isTwoUnitsInOneEgg() ? 2 : 1) - type.whatBuilds().first.supplyRequired()) * count)
+{
+}
+
+void ResourceLedger::reset(const int minerals, const int gas, const int supplyAvailable)
+{
+    available = Cost(minerals, gas, supplyAvailable);
+    reserved = Cost();
+    std::fill(numReserved.begin(), numReserved.end(), 0);
+    std::fill(numCommitted.begin(), numCommitted.end(), 0);
+}
+
+void ResourceLedger::reserve(const BWAPI::UnitType type, const int count)
+{
+    const int typeID = type.getID();
+    ensureType(typeID);
+    const int oldNumReserved = getNumReserved(typeID);
+    numReserved[typeID] = std::max(0, count);
+    reserved = reserved + Cost(type, getNumReserved(typeID) - oldNumReserved);
+}
+
+void ResourceLedger::clearReservations()
+{
+    reserved = Cost();
+    std::fill(numReserved.begin(), numReserved.end(), 0);
+}
+
+void ResourceLedger::commit(const BWAPI::UnitType type, const int count)
+{
+    const int typeID = type.getID();
+    ensureType(typeID);
+    const int oldNumReserved = getNumReserved(typeID);
+    numCommitted[typeID] += count;
+    reserved = reserved + Cost(type, getNumReserved(typeID) - oldNumReserved);
+    available = available - Cost(type, count);
+}
+
+bool ResourceLedger::canAfford(const Cost& cost) const
+{
+    return
+        (cost.minerals <= 0 || getMinerals() >= cost.minerals) &&
+        (cost.gas <= 0 || getGas() >= cost.gas) &&
+        (cost.supply <= 0 || getSupply() >= cost.supply);
+}
+
+int ResourceLedger::getNumReserved(const int typeID) const
+{
+    return std::max(0, numReserved[typeID] - numCommitted[typeID]);
+}
+
+void ResourceLedger::ensureType(const int typeID)
+{
+    if (typeID >= (int) numReserved.size())
+    {
+        numReserved.resize(typeID + 1, 0);
+        numCommitted.resize(typeID + 1, 0);
+    }
+}
@@ -0,0 +1,90 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+#include <BWAPI.h>
+#include <vector>
+
+// How much of my minerals/gas/supply is left this frame once the commands issued so far are paid
+// for, and once the items that are being saved up for are held back. Queries are O(1) because the totals are kept up to date as
+// items are committed/reserved.
+//
+// Reservations are per unit type and count how many more of the type are wanted but not ordered
+// yet, so committing an item of a reserved type uses up one of its reservations rather than
+// paying for it twice.
+class ResourceLedger
+{
+public:
+    struct Cost
+    {
+        Cost() {}
+        Cost(const int newMinerals, const int newGas, const int newSupply) : minerals(newMinerals), gas(newGas), supply(newSupply) {}
+
+        // The cost of making count of the unit type (for a morph the supply is the difference from
+        // the unit it morphs from, and both zerglings/scourges in an egg are counted).
+        explicit Cost(const BWAPI::UnitType type, const int count = 1);
+
+        Cost operator+(const Cost& other) const { return Cost(minerals + other.minerals, gas + other.gas, supply + other.supply); }
+        Cost operator-(const Cost& other) const { return Cost(minerals - other.minerals, gas - other.gas, supply - other.supply); }
+
+        int minerals = 0;
+        int gas = 0;
+        int supply = 0;
+    };
+
+    // Starts a new frame with what I have (and forgets the commitments/reservations of the
+    // previous frame).
+    void reset(const int minerals, const int gas, const int supplyAvailable);
+
+    // Sets how many more of the unit type to save up for (replacing any previous reservation for
+    // the type).
+    void reserve(const BWAPI::UnitType type, const int count);
+    void clearReservations();
+
+    // Pays for count of the unit type.
+    void commit(const BWAPI::UnitType type, const int count = 1);
+
+    // Whether the cost can be paid from what is left after the commitments and reservations (an
+    // item only waits for the resources that it needs, e.g. reserved gas doesn't hold back a
+    // building that only costs minerals).
+    bool canAfford(const Cost& cost) const;
+    bool canAfford(const BWAPI::UnitType type, const int count = 1) const { return canAfford(Cost(type, count)); }
+
+    // What is left after the commitments and reservations (may be negative).
+    int getMinerals() const { return available.minerals - reserved.minerals; }
+    int getGas() const { return available.gas - reserved.gas; }
+    int getSupply() const { return available.supply - reserved.supply; }
+
+private:
+    // The number of reservations of the type that haven't been used up by commitments.
+    int getNumReserved(const int typeID) const;
+    void ensureType(const int typeID);
+
+    // What I have minus the commitments.
+    Cost available;
+
+    // The total of the reservations that haven't been used up.
+    Cost reserved;
+
+    // By unit type ID.
+    std::vector<int> numReserved;
+    std::vector<int> numCommitted;
+};
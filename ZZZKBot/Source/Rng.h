@@ -0,0 +1,117 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <cstdint>
+#include <limits>
+
+// A small, fast pseudo-random number generator (xoshiro256**) that is explicitly seeded, so that
+// a game can be reproduced from its seed (which is logged in the init update of the learning
+// file). Unlike rand(), each subsystem gets its own independent substream (see getSubstream()),
+// so e.g. drawing one more number for strategy selection doesn't change what exploration draws.
+class Rng
+{
+public:
+    typedef std::uint64_t result_type;
+
+    // The substreams of the bot's RNG. Append new ones at the end so that the existing ones
+    // keep drawing the same numbers for the same seed.
+    enum Stream : std::uint64_t
+    {
+        StratSelectionStream = 1,
+        StratExplorationStream = 2
+    };
+
+    explicit Rng(const std::uint64_t newSeed = 0)
+    {
+        seed(newSeed);
+    }
+
+    void seed(const std::uint64_t newSeed)
+    {
+        seedValue = newSeed;
+        std::uint64_t splitMixState = newSeed;
+        for (std::uint64_t& word : state)
+        {
+            word = splitMix64(splitMixState);
+        }
+    }
+
+    std::uint64_t getSeed() const
+    {
+        return seedValue;
+    }
+
+    // Returns a generator whose sequence depends only on this generator's seed and the stream,
+    // not on how many numbers have been drawn from this generator.
+    Rng getSubstream(const std::uint64_t stream) const
+    {
+        std::uint64_t splitMixState = stream;
+        return Rng(seedValue ^ splitMix64(splitMixState));
+    }
+
+    std::uint64_t next()
+    {
+        const std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const std::uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // Returns a number in [0, n) (n must be positive). Uses the high bits (multiply and shift
+    // rather than modulo), the bias of which is negligible for the small n used.
+    int nextInt(const int n)
+    {
+        return (int) (((next() >> 32) * (std::uint64_t) n) >> 32);
+    }
+
+    // Returns a number in [0, 1).
+    double nextDouble()
+    {
+        return (double) (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // So that it can be used with the <random> distributions and algorithms too.
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+    result_type operator()() { return next(); }
+
+private:
+    static std::uint64_t rotl(const std::uint64_t x, const int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    static std::uint64_t splitMix64(std::uint64_t& x)
+    {
+        std::uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    std::uint64_t seedValue = 0;
+    std::uint64_t state[4];
+};
@@ -0,0 +1,149 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "Scenario.h"
+#include <sstream>
+
+const Scenario::Player* Scenario::findPlayer(const int playerID) const
+{
+    for (const Player& player : players)
+    {
+        if (player.id == playerID)
+        {
+            return &player;
+        }
+    }
+
+    return nullptr;
+}
+
+Scenario::Player* Scenario::findPlayer(const int playerID)
+{
+    for (Player& player : players)
+    {
+        if (player.id == playerID)
+        {
+            return &player;
+        }
+    }
+
+    return nullptr;
+}
+
+bool Scenario::parse(std::istream& is, std::vector<Scenario>& scenarios, std::string& error)
+{
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(is, line))
+    {
+        ++lineNumber;
+        const std::string::size_type commentPos = line.find('#');
+        if (commentPos != std::string::npos)
+        {
+            line.erase(commentPos);
+        }
+
+        std::istringstream iss(line);
+        std::string command;
+        if (!(iss >> command))
+        {
+            continue;
+        }
+
+        bool isValid = true;
+        if (command == "scenario")
+        {
+            scenarios.emplace_back();
+            isValid = (bool) (iss >> scenarios.back().name);
+        }
+        else if (scenarios.empty())
+        {
+            // Everything else belongs to a scenario.
+            isValid = false;
+        }
+        else if (command == "map")
+        {
+            isValid = (iss >> scenarios.back().mapWidth >> scenarios.back().mapHeight) && scenarios.back().mapWidth > 0 && scenarios.back().mapHeight > 0;
+        }
+        else if (command == "maphash")
+        {
+            isValid = (bool) (iss >> scenarios.back().mapHash);
+        }
+        else if (command == "startloc")
+        {
+            std::pair<int, int> startLocation;
+            isValid = (iss >> startLocation.first >> startLocation.second) && startLocation.first >= 0 && startLocation.second >= 0;
+            scenarios.back().startLocations.push_back(startLocation);
+        }
+        else if (command == "frames")
+        {
+            isValid = (iss >> scenarios.back().numFrames) && scenarios.back().numFrames > 0;
+        }
+        else if (command == "player")
+        {
+            Player player;
+            std::string relation;
+            isValid = (bool) (iss >> player.id >> relation) && scenarios.back().findPlayer(player.id) == nullptr;
+            player.isSelf = relation == "self";
+            player.isEnemy = relation == "enemy";
+            player.isNeutral = relation == "neutral";
+            isValid = isValid && (player.isSelf || player.isEnemy || player.isNeutral);
+            scenarios.back().players.push_back(player);
+        }
+        else if (command == "units")
+        {
+            UnitGroup unitGroup;
+            isValid = (bool) (iss >> unitGroup.count >> unitGroup.typeName >> unitGroup.playerID >> unitGroup.x >> unitGroup.y);
+            if (!(iss >> unitGroup.radius))
+            {
+                unitGroup.radius = 0;
+            }
+
+            isValid = isValid && unitGroup.count > 0 && scenarios.back().findPlayer(unitGroup.playerID) != nullptr;
+            scenarios.back().unitGroups.push_back(unitGroup);
+        }
+        else if (command == "order")
+        {
+            int playerID = -1;
+            std::string order;
+            isValid = (bool) (iss >> playerID >> order);
+            Player* player = isValid ? scenarios.back().findPlayer(playerID) : nullptr;
+            isValid = player != nullptr;
+            if (isValid)
+            {
+                player->order = order == "attack" ? Order::Attack : order == "move" ? Order::Move : Order::Hold;
+                isValid = order == "attack" || order == "hold" || (order == "move" && (iss >> player->orderX >> player->orderY));
+            }
+        }
+        else
+        {
+            isValid = false;
+        }
+
+        if (!isValid)
+        {
+            error = "line " + std::to_string(lineNumber) + ": " + line;
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,92 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// A synthetic match for MockGame, e.g. a big battle that real games rarely get to, described in a
+// small text format with one command per line (# starts a comment):
+//
+//   scenario <name>               Starts a new scenario.
+//   map <width> <height>          The map size in tiles (128 x 128 by default).
+//   maphash <hash>                The mapHash() of the map that the scenario stands in for, if any.
+//   startloc <x> <y>              Adds a start location (in tiles) of the map.
+//   frames <n>                    How many frames to run (1000 by default).
+//   player <id> <self|enemy|neutral>
+//   units <count> <type> <player> <x> <y> [<radius>]
+//                                 Adds units of the type (by BWAPI name, e.g. Zerg_Zergling),
+//                                 spread evenly over a disc around the position (in pixels).
+//   order <player> <attack|hold|move> [<x> <y>]
+//                                 What all the units of the player do: attack the nearest enemy
+//                                 that they can hit (moving to it), only attack enemies that are
+//                                 in range, or move to the position.
+//
+// It doesn't depend on BWAPI.
+struct Scenario
+{
+    enum class Order
+    {
+        Attack,
+        Hold,
+        Move
+    };
+
+    struct Player
+    {
+        int id = -1;
+        bool isSelf = false;
+        bool isEnemy = false;
+        bool isNeutral = false;
+        Order order = Order::Hold;
+        int orderX = 0;
+        int orderY = 0;
+    };
+
+    struct UnitGroup
+    {
+        int count = 0;
+        std::string typeName;
+        int playerID = -1;
+        int x = 0;
+        int y = 0;
+        int radius = 0;
+    };
+
+    std::string name;
+    int mapWidth = 128;
+    int mapHeight = 128;
+    std::string mapHash;
+    std::vector<std::pair<int, int>> startLocations;
+    int numFrames = 1000;
+    std::vector<Player> players;
+    std::vector<UnitGroup> unitGroups;
+
+    // Returns the player, or nullptr if the scenario doesn't have it.
+    const Player* findPlayer(const int playerID) const;
+    Player* findPlayer(const int playerID);
+
+    // Parses all the scenarios in the text. Returns false with a description of the first line
+    // that it doesn't understand in error.
+    static bool parse(std::istream& is, std::vector<Scenario>& scenarios, std::string& error);
+};
@@ -0,0 +1,375 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "ScoutingTours.h"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <set>
+#include <sstream>
+
+static const std::string toursFileName = "ZZZKBot_scouting_tours.txt";
+static const std::string readDirPath = "bwapi-data/read/";
+static const std::string writeDirPath = "bwapi-data/write/";
+
+// Each line of the file is:
+// <map hash> <my start loc x> <my start loc y> <tour type> <num locs> <loc 1 x> <loc 1 y> ... <EOL sentinel>
+static const char groundTourType = 'g';
+static const char airTourType = 'a';
+static const int endOfLineSentinel = -1;
+
+// Use exact DP for up to this many other start locations, otherwise nearest neighbour.
+static const int maxExactTourLocs = 8;
+
+// Distance used for start locations that can't be reached by ground, so that they go last.
+static const int unreachableDist = std::numeric_limits<int>::max() / 4;
+
+static BWAPI::Position getStartLocPos(const BWAPI::TilePosition loc)
+{
+    return
+        BWAPI::Position(loc) +
+        BWAPI::Position(
+            (BWAPI::UnitTypes::Special_Start_Location.tileWidth() * BWAPI::TILEPOSITION_SCALE) / 2,
+            (BWAPI::UnitTypes::Special_Start_Location.tileHeight() * BWAPI::TILEPOSITION_SCALE) / 2);
+}
+
+void ScoutingTours::onStart(BWAPI::Game& Broodwar)
+{
+    *this = ScoutingTours();
+
+    if (Broodwar->isReplay() || !Broodwar->self())
+    {
+        return;
+    }
+
+    const BWAPI::TilePosition myStartLoc = Broodwar->self()->getStartLocation();
+    if (myStartLoc == BWAPI::TilePositions::None || myStartLoc == BWAPI::TilePositions::Unknown)
+    {
+        return;
+    }
+
+    std::vector<BWAPI::TilePosition> otherStartLocs;
+    for (const BWAPI::TilePosition loc : Broodwar->getStartLocations())
+    {
+        if (loc != BWAPI::TilePositions::None && loc != BWAPI::TilePositions::Unknown && loc != myStartLoc)
+        {
+            otherStartLocs.push_back(loc);
+        }
+    }
+
+    if (otherStartLocs.empty())
+    {
+        return;
+    }
+
+    const std::string mapHash = Broodwar->mapHash();
+
+    // Read the cached tours (the file in the write folder takes precedence because it is the
+    // newest if it exists). A cached tour is only used if it visits the same start locations.
+    std::vector<std::string> cachedLines;
+    std::set<std::string> cachedLineSet;
+    for (const std::string& dirPath : { writeDirPath, readDirPath })
+    {
+        std::ifstream ifs(dirPath + toursFileName);
+        if (!ifs)
+        {
+            continue;
+        }
+
+        std::string line;
+        while (std::getline(ifs, line))
+        {
+            std::istringstream iss(line);
+            std::string tmpMapHash;
+            int tmpMyStartLocX = 0;
+            int tmpMyStartLocY = 0;
+            char tmpTourType = 0;
+            int numLocs = 0;
+            if (!(iss >> tmpMapHash >> tmpMyStartLocX >> tmpMyStartLocY >> tmpTourType >> numLocs) ||
+                numLocs < 0)
+            {
+                continue;
+            }
+
+            std::vector<BWAPI::TilePosition> tour;
+            for (int i = 0; i < numLocs; ++i)
+            {
+                int tmpX = 0;
+                int tmpY = 0;
+                if (iss >> tmpX >> tmpY)
+                {
+                    tour.push_back(BWAPI::TilePosition(tmpX, tmpY));
+                }
+            }
+
+            int tmpEndOfLineSentinel = 0;
+            if ((int) tour.size() != numLocs || !(iss >> tmpEndOfLineSentinel) || tmpEndOfLineSentinel != endOfLineSentinel)
+            {
+                continue;
+            }
+
+            if (cachedLineSet.insert(line).second)
+            {
+                cachedLines.push_back(line);
+            }
+
+            if (tmpMapHash != mapHash || BWAPI::TilePosition(tmpMyStartLocX, tmpMyStartLocY) != myStartLoc ||
+                !std::is_permutation(tour.begin(), tour.end(), otherStartLocs.begin(), otherStartLocs.end()))
+            {
+                continue;
+            }
+
+            std::vector<BWAPI::TilePosition>& cachedTour = (tmpTourType == groundTourType) ? groundTour : airTour;
+            if (cachedTour.empty() && (tmpTourType == groundTourType || tmpTourType == airTourType))
+            {
+                cachedTour = tour;
+            }
+        }
+    }
+
+    if (!groundTour.empty() && !airTour.empty())
+    {
+        return;
+    }
+
+    std::vector<BWAPI::Position> positions;
+    positions.push_back(getStartLocPos(myStartLoc));
+    for (const BWAPI::TilePosition loc : otherStartLocs)
+    {
+        positions.push_back(getStartLocPos(loc));
+    }
+
+    if (groundTour.empty())
+    {
+        for (const int i : solveTour(getGroundDists(Broodwar, positions)))
+        {
+            groundTour.push_back(otherStartLocs[i]);
+        }
+    }
+
+    if (airTour.empty())
+    {
+        for (const int i : solveTour(getAirDists(positions)))
+        {
+            airTour.push_back(otherStartLocs[i]);
+        }
+    }
+
+    // Rewrite the whole file in the write folder with everything that was read plus the new
+    // tours.
+    std::ofstream ofs(writeDirPath + toursFileName, std::ios_base::out | std::ios_base::trunc);
+    if (ofs)
+    {
+        for (const std::string& line : cachedLines)
+        {
+            ofs << line << std::endl;
+        }
+
+        for (const char tourType : { groundTourType, airTourType })
+        {
+            const std::vector<BWAPI::TilePosition>& tour = (tourType == groundTourType) ? groundTour : airTour;
+            std::ostringstream oss;
+            oss << mapHash << " " << myStartLoc.x << " " << myStartLoc.y << " " << tourType << " " << tour.size();
+            for (const BWAPI::TilePosition loc : tour)
+            {
+                oss << " " << loc.x << " " << loc.y;
+            }
+
+            oss << " " << endOfLineSentinel;
+            if (cachedLineSet.find(oss.str()) == cachedLineSet.end())
+            {
+                ofs << oss.str() << std::endl;
+            }
+        }
+    }
+}
+
+std::vector<int> ScoutingTours::solveTour(const std::vector<std::vector<int>>& dists)
+{
+    const int n = (int) dists.size() - 1;
+    std::vector<int> order;
+
+    if (n > maxExactTourLocs)
+    {
+        // Nearest neighbour.
+        std::vector<bool> isVisited(n, false);
+        int current = 0;
+        for (int step = 0; step < n; ++step)
+        {
+            int best = -1;
+            for (int i = 0; i < n; ++i)
+            {
+                if (!isVisited[i] && (best == -1 || dists[current][i + 1] < dists[current][best + 1]))
+                {
+                    best = i;
+                }
+            }
+
+            isVisited[best] = true;
+            order.push_back(best);
+            current = best + 1;
+        }
+
+        return order;
+    }
+
+    // Held-Karp: cost[mask][i] is the length of the shortest path that starts at my start
+    // location, visits the other start locations in mask and ends at other start location i.
+    const int numMasks = 1 << n;
+    std::vector<std::vector<long long>> cost(numMasks, std::vector<long long>(n, std::numeric_limits<long long>::max()));
+    std::vector<std::vector<int>> prev(numMasks, std::vector<int>(n, -1));
+    for (int i = 0; i < n; ++i)
+    {
+        cost[1 << i][i] = dists[0][i + 1];
+    }
+
+    for (int mask = 1; mask < numMasks; ++mask)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            if (!(mask & (1 << i)) || cost[mask][i] == std::numeric_limits<long long>::max())
+            {
+                continue;
+            }
+
+            for (int j = 0; j < n; ++j)
+            {
+                if (mask & (1 << j))
+                {
+                    continue;
+                }
+
+                const int nextMask = mask | (1 << j);
+                const long long nextCost = cost[mask][i] + dists[i + 1][j + 1];
+                if (nextCost < cost[nextMask][j])
+                {
+                    cost[nextMask][j] = nextCost;
+                    prev[nextMask][j] = i;
+                }
+            }
+        }
+    }
+
+    int last = 0;
+    for (int i = 1; i < n; ++i)
+    {
+        if (cost[numMasks - 1][i] < cost[numMasks - 1][last])
+        {
+            last = i;
+        }
+    }
+
+    for (int mask = numMasks - 1; last != -1; )
+    {
+        order.push_back(last);
+        const int prevLast = prev[mask][last];
+        mask &= ~(1 << last);
+        last = prevLast;
+    }
+
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+std::vector<std::vector<int>> ScoutingTours::getGroundDists(BWAPI::Game& Broodwar, const std::vector<BWAPI::Position>& positions)
+{
+    // Breadth-first search over the walk tiles from each position (diagonal steps count the same
+    // as straight ones, which is close enough for choosing an order).
+    const int walkWidth = Broodwar->mapWidth() * 4;
+    const int walkHeight = Broodwar->mapHeight() * 4;
+    std::vector<bool> isWalkable((size_t) walkWidth * walkHeight);
+    for (int y = 0; y < walkHeight; ++y)
+    {
+        for (int x = 0; x < walkWidth; ++x)
+        {
+            isWalkable[(size_t) y * walkWidth + x] = Broodwar->isWalkable(x, y);
+        }
+    }
+
+    const int numPositions = (int) positions.size();
+    std::vector<std::vector<int>> dists(numPositions, std::vector<int>(numPositions, unreachableDist));
+    std::vector<int> walkDists((size_t) walkWidth * walkHeight);
+    std::deque<int> queue;
+    for (int i = 0; i < numPositions; ++i)
+    {
+        std::fill(walkDists.begin(), walkDists.end(), -1);
+        queue.clear();
+
+        const BWAPI::WalkPosition source(positions[i]);
+        const int sourceIndex = source.y * walkWidth + source.x;
+        walkDists[sourceIndex] = 0;
+        queue.push_back(sourceIndex);
+        while (!queue.empty())
+        {
+            const int index = queue.front();
+            queue.pop_front();
+            const int x = index % walkWidth;
+            const int y = index / walkWidth;
+            for (int dy = -1; dy <= 1; ++dy)
+            {
+                for (int dx = -1; dx <= 1; ++dx)
+                {
+                    const int nx = x + dx;
+                    const int ny = y + dy;
+                    if (nx < 0 || ny < 0 || nx >= walkWidth || ny >= walkHeight)
+                    {
+                        continue;
+                    }
+
+                    const int nIndex = ny * walkWidth + nx;
+                    if (walkDists[nIndex] == -1 && isWalkable[nIndex])
+                    {
+                        walkDists[nIndex] = walkDists[index] + 1;
+                        queue.push_back(nIndex);
+                    }
+                }
+            }
+        }
+
+        for (int j = 0; j < numPositions; ++j)
+        {
+            const BWAPI::WalkPosition target(positions[j]);
+            const int walkDist = walkDists[target.y * walkWidth + target.x];
+            if (walkDist != -1)
+            {
+                dists[i][j] = walkDist * 8;
+            }
+        }
+    }
+
+    return dists;
+}
+
+std::vector<std::vector<int>> ScoutingTours::getAirDists(const std::vector<BWAPI::Position>& positions)
+{
+    const int numPositions = (int) positions.size();
+    std::vector<std::vector<int>> dists(numPositions, std::vector<int>(numPositions, 0));
+    for (int i = 0; i < numPositions; ++i)
+    {
+        for (int j = 0; j < numPositions; ++j)
+        {
+            dists[i][j] = (int) positions[i].getDistance(positions[j]);
+        }
+    }
+
+    return dists;
+}
@@ -0,0 +1,66 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <BWAPI.h>
+#include <string>
+#include <vector>
+
+// The order in which to scout the other start locations: the shortest route from my start
+// location that visits all of them, using ground distance for ground units and straight-line
+// distance for flying units (exact for up to 8 other start locations, otherwise nearest
+// neighbour). The tours only depend on the map and my start location, so they are cached in a
+// file in the bwapi-data/read/ and bwapi-data/write/ folders rather than being recalculated
+// every game.
+class ScoutingTours
+{
+public:
+    void onStart(BWAPI::Game& Broodwar);
+
+    const std::vector<BWAPI::TilePosition>& getGroundTour() const { return groundTour; }
+    const std::vector<BWAPI::TilePosition>& getAirTour() const { return airTour; }
+
+    // Returns the first start location in the tour for which pred returns true, or
+    // BWAPI::TilePositions::Unknown if there isn't one.
+    template <typename Pred>
+    static BWAPI::TilePosition getNext(const std::vector<BWAPI::TilePosition>& tour, Pred pred)
+    {
+        for (const BWAPI::TilePosition loc : tour)
+        {
+            if (pred(loc))
+            {
+                return loc;
+            }
+        }
+
+        return BWAPI::TilePositions::Unknown;
+    }
+
+private:
+    // The first element of dists is the row for my start location, followed by the rows for the
+    // other start locations in the same order as otherStartLocs. Returns the indexes into
+    // otherStartLocs in the order that they should be visited.
+    static std::vector<int> solveTour(const std::vector<std::vector<int>>& dists);
+    static std::vector<std::vector<int>> getGroundDists(BWAPI::Game& Broodwar, const std::vector<BWAPI::Position>& positions);
+    static std::vector<std::vector<int>> getAirDists(const std::vector<BWAPI::Position>& positions);
+
+    std::vector<BWAPI::TilePosition> groundTour;
+    std::vector<BWAPI::TilePosition> airTour;
+};
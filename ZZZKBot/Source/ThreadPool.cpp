@@ -0,0 +1,210 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "ThreadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(const int numWorkers)
+{
+    const int n = std::max(0, numWorkers);
+    for (int i = 0; i <= n; ++i)
+    {
+        queues.push_back(std::unique_ptr<Queue>(new Queue()));
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        workers.push_back(std::thread(&ThreadPool::workerLoop, this, i + 1));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        isStopping = true;
+    }
+
+    wakeCondition.notify_all();
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+int ThreadPool::getDefaultNumWorkers()
+{
+    // hardware_concurrency() returns 0 if it isn't known.
+    const int numHardwareThreads = (int) std::thread::hardware_concurrency();
+    return std::max(0, std::min(3, numHardwareThreads - 1));
+}
+
+void ThreadPool::run(const std::vector<Task>& tasks)
+{
+    if (tasks.empty())
+    {
+        return;
+    }
+
+    if (workers.empty() || tasks.size() == 1)
+    {
+        for (const Task& task : tasks)
+        {
+            task();
+        }
+
+        return;
+    }
+
+    numUnfinished += (int) tasks.size();
+
+    // Deal the tasks out round-robin (the thieves even out any imbalance).
+    for (size_t i = 0; i < tasks.size(); ++i)
+    {
+        Queue& queue = *queues[i % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(&tasks[i]);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        numQueued += (int) tasks.size();
+    }
+
+    wakeCondition.notify_all();
+
+    // Work on the tasks too, then sleep until the workers have finished the ones they are still
+    // running.
+    while (tryRunOne(0))
+    {
+    }
+
+    std::unique_lock<std::mutex> lock(doneMutex);
+    doneCondition.wait(
+        lock,
+        [this]()
+        {
+            return numUnfinished == 0;
+        });
+}
+
+void ThreadPool::parallelFor(const int n, const std::function<void(int)>& fn)
+{
+    if (n <= 0)
+    {
+        return;
+    }
+
+    // A few chunks per thread so that stealing can balance chunks that take longer than others.
+    const int numChunks = std::min(n, (int) queues.size() * 4);
+    chunkTasks.clear();
+    for (int chunk = 0; chunk < numChunks; ++chunk)
+    {
+        const int begin = (int) ((long long) n * chunk / numChunks);
+        const int end = (int) ((long long) n * (chunk + 1) / numChunks);
+        chunkTasks.push_back(
+            [&fn, begin, end]()
+            {
+                for (int i = begin; i < end; ++i)
+                {
+                    fn(i);
+                }
+            });
+    }
+
+    run(chunkTasks);
+}
+
+bool ThreadPool::tryPop(const int queueIndex, const Task*& task)
+{
+    Queue& queue = *queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+    {
+        return false;
+    }
+
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::trySteal(const int queueIndex, const Task*& task)
+{
+    for (size_t offset = 1; offset < queues.size(); ++offset)
+    {
+        Queue& queue = *queues[(queueIndex + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty())
+        {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool ThreadPool::tryRunOne(const int queueIndex)
+{
+    const Task* task = nullptr;
+    if (!tryPop(queueIndex, task) && !trySteal(queueIndex, task))
+    {
+        return false;
+    }
+
+    --numQueued;
+    (*task)();
+
+    // Lock before notifying so that the notification can't be missed by run() between checking
+    // numUnfinished and starting to wait.
+    if (--numUnfinished == 0)
+    {
+        std::lock_guard<std::mutex> lock(doneMutex);
+        doneCondition.notify_one();
+    }
+
+    return true;
+}
+
+void ThreadPool::workerLoop(const int queueIndex)
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeCondition.wait(
+                lock,
+                [this]()
+                {
+                    return isStopping || numQueued > 0;
+                });
+            if (isStopping)
+            {
+                return;
+            }
+        }
+
+        while (tryRunOne(queueIndex))
+        {
+        }
+    }
+}
@@ -0,0 +1,95 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A small fixed-size pool of worker threads for running independent pieces of a frame at the
+// same time. Each thread (including the calling thread, which works too instead of just
+// waiting) has its own queue of tasks: it takes tasks from the back of its own queue and when
+// that is empty it steals from the front of the others, so that a thread that finishes its
+// share early helps with whatever is left rather than sitting idle.
+// Only one thread (i.e. the main thread in onFrame()) may call run()/parallelFor() at a time.
+// It doesn't depend on BWAPI.
+class ThreadPool
+{
+public:
+    typedef std::function<void()> Task;
+
+    // A pool with no worker threads runs everything on the calling thread.
+    explicit ThreadPool(const int numWorkers = getDefaultNumWorkers());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // One less than the number of hardware threads (the main thread is the other one) but not
+    // more than 3, because tournament machines are shared with the game and the other bot.
+    static int getDefaultNumWorkers();
+
+    int getNumWorkers() const { return (int) workers.size(); }
+
+    // Runs all the tasks and returns once they have all finished. The order in which they run is
+    // unspecified, so they mustn't write anything that another one of them reads or writes.
+    void run(const std::vector<Task>& tasks);
+
+    // Calls fn(i) for every i from 0 to n - 1 (in contiguous chunks) and returns once they have
+    // all finished. Same restrictions as run().
+    void parallelFor(const int n, const std::function<void(int)>& fn);
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<const Task*> tasks;
+    };
+
+    bool tryPop(const int queueIndex, const Task*& task);
+    bool trySteal(const int queueIndex, const Task*& task);
+    bool tryRunOne(const int queueIndex);
+    void workerLoop(const int queueIndex);
+
+    // Index 0 is the calling thread's queue and index i + 1 is the queue of workers[i].
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    bool isStopping = false;
+
+    // Notified when the last unfinished task finishes (run() waits on it once there is nothing
+    // left in the queues for the calling thread to do).
+    std::mutex doneMutex;
+    std::condition_variable doneCondition;
+
+    // Tasks that are in a queue / that haven't finished yet.
+    std::atomic<int> numQueued{ 0 };
+    std::atomic<int> numUnfinished{ 0 };
+
+    // Reused by parallelFor() so that it doesn't allocate every call.
+    std::vector<Task> chunkTasks;
+};
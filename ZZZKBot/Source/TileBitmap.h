@@ -0,0 +1,174 @@
+// Copyright 2017 Chris Coxe.
+//
+// ZZZKBot is distributed under the terms of the GNU Lesser General
+// Public License (LGPL) version 3.
+//
+// This file is part of ZZZKBot.
+//
+// ZZZKBot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ZZZKBot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with ZZZKBot.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// One bit per build tile, stored as 64-bit words per row (maps are at most 256 tiles wide so a
+// row is at most 4 words). Out-of-range tiles read as unset and writes to them are ignored, so
+// callers don't need to clip footprints at the edge of the map.
+class TileBitmap
+{
+public:
+    void reset(const int newWidth, const int newHeight)
+    {
+        width = newWidth;
+        height = newHeight;
+        wordsPerRow = (width + 63) / 64;
+        words.assign((size_t) wordsPerRow * height, 0);
+    }
+
+    void clear()
+    {
+        std::fill(words.begin(), words.end(), 0);
+    }
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getWordsPerRow() const { return wordsPerRow; }
+
+    bool isValid(const int x, const int y) const
+    {
+        return x >= 0 && y >= 0 && x < width && y < height;
+    }
+
+    bool get(const int x, const int y) const
+    {
+        return isValid(x, y) && ((words[(size_t) y * wordsPerRow + (x >> 6)] >> (x & 63)) & 1) != 0;
+    }
+
+    void set(const int x, const int y, const bool val = true)
+    {
+        if (isValid(x, y))
+        {
+            std::uint64_t& word = words[(size_t) y * wordsPerRow + (x >> 6)];
+            const std::uint64_t mask = std::uint64_t(1) << (x & 63);
+            word = val ? (word | mask) : (word & ~mask);
+        }
+    }
+
+    void setRect(const int x, const int y, const int w, const int h, const bool val = true)
+    {
+        for (int tileY = y; tileY < y + h; ++tileY)
+        {
+            for (int tileX = x; tileX < x + w; ++tileX)
+            {
+                set(tileX, tileY, val);
+            }
+        }
+    }
+
+    // Sets tiles x to x + w - 1 of row y, a word at a time.
+    void setRowRange(const int x, const int y, const int w)
+    {
+        if (y < 0 || y >= height)
+        {
+            return;
+        }
+
+        const int endX = std::min(x + w, width);
+        for (int tileX = std::max(x, 0); tileX < endX; )
+        {
+            const int bitInWord = tileX & 63;
+            const int n = std::min(endX - tileX, 64 - bitInWord);
+            const std::uint64_t mask = n < 64 ? (std::uint64_t(1) << n) - 1 : ~std::uint64_t(0);
+            words[(size_t) y * wordsPerRow + (tileX >> 6)] |= mask << bitInWord;
+            tileX += n;
+        }
+    }
+
+    // Returns the bits for tiles x to x + w - 1 of row y (bit 0 is tile x), where 0 < w <= 64.
+    // Out-of-range tiles are returned as unset.
+    std::uint64_t getRowBits(const int x, const int y, const int w) const
+    {
+        if (y < 0 || y >= height)
+        {
+            return 0;
+        }
+
+        std::uint64_t bits = 0;
+        for (int i = 0; i < w; )
+        {
+            const int tileX = x + i;
+            if (tileX < 0)
+            {
+                ++i;
+                continue;
+            }
+
+            if (tileX >= width)
+            {
+                break;
+            }
+
+            // Copy as many bits as possible from the word that tileX is in.
+            const int bitInWord = tileX & 63;
+            const int n = std::min(w - i, 64 - bitInWord);
+            std::uint64_t chunk = words[(size_t) y * wordsPerRow + (tileX >> 6)] >> bitInWord;
+            if (n < 64)
+            {
+                chunk &= (std::uint64_t(1) << n) - 1;
+            }
+
+            bits |= chunk << i;
+            i += n;
+        }
+
+        return bits;
+    }
+
+    bool isRectAllSet(const int x, const int y, const int w, const int h) const
+    {
+        const std::uint64_t mask = w >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << w) - 1;
+        for (int tileY = y; tileY < y + h; ++tileY)
+        {
+            if (getRowBits(x, tileY, w) != mask)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool isRectAnySet(const int x, const int y, const int w, const int h) const
+    {
+        for (int tileY = y; tileY < y + h; ++tileY)
+        {
+            if (getRowBits(x, tileY, w) != 0)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    const std::uint64_t* getRow(const int y) const { return &words[(size_t) y * wordsPerRow]; }
+    std::uint64_t* getRow(const int y) { return &words[(size_t) y * wordsPerRow]; }
+
+private:
+    int width = 0;
+    int height = 0;
+    int wordsPerRow = 0;
+    std::vector<std::uint64_t> words;
+};
@@ -28,10 +28,34 @@
 
 #pragma once
 #include <BWAPI.h>
-#include <set>
+#include <cstdint>
 #include <ctime>
+#include <map>
+#include <memory_resource>
+#include <optional>
+#include <set>
 
-#include "..\Frontend\BWAPIFrontendClient\ProtoClient.h"
+#include "../Frontend/BWAPIFrontendClient/ProtoClient.h"
+
+#include "Arena.h"
+#include "AssignmentSolver.h"
+#include "BaseRegistry.h"
+#include "BuildPlanner.h"
+#include "CombatIntents.h"
+#include "ExplorationMap.h"
+#include "FramePipeline.h"
+#include "FrameSnapshot.h"
+#include "FrameWatchdog.h"
+#include "GathererRegistry.h"
+#include "InitialCreep.h"
+#include "Learning.h"
+#include "MyUnitBuckets.h"
+#include "OccupancyMap.h"
+#include "ProductionPlanner.h"
+#include "ResourceLedger.h"
+#include "Rng.h"
+#include "ScoutingTours.h"
+#include "ThreadPool.h"
 
 // Reminder: don't use "Broodwar" in any global class constructor!
 
@@ -60,17 +84,22 @@ public:
     void onUnitComplete(BWAPI::Unit unit);
     // Everything below this line is safe to modify.
 
-    const std::string startOfLineSentinel = "||->";
-    const std::string endOfLineSentinel = "<-||";
-    const std::string startOfUpdateSentinel = "|->";
-    const std::string endOfUpdateSentinel = "<-|";
+    // Calls the callback for the type of the event (all but onStart() and onFrame(), which the
+    // host calls itself).
+    void onEvent(const BWAPI::Event& e);
 
-    const std::string delim = "\t";
+    // The same as the ones that Learning reads.
+    const std::string startOfLineSentinel = Learning::startOfLineSentinel;
+    const std::string endOfLineSentinel = Learning::endOfLineSentinel;
+    const std::string startOfUpdateSentinel = Learning::startOfUpdateSentinel;
+    const std::string endOfUpdateSentinel = Learning::endOfUpdateSentinel;
 
-    const std::string initUpdateSignifier = "init";
-    const std::string raceScoutedUpdateSignifier = "raceScouted";
-    const std::string onPlayerLeftUpdateSignifier = "onPlayerLeft";
-    const std::string onEndUpdateSignifier = "onEnd";
+    const std::string delim = Learning::delim;
+
+    const std::string initUpdateSignifier = Learning::initUpdateSignifier;
+    const std::string raceScoutedUpdateSignifier = Learning::raceScoutedUpdateSignifier;
+    const std::string onPlayerLeftUpdateSignifier = Learning::onPlayerLeftUpdateSignifier;
+    const std::string onEndUpdateSignifier = Learning::onEndUpdateSignifier;
 
     int enemyPlayerID = -1;
     std::string enemyWriteFilePath;
@@ -79,14 +108,13 @@ public:
 
     BWAPI::ProtoClient BWAPIClient;
     BWAPI::Game Broodwar;
-    std::map<BWAPI::Unit, std::map<int, void *>> unitInfo;
 
     void *getClientInfo(BWAPI::Unit unit, int key = 0) {
       // Retrieve iterator to element at index
-      auto result = unitInfo[unit].find(key);
+      auto result = matchState->unitInfo[unit].find(key);
 
       // Return a default value if not found
-      if (result == unitInfo[unit].end())
+      if (result == matchState->unitInfo[unit].end())
         return nullptr;
 
       // return the desired value
@@ -96,204 +124,248 @@ public:
     template < typename V >
     void setClientInfo(BWAPI::Unit unit, const V &clientInfo, int key = 0)
     {
-      unitInfo[unit][key] = (void*)clientInfo;
+      matchState->unitInfo[unit][key] = (void*)(std::intptr_t)clientInfo;
     };
 
-    struct StratSettings
-    {
-        bool is4PoolBO;
-        bool isSpeedlingBO;
-        bool isHydraRushBO;
-        bool isMutaRushBODecidedAfterScoutEnemyRace;
-        bool isMutaRushBO;
-
-        // For normal queries, query isMutaRushBO, not these because they are only used
-        // in conjunction with isMutaRushBODecidedAfterScoutEnemyRace.
-        bool isMutaRushBOVsProtoss;
-        bool isMutaRushBOVsTerran;
-        bool isMutaRushBOVsZerg;
-
-        bool isSpeedlingPushDeferred;
-        bool isEnemyWorkerRusher;
-        bool isNumSunkensDecidedAfterScoutEnemyRace;
-        int numSunkens;
-
-        // For normal queries, query numSunkens, not these because they are only used
-        // in conjunction with isNumSunkensDecidedAfterScoutEnemyRace.
-        int numSunkensVsProtoss;
-        int numSunkensVsTerran;
-        int numSunkensVsZerg;
-
-        inline bool operator <(const StratSettings& other) const
-        {
-            if (!is4PoolBO && other.is4PoolBO) return true;
-            if (is4PoolBO && !other.is4PoolBO) return false;
-            if (!isSpeedlingBO && other.isSpeedlingBO) return true;
-            if (isSpeedlingBO && !other.isSpeedlingBO) return false;
-            if (!isHydraRushBO && other.isHydraRushBO) return true;
-            if (isHydraRushBO && !other.isHydraRushBO) return false;
-            if (!isMutaRushBODecidedAfterScoutEnemyRace && other.isMutaRushBODecidedAfterScoutEnemyRace) return true;
-            if (isMutaRushBODecidedAfterScoutEnemyRace && !other.isMutaRushBODecidedAfterScoutEnemyRace) return false;
-            if (!isMutaRushBO && other.isMutaRushBO) return true;
-            if (isMutaRushBO && !other.isMutaRushBO) return false;
-            if (!isMutaRushBOVsProtoss && other.isMutaRushBOVsProtoss) return true;
-            if (isMutaRushBOVsProtoss && !other.isMutaRushBOVsProtoss) return false;
-            if (!isMutaRushBOVsTerran && other.isMutaRushBOVsTerran) return true;
-            if (isMutaRushBOVsTerran && !other.isMutaRushBOVsTerran) return false;
-            if (!isMutaRushBOVsZerg && other.isMutaRushBOVsZerg) return true;
-            if (isMutaRushBOVsZerg && !other.isMutaRushBOVsZerg) return false;
-            if (!isSpeedlingPushDeferred && other.isSpeedlingPushDeferred) return true;
-            if (isSpeedlingPushDeferred && !other.isSpeedlingPushDeferred) return false;
-            if (!isEnemyWorkerRusher && other.isEnemyWorkerRusher) return true;
-            if (isEnemyWorkerRusher && !other.isEnemyWorkerRusher) return false;
-            if (!isNumSunkensDecidedAfterScoutEnemyRace && other.isNumSunkensDecidedAfterScoutEnemyRace) return true;
-            if (isNumSunkensDecidedAfterScoutEnemyRace && !other.isNumSunkensDecidedAfterScoutEnemyRace) return false;
-            if (numSunkens < other.numSunkens) return true;
-            if (numSunkens > other.numSunkens) return false;
-            if (numSunkensVsProtoss < other.numSunkensVsProtoss) return true;
-            if (numSunkensVsProtoss > other.numSunkensVsProtoss) return false;
-            if (numSunkensVsTerran < other.numSunkensVsTerran) return true;
-            if (numSunkensVsTerran > other.numSunkensVsTerran) return false;
-            if (numSunkensVsZerg < other.numSunkensVsZerg) return true;
-            if (numSunkensVsZerg > other.numSunkensVsZerg) return false;
-            return true;
-        }
-
-        inline bool operator ==(const StratSettings& other) const
-        {
-            if (is4PoolBO != other.is4PoolBO) return false;
-            if (isSpeedlingBO != other.isSpeedlingBO) return false;
-            if (isHydraRushBO != other.isHydraRushBO) return false;
-            if (isMutaRushBODecidedAfterScoutEnemyRace != other.isMutaRushBODecidedAfterScoutEnemyRace) return false;
-            if (isMutaRushBO != other.isMutaRushBO) return false;
-            if (isMutaRushBOVsProtoss != other.isMutaRushBOVsProtoss) return false;
-            if (isMutaRushBOVsTerran != other.isMutaRushBOVsTerran) return false;
-            if (isMutaRushBOVsZerg != other.isMutaRushBOVsZerg) return false;
-            if (isSpeedlingPushDeferred != other.isSpeedlingPushDeferred) return false;
-            if (isEnemyWorkerRusher != other.isEnemyWorkerRusher) return false;
-            if (isNumSunkensDecidedAfterScoutEnemyRace != other.isNumSunkensDecidedAfterScoutEnemyRace) return false;
-            if (numSunkens != other.numSunkens) return false;
-            if (numSunkensVsProtoss != other.numSunkensVsProtoss) return false;
-            if (numSunkensVsTerran != other.numSunkensVsTerran) return false;
-            if (numSunkensVsZerg != other.numSunkensVsZerg) return false;
-            return true;
-        }
-    } ss = {};
-
-    // The key is the game ID.
-    std::map<int, StratSettings> gameIDToStratSettings;
-
-    // The key is the game ID. The value is the frame count in onEnd().
-    std::map<int, int> gameIDToOnEndFrameCount;
-
-    struct GameIDSet
-    {
-        // The value is the game ID.
-        std::set<int> val;
-    };
+    // Base locations and their resources (rebuilt in onStart()).
+    BaseRegistry baseRegistry;
 
-    struct TimerAtGameStartMap
-    {
-        // The key is the timer at the start of the game.
-        std::map<int, GameIDSet> val;
-    };
+    // Build locations for buildings (rebuilt in onStart()).
+    BuildPlanner buildPlanner;
 
-    struct OutcomeMap
-    {
-        // The key is whether the value is about wins (i.e. true) or losses (i.e. false).
-        std::map<bool, TimerAtGameStartMap> val;
+    // Which resource each of my gatherers is gathering from (updated from the unit events).
+    GathererRegistry gathererRegistry;
 
-        // The key is whether the value is about wins (i.e. true) or losses (i.e. false).
-        std::map<bool, std::map<StratSettings, int> > numOutcomes;
+    // Which tiles are covered by buildings/units (rebuilt at the start of each frame).
+    OccupancyMap occupancyMap;
 
-        int gameIDIfWonLastGame = -1;
-        int gameIDIfLostLastGame = -1;
-    };
+    // My units by type etc (rebuilt once per frame).
+    MyUnitBuckets myUnitBuckets;
 
-    struct EnemyStartLocDeducedMap
-    {
-        // The key is the enemy start location if it is known at the start of the
-        // game (e.g. if the CompleteMapInformation flag is enabled) or if it is.
-        // deduced at the start of the game, otherwise it is Unknown.
-        std::map<const BWAPI::TilePosition, OutcomeMap> val;
-
-        // The key is whether the value is about wins (i.e. true) or losses (i.e. false).
-        std::map<bool, std::map<StratSettings, int> > numOutcomes;
+    // The state of all the accessible units (copied at the start of each frame).
+    FrameSnapshot frameSnapshot;
 
-        int gameIDIfWonLastGame = -1;
-        int gameIDIfLostLastGame = -1;
-    };
+    // When each part of the map was last seen, and which unit is exploring it.
+    ExplorationMap explorationMap;
 
-    struct MyStartLocationMap
-    {
-        // The key is my start location.
-        std::map<const BWAPI::TilePosition, EnemyStartLocDeducedMap> val;
+    // Worker threads for the parts of a frame that can run at the same time.
+    ThreadPool threadPool;
 
-        // The key is whether the value is about wins (i.e. true) or losses (i.e. false).
-        std::map<bool, std::map<StratSettings, int> > numOutcomes;
+    // Counts the slow frames and says when to shed non-critical work (the host calls its
+    // onFrameStart()/onFrameEnd() around each frame; onFrame() marks its stages).
+    FrameWatchdog frameWatchdog;
 
-        int gameIDIfWonLastGame = -1;
-        int gameIDIfLostLastGame = -1;
-    };
+    // Whether onFrame() does its main work (classifying my units, the main loop etc) this frame.
+    // Unless the latency is 2 frames, it is only done on odd frames.
+    bool isMainWorkFrame();
 
-    struct MapHashMap
-    {
-        // The key is the mapHash().
-        std::map<std::string, MyStartLocationMap> val;
+    // Whether the host may skip onFrame() this frame to catch up (see FrameCatchUp). Not if the
+    // main work is only done every other frame and this is one of those frames, because then my
+    // units would go twice as long without new commands.
+    bool isFrameCoalescable();
 
-        // The key is whether the value is about wins (i.e. true) or losses (i.e. false).
-        std::map<bool, std::map<StratSettings, int> > numOutcomes;
+    // The seed for rng if it is set (e.g. from the command line, to reproduce a game), otherwise
+    // a new one is chosen in each onStart().
+    std::optional<std::uint64_t> fixedRngSeed;
 
-        int gameIDIfWonLastGame = -1;
-        int gameIDIfLostLastGame = -1;
-    };
+    // The random number generator of the match (seeded in onStart(); the seed is logged in the
+    // init update). Each subsystem draws from its own substream (see Rng::Stream).
+    Rng rng;
 
-    struct NumStartLocationsMap
+    // Bits for the data that the stages of the frame pipeline read/write.
+    enum FrameData : FramePipeline::DataMask
     {
-        // The key is the total number of start locations for the map.
-        std::map<int, MapHashMap> val;
-
-        // The key is whether the value is about wins (i.e. true) or losses (i.e. false).
-        std::map<bool, std::map<StratSettings, int> > numOutcomes;
-
-        int gameIDIfWonLastGame = -1;
-        int gameIDIfLostLastGame = -1;
+        GameStateData = 1 << 0,
+        OccupancyMapData = 1 << 1,
+        ExplorationMapData = 1 << 2,
+        FrameSnapshotData = 1 << 3
     };
 
-    struct EnemyRaceScoutedMap
+    // The stages at the start of each frame that only read the game state (set up in onStart()).
+    FramePipeline framePipeline;
+
+    // Whether the exploration map is updated this frame (decided by the "visibility" stage on the
+    // main thread, because the watchdog isn't thread-safe).
+    bool isExplorationUpdateDue = false;
+
+    // The targets chosen for my units this frame (evaluated on the thread pool, then applied in the main loop).
+    CombatIntents combatIntents;
+
+    // Set this to true to evaluate the combat intents again on the main thread every frame with
+    // BWAPI's unit queries and report any that differ from the ones that were evaluated from the
+    // frame snapshot on the thread pool (slow, only for debugging).
+    bool isCombatIntentCheckEnabled = false;
+
+    // Set this to true to infer the enemy start locations from creep again with BWAPI's unit
+    // queries (getUnitsOnTile() per tile, as before the occupancy map) every frame and count the
+    // inferences that differ from the ones made with the occupancy map (only for debugging).
+    bool isCreepInferenceCheckEnabled = false;
+
+    // How many combat intents/creep inferences were checked and how many of them differed in this
+    // match (reset in onStart()).
+    int numCombatIntentsChecked = 0;
+    int numCombatIntentMismatches = 0;
+    int numCreepInferencesChecked = 0;
+    int numCreepInferenceMismatches = 0;
+
+    // The order in which to scout the other start locations (loaded or calculated in onStart()).
+    ScoutingTours scoutingTours;
+
+    // What is left of my minerals/gas/supply after what has been made/saved up for so far (reset each frame).
+    ResourceLedger resourceLedger;
+
+    // What the larvae etc. make this frame (requested and allocated each frame).
+    ProductionPlanner productionPlanner;
+
+    // The strategy settings for this game (chosen from the learning data on the first frame).
+    StratSettings ss = {};
+
+    // What onFrame() etc. remember from one frame to the next. These used to be function-level
+    // static variables, which meant that only one game could be played per process (and what was
+    // remembered leaked into the next game if the process played more than one). The names are
+    // the same as the variables they replaced.
+    //
+    // The containers are allocated from the match arena, so the learning data etc. of a game is
+    // freed in one go when the next game starts rather than node by node. The ones that have
+    // elements inserted and erased all game long (freeGathererToRow, freeMineralToCol,
+    // lastKnownEnemyUnliftedBuildingsAnywherePosSet and unitInfo) are allocated from churnAlloc
+    // instead, which reuses the nodes that they free (the arena never does, so they would use more
+    // memory the longer the game went on).
+    struct MatchState
     {
-        // The key is enemyRaceInit if the enemy race is known at the start of the game,
-        // otherwise if the enemy race is eventually scouted it is the enemy race scouted,
-        // otherwise it is empty.
-        std::map<std::string, NumStartLocationsMap> val;
+        using allocator_type = std::pmr::polymorphic_allocator<char>;
+        MatchState(const allocator_type& alloc, const allocator_type& churnAlloc);
 
-        // The key is whether the value is about wins (i.e. true) or losses (i.e. false).
-        std::map<bool, std::map<StratSettings, int> > numOutcomes;
-
-        int gameIDIfWonLastGame = -1;
-        int gameIDIfLostLastGame = -1;
-    };
-
-    struct EnemyRaceInitMap
-    {
-        // The key is the enemy race at the start of the game (which may be Unknown).
-        std::map<std::string, EnemyRaceScoutedMap> val;
+        // Each element of the set is a tile position where creep should be on frame zero for that start location.
+        struct InitialCreepLocsSet
+        {
+            using allocator_type = std::pmr::polymorphic_allocator<char>;
+            explicit InitialCreepLocsSet(const allocator_type& alloc = {}) : val(alloc) {}
 
-        // The key is whether the value is about wins (i.e. true) or losses (i.e. false).
-        std::map<bool, std::map<StratSettings, int> > numOutcomes;
+            std::pmr::set<BWAPI::TilePosition> val;
+        };
 
-        int gameIDIfWonLastGame = -1;
-        int gameIDIfLostLastGame = -1;
+        // The key is the starting location (mine and possible enemy start locations).
+        struct InitialCreepLocsMap
+        {
+            using allocator_type = std::pmr::polymorphic_allocator<char>;
+            explicit InitialCreepLocsMap(const allocator_type& alloc = {}) : val(alloc) {}
+
+            std::pmr::map<const BWAPI::TilePosition, InitialCreepLocsSet> val;
+        };
+
+        // Start locations.
+        std::pmr::set<BWAPI::TilePosition> enemyStartLocs;
+        std::pmr::set<BWAPI::TilePosition> possibleOverlordScoutLocs;
+        bool isARemainingEnemyZerg = false;
+        bool isARemainingEnemyTerran = false;
+        bool isARemainingEnemyProtoss = false;
+        bool isARemainingEnemyRandomRace = false;
+        std::pmr::set<BWAPI::TilePosition> startLocs;
+        BWAPI::TilePosition myStartLoc = BWAPI::TilePositions::Unknown;
+        BWAPI::Position myStartRoughPos = BWAPI::Positions::Unknown;
+        std::pmr::set<BWAPI::TilePosition> otherStartLocs;
+        std::pmr::set<BWAPI::TilePosition> scoutedOtherStartLocs;
+        std::pmr::set<BWAPI::TilePosition> unscoutedOtherStartLocs;
+
+        // Initial creep.
+        bool isMapPlasma_v_1_0 = false;
+        InitialCreepLocsMap initialCreepLocsMap;
+        bool isCreepDataUpdateAttempted = false;
+        BWAPI::TilePosition probableEnemyStartLoc = BWAPI::TilePositions::Unknown;
+
+        // The enemy details (read once, on the first frame).
+        BWAPI::Race enemyRaceInit;
+        BWAPI::Race enemyRaceScouted;
+        bool checkedEnemyDetails = false;
+        BWAPI::PlayerType enemyPlayerType;
+        BWAPI::TilePosition enemyStartLoc;
+        BWAPI::TilePosition enemyStartLocDeduced = BWAPI::TilePositions::Unknown;
+        std::string enemyName;
+        std::string enemyNameUpperCase;
+        std::string enemyFileName;
+        std::string enemyReadFilePath;
+
+        // The learning data read from the enemy's file on the first frame.
+        // The key is the game ID.
+        std::pmr::map<int, StratSettings> gameIDToStratSettings;
+        // The key is the game ID. The value is the frame count in onEnd().
+        std::pmr::map<int, int> gameIDToOnEndFrameCount;
+        LearningMap learningMap;
+
+        // Where enemy units have been seen.
+        std::pmr::set<BWAPI::Position> lastKnownEnemyUnliftedBuildingsAnywherePosSet;
+        BWAPI::Position firstEnemyNonWorkerSeenPos = BWAPI::Positions::Unknown;
+        BWAPI::Position closestEnemySeenPos = BWAPI::Positions::Unknown;
+        BWAPI::Position furthestEnemySeenPos = BWAPI::Positions::Unknown;
+        bool isClosestEnemySeenAnOverlord = false;
+
+        // Scouting (the isScoutingUsing*/isNeed* flags are decided from the strat settings on
+        // the first frame, which is what isScoutingDecided is for).
+        BWAPI::Unit scoutingWorker = nullptr;
+        BWAPI::Unit scoutingZergling = nullptr;
+        bool isScoutingDecided = false;
+        bool isScoutingUsingWorker = false;
+        bool isScoutingUsingZergling = false;
+        bool isNeedScoutingWorker = false;
+        bool isNeedToMorphScoutingWorker = false;
+        bool isScoutingWorkerReadyToScout = false;
+
+        // Builders and where they are building.
+        BWAPI::Unit geyser = nullptr;
+        BWAPI::Unit groundArmyBuildingBuilder = nullptr;
+        BWAPI::TilePosition groundArmyBuildingLoc = BWAPI::TilePositions::None;
+        BWAPI::Unit extractorBuilder = nullptr;
+        BWAPI::TilePosition extractorLoc = BWAPI::TilePositions::None;
+        BWAPI::Unit creepColonyBuilder = nullptr;
+        BWAPI::TilePosition creepColonyLoc = BWAPI::TilePositions::None;
+        BWAPI::Unit hatcheryBuilder = nullptr;
+        BWAPI::TilePosition hatcheryLoc = BWAPI::TilePositions::None;
+        BWAPI::Unit queensNestBuilder = nullptr;
+        BWAPI::TilePosition queensNestLoc = BWAPI::TilePositions::None;
+        BWAPI::Unit spireBuilder = nullptr;
+        BWAPI::TilePosition spireLoc = BWAPI::TilePositions::None;
+        BWAPI::Unit hydraDenBuilder = nullptr;
+        BWAPI::TilePosition hydraDenLoc = BWAPI::TilePositions::None;
+        BWAPI::Unit ultraCavernBuilder = nullptr;
+        BWAPI::TilePosition ultraCavernLoc = BWAPI::TilePositions::None;
+
+        // Economy.
+        int lastAddedGathererToRefinery = 0;
+        int lastIssuedBuildSupplyProviderCmd = 0;
+        AssignmentSolver freeMineralSolver;
+        std::pmr::map<const BWAPI::Unit, int> freeGathererToRow;
+        std::pmr::map<const BWAPI::Unit, int> freeMineralToCol;
+
+        // The values set by setClientInfo() for each unit (the key of the inner map is the index).
+        std::pmr::map<BWAPI::Unit, std::pmr::map<int, void *>> unitInfo;
+
+        // The frame count when onEnd() was called (so that it only writes once), and the players
+        // that onPlayerLeft() has been called for (likewise).
+        int frameCountLastCalled = -1;
+        std::pmr::set<BWAPI::PlayerID> playerIDsLeft;
     };
 
-    struct LearningMap
-    {
-        EnemyRaceInitMap enemyRaceInitMap;
-
-        // The key is whether the value is about wins (i.e. true) or losses (i.e. false).
-        std::map<bool, int> numOutcomes;
-
-        int gameIDIfWonLastGame = -1;
-        int gameIDIfLostLastGame = -1;
-    } learningMap;
+    // Containers that onFrame() reuses every frame (it clears them first) rather than making new
+    // ones, because the components that they are passed to take a std::vector. Their memory is
+    // only allocated when they grow past their biggest size so far.
+    std::vector<BWAPI::UnitType> producerTypesScratch;
+    std::vector<BWAPI::Unit> producersScratch;
+    std::vector<BWAPI::Unit> myCombatIntentUnitsScratch;
+
+    // The memory for matchState (released in one go in onStart()) and for the temporaries of
+    // onFrame() (released at the start of each frame). The peaks are written to arenaStatsFileName
+    // in the write folder in onEnd().
+    Arena matchArena;
+    Arena frameArena{64 * 1024};
+
+    // The memory for the containers of matchState that churn (see MatchState). It gets its memory
+    // from the match arena in chunks and keeps the nodes that are freed in pools to hand out again.
+    // Recreated in onStart() along with matchState.
+    std::optional<std::pmr::unsynchronized_pool_resource> matchPool;
+    const std::string arenaStatsFileName = "ZZZKBot_arena_stats.txt";
+
+    // Everything that onFrame() etc. remember between frames (recreated in onStart(), after the
+    // previous one is destroyed and the match arena is reset, so it is empty until then).
+    std::optional<MatchState> matchState;
 };
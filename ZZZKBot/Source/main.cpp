@@ -1,20 +1,177 @@
 #include <BWAPI.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <string>
 
+#ifdef ZZZKBOT_COUNT_ALLOCATIONS
+#include "AllocationCounter.h"
+#endif
+#include "Backoff.h"
+#include "FrameCatchUp.h"
+#include "FrameTimeStats.h"
+#include "FrameWatchdog.h"
+#include "GameRecordReader.h"
+#include "GameRecorder.h"
 #include "ZZZKBotAIModule.h"
 
 
 void reconnect(BWAPI::Client &BWAPIClient)
 {
+  // Retry quickly at first (e.g. the server is just starting) but then back off so that a
+  // missing server doesn't cost much CPU.
+  Backoff backoff(std::chrono::milliseconds{ 100 }, std::chrono::milliseconds{ 5000 }, true);
   while (!BWAPIClient.connect())
   {
-    std::this_thread::sleep_for(std::chrono::milliseconds{ 1000 });
+    std::this_thread::sleep_for(backoff.next());
   }
 }
 
+// Command line options:
+// --frame-period-ms <ms>: the real time per game frame that the catch-up policy assumes.
+// --max-coalesced-frames <n>: how many frames in a row may skip onFrame() when the bot is
+// behind (0, the default, disables it).
+FrameCatchUp::Policy parseFrameCatchUpPolicy(int argc, const char* argv[])
+{
+  FrameCatchUp::Policy policy;
+  for (int i = 1; i + 1 < argc; ++i)
+  {
+    if (std::strcmp(argv[i], "--frame-period-ms") == 0)
+    {
+      policy.framePeriod = std::chrono::milliseconds{ std::max(1, std::atoi(argv[++i])) };
+    }
+    else if (std::strcmp(argv[i], "--max-coalesced-frames") == 0)
+    {
+      policy.maxConsecutiveCoalescedFrames = std::max(0, std::atoi(argv[++i]));
+    }
+  }
+
+  return policy;
+}
+
+// --shed-fraction <f>: shed non-critical work for the rest of the game once the slow frames have
+// used up this fraction of any of the competition limits.
+// --shed-frames <n>: also shed it for n frames after each frame over 55ms.
+// --deferred-work-period <n>: while shedding, do the work that is put off once every n frames.
+FrameWatchdog::Policy parseFrameWatchdogPolicy(int argc, const char* argv[])
+{
+  FrameWatchdog::Policy policy;
+  for (int i = 1; i + 1 < argc; ++i)
+  {
+    if (std::strcmp(argv[i], "--shed-fraction") == 0)
+    {
+      policy.shedFraction = std::max(0.0, std::atof(argv[++i]));
+    }
+    else if (std::strcmp(argv[i], "--shed-frames") == 0)
+    {
+      policy.shedFramesAfterSlowFrame = std::max(0, std::atoi(argv[++i]));
+    }
+    else if (std::strcmp(argv[i], "--deferred-work-period") == 0)
+    {
+      policy.deferredWorkPeriodFrames = std::max(1, std::atoi(argv[++i]));
+    }
+  }
+
+  return policy;
+}
+
+// --record <prefix>: write a game record of each match to <prefix><match number>.zzkr.
+// --dump-record <file>: read a game record back (without connecting) and report what's in it and
+// how fast it decodes, then exit. (To play a record through the bot, use the bench's --replay.)
+// --seed <n>: seed the bot's RNG with n in every match (to reproduce a game from the seed in its
+// init update) instead of with a new random seed.
+const char* getOption(int argc, const char* argv[], const char* name)
+{
+  for (int i = 1; i + 1 < argc; ++i)
+  {
+    if (std::strcmp(argv[i], name) == 0)
+    {
+      return argv[i + 1];
+    }
+  }
+
+  return nullptr;
+}
+
+int dumpRecord(const char* filePath)
+{
+  GameRecordReader reader;
+  if (!reader.open(filePath))
+  {
+    std::cout << "Can't read game record " << filePath << std::endl;
+    return 1;
+  }
+
+  std::cout << "map: " << reader.getMatchInfo().mapName << " (" << reader.getMatchInfo().mapHash << ")"
+            << ", players: " << reader.getMatchInfo().players.size() << std::endl;
+
+  GameRecord::Frame frame;
+  std::uint64_t numFrames = 0;
+  std::uint64_t numUnitStates = 0;
+  std::uint64_t numEvents = 0;
+  std::uint64_t numCommands = 0;
+  std::size_t maxUnits = 0;
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  while (reader.readFrame(frame))
+  {
+    ++numFrames;
+    numUnitStates += frame.units.size();
+    numEvents += frame.events.size();
+    numCommands += frame.commands.size();
+    maxUnits = std::max(maxUnits, frame.units.size());
+  }
+  const std::chrono::microseconds duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+  std::cout << "frames: " << numFrames
+            << ", last frame: " << frame.frameCount
+            << ", max units: " << maxUnits
+            << ", events: " << numEvents
+            << ", commands: " << numCommands << std::endl;
+  std::cout << "decoded in " << duration.count() << " us"
+            << " (" << (numFrames > 0 ? (double) duration.count() / numFrames : 0.0) << " us per frame, "
+            << (duration.count() > 0 ? (double) numUnitStates * 1000000 / duration.count() : 0.0) << " unit states per second)" << std::endl;
+  if (reader.isCorrupt())
+  {
+    std::cout << "The record is truncated or corrupt after frame " << frame.frameCount << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
 int main(int argc, const char* argv[])
 {
+  if (const char* dumpFilePath = getOption(argc, argv, "--dump-record"))
+  {
+    return dumpRecord(dumpFilePath);
+  }
+
+  const char* recordPathPrefix = getOption(argc, argv, "--record");
+  GameRecorder gameRecorder;
+  int matchNumber = 0;
+
   ZZZKBotAIModule bot;
+  if (const char* seedStr = getOption(argc, argv, "--seed"))
+  {
+    bot.fixedRngSeed = std::strtoull(seedStr, nullptr, 10);
+  }
+  bot.frameWatchdog.setPolicy(parseFrameWatchdogPolicy(argc, argv));
+
+  FrameCatchUp frameCatchUp(parseFrameCatchUpPolicy(argc, argv));
+
+#ifdef ZZZKBOT_COUNT_ALLOCATIONS
+  // Once the arenas and the reused containers have grown to their working sizes, a frame should
+  // hardly allocate from the heap, so the allocations of each frame after the first minute of
+  // game time are counted.
+  const int allocationWarmUpFrames = 24 * 60;
+#endif
+
+  // Between matches the updates return straight away, so wait a little longer each time rather
+  // than spinning.
+  Backoff lobbyBackoff(std::chrono::milliseconds{ 1 }, std::chrono::milliseconds{ 100 }, false);
+
   std::cout << "Connecting..." << std::endl;
   reconnect(bot.BWAPIClient);
   while (true)
@@ -28,64 +185,99 @@ int main(int argc, const char* argv[])
         reconnect(bot.BWAPIClient);
       }
       bot.BWAPIClient.update(bot.Broodwar);
+      if (!bot.Broodwar->isInGame())
+      {
+        std::this_thread::sleep_for(lobbyBackoff.next());
+      }
     }
+    lobbyBackoff.reset();
+    if (recordPathPrefix != nullptr)
+    {
+      const std::string recordFilePath = recordPathPrefix + std::to_string(matchNumber) + ".zzkr";
+      if (!gameRecorder.onStart(bot.Broodwar, recordFilePath))
+      {
+        std::cout << "Can't write game record " << recordFilePath << std::endl;
+      }
+    }
+    ++matchNumber;
     bot.onStart();
+    frameCatchUp.onStart();
+    FrameTimeStats frameTimes;
+#ifdef ZZZKBOT_COUNT_ALLOCATIONS
+    int numFramesAfterWarmUp = 0;
+    int numAllocatingFramesAfterWarmUp = 0;
+    std::uint64_t maxAllocationsPerFrameAfterWarmUp = 0;
+#endif
     while (bot.Broodwar->isInGame())
     {
+      const std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+#ifdef ZZZKBOT_COUNT_ALLOCATIONS
+      const std::uint64_t numAllocationsBefore = AllocationCounter::getNumAllocations();
+#endif
+      bot.frameWatchdog.onFrameStart();
+      const bool isCoalesced = frameCatchUp.shouldCoalesce(bot.isFrameCoalescable());
+
+      // Every event is delivered even if the frame is coalesced, so that e.g. the registries
+      // that are updated from unit events stay correct.
       for (auto &e : bot.Broodwar->getEvents())
       {
-        switch (e.getType())
+        bot.onEvent(e);
+      }
+      if (!isCoalesced)
+      {
+        bot.onFrame();
+      }
+      if (gameRecorder.isRecording())
+      {
+        bot.frameWatchdog.beginStage("record");
+        gameRecorder.onFrame(bot.Broodwar, bot.Broodwar->getEvents());
+      }
+
+#ifdef ZZZKBOT_COUNT_ALLOCATIONS
+      // Coalesced frames are counted too, so that skipping onFrame() doesn't hide slow or
+      // allocating frames from the stats.
+      if (bot.Broodwar->getFrameCount() >= allocationWarmUpFrames)
+      {
+        const std::uint64_t numAllocations = AllocationCounter::getNumAllocations() - numAllocationsBefore;
+        ++numFramesAfterWarmUp;
+        if (numAllocations > 0)
         {
-        case BWAPI::EventType::MatchEnd:
-          bot.onEnd(e.isWinner());
-          break;
-        case BWAPI::EventType::SendText:
-          bot.onSendText(e.getText());
-          break;
-        case BWAPI::EventType::ReceiveText:
-          bot.onReceiveText(e.getPlayer(), e.getText());
-          break;
-        case BWAPI::EventType::PlayerLeft:
-          bot.onPlayerLeft(e.getPlayer());
-          break;
-        case BWAPI::EventType::NukeDetect:
-          bot.onNukeDetect(e.getPosition());
-          break;
-        case BWAPI::EventType::UnitDiscover:
-          bot.onUnitDiscover(e.getUnit());
-          break;
-        case BWAPI::EventType::UnitEvade:
-          bot.onUnitEvade(e.getUnit());
-          break;
-        case BWAPI::EventType::UnitShow:
-          bot.onUnitShow(e.getUnit());
-          break;
-        case BWAPI::EventType::UnitHide:
-          bot.onUnitHide(e.getUnit());
-          break;
-        case BWAPI::EventType::UnitCreate:
-          bot.onUnitCreate(e.getUnit());
-          break;
-        case BWAPI::EventType::UnitDestroy:
-          bot.onUnitDestroy(e.getUnit());
-          break;
-        case BWAPI::EventType::UnitMorph:
-          bot.onUnitMorph(e.getUnit());
-          break;
-        case BWAPI::EventType::UnitRenegade:
-          bot.onUnitRenegade(e.getUnit());
-          break;
-        case BWAPI::EventType::SaveGame:
-          bot.onSaveGame(e.getText());
-          break;
-        case BWAPI::EventType::UnitComplete:
-          bot.onUnitComplete(e.getUnit());
-          break;
+          ++numAllocatingFramesAfterWarmUp;
         }
+        maxAllocationsPerFrameAfterWarmUp = std::max(maxAllocationsPerFrameAfterWarmUp, numAllocations);
       }
-      bot.onFrame();
+#endif
+      bot.frameWatchdog.onFrameEnd(bot.Broodwar->getFrameCount(), isCoalesced);
       bot.BWAPIClient.update(bot.Broodwar);
+
+      // A frame lasts from the return of one update to the return of the next, so its time
+      // includes the transport (and the time the server took to run the game frame).
+      const std::chrono::microseconds frameDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - frameStart);
+      frameTimes.add(frameDuration);
+      frameCatchUp.onFrameProcessed(frameDuration);
+    }
+    if (gameRecorder.isRecording())
+    {
+      gameRecorder.onEnd();
+      std::cout << "recorded frames: " << gameRecorder.getNumFramesWritten()
+                << ", bytes: " << gameRecorder.getNumBytesWritten() << std::endl;
     }
+    std::cout << "frames: " << frameCatchUp.getNumFrames()
+              << ", coalesced: " << frameCatchUp.getNumCoalescedFrames()
+              << ", max frames behind: " << frameCatchUp.getMaxFramesBehind() << std::endl;
+    std::cout << "frame p50: " << frameTimes.getPercentile(0.5).count() << " us"
+              << ", p99: " << frameTimes.getPercentile(0.99).count() << " us"
+              << ", max: " << frameTimes.getMax().count() << " us" << std::endl;
+    std::cout << "frames over 55ms: " << bot.frameWatchdog.getNumFramesOver(0)
+              << ", over 1s: " << bot.frameWatchdog.getNumFramesOver(1)
+              << ", over 10s: " << bot.frameWatchdog.getNumFramesOver(2)
+              << ", shed: " << bot.frameWatchdog.getNumShedFrames()
+              << ", worst stages: " << bot.frameWatchdog.getWorstStagesString(3) << std::endl;
+#ifdef ZZZKBOT_COUNT_ALLOCATIONS
+    std::cout << "frames after warm-up: " << numFramesAfterWarmUp
+              << ", of which allocated: " << numAllocatingFramesAfterWarmUp
+              << ", max allocations in a frame: " << maxAllocationsPerFrameAfterWarmUp << std::endl;
+#endif
   }
   return 0;
 }
\ No newline at end of file